@@ -32,6 +32,7 @@
 #import "ORKAccelerometerRecorder.h"
 #import "ORKDataLogger.h"
 #import "CMAccelerometerData+ORKJSONDictionary.h"
+#import "ORKMotionHub.h"
 #import <CoreMotion/CoreMotion.h>
 #import "ORKRecorder_Internal.h"
 #import "ORKRecorder_Private.h"
@@ -43,9 +44,9 @@
     NSError *_recordingError;
 }
 
-@property (nonatomic, strong) CMMotionManager *motionManager;
+@property (nonatomic, strong) ORKMotionHub *motionHub;
 
-@property (nonatomic) NSTimeInterval uptime;
+@property (nonatomic, strong) id<NSObject> motionSubscription;
 
 @end
 
@@ -77,14 +78,15 @@
     }
 }
 
-- (CMMotionManager *)createMotionManager {
-    return [[CMMotionManager alloc] init];
+- (ORKMotionHub *)sharedMotionHub {
+    return [ORKMotionHub sharedHub];
 }
 
 - (void)start {
     [super start];
     
-    self.motionManager = [self createMotionManager];
+    [self doStopRecording];
+    self.motionHub = [self sharedMotionHub];
     
     if (!_logger) {
         NSError *error = nil;
@@ -95,7 +97,7 @@
         }
     }
     
-    if (!self.motionManager || !self.motionManager.accelerometerAvailable) {
+    if (!self.motionHub || !self.motionHub.accelerometerAvailable) {
         NSError *error = [NSError errorWithDomain:NSCocoaErrorDomain
                                              code:NSFeatureUnsupportedError
                                          userInfo:@{@"recorder": self}];
@@ -103,13 +105,8 @@
         return;
     }
     
-    self.motionManager.accelerometerUpdateInterval = 1.0 / _frequency;
-    
-    self.uptime = [NSProcessInfo processInfo].systemUptime;
-    
-    [self.motionManager stopAccelerometerUpdates];
-    
-    [self.motionManager startAccelerometerUpdatesToQueue:[[NSOperationQueue alloc] init] withHandler:^(CMAccelerometerData *data, NSError *error) {
+    // The hub runs the sensor at the highest rate any recorder needs, and decimates to ours.
+    self.motionSubscription = [self.motionHub addAccelerometerSubscriberWithFrequency:_frequency queue:nil handler:^(CMAccelerometerData *data, NSError *error) {
          BOOL success = NO;
          if (data) {
              success = [_logger append:[data ork_JSONDictionary] error:&error];
@@ -129,14 +126,11 @@
 
 - (void)stop {
     [self doStopRecording];
-    [_logger finishCurrentLog];
+    [self finishCurrentLogOfLogger:_logger];
     
     NSError *error = _recordingError;
     _recordingError = nil;
-    __block NSURL *fileUrl = nil;
-    [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
-        fileUrl = logFileUrl;
-    } error:&error];
+    NSURL *fileUrl = _logger.lastFinishedLogFileURL;
     
     [self reportFileResultWithFile:fileUrl error:error];
     
@@ -145,8 +139,8 @@
 
 - (void)doStopRecording {
     if (self.isRecording) {
-        [self.motionManager stopAccelerometerUpdates];
-        self.motionManager = nil;
+        [self.motionHub removeSubscriber:self.motionSubscription];
+        self.motionSubscription = nil;
     }
 }
 
@@ -162,7 +156,7 @@
 }
 
 - (BOOL)isRecording {
-    return self.motionManager.accelerometerActive;
+    return (self.motionSubscription != nil);
 }
 
 - (NSString *)mimeType {
@@ -44,6 +44,7 @@
 #import "ORKTaskViewController_Internal.h"
 #import "ORKActiveStepTimerView.h"
 #import "ORKActiveStepTimer.h"
+#import "ORKSessionClock.h"
 #import "ORKAccessibility.h"
 #import "ORKStepHeaderView_Internal.h"
 #import "ORKActiveStepView.h"
@@ -52,8 +53,12 @@
 @interface ORKActiveStepViewController () {
     ORKActiveStepView *_activeStepView;
     ORKActiveStepTimer *_activeStepTimer;
+    ORKSessionClock *_sessionClock;
 
     NSArray *_recorderResults;
+    // Recorders whose logs are still being closed, and whether to go forward once they have reported
+    NSMutableArray<ORKRecorder *> *_stoppingRecorders;
+    BOOL _goForwardAfterStoppingRecorders;
     
     SystemSoundID _alertSound;
     NSURL *_alertSoundURL;
@@ -72,6 +77,7 @@
     self = [super initWithStep:step];
     if (self) {
         _recorderResults = [NSArray new];
+        _stoppingRecorders = [NSMutableArray new];
         
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationWillResignActive:) name:UIApplicationWillResignActiveNotification object:nil];
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationDidBecomeActive:) name:UIApplicationDidBecomeActiveNotification object:nil];
@@ -225,6 +231,10 @@
     // Stop any existing recorders
     [self recordersWillStop];
     for (ORKRecorder *recorder in self.recorders) {
+        if ([_stoppingRecorders containsObject:recorder]) {
+            // Still reports its result once its log is closed
+            continue;
+        }
         recorder.delegate = nil;
         [recorder stop];
     }
@@ -275,18 +285,68 @@
 
 - (void)startRecorders {
     [self recordersWillStart];
+    // All recorders of the step share one clock, so their streams can be aligned.
+    // The clock outlives recorder restarts (e.g. on returning from background).
+    if (!_sessionClock) {
+        _sessionClock = [ORKSessionClock new];
+    }
     // Start recorders
+    CFTimeInterval startTime = CACurrentMediaTime();
     for (ORKRecorder *recorder in self.recorders) {
+        recorder.sessionClock = _sessionClock;
         [recorder viewController:self willStartStepWithView:self.customViewContainer];
         [recorder start];
     }
+    _recorderStartDuration = CACurrentMediaTime() - startTime;
+    ORK_Log_Debug(@"Started %@ recorders in %.1f ms", @(self.recorders.count), _recorderStartDuration * 1000);
 }
 
 - (void)stopRecorders {
     [self recordersWillStop];
+    CFTimeInterval startTime = CACurrentMediaTime();
+    NSMutableArray<ORKRecorder *> *recorders = [NSMutableArray array];
     for (ORKRecorder *recorder in self.recorders) {
-        [recorder stop];
+        if (![_stoppingRecorders containsObject:recorder]) {
+            [recorders addObject:recorder];
+        }
+    }
+    if (recorders.count == 0) {
+        return;
+    }
+    [_stoppingRecorders addObjectsFromArray:recorders];
+    
+    // Stop capture on every recorder first and let their log files close concurrently off the
+    // main queue, so each -stop only has to report a file that is already finished.
+    dispatch_group_t group = dispatch_group_create();
+    for (ORKRecorder *recorder in recorders) {
+        [recorder prepareToStopInGroup:group];
+    }
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        for (ORKRecorder *recorder in recorders) {
+            [recorder stop];
+        }
+        [_stoppingRecorders removeObjectsInArray:recorders];
+        _recorderStopDuration = CACurrentMediaTime() - startTime;
+        ORK_Log_Debug(@"Stopped %@ recorders in %.1f ms", @(recorders.count), _recorderStopDuration * 1000);
+        
+        if (_goForwardAfterStoppingRecorders && _stoppingRecorders.count == 0) {
+            _goForwardAfterStoppingRecorders = NO;
+            [self goForward];
+        }
+    });
+}
+
+- (BOOL)isStoppingRecorders {
+    return _stoppingRecorders.count > 0;
+}
+
+- (void)goForward {
+    if (self.isStoppingRecorders) {
+        // The step result must include the results of the recorders being stopped
+        _goForwardAfterStoppingRecorders = YES;
+        return;
     }
+    [super goForward];
 }
 
 - (void)playSound {
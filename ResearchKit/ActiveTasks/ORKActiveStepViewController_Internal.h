@@ -59,8 +59,20 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)applicationWillResignActive:(NSNotification *)notification;
 - (void)applicationDidBecomeActive:(NSNotification *)notification;
 
+/*
+ Stops capture on all running recorders and closes their logs off the main queue. The recorders
+ report their results on the main queue once every log is closed; until then `isStoppingRecorders`
+ is `YES` and `-goForward` is deferred, so the step result includes them.
+ */
 - (void)stopRecorders;
 
+@property (nonatomic, readonly, getter=isStoppingRecorders) BOOL stoppingRecorders;
+
+// How long the last start of the step's recorders took on the main queue, and how long their last
+// stop took to complete, for tuning.
+@property (nonatomic, readonly) NSTimeInterval recorderStartDuration;
+@property (nonatomic, readonly) NSTimeInterval recorderStopDuration;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -83,6 +83,34 @@ ORK_CLASS_AVAILABLE
                    onChannel:(ORKAudioChannel)channel
               fadeInDuration:(NSTimeInterval)duration;
 
+/**
+ Plays an audio stimulus at a specific frequency on a specific channel, with a fade-in effect.
+
+ The stimulus is fully prepared before playback starts, so the audio render thread neither
+ allocates memory nor takes locks. Its peak amplitude is looked up in `calibrationTable`.
+
+ @param stimulusType The kind of stimulus to play.
+ @param frequency The audio frequency in hertz (center frequency for narrow band noise).
+ @param channel The audio channel (left or right).
+ @param duration The fade-in duration.
+ */
+- (void)playStimulus:(ORKAudioStimulusType)stimulusType
+         atFrequency:(double)frequency
+           onChannel:(ORKAudioChannel)channel
+      fadeInDuration:(NSTimeInterval)duration;
+
+/**
+ Prepares a stimulus for the specified frequencies in the background, so that playing it later
+ does not have to. Narrow band noise is calibrated to the level of a pure tone, which takes a
+ measurable amount of time per frequency; other stimuli need no preparation.
+
+ Frequencies that were not prepared are prepared when they are played.
+
+ @param stimulusType The kind of stimulus to prepare.
+ @param frequencies The frequencies, in hertz (`NSNumber`), that will be played.
+ */
+- (void)prepareStimulus:(ORKAudioStimulusType)stimulusType atFrequencies:(NSArray<NSNumber *> *)frequencies;
+
 /**
  Stops the audio being played.
  */
@@ -102,6 +130,33 @@ ORK_CLASS_AVAILABLE
  */
 - (double)volumeAmplitude;
 
+/**
+ The sample rate used to render audio, in hertz.
+
+ This is the current hardware sample rate of the shared audio session. It is refreshed when the
+ audio route changes or media services are reset, which stops the stimulus being played.
+ */
+@property (nonatomic, readonly) double sampleRate;
+
+/**
+ A table mapping frequencies in hertz (`NSNumber`) to the peak amplitude, from 0 to 1,
+ reached at the end of the fade-in (`NSNumber`).
+
+ Amplitudes are interpolated in decibels over the logarithm of the frequency, and frequencies
+ outside the table use the nearest entry. When the table is `nil` or empty, a fixed default
+ amplitude is used. Changes apply to the next stimulus played.
+ */
+@property (nonatomic, copy, nullable) NSDictionary<NSNumber *, NSNumber *> *calibrationTable;
+
+/**
+ Returns the calibrated peak amplitude for a frequency.
+
+ @param frequency The audio frequency in hertz.
+
+ @return The peak amplitude, from 0 to 1.
+ */
+- (double)amplitudeForFrequency:(double)frequency;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -51,24 +51,40 @@
 
 #import "ORKAudioGenerator.h"
 
+#import "ORKToneSynthesizer.h"
+#import "ORKHelpers.h"
+
 @import AudioToolbox;
 
+
+/**
+ Everything the render callback needs, kept in plain C so that the real-time audio thread
+ never messages or reads through an Objective-C object.
+ */
+typedef struct ORKAudioGeneratorRenderContext {
+    ORKToneSynthesizer synthesizer;
+    ORKAudioChannel activeChannel;
+    bool playsStereo;
+} ORKAudioGeneratorRenderContext;
+
 @interface ORKAudioGenerator () {
-    @public
     AudioComponentInstance _toneUnit;
-
-@public
-    double _frequency;
-    double _theta;
-    ORKAudioChannel _activeChannel;
-    BOOL _playsStereo;
-    double _fadeInFactor;
-    NSTimeInterval _fadeInDuration;
+    ORKAudioGeneratorRenderContext _renderContext;
+    
+    // Owns the precomputed waveform the render context loops over, if any.
+    NSMutableData *_waveformData;
+    uint32_t _noiseSeed;
+    
+    NSArray<NSNumber *> *_calibrationFrequencies;
+    
+    // Narrow band noise gains keyed by @[sample rate, frequency]; only accessed on _calibrationQueue.
+    dispatch_queue_t _calibrationQueue;
+    NSMutableDictionary<NSArray<NSNumber *> *, NSNumber *> *_noiseGains;
 }
 
 - (void)setupAudioSession;
 - (void)createToneUnit;
-- (void)play;
+- (void)playWithConfiguration:(void (^)(ORKToneSynthesizer *synthesizer))configuration;
 - (void)handleInterruption:(id)sender;
 
 @end
@@ -83,45 +99,19 @@ OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
                                      UInt32 					inBusNumber,
                                      UInt32 					inNumberFrames,
                                      AudioBufferList 			*ioData) {
-    // Fixed amplitude is good enough for our purposes
-    const double amplitude = ORKSineWaveToneGeneratorAmplitudeDefault;
-
-    // Get the tone parameters out of the view controller
-    ORKAudioGenerator *audioGenerator = (__bridge ORKAudioGenerator *)inRefCon;
-    double theta = audioGenerator->_theta;
-    double theta_increment = 2.0 * M_PI * audioGenerator->_frequency / ORKSineWaveToneGeneratorSampleRateDefault;
-
-    double fadeInFactor = audioGenerator->_fadeInFactor;
-
-    // This is a mono tone generator so we only need the first buffer
-    Float32 *bufferActive    = (Float32 *)ioData->mBuffers[audioGenerator->_activeChannel].mData;
-    Float32 *bufferNonActive = (Float32 *)ioData->mBuffers[1 - audioGenerator->_activeChannel].mData;
-
-    // Generate the samples
-    for (UInt32 frame = 0; frame < inNumberFrames; frame++) {
-        double bufferValue = sin(theta) * amplitude * pow(10, 2 * fadeInFactor - 2);
-        bufferActive[frame] = bufferValue;
-        if (audioGenerator->_playsStereo) {
-            bufferNonActive[frame] = bufferValue;
-        } else {
-            bufferNonActive[frame] = 0;
-        }
+    ORKAudioGeneratorRenderContext *context = (ORKAudioGeneratorRenderContext *)inRefCon;
 
-        theta += theta_increment;
-        if (theta > 2.0 * M_PI) {
-            theta -= 2.0 * M_PI;
-        }
+    // This is a mono tone generator so we only render the active buffer
+    Float32 *bufferActive    = (Float32 *)ioData->mBuffers[context->activeChannel].mData;
+    Float32 *bufferNonActive = (Float32 *)ioData->mBuffers[1 - context->activeChannel].mData;
 
-        fadeInFactor += 1.0 / (ORKSineWaveToneGeneratorSampleRateDefault * audioGenerator->_fadeInDuration);
-        if (fadeInFactor >= 1) {
-            fadeInFactor = 1;
-        }
+    ORKToneSynthesizerRender(&context->synthesizer, bufferActive, inNumberFrames);
+    if (context->playsStereo) {
+        memcpy(bufferNonActive, bufferActive, inNumberFrames * sizeof(Float32));
+    } else {
+        memset(bufferNonActive, 0, inNumberFrames * sizeof(Float32));
     }
 
-    // Store the theta back in the view controller
-    audioGenerator->_theta = theta;
-    audioGenerator->_fadeInFactor = fadeInFactor;
-
     return noErr;
 }
 
@@ -133,6 +123,16 @@ OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
     if (self) {
         [self setupAudioSession];
         
+        _sampleRate = [AVAudioSession sharedInstance].sampleRate;
+        if (_sampleRate <= 0) {
+            _sampleRate = ORKSineWaveToneGeneratorSampleRateDefault;
+        }
+        _noiseSeed = arc4random() | 1;
+        ORKToneSynthesizerInitialize(&_renderContext.synthesizer, _sampleRate, ORKSineWaveToneGeneratorAmplitudeDefault);
+        
+        _calibrationQueue = dispatch_queue_create("org.researchkit.audiogenerator.calibration", DISPATCH_QUEUE_SERIAL);
+        _noiseGains = [NSMutableDictionary new];
+        
         // Automatically stop and then restart audio playback when the app resigns active.
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationDidBecomeActive:) name:UIApplicationDidBecomeActiveNotification object:nil];
         [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(applicationWillResignActive:) name:UIApplicationWillResignActiveNotification object:nil];
@@ -165,42 +165,159 @@ OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
 }
 
 - (double)volumeAmplitude {
-    return ORKSineWaveToneGeneratorAmplitudeDefault * pow(10, 2 * _fadeInFactor - 2);
+    return ORKToneSynthesizerCurrentAmplitude(&_renderContext.synthesizer);
 }
 
-- (void)playSoundAtFrequency:(double)playFrequency {
-    _frequency = playFrequency;
-    _fadeInFactor = 0;
-    _fadeInDuration = 0.5;
-    _playsStereo = YES;
+- (void)setCalibrationTable:(NSDictionary<NSNumber *, NSNumber *> *)calibrationTable {
+    _calibrationTable = [calibrationTable copy];
+    _calibrationFrequencies = [_calibrationTable.allKeys sortedArrayUsingSelector:@selector(compare:)];
+}
+
+- (double)amplitudeForFrequency:(double)frequency {
+    NSUInteger count = _calibrationFrequencies.count;
+    if (count == 0) {
+        // Fixed amplitude is good enough for our purposes
+        return ORKSineWaveToneGeneratorAmplitudeDefault;
+    }
+    
+    NSUInteger upperIndex = 0;
+    while (upperIndex < count && _calibrationFrequencies[upperIndex].doubleValue < frequency) {
+        upperIndex++;
+    }
+    if (upperIndex == 0 || upperIndex == count) {
+        NSNumber *nearest = _calibrationFrequencies[upperIndex == 0 ? 0 : count - 1];
+        return MIN(MAX(_calibrationTable[nearest].doubleValue, 0), 1);
+    }
+    
+    NSNumber *lowerFrequency = _calibrationFrequencies[upperIndex - 1];
+    NSNumber *upperFrequency = _calibrationFrequencies[upperIndex];
+    double lowerLevel = 20 * log10(MAX(_calibrationTable[lowerFrequency].doubleValue, DBL_MIN));
+    double upperLevel = 20 * log10(MAX(_calibrationTable[upperFrequency].doubleValue, DBL_MIN));
+    double position = log(frequency / lowerFrequency.doubleValue) / log(upperFrequency.doubleValue / lowerFrequency.doubleValue);
+    double level = lowerLevel + position * (upperLevel - lowerLevel);
+    return MIN(MAX(pow(10, level / 20), 0), 1);
+}
 
-    [self play];
+- (void)prepareStimulus:(ORKAudioStimulusType)stimulusType atFrequencies:(NSArray<NSNumber *> *)frequencies {
+    if (stimulusType != ORKAudioStimulusTypeNarrowBandNoise) {
+        // Tone waveforms are cheap to build when played.
+        return;
+    }
+    
+    double sampleRate = _sampleRate;
+    uint32_t noiseSeed = _noiseSeed;
+    NSArray<NSNumber *> *frequenciesCopy = [frequencies copy];
+    dispatch_async(_calibrationQueue, ^{
+        for (NSNumber *frequency in frequenciesCopy) {
+            NSArray<NSNumber *> *key = @[@(sampleRate), frequency];
+            if (!_noiseGains[key]) {
+                _noiseGains[key] = @(ORKToneSynthesizerNarrowBandNoiseGain(sampleRate, frequency.doubleValue, noiseSeed));
+            }
+        }
+    });
+}
+
+- (double)noiseGainForFrequency:(double)frequency {
+    double sampleRate = _sampleRate;
+    uint32_t noiseSeed = _noiseSeed;
+    __block double gain = 0;
+    // Waits for any preparation in flight; frequencies that were never prepared are measured here.
+    dispatch_sync(_calibrationQueue, ^{
+        NSArray<NSNumber *> *key = @[@(sampleRate), @(frequency)];
+        NSNumber *cachedGain = _noiseGains[key];
+        if (!cachedGain) {
+            cachedGain = @(ORKToneSynthesizerNarrowBandNoiseGain(sampleRate, frequency, noiseSeed));
+            _noiseGains[key] = cachedGain;
+        }
+        gain = cachedGain.doubleValue;
+    });
+    return gain;
+}
+
+- (void)playSoundAtFrequency:(double)playFrequency {
+    double amplitude = [self amplitudeForFrequency:playFrequency];
+    [self playWithConfiguration:^(ORKToneSynthesizer *synthesizer) {
+        ORKToneSynthesizerSetAmplitude(synthesizer, amplitude);
+        ORKToneSynthesizerSetFrequency(synthesizer, playFrequency);
+        ORKToneSynthesizerStartFadeIn(synthesizer, 0.5);
+        _renderContext.playsStereo = true;
+        _waveformData = nil;
+    }];
 }
 
 - (void)playSoundAtFrequency:(double)playFrequency
                    onChannel:(ORKAudioChannel)playChannel
               fadeInDuration:(NSTimeInterval)duration {
-    _frequency = playFrequency;
-    _activeChannel = playChannel;
-    _fadeInFactor = 0;
-    _fadeInDuration = duration;
-    _playsStereo = NO;
+    [self playStimulus:ORKAudioStimulusTypePureTone
+           atFrequency:playFrequency
+             onChannel:playChannel
+        fadeInDuration:duration];
+}
 
-    [self play];
+- (void)playStimulus:(ORKAudioStimulusType)stimulusType
+         atFrequency:(double)playFrequency
+           onChannel:(ORKAudioChannel)playChannel
+      fadeInDuration:(NSTimeInterval)duration {
+    double sampleRate = _sampleRate;
+    uint32_t noiseSeed = _noiseSeed;
+    
+    // Precompute periodic waveforms up front, so rendering only loops over them.
+    NSMutableData *waveformData = nil;
+    if (stimulusType == ORKAudioStimulusTypePulsedTone) {
+        uint32_t length = ORKToneSynthesizerPulsedToneLength(sampleRate);
+        waveformData = [NSMutableData dataWithLength:length * sizeof(float)];
+        ORKToneSynthesizerFillPulsedTone(waveformData.mutableBytes, length, sampleRate, playFrequency);
+    } else if (stimulusType == ORKAudioStimulusTypeWarbleTone) {
+        uint32_t length = ORKToneSynthesizerWarbleToneLength(sampleRate);
+        waveformData = [NSMutableData dataWithLength:length * sizeof(float)];
+        ORKToneSynthesizerFillWarbleTone(waveformData.mutableBytes, length, sampleRate, playFrequency);
+    }
+    double noiseGain = 0;
+    if (stimulusType == ORKAudioStimulusTypeNarrowBandNoise) {
+        noiseGain = [self noiseGainForFrequency:playFrequency];
+    }
+    
+    double amplitude = [self amplitudeForFrequency:playFrequency];
+    [self playWithConfiguration:^(ORKToneSynthesizer *synthesizer) {
+        ORKToneSynthesizerSetAmplitude(synthesizer, amplitude);
+        switch (stimulusType) {
+            case ORKAudioStimulusTypePureTone:
+                ORKToneSynthesizerSetFrequency(synthesizer, playFrequency);
+                break;
+            case ORKAudioStimulusTypePulsedTone:
+            case ORKAudioStimulusTypeWarbleTone:
+                ORKToneSynthesizerSetWaveform(synthesizer, waveformData.bytes, (uint32_t)(waveformData.length / sizeof(float)));
+                break;
+            case ORKAudioStimulusTypeNarrowBandNoise:
+                ORKToneSynthesizerSetNarrowBandNoise(synthesizer, playFrequency, noiseSeed, noiseGain);
+                break;
+        }
+        ORKToneSynthesizerStartFadeIn(synthesizer, duration);
+        _renderContext.activeChannel = playChannel;
+        _renderContext.playsStereo = false;
+        _waveformData = waveformData;
+    }];
 }
 
-- (void)play {
+- (void)playWithConfiguration:(void (^)(ORKToneSynthesizer *synthesizer))configuration {
+    // The render callback reads the context without locking, so it is only modified while
+    // the output unit is stopped; AudioOutputUnitStop waits for any render in progress.
+    if (_toneUnit) {
+        AudioOutputUnitStop(_toneUnit);
+    }
+    configuration(&_renderContext.synthesizer);
+    
     if (!_toneUnit) {
         [self createToneUnit];
 
         // Stop changing parameters on the unit
         OSErr error = AudioUnitInitialize(_toneUnit);
         NSAssert1(error == noErr, @"Error initializing unit: %hd", error);
-
-        // Start playback
-        error = AudioOutputUnitStart(_toneUnit);
-        NSAssert1(error == noErr, @"Error starting unit: %hd", error);
     }
+
+    // Start playback
+    __unused OSErr error = AudioOutputUnitStart(_toneUnit);
+    NSAssert1(error == noErr, @"Error starting unit: %hd", error);
 }
 
 - (void)stop {
@@ -222,6 +339,41 @@ OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
                                              selector:@selector(handleInterruption:)
                                                  name:AVAudioSessionInterruptionNotification
                                                object:audioSession];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(handleAudioConfigurationChange:)
+                                                 name:AVAudioSessionRouteChangeNotification
+                                               object:audioSession];
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(handleAudioConfigurationChange:)
+                                                 name:AVAudioSessionMediaServicesWereResetNotification
+                                               object:nil];
+}
+
+- (void)handleAudioConfigurationChange:(NSNotification *)notification {
+    // Audio session notifications arrive on a secondary thread.
+    BOOL mediaServicesWereReset = [notification.name isEqualToString:AVAudioSessionMediaServicesWereResetNotification];
+    ORKWeakTypeOf(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        ORKStrongTypeOf(self) strongSelf = weakSelf;
+        [strongSelf updateSampleRateDiscardingToneUnit:mediaServicesWereReset];
+    });
+}
+
+- (void)updateSampleRateDiscardingToneUnit:(BOOL)discardToneUnit {
+    double sampleRate = [AVAudioSession sharedInstance].sampleRate;
+    BOOL sampleRateChanged = (sampleRate > 0 && sampleRate != _sampleRate);
+    if (!sampleRateChanged && !discardToneUnit) {
+        return;
+    }
+    
+    // The tone unit's stream format and the synthesizer are both tied to the old rate, so the
+    // current stimulus stops; the next one is rendered at the new rate.
+    [self stop];
+    if (sampleRateChanged) {
+        _sampleRate = sampleRate;
+        ORKToneSynthesizerInitialize(&_renderContext.synthesizer, _sampleRate, ORKSineWaveToneGeneratorAmplitudeDefault);
+        _waveformData = nil;
+    }
 }
 
 - (void)createToneUnit {
@@ -246,7 +398,7 @@ OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
     // Set our tone rendering function on the unit
     AURenderCallbackStruct input;
     input.inputProc = ORKAudioGeneratorRenderTone;
-    input.inputProcRefCon = (__bridge void *)(self);
+    input.inputProcRefCon = &_renderContext;
     error = AudioUnitSetProperty(_toneUnit,
                                kAudioUnitProperty_SetRenderCallback,
                                kAudioUnitScope_Input,
@@ -259,7 +411,7 @@ OSStatus ORKAudioGeneratorRenderTone(void *inRefCon,
     const int four_bytes_per_float = 4;
     const int eight_bits_per_byte = 8;
     AudioStreamBasicDescription streamFormat;
-    streamFormat.mSampleRate = ORKSineWaveToneGeneratorSampleRateDefault;
+    streamFormat.mSampleRate = _sampleRate;
     streamFormat.mFormatID = kAudioFormatLinearPCM;
     streamFormat.mFormatFlags = kAudioFormatFlagsNativeFloatPacked | kAudioFormatFlagIsNonInterleaved;
     streamFormat.mBytesPerPacket = four_bytes_per_float;
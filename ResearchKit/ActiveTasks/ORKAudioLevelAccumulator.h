@@ -0,0 +1,89 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `ORKAudioLevelAccumulator` gathers level statistics over 16-bit linear PCM samples in a
+ single streaming pass, in constant memory.
+
+ Samples of all channels are pooled, as the audio level check does not distinguish between
+ channels. The per-sample level used by `ORKAudioLevelNavigationRule` is read from a
+ precomputed table, so the pass performs no logarithm per sample and copies no data.
+ */
+typedef struct ORKAudioLevelAccumulator {
+    double levelSum;
+    uint64_t levelCount;
+    
+    double sumOfSquares;
+    uint64_t sampleCount;
+    int32_t peak;
+    
+    uint32_t windowLength;
+    uint32_t windowFill;
+    double windowSumOfSquares;
+    double minimumWindowSumOfSquares;
+    BOOL hasCompleteWindow;
+} ORKAudioLevelAccumulator;
+
+/**
+ Resets the accumulator. The noise floor is measured over 50 ms windows of the given format.
+ */
+ORK_EXTERN void ORKAudioLevelAccumulatorInitialize(ORKAudioLevelAccumulator *accumulator, double sampleRate, NSUInteger channelCount);
+
+/**
+ Adds interleaved 16-bit samples to the statistics.
+ */
+ORK_EXTERN void ORKAudioLevelAccumulatorAddSamples(ORKAudioLevelAccumulator *accumulator, const SInt16 *samples, size_t sampleCount);
+
+/**
+ Adds non-interleaved floating point samples, in the range -1 to 1, such as the buffers of an
+ audio engine tap. Samples are quantized to 16 bits, so the statistics match those of a 16-bit
+ decode of the same audio. Pass interleaved data as a single channel.
+ */
+ORK_EXTERN void ORKAudioLevelAccumulatorAddFloatSamples(ORKAudioLevelAccumulator *accumulator, const float *const *channelData, NSUInteger channelCount, size_t frameCount);
+
+/**
+ Returns the statistics gathered so far, keyed by the `ORKAudioRecorderLevel...Key` constants.
+ */
+ORK_EXTERN NSDictionary<NSString *, NSNumber *> *ORKAudioLevelAccumulatorStatistics(const ORKAudioLevelAccumulator *accumulator);
+
+/**
+ Decodes an audio file to 16-bit linear PCM and returns its level statistics, or `nil` if the
+ file cannot be read.
+ */
+ORK_EXTERN NSDictionary<NSString *, NSNumber *> *_Nullable ORKAudioLevelStatisticsForFileAtURL(NSURL *fileURL, double sampleRate, NSUInteger channelCount);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,208 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKAudioLevelAccumulator.h"
+#import "ORKAudioRecorder.h"
+#import "ORKHelpers.h"
+
+#import <AVFoundation/AVFoundation.h>
+
+
+static const double ORKAudioLevelMaxAmplitude = 32767.0;
+static const double ORKAudioLevelVolumeClamp = 60.0;
+static const double ORKAudioLevelNoiseFloorWindowDuration = 0.05;
+static const double ORKAudioLevelSilenceDecibels = -120.0;
+static const UInt16 ORKAudioLevelLinearPCMBitDepth = 16;
+
+// Normalized level of each possible 16-bit magnitude: 20 * log10(|x| / max) / 60, clamped
+// to [-1, ...) and offset by 1, so quiet samples map to 0 and full scale to 1.
+static float ORKAudioLevelTable[32769];
+
+static void ORKAudioLevelTableInitialize(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        ORKAudioLevelTable[0] = 0;
+        for (int magnitude = 1; magnitude <= 32768; magnitude++) {
+            double dB = 20 * log10(magnitude / ORKAudioLevelMaxAmplitude);
+            ORKAudioLevelTable[magnitude] = (float)(MAX(dB / ORKAudioLevelVolumeClamp, -1) + 1);
+        }
+    });
+}
+
+static double ORKAudioLevelDecibels(double amplitude) {
+    // Digital silence is reported as a finite level, so the statistics stay JSON serializable.
+    return (amplitude > 0) ? MAX(20 * log10(amplitude / ORKAudioLevelMaxAmplitude), ORKAudioLevelSilenceDecibels) : ORKAudioLevelSilenceDecibels;
+}
+
+void ORKAudioLevelAccumulatorInitialize(ORKAudioLevelAccumulator *accumulator, double sampleRate, NSUInteger channelCount) {
+    ORKAudioLevelTableInitialize();
+    memset(accumulator, 0, sizeof(ORKAudioLevelAccumulator));
+    accumulator->windowLength = (uint32_t)MAX(lround(sampleRate * ORKAudioLevelNoiseFloorWindowDuration) * (long)MAX(channelCount, 1), 1);
+    accumulator->minimumWindowSumOfSquares = INFINITY;
+}
+
+void ORKAudioLevelAccumulatorAddSamples(ORKAudioLevelAccumulator *accumulator, const SInt16 *samples, size_t sampleCount) {
+    const float *levelTable = ORKAudioLevelTable;
+    
+    while (sampleCount > 0) {
+        // Process up to the end of the current noise floor window, so the inner loop only
+        // accumulates and can be vectorized.
+        size_t count = MIN(sampleCount, (size_t)(accumulator->windowLength - accumulator->windowFill));
+        
+        float levelSum = 0;
+        uint32_t levelCount = 0;
+        double sumOfSquares = 0;
+        int32_t peak = accumulator->peak;
+        for (size_t i = 0; i < count; i++) {
+            int32_t value = samples[i];
+            int32_t magnitude = (value < 0) ? -value : value;
+            levelSum += levelTable[magnitude];
+            levelCount += (magnitude != 0);
+            sumOfSquares += (double)(value * value);
+            peak = (magnitude > peak) ? magnitude : peak;
+        }
+        
+        accumulator->levelSum += levelSum;
+        accumulator->levelCount += levelCount;
+        accumulator->sumOfSquares += sumOfSquares;
+        accumulator->sampleCount += count;
+        accumulator->peak = peak;
+        
+        accumulator->windowSumOfSquares += sumOfSquares;
+        accumulator->windowFill += count;
+        if (accumulator->windowFill == accumulator->windowLength) {
+            accumulator->minimumWindowSumOfSquares = MIN(accumulator->minimumWindowSumOfSquares, accumulator->windowSumOfSquares);
+            accumulator->hasCompleteWindow = YES;
+            accumulator->windowSumOfSquares = 0;
+            accumulator->windowFill = 0;
+        }
+        
+        samples += count;
+        sampleCount -= count;
+    }
+}
+
+void ORKAudioLevelAccumulatorAddFloatSamples(ORKAudioLevelAccumulator *accumulator, const float *const *channelData, NSUInteger channelCount, size_t frameCount) {
+    // Quantize through a small stack buffer, so the tap thread never allocates.
+    enum { ORKAudioLevelFloatChunkLength = 1024 };
+    SInt16 chunk[ORKAudioLevelFloatChunkLength];
+    size_t framesPerChunk = MAX(ORKAudioLevelFloatChunkLength / MAX(channelCount, 1), 1);
+    
+    for (size_t frame = 0; frame < frameCount; frame += framesPerChunk) {
+        size_t count = MIN(framesPerChunk, frameCount - frame);
+        size_t sampleCount = 0;
+        for (size_t i = 0; i < count; i++) {
+            for (NSUInteger channel = 0; channel < channelCount; channel++) {
+                float value = channelData[channel][frame + i];
+                value = MIN(MAX(value, -1.0f), 1.0f);
+                chunk[sampleCount++] = (SInt16)lrintf(value * (float)ORKAudioLevelMaxAmplitude);
+            }
+        }
+        ORKAudioLevelAccumulatorAddSamples(accumulator, chunk, sampleCount);
+    }
+}
+
+NSDictionary<NSString *, NSNumber *> *ORKAudioLevelAccumulatorStatistics(const ORKAudioLevelAccumulator *accumulator) {
+    double meanLevel = (accumulator->levelCount > 0) ? accumulator->levelSum / accumulator->levelCount : 0;
+    double rms = (accumulator->sampleCount > 0) ? sqrt(accumulator->sumOfSquares / accumulator->sampleCount) : 0;
+    
+    // Recordings shorter than one window use their overall level as the noise floor.
+    double noiseFloor = accumulator->hasCompleteWindow ? sqrt(accumulator->minimumWindowSumOfSquares / accumulator->windowLength) : rms;
+    
+    return @{ ORKAudioRecorderLevelMeanKey: @(meanLevel),
+              ORKAudioRecorderLevelRMSKey: @(ORKAudioLevelDecibels(rms)),
+              ORKAudioRecorderLevelPeakKey: @(ORKAudioLevelDecibels(accumulator->peak)),
+              ORKAudioRecorderLevelNoiseFloorKey: @(ORKAudioLevelDecibels(noiseFloor)),
+              ORKAudioRecorderLevelSampleCountKey: @(accumulator->sampleCount) };
+}
+
+NSDictionary<NSString *, NSNumber *> *ORKAudioLevelStatisticsForFileAtURL(NSURL *fileURL, double sampleRate, NSUInteger channelCount) {
+    AVURLAsset *urlAsset = [AVURLAsset URLAssetWithURL:fileURL options:nil];
+    if (urlAsset.tracks.count == 0) {
+        ORK_Log_Warning(@"No tracks found for urlAsset: %@", fileURL);
+        return nil;
+    }
+    
+    NSError *error = nil;
+    AVAssetReader *reader = [[AVAssetReader alloc] initWithAsset:urlAsset error:&error];
+    if (!reader) {
+        ORK_Log_Warning(@"Cannot read %@: %@", fileURL, error);
+        return nil;
+    }
+    AVAssetTrack *track = [urlAsset.tracks objectAtIndex:0];
+    NSDictionary *outputSettings = @{AVFormatIDKey: @(kAudioFormatLinearPCM),
+                                     AVLinearPCMBitDepthKey: @(ORKAudioLevelLinearPCMBitDepth),
+                                     AVLinearPCMIsBigEndianKey: @(NO),
+                                     AVLinearPCMIsFloatKey: @(NO),
+                                     AVLinearPCMIsNonInterleaved: @(NO)};
+    AVAssetReaderTrackOutput *trackOutput = [[AVAssetReaderTrackOutput alloc] initWithTrack:track outputSettings:outputSettings];
+    // The accumulator only reads the samples, so the reader can hand out its own buffers.
+    trackOutput.alwaysCopiesSampleData = NO;
+    [reader addOutput:trackOutput];
+    
+    ORKAudioLevelAccumulator accumulator;
+    ORKAudioLevelAccumulatorInitialize(&accumulator, sampleRate, channelCount);
+    
+    NSMutableData *scratch = nil;
+    [reader startReading];
+    while (reader.status == AVAssetReaderStatusReading) {
+        CMSampleBufferRef sampleBufferRef = [trackOutput copyNextSampleBuffer];
+        if (!sampleBufferRef) {
+            continue;
+        }
+        
+        CMBlockBufferRef blockBufferRef = CMSampleBufferGetDataBuffer(sampleBufferRef);
+        size_t lengthAtOffset = 0;
+        size_t totalLength = 0;
+        char *dataPointer = NULL;
+        if (blockBufferRef &&
+            CMBlockBufferGetDataPointer(blockBufferRef, 0, &lengthAtOffset, &totalLength, &dataPointer) == kCMBlockBufferNoErr) {
+            if (lengthAtOffset < totalLength) {
+                // Only non-contiguous buffers are copied, into a reused scratch buffer.
+                if (scratch.length < totalLength) {
+                    scratch = [NSMutableData dataWithLength:totalLength];
+                }
+                CMBlockBufferCopyDataBytes(blockBufferRef, 0, totalLength, scratch.mutableBytes);
+                dataPointer = scratch.mutableBytes;
+            }
+            ORKAudioLevelAccumulatorAddSamples(&accumulator, (const SInt16 *)dataPointer, totalLength / sizeof(SInt16));
+        }
+        
+        CMSampleBufferInvalidate(sampleBufferRef);
+        CFRelease(sampleBufferRef);
+    }
+    
+    if (reader.status == AVAssetReaderStatusFailed) {
+        ORK_Log_Warning(@"Error reading %@: %@", fileURL, reader.error);
+        return nil;
+    }
+    return ORKAudioLevelAccumulatorStatistics(&accumulator);
+}
@@ -36,15 +36,14 @@
 
 #import <AVFoundation/AVFoundation.h>
 
+#import "ORKAudioLevelAccumulator.h"
+#import "ORKAudioRecorder.h"
 #import "ORKHelpers.h"
 #import "ORKResult.h"
 #import "ORKResultPredicate.h"
 
 
 Float32 const VolumeThreshold = 0.45;
-UInt16  const LinearPCMBitDepth = 16;
-Float32 const MaxAmplitude = 32767.0;
-Float32 const VolumeClamp = 60.0;
 
 
 @interface ORKAudioLevelNavigationRule ()
@@ -126,7 +125,7 @@ Float32 const VolumeClamp = 60.0;
     ORKFileResult *audioLevelResult = (ORKFileResult *)[stepResult.results firstObject];
     
     // Check the volume
-    if ((audioLevelResult.fileURL != nil) && [self checkAudioLevelFromSoundFile:audioLevelResult.fileURL]) {
+    if ((audioLevelResult.fileURL != nil) && [self checkAudioLevelFromResult:audioLevelResult]) {
         // Returning nil will drop through to the next step (which should be the the step that has the instructions
         // for moving to a quieter room).
         return nil;
@@ -135,75 +134,17 @@ Float32 const VolumeClamp = 60.0;
     return self.destinationStepIdentifier;
 }
 
-- (BOOL)checkAudioLevelFromSoundFile:(NSURL *)fileURL
-{
-    // Setup reader
-    AVURLAsset *urlAsset = [AVURLAsset URLAssetWithURL:fileURL options:nil];
-    if (urlAsset.tracks.count == 0) {
-        NSLog(@"No tracks found for urlAsset: %@", fileURL);
-        return NO;
+- (BOOL)checkAudioLevelFromResult:(ORKFileResult *)fileResult {
+    // Use the statistics computed by the audio recorder when it stopped; only decode the
+    // file when the result does not carry them (for example, results from older archives).
+    NSNumber *meanLevel = fileResult.userInfo[ORKAudioRecorderLevelMeanKey];
+    if (![meanLevel isKindOfClass:[NSNumber class]]) {
+        // Assume 2 channels if not in recording settings
+        double sampleRate = [self.recordingSettings[AVSampleRateKey] doubleValue] ? : 44100.0;
+        NSUInteger channelCount = [self.recordingSettings[AVNumberOfChannelsKey] unsignedIntegerValue] ? : 2;
+        meanLevel = ORKAudioLevelStatisticsForFileAtURL(fileResult.fileURL, sampleRate, channelCount)[ORKAudioRecorderLevelMeanKey];
     }
-    
-    NSError *error = nil;
-    AVAssetReader *reader = [[AVAssetReader alloc] initWithAsset:urlAsset error:&error];
-    AVAssetTrack *track = [urlAsset.tracks objectAtIndex:0];
-    NSDictionary *outputSettings = @{AVFormatIDKey: @(kAudioFormatLinearPCM),
-                                     AVLinearPCMBitDepthKey: @(LinearPCMBitDepth),
-                                     AVLinearPCMIsBigEndianKey: @(NO),
-                                     AVLinearPCMIsFloatKey: @(NO),
-                                     AVLinearPCMIsNonInterleaved: @(NO)};
-    AVAssetReaderTrackOutput *output = [[AVAssetReaderTrackOutput alloc] initWithTrack:track outputSettings:outputSettings];
-    [reader addOutput:output];
-    
-    // Setup initial values - Assume 2 channels if not in recording settings
-    const UInt32 channelCount = (UInt32)[self.recordingSettings[AVNumberOfChannelsKey] unsignedIntegerValue] ? : 2;
-    const UInt32 bytesPerSample = 2 * channelCount;
-    
-    // setup criteria block - Use a high-pass filter and a rolling average of the amplitude
-    // normalized to be < 1
-    __block Float32 rollingAvg = 0;
-    __block UInt64 totalCount = 0;
-    void (^processVolume)(Float32) = ^(Float32 amplitude) {
-        if (amplitude != 0) {
-            Float32 dB = 20 * log10(ABS(amplitude) / MaxAmplitude);
-            float clampedValue = MAX(dB / VolumeClamp, -1) + 1;
-            totalCount++;
-            rollingAvg = (rollingAvg * (totalCount - 1) + clampedValue) / totalCount;
-        }
-    };
-    
-    // While there are samples to read and the number of samples above the decibel threshold
-    // is less than the total number of allowed samples over the limit, keep going
-    [reader startReading];
-    while (reader.status == AVAssetReaderStatusReading) {
-        
-        AVAssetReaderTrackOutput *trackOutput = (AVAssetReaderTrackOutput *)[reader.outputs objectAtIndex:0];
-        CMSampleBufferRef sampleBufferRef = [trackOutput copyNextSampleBuffer];
-        
-        if (sampleBufferRef) {
-            CMBlockBufferRef blockBufferRef = CMSampleBufferGetDataBuffer(sampleBufferRef);
-            size_t length = CMBlockBufferGetDataLength(blockBufferRef);
-            
-            NSMutableData *data = [NSMutableData dataWithLength:length];
-            CMBlockBufferCopyDataBytes(blockBufferRef, 0, length, data.mutableBytes);
-            
-            SInt16 *samples = (SInt16 *) data.mutableBytes;
-            UInt64 sampleCount = length / bytesPerSample;
-            for (UInt32 i = 0; i < sampleCount ; i++) {
-                Float32 left = (Float32) *samples++;
-                processVolume(left);
-                if (channelCount == 2) {
-                    Float32 right = (Float32) *samples++;
-                    processVolume(right);
-                }
-            }
-            
-            CMSampleBufferInvalidate(sampleBufferRef);
-            CFRelease(sampleBufferRef);
-        }
-    }
-    
-    return rollingAvg > VolumeThreshold;
+    return meanLevel.floatValue > VolumeThreshold;
 }
 
 
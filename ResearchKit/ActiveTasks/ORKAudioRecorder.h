@@ -35,6 +35,29 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ Keys of the level statistics that `ORKAudioRecorder` reports in the `userInfo` of its file result.
+ 
+ The statistics are metered from the microphone input while recording, quantized to 16 bits,
+ with all channels pooled. Levels are in decibels relative to full scale. When the input cannot
+ be metered, the statistics are not reported.
+ */
+
+/// The mean per-sample level, normalized over a 60 dB range so that 0 is -60 dBFS or lower and 1 is full scale.
+ORK_EXTERN NSString *const ORKAudioRecorderLevelMeanKey ORK_AVAILABLE_DECL;
+
+/// The RMS level of the recording, in dBFS.
+ORK_EXTERN NSString *const ORKAudioRecorderLevelRMSKey ORK_AVAILABLE_DECL;
+
+/// The peak sample level of the recording, in dBFS.
+ORK_EXTERN NSString *const ORKAudioRecorderLevelPeakKey ORK_AVAILABLE_DECL;
+
+/// The RMS level of the quietest 50 ms of the recording, in dBFS.
+ORK_EXTERN NSString *const ORKAudioRecorderLevelNoiseFloorKey ORK_AVAILABLE_DECL;
+
+/// The number of samples analyzed, across all channels.
+ORK_EXTERN NSString *const ORKAudioRecorderLevelSampleCountKey ORK_AVAILABLE_DECL;
+
 /**
  The ORKAudioRecorder class represents a recorder that uses the app's 
  `AVAudioSession` object to record audio.
@@ -84,6 +107,13 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, strong, readonly, nullable) AVAudioRecorder *audioRecorder;
 
+/**
+ A Boolean value indicating whether the recorder extracts voice features while it records.
+ 
+ See `extractsVoiceFeatures` on `ORKAudioRecorderConfiguration`.
+ */
+@property (nonatomic) BOOL extractsVoiceFeatures;
+
 @end
 
 NS_ASSUME_NONNULL_END
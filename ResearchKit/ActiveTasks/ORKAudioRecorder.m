@@ -30,11 +30,20 @@
 
 
 #import "ORKAudioRecorder.h"
+#import "ORKAudioLevelAccumulator.h"
+#import "ORKVoiceFeatureExtractor.h"
 #import "ORKHelpers.h"
 #import "ORKRecorder_Internal.h"
 #import "ORKRecorder_Private.h"
 
 
+NSString *const ORKAudioRecorderLevelMeanKey = @"levelMean";
+NSString *const ORKAudioRecorderLevelRMSKey = @"levelRMS";
+NSString *const ORKAudioRecorderLevelPeakKey = @"levelPeak";
+NSString *const ORKAudioRecorderLevelNoiseFloorKey = @"levelNoiseFloor";
+NSString *const ORKAudioRecorderLevelSampleCountKey = @"levelSampleCount";
+
+
 @interface ORKAudioRecorder ()
 
 @property (nonatomic, strong) AVAudioRecorder *audioRecorder;
@@ -43,6 +52,15 @@
 
 @property (nonatomic, copy) NSString *savedSessionCategory;
 
+@property (nonatomic, copy) NSDictionary *levelStatistics;
+
+@property (nonatomic, strong) AVAudioEngine *inputEngine;
+
+@property (nonatomic, strong) ORKVoiceFeatureExtractor *featureExtractor;
+
+// Holds an ORKAudioLevelAccumulator fed by the input tap; only read once the tap is removed.
+@property (nonatomic, strong) NSMutableData *levelAccumulatorData;
+
 @end
 
 
@@ -52,6 +70,7 @@
     ORK_Log_Debug(@"Remove audiorecorder %p", self);
     [_audioRecorder stop];
     _audioRecorder = nil;
+    [self stopInputAnalysis];
 }
 
 + (NSDictionary *)defaultRecorderSettings {
@@ -135,6 +154,7 @@
         [_audioRecorder record];
     }
 #endif
+    [self startInputAnalysis];
     [super start];
     
 }
@@ -152,11 +172,110 @@
         fileUrl = nil;
     }
     
+    // The level was metered while recording, so consumers of the result (such as the audio level
+    // navigation rule) do not need to decode the recording. Without input metering the statistics
+    // are left out, and the navigation rule decodes the file itself.
+    const ORKAudioLevelAccumulator *accumulator = _levelAccumulatorData.bytes;
+    if (fileUrl && accumulator && accumulator->sampleCount > 0) {
+        self.levelStatistics = ORKAudioLevelAccumulatorStatistics(accumulator);
+    }
+    
+    ORKFileResult *featuresResult = fileUrl ? [self finishFeatureExtraction] : nil;
+    
     [self reportFileResultWithFile:fileUrl error:nil];
     
+    if (featuresResult) {
+        id<ORKRecorderDelegate> localDelegate = self.delegate;
+        if ([localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+            [localDelegate recorder:self didCompleteWithResult:featuresResult];
+        }
+    }
+    
     [super stop];
 }
 
+#pragma mark Input analysis
+
+- (void)startInputAnalysis {
+    if (_inputEngine) {
+        return;
+    }
+    
+    // Analyze the input as it is captured with a tap, alongside the AVAudioRecorder
+    // that writes the audio file; only the level statistics and features are kept in memory.
+    AVAudioEngine *engine = [[AVAudioEngine alloc] init];
+    AVAudioInputNode *inputNode = engine.inputNode;
+    AVAudioFormat *format = [inputNode outputFormatForBus:0];
+    if (format.sampleRate <= 0 || format.channelCount == 0) {
+        ORK_Log_Warning(@"No audio input available for level metering");
+        return;
+    }
+    
+    if (!_levelAccumulatorData) {
+        _levelAccumulatorData = [NSMutableData dataWithLength:sizeof(ORKAudioLevelAccumulator)];
+        ORKAudioLevelAccumulatorInitialize(_levelAccumulatorData.mutableBytes, format.sampleRate, format.channelCount);
+    }
+    if (self.extractsVoiceFeatures && !_featureExtractor) {
+        _featureExtractor = [[ORKVoiceFeatureExtractor alloc] initWithSampleRate:format.sampleRate];
+    }
+    NSMutableData *levelAccumulatorData = _levelAccumulatorData;
+    ORKVoiceFeatureExtractor *extractor = _featureExtractor;
+    [inputNode installTapOnBus:0 bufferSize:4096 format:format block:^(AVAudioPCMBuffer *buffer, AVAudioTime *when) {
+        float *const *channelData = buffer.floatChannelData;
+        if (!channelData) {
+            return;
+        }
+        ORKAudioLevelAccumulator *accumulator = levelAccumulatorData.mutableBytes;
+        if (buffer.format.isInterleaved) {
+            ORKAudioLevelAccumulatorAddFloatSamples(accumulator, channelData, 1, buffer.frameLength * buffer.format.channelCount);
+        } else {
+            ORKAudioLevelAccumulatorAddFloatSamples(accumulator, channelData, buffer.format.channelCount, buffer.frameLength);
+        }
+        [extractor appendSamples:channelData[0] count:buffer.frameLength];
+    }];
+    
+    NSError *error = nil;
+    if (![engine startAndReturnError:&error]) {
+        ORK_Log_Warning(@"Failed to start audio input analysis: %@", error);
+        [inputNode removeTapOnBus:0];
+        return;
+    }
+    _inputEngine = engine;
+}
+
+- (void)stopInputAnalysis {
+    if (_inputEngine) {
+        [_inputEngine.inputNode removeTapOnBus:0];
+        [_inputEngine stop];
+        _inputEngine = nil;
+    }
+}
+
+- (ORKFileResult *)finishFeatureExtraction {
+    [self stopInputAnalysis];
+    
+    ORKVoiceFeatureExtractor *extractor = _featureExtractor;
+    _featureExtractor = nil;
+    if (!extractor) {
+        return nil;
+    }
+    
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:[extractor JSONObject] options:(NSJSONWritingOptions)0 error:&error];
+    NSURL *featuresURL = [[self recordingDirectoryURL] URLByAppendingPathComponent:[NSString stringWithFormat:@"%@_features.json", [self logName]]];
+    if (!data || ![data writeToURL:featuresURL options:NSDataWritingAtomic | NSDataWritingFileProtectionComplete error:&error]) {
+        ORK_Log_Error(@"Failed to write voice features: %@", error);
+        return nil;
+    }
+    
+    ORKFileResult *result = [[ORKFileResult alloc] initWithIdentifier:[self.identifier stringByAppendingString:@"_features"]];
+    result.contentType = @"application/json";
+    result.fileURL = featuresURL;
+    result.userInfo = [extractor summary];
+    result.startDate = self.startDate;
+    return result;
+}
+
 - (BOOL)isRecording {
     return _audioRecorder.recording;
 }
@@ -196,7 +315,12 @@
     return @"audio";
 }
 
+- (NSDictionary *)userInfo {
+    return self.levelStatistics;
+}
+
 - (void)doStopRecording {
+    [self stopInputAnalysis];
     if (self.isRecording) {
 #if !TARGET_IPHONE_SIMULATOR
         [_audioRecorder stop];
@@ -273,6 +397,10 @@
 - (void)reset {
     [_audioRecorder stop];
     _audioRecorder = nil;
+    _levelStatistics = nil;
+    [self stopInputAnalysis];
+    _featureExtractor = nil;
+    _levelAccumulatorData = nil;
     [super reset];
 }
 
@@ -302,16 +430,19 @@
 
 - (ORKRecorder *)recorderForStep:(ORKStep *)step
                  outputDirectory:(NSURL *)outputDirectory {
-    return [[ORKAudioRecorder alloc] initWithIdentifier:self.identifier
-                                       recorderSettings:self.recorderSettings
-                                                   step:step
-                                        outputDirectory:outputDirectory];
+    ORKAudioRecorder *recorder = [[ORKAudioRecorder alloc] initWithIdentifier:self.identifier
+                                                             recorderSettings:self.recorderSettings
+                                                                         step:step
+                                                              outputDirectory:outputDirectory];
+    recorder.extractsVoiceFeatures = self.extractsVoiceFeatures;
+    return recorder;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
     if (self) {
         ORK_DECODE_OBJ_CLASS(aDecoder, recorderSettings, NSDictionary);
+        ORK_DECODE_BOOL(aDecoder, extractsVoiceFeatures);
     }
     return self;
 }
@@ -319,6 +450,7 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_OBJ(aCoder, recorderSettings);
+    ORK_ENCODE_BOOL(aCoder, extractsVoiceFeatures);
 }
 
 + (BOOL)supportsSecureCoding {
@@ -330,7 +462,8 @@
     
     __typeof(self) castObject = object;
     return (isParentSame &&
-            ORKEqualObjects(self.recorderSettings, castObject.recorderSettings));
+            ORKEqualObjects(self.recorderSettings, castObject.recorderSettings) &&
+            (self.extractsVoiceFeatures == castObject.extractsVoiceFeatures));
 }
 
 - (ORKPermissionMask)requestedPermissionMask {
@@ -123,6 +123,14 @@ ORK_CLASS_AVAILABLE
 /// The log formatter being used.
 @property (strong, readonly) ORKLogFormatter *logFormatter;
 
+/**
+ The URL of the most recent log file finished by a rollover, or `nil` if no log has been finished.
+ 
+ After `finishCurrentLog` returns, this is the file the logger just completed, so callers that
+ write a single log need not enumerate the log directory to find it.
+ */
+@property (copy, readonly, nullable) NSURL *lastFinishedLogFileURL;
+
 /**
  The maximum current log file size.
  
@@ -152,6 +160,15 @@ ORK_CLASS_AVAILABLE
 /// Forces a roll-over now.
 - (void)finishCurrentLog;
 
+/**
+ Forces a roll-over now, reporting whether the current log could be moved into place.
+ 
+ @param error   On failure, the error that prevented the log from being finished.
+ 
+ @return `YES` if the log was finished or there was nothing to finish; otherwise, `NO`.
+ */
+- (BOOL)finishCurrentLogWithError:(NSError * _Nullable *)error;
+
 /// The current log file's location.
 - (NSURL *)currentLogFileURL;
 
@@ -352,14 +369,22 @@ ORK_CLASS_AVAILABLE
  The `ORKJSONLogFormatter` class represents a log formatter for producing JSON output.
  
  The JSON log formatter accepts `NSDictionary` objects for serialization.
- The JSON output is a dictionary that contains one key, `items`,
- which contains the array of logged items. The log itself does not contain
- any timestamp information, so the items should include such fields,
- if desired.
+ The JSON output is a dictionary that contains the key `items`,
+ which contains the array of logged items, and, if a header has been set,
+ the key `header`. The log itself does not contain any timestamp information,
+ so the items should include such fields, if desired.
  */
 ORK_CLASS_AVAILABLE
 @interface ORKJSONLogFormatter : ORKLogFormatter
 
+/**
+ A JSON serializable dictionary written at the start of each new log file, under the `header` key.
+ 
+ The header is written when a log file is begun, so set it before the first object is
+ appended. The default value is `nil`, in which case no header is written.
+ */
+@property (nonatomic, copy, nullable) NSDictionary *header;
+
 @end
 
 
@@ -53,6 +53,8 @@ static NSString *const ORKDataLoggerManagerConfigurationFilename = @".ORKDataLog
 
 @property (strong, setter=_setLogFormatter:) ORKLogFormatter *logFormatter;
 
+@property (copy, readwrite) NSURL *lastFinishedLogFileURL;
+
 - (void)fileSizeLimitsDidChange;
 
 - (instancetype)initWithDirectory:(NSURL *)url configuration:(NSDictionary *)configuration delegate:(id<ORKDataLoggerDelegate>)delegate;
@@ -301,23 +303,50 @@ static NSString *const kJSONLogEmptyLogString = @"{\"items\":[]}";
 static NSString *const kJSONLogFooterString = @"]}";  // The part of the log string that comes after the logged objects
 static NSString *const kJSONObjectSeparatorString = @",";
 
-static NSInteger _ORKJSON_emptyLogLength = 0;
 static NSInteger _ORKJSON_terminatorLength = 0;
 
-@implementation ORKJSONLogFormatter
+@implementation ORKJSONLogFormatter {
+    NSData *_emptyLogData;
+}
 
 - (instancetype)init {
     self = [super init];
     if (self) {
         static dispatch_once_t onceToken;
         dispatch_once(&onceToken, ^{
-            _ORKJSON_emptyLogLength = [kJSONLogEmptyLogString dataUsingEncoding:NSUTF8StringEncoding].length;
             _ORKJSON_terminatorLength = [kJSONLogFooterString dataUsingEncoding:NSUTF8StringEncoding].length;
         });
     }
     return self;
 }
 
+- (void)setHeader:(NSDictionary *)header {
+    if (header && ![NSJSONSerialization isValidJSONObject:header]) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"ORKJSONLogFormatter header must be JSON serializable" userInfo:nil];
+    }
+    _header = [header copy];
+    _emptyLogData = nil;
+}
+
+/*
+ * The empty log is the smallest valid log for this formatter: the header (if
+ * any) followed by an empty items array. Anything written past its length is
+ * a logged object, so appends after that point need a separator.
+ */
+- (NSData *)emptyLogData {
+    if (!_emptyLogData) {
+        if (_header) {
+            NSMutableData *data = [[@"{\"header\":" dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+            [data appendData:[NSJSONSerialization dataWithJSONObject:_header options:(NSJSONWritingOptions)0 error:nil]];
+            [data appendData:[@",\"items\":[]}" dataUsingEncoding:NSUTF8StringEncoding]];
+            _emptyLogData = data;
+        } else {
+            _emptyLogData = [kJSONLogEmptyLogString dataUsingEncoding:NSUTF8StringEncoding];
+        }
+    }
+    return _emptyLogData;
+}
+
 - (BOOL)canAcceptLogObjectOfClass:(Class)c {
     return [c isSubclassOfClass:[NSDictionary class]];
 }
@@ -328,8 +357,7 @@ static NSInteger _ORKJSON_terminatorLength = 0;
 
 - (BOOL)beginLogWithFileHandle:(NSFileHandle *)fileHandle error:(NSError **)error {
     // Write valid JSON containing no objects
-    NSData *data = [kJSONLogEmptyLogString dataUsingEncoding:NSUTF8StringEncoding];
-    return [self writeData:data fileHandle:fileHandle error:error];
+    return [self writeData:[self emptyLogData] fileHandle:fileHandle error:error];
 }
 
 - (unsigned long long)checkpointWithFileHandle:(NSFileHandle *)fileHandle {
@@ -386,7 +414,7 @@ static NSInteger _ORKJSON_terminatorLength = 0;
     
     NSMutableData *outputData = [NSMutableData data];
     NSData *separatorData = [kJSONObjectSeparatorString dataUsingEncoding:NSUTF8StringEncoding];
-    if (offset > _ORKJSON_emptyLogLength) {
+    if (offset > [self emptyLogData].length) {
         [outputData appendData:separatorData];
     }
     
@@ -558,6 +586,18 @@ static NSInteger _ORKJSON_terminatorLength = 0;
     });
 }
 
+- (BOOL)finishCurrentLogWithError:(NSError **)error {
+    __block BOOL success = NO;
+    __block NSError *localError = nil;
+    dispatch_sync(_queue, ^{
+        success = [self queue_closeAndRenameLogWithError:&localError];
+    });
+    if (!success && error) {
+        *error = localError;
+    }
+    return success;
+}
+
 - (NSURL *)currentLogFileURL {
     return [_url URLByAppendingPathComponent:_logName];
 }
@@ -848,6 +888,10 @@ static NSInteger _ORKJSON_terminatorLength = 0;
 }
 
 - (void)queue_closeAndRenameLog {
+    [self queue_closeAndRenameLogWithError:nil];
+}
+
+- (BOOL)queue_closeAndRenameLogWithError:(NSError **)error {
     NSFileManager *fileManager = [NSFileManager defaultManager];
     NSURL *url = [self currentLogFileURL];
     
@@ -865,16 +909,25 @@ static NSInteger _ORKJSON_terminatorLength = 0;
         if (((NSNumber *)parameters[NSURLFileSizeKey]).intValue > 0) {
             NSURL *destinationUrl = [ORKDataLogger nextUrlForDirectoryUrl:_url logName:_logName];
             ORK_Log_Debug(@"Rollover: %@ to %@", [url lastPathComponent], [destinationUrl lastPathComponent]);
-            [fileManager moveItemAtURL:url toURL:destinationUrl error:nil];
+            NSError *moveError = nil;
+            if (![fileManager moveItemAtURL:url toURL:destinationUrl error:&moveError]) {
+                ORK_Log_Error(@"Error finishing log %@: %@", url, moveError);
+                if (error) {
+                    *error = moveError;
+                }
+                return NO;
+            }
             if (self.fileProtectionMode == ORKFileProtectionCompleteUnlessOpen) {
                 // Upgrade to complete file protection after roll-over
-                NSError *error = nil;
+                NSError *protectionError = nil;
                 if (![fileManager setAttributes:@{NSFileProtectionKey: NSFileProtectionComplete}
-                                   ofItemAtPath:[destinationUrl path] error:&error]) {
-                    ORK_Log_Warning(@"Error setting NSFileProtectionComplete on %@: %@", destinationUrl, error);
+                                   ofItemAtPath:[destinationUrl path] error:&protectionError]) {
+                    ORK_Log_Warning(@"Error setting NSFileProtectionComplete on %@: %@", destinationUrl, protectionError);
                 }
             }
             
+            self.lastFinishedLogFileURL = destinationUrl;
+            
             dispatch_async(dispatch_get_main_queue(), ^{
                 id<ORKDataLoggerDelegate> delegate = self.delegate;
                 [delegate dataLogger:self finishedLogFile:destinationUrl];
@@ -884,6 +937,7 @@ static NSInteger _ORKJSON_terminatorLength = 0;
             [fileManager removeItemAtURL:url error:nil];
         }
     }
+    return YES;
 }
 
 - (void)queue_rolloverIfNeeded {
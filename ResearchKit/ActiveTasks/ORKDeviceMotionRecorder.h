@@ -71,6 +71,20 @@ ORK_CLASS_AVAILABLE
                               step:(nullable ORKStep *)step
                    outputDirectory:(nullable NSURL *)outputDirectory NS_DESIGNATED_INITIALIZER;
 
+/**
+ A Boolean value indicating whether the recorder extracts gait features while it records.
+ 
+ See `extractsGaitFeatures` on `ORKDeviceMotionRecorderConfiguration`.
+ */
+@property (nonatomic) BOOL extractsGaitFeatures;
+
+/**
+ A Boolean value indicating whether the recorder estimates the tremor spectrum while it records.
+ 
+ See `extractsTremorSpectrum` on `ORKDeviceMotionRecorderConfiguration`.
+ */
+@property (nonatomic) BOOL extractsTremorSpectrum;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -34,17 +34,29 @@
 #import "ORKRecorder_Internal.h"
 #import "ORKRecorder_Private.h"
 #import "ORKDataLogger.h"
+#import "ORKMotionHub.h"
+#import "ORKGaitAnalyzer.h"
+#import "ORKTremorSpectrum.h"
+#import "ORKResult.h"
 #import <CoreMotion/CoreMotion.h>
 #import "CMDeviceMotion+ORKJSONDictionary.h"
 
 
+static const double ORKTremorSpectrumLowerBandFrequency = 3.0;
+static const double ORKTremorSpectrumUpperBandFrequency = 12.0;
+
+
 @interface ORKDeviceMotionRecorder () {
     ORKDataLogger *_logger;
+    ORKGaitAnalyzer _gaitAnalyzer;
+    BOOL _analyzingGait;
+    ORKTremorSpectrum _tremorSpectrum;
+    BOOL _analyzingTremor;
 }
 
-@property (nonatomic, strong) CMMotionManager *motionManager;
+@property (nonatomic, strong) ORKMotionHub *motionHub;
 
-@property (nonatomic) NSTimeInterval uptime;
+@property (nonatomic, strong) id<NSObject> motionSubscription;
 
 @end
 
@@ -67,6 +79,9 @@
 
 - (void)dealloc {
     [_logger finishCurrentLog];
+    if (_analyzingTremor) {
+        ORKTremorSpectrumDestroy(&_tremorSpectrum);
+    }
 }
 
 - (void)setFrequency:(double)frequency {
@@ -77,8 +92,8 @@
     }
 }
 
-- (CMMotionManager *)createMotionManager {
-    return [[CMMotionManager alloc] init];
+- (ORKMotionHub *)sharedMotionHub {
+    return [ORKMotionHub sharedHub];
 }
 
 - (void)start {
@@ -93,17 +108,24 @@
         }
     }
     
-    self.motionManager = [self createMotionManager];
-    self.motionManager.deviceMotionUpdateInterval = 1.0 / _frequency;
-    
-    self.uptime = [NSProcessInfo processInfo].systemUptime;
+    [self doStopRecording];
+    self.motionHub = [self sharedMotionHub];
     
-    [self.motionManager stopDeviceMotionUpdates];
+    if (_extractsGaitFeatures && !_analyzingGait) {
+        ORKGaitAnalyzerInitialize(&_gaitAnalyzer, _frequency);
+        _analyzingGait = YES;
+    }
+    if (_extractsTremorSpectrum && !_analyzingTremor) {
+        ORKTremorSpectrumInitialize(&_tremorSpectrum, _frequency);
+        _analyzingTremor = YES;
+    }
     
-    [self.motionManager startDeviceMotionUpdatesToQueue:[NSOperationQueue mainQueue] withHandler:^(CMDeviceMotion *data, NSError *error) {
+    // The hub runs the sensor at the highest rate any recorder needs, and decimates to ours.
+    self.motionSubscription = [self.motionHub addDeviceMotionSubscriberWithFrequency:_frequency queue:[NSOperationQueue mainQueue] handler:^(CMDeviceMotion *data, NSError *error) {
          BOOL success = NO;
          if (data) {
              success = [_logger append:[data ork_JSONDictionary] error:&error];
+             [self analyzeMotion:data];
              id delegate = self.delegate;
              if ([delegate respondsToSelector:@selector(deviceMotionRecorderDidUpdateWithMotion:)]) {
                  [delegate deviceMotionRecorderDidUpdateWithMotion:data];
@@ -123,23 +145,107 @@
 
 - (void)stop {
     [self doStopRecording];
-    [_logger finishCurrentLog];
+    [self finishCurrentLogOfLogger:_logger];
     
-    NSError *error = nil;
-    __block NSURL *fileUrl = nil;
-    [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
-        fileUrl = logFileUrl;
-    } error:&error];
+    NSURL *fileUrl = _logger.lastFinishedLogFileURL;
     
-    [self reportFileResultWithFile:fileUrl error:error];
+    NSMutableArray<ORKResult *> *featureResults = [NSMutableArray array];
+    if (fileUrl) {
+        ORKResult *gaitResult = [self finishGaitAnalysis];
+        if (gaitResult) {
+            [featureResults addObject:gaitResult];
+        }
+        ORKResult *tremorResult = [self finishTremorAnalysis];
+        if (tremorResult) {
+            [featureResults addObject:tremorResult];
+        }
+    }
+    _analyzingGait = NO;
+    if (_analyzingTremor) {
+        ORKTremorSpectrumDestroy(&_tremorSpectrum);
+        _analyzingTremor = NO;
+    }
+    
+    [self reportFileResultWithFile:fileUrl error:nil];
+    
+    id<ORKRecorderDelegate> localDelegate = self.delegate;
+    if ([localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+        for (ORKResult *result in featureResults) {
+            [localDelegate recorder:self didCompleteWithResult:result];
+        }
+    }
     
     [super stop];
 }
 
+#pragma mark Gait features
+
+- (void)analyzeMotion:(CMDeviceMotion *)motion {
+    if (!_analyzingGait && !_analyzingTremor) {
+        return;
+    }
+    CMAcceleration userAcceleration = motion.userAcceleration;
+    CMAcceleration gravity = motion.gravity;
+    CMRotationRate rotationRate = motion.rotationRate;
+    const double userAccelerationVector[3] = { userAcceleration.x, userAcceleration.y, userAcceleration.z };
+    const double gravityVector[3] = { gravity.x, gravity.y, gravity.z };
+    const double rotationRateVector[3] = { rotationRate.x, rotationRate.y, rotationRate.z };
+    if (_analyzingGait) {
+        ORKGaitAnalyzerAddSample(&_gaitAnalyzer, motion.timestamp, userAccelerationVector, gravityVector, rotationRateVector);
+    }
+    if (_analyzingTremor) {
+        ORKTremorSpectrumAddSample(&_tremorSpectrum, userAccelerationVector, rotationRateVector);
+    }
+}
+
+- (ORKGaitResult *)finishGaitAnalysis {
+    if (!_analyzingGait) {
+        return nil;
+    }
+    ORKGaitSummary summary = ORKGaitAnalyzerSummary(&_gaitAnalyzer);
+    
+    ORKGaitResult *result = [[ORKGaitResult alloc] initWithIdentifier:[self.identifier stringByAppendingString:@"_gait"]];
+    result.startDate = self.startDate;
+    result.duration = summary.duration;
+    result.numberOfSteps = summary.numberOfSteps;
+    result.cadence = summary.cadence;
+    result.meanStepDuration = summary.meanStepDuration;
+    result.stepDurationVariability = summary.stepDurationVariability;
+    result.meanStrideDuration = summary.meanStrideDuration;
+    result.strideDurationVariability = summary.strideDurationVariability;
+    result.stepSymmetry = summary.stepSymmetry;
+    result.numberOfTurns = summary.numberOfTurns;
+    result.meanTurnDuration = summary.meanTurnDuration;
+    result.meanTurnAngle = summary.meanTurnAngle;
+    return result;
+}
+
+#pragma mark Tremor spectrum
+
+- (ORKTremorSpectrumResult *)finishTremorAnalysis {
+    if (!_analyzingTremor) {
+        return nil;
+    }
+    const ORKTremorSpectrum *spectrum = &_tremorSpectrum;
+    
+    ORKTremorSpectrumResult *result = [[ORKTremorSpectrumResult alloc] initWithIdentifier:[self.identifier stringByAppendingString:@"_tremor"]];
+    result.startDate = self.startDate;
+    result.lowerBandFrequency = ORKTremorSpectrumLowerBandFrequency;
+    result.upperBandFrequency = ORKTremorSpectrumUpperBandFrequency;
+    result.numberOfSegments = (NSInteger)spectrum->segmentCount;
+    result.userAccelerationBandPower = ORKTremorSpectrumBandPower(spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTremorSpectrumLowerBandFrequency, ORKTremorSpectrumUpperBandFrequency);
+    result.userAccelerationTotalPower = ORKTremorSpectrumTotalPower(spectrum, ORKTremorSpectrumSignalUserAcceleration);
+    result.userAccelerationDominantFrequency = ORKTremorSpectrumDominantFrequency(spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTremorSpectrumLowerBandFrequency, ORKTremorSpectrumUpperBandFrequency);
+    result.rotationRateBandPower = ORKTremorSpectrumBandPower(spectrum, ORKTremorSpectrumSignalRotationRate, ORKTremorSpectrumLowerBandFrequency, ORKTremorSpectrumUpperBandFrequency);
+    result.rotationRateTotalPower = ORKTremorSpectrumTotalPower(spectrum, ORKTremorSpectrumSignalRotationRate);
+    result.rotationRateDominantFrequency = ORKTremorSpectrumDominantFrequency(spectrum, ORKTremorSpectrumSignalRotationRate, ORKTremorSpectrumLowerBandFrequency, ORKTremorSpectrumUpperBandFrequency);
+    return result;
+}
+
 - (void)doStopRecording {
     if (self.isRecording) {
-        [self.motionManager stopDeviceMotionUpdates];
-        self.motionManager = nil;
+        [self.motionHub removeSubscriber:self.motionSubscription];
+        self.motionSubscription = nil;
     }
 }
 
@@ -149,7 +255,7 @@
 }
 
 - (BOOL)isRecording {
-    return self.motionManager.deviceMotionActive;
+    return (self.motionSubscription != nil);
 }
 
 - (NSString *)mimeType {
@@ -183,16 +289,21 @@
 #pragma clang diagnostic pop
 
 - (ORKRecorder *)recorderForStep:(ORKStep *)step outputDirectory:(NSURL *)outputDirectory {
-    return [[ORKDeviceMotionRecorder alloc] initWithIdentifier:self.identifier
-                                                     frequency:self.frequency
-                                                          step:step
-                                               outputDirectory:outputDirectory];
+    ORKDeviceMotionRecorder *recorder = [[ORKDeviceMotionRecorder alloc] initWithIdentifier:self.identifier
+                                                                                   frequency:self.frequency
+                                                                                        step:step
+                                                                             outputDirectory:outputDirectory];
+    recorder.extractsGaitFeatures = self.extractsGaitFeatures;
+    recorder.extractsTremorSpectrum = self.extractsTremorSpectrum;
+    return recorder;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
     if (self) {
         ORK_DECODE_DOUBLE(aDecoder, frequency);
+        ORK_DECODE_BOOL(aDecoder, extractsGaitFeatures);
+        ORK_DECODE_BOOL(aDecoder, extractsTremorSpectrum);
     }
     return self;
 }
@@ -200,6 +311,8 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_DOUBLE(aCoder, frequency);
+    ORK_ENCODE_BOOL(aCoder, extractsGaitFeatures);
+    ORK_ENCODE_BOOL(aCoder, extractsTremorSpectrum);
 }
 
 + (BOOL)supportsSecureCoding {
@@ -211,7 +324,9 @@
     
     __typeof(self) castObject = object;
     return (isParentSame &&
-            (self.frequency == castObject.frequency));
+            (self.frequency == castObject.frequency) &&
+            (self.extractsGaitFeatures == castObject.extractsGaitFeatures) &&
+            (self.extractsTremorSpectrum == castObject.extractsTremorSpectrum));
 }
 
 - (ORKPermissionMask)requestedPermissionMask {
@@ -0,0 +1,131 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+#import <ResearchKit/ORKDefines.h>
+#import "ORKRunningStatistics.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A second-order IIR section, in transposed direct form II.
+ */
+typedef struct ORKGaitBiquad {
+    double b0, b1, b2, a1, a2;
+    double z1, z2;
+} ORKGaitBiquad;
+
+/**
+ `ORKGaitAnalyzer` extracts gait features from a stream of device motion samples, one sample
+ at a time, in constant memory.
+ 
+ Steps are detected as peaks of the vertical (gravity aligned) user acceleration, band-limited
+ to 0.5-3 Hz, above an adaptive threshold. Intervals between consecutive steps feed running
+ step and stride (two step) time statistics; intervals longer than 2 seconds start a new
+ walking bout. Turns are detected from the rotation rate about the gravity axis: a turn is a
+ period of sustained rotation that covers at least 45 degrees.
+ */
+typedef struct ORKGaitAnalyzer {
+    ORKGaitBiquad verticalLowPass;
+    ORKGaitBiquad verticalHighPass;
+    ORKGaitBiquad yawLowPass;
+    
+    uint64_t sampleCount;
+    double firstTimestamp;
+    double previousTimestamp;
+    
+    // Step detection, on the two previous filtered samples
+    double vertical1;
+    double vertical2;
+    double peakAmplitude;
+    BOOL armed;
+    BOOL hasStep;
+    double lastStepTimestamp;
+    uint64_t stepCount;
+    
+    // Step timing, per walking bout
+    uint64_t boutStepCount;
+    double previousStepDuration;
+    ORKRunningStatistics stepDurations;
+    ORKRunningStatistics strideDurations;
+    ORKRunningStatistics evenStepDurations;
+    ORKRunningStatistics oddStepDurations;
+    
+    // Turn detection
+    BOOL turning;
+    double turnStartTimestamp;
+    double turnAngle;
+    uint64_t turnCount;
+    double totalTurnDuration;
+    double totalTurnAngle;
+} ORKGaitAnalyzer;
+
+/**
+ The gait features computed so far. Durations are in seconds, cadence in steps per minute,
+ variabilities are coefficients of variation, and angles are in degrees.
+ */
+typedef struct ORKGaitSummary {
+    NSTimeInterval duration;
+    NSInteger numberOfSteps;
+    double cadence;
+    NSTimeInterval meanStepDuration;
+    double stepDurationVariability;
+    NSTimeInterval meanStrideDuration;
+    double strideDurationVariability;
+    double stepSymmetry;
+    NSInteger numberOfTurns;
+    NSTimeInterval meanTurnDuration;
+    double meanTurnAngle;
+} ORKGaitSummary;
+
+/**
+ Resets the analyzer. The filters are designed for the nominal sample rate of the stream;
+ sample timestamps are used for all timing.
+ */
+ORK_EXTERN void ORKGaitAnalyzerInitialize(ORKGaitAnalyzer *analyzer, double sampleRate);
+
+/**
+ Adds one device motion sample. Accelerations are in g, rotation rate in radians per second,
+ and the timestamp in seconds.
+ */
+ORK_EXTERN void ORKGaitAnalyzerAddSample(ORKGaitAnalyzer *analyzer,
+                                         double timestamp,
+                                         const double userAcceleration[_Nonnull 3],
+                                         const double gravity[_Nonnull 3],
+                                         const double rotationRate[_Nonnull 3]);
+
+/**
+ Returns the gait features for the samples added so far.
+ */
+ORK_EXTERN ORKGaitSummary ORKGaitAnalyzerSummary(const ORKGaitAnalyzer *analyzer);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,214 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKGaitAnalyzer.h"
+
+
+static const double ORKGaitVerticalLowPassFrequency = 3.0;
+static const double ORKGaitVerticalHighPassFrequency = 0.5;
+static const double ORKGaitYawLowPassFrequency = 1.5;
+
+static const double ORKGaitMinimumPeakAcceleration = 0.05;    // g
+static const double ORKGaitAdaptiveThresholdRatio = 0.4;      // of the running peak amplitude
+static const double ORKGaitPeakAmplitudeSmoothing = 0.2;
+static const double ORKGaitMinimumStepDuration = 0.25;        // s, i.e. at most 240 steps per minute
+static const double ORKGaitMaximumStepDuration = 2.0;         // s, longer pauses start a new bout
+
+static const double ORKGaitTurnRateThreshold = 0.5;           // rad/s
+static const double ORKGaitMinimumTurnAngle = M_PI_4;         // rad
+static const double ORKGaitMaximumSampleInterval = 0.1;       // s, gaps are not integrated
+
+typedef NS_ENUM(NSInteger, ORKGaitBiquadType) {
+    ORKGaitBiquadTypeLowPass,
+    ORKGaitBiquadTypeHighPass
+};
+
+// Butterworth (Q = 1/sqrt(2)) section, from the RBJ audio EQ cookbook.
+static void ORKGaitBiquadInitialize(ORKGaitBiquad *biquad, ORKGaitBiquadType type, double cutoff, double sampleRate) {
+    double omega = 2 * M_PI * MIN(cutoff, 0.45 * sampleRate) / sampleRate;
+    double alpha = sin(omega) / (2 * M_SQRT1_2);
+    double cosine = cos(omega);
+    double a0 = 1 + alpha;
+    
+    double b1 = (type == ORKGaitBiquadTypeLowPass) ? (1 - cosine) : -(1 + cosine);
+    biquad->b0 = fabs(b1) / 2 / a0;
+    biquad->b1 = b1 / a0;
+    biquad->b2 = biquad->b0;
+    biquad->a1 = -2 * cosine / a0;
+    biquad->a2 = (1 - alpha) / a0;
+    biquad->z1 = 0;
+    biquad->z2 = 0;
+}
+
+static inline double ORKGaitBiquadProcess(ORKGaitBiquad *biquad, double x) {
+    double y = biquad->b0 * x + biquad->z1;
+    biquad->z1 = biquad->b1 * x - biquad->a1 * y + biquad->z2;
+    biquad->z2 = biquad->b2 * x - biquad->a2 * y;
+    return y;
+}
+
+void ORKGaitAnalyzerInitialize(ORKGaitAnalyzer *analyzer, double sampleRate) {
+    memset(analyzer, 0, sizeof(ORKGaitAnalyzer));
+    sampleRate = (sampleRate > 0) ? sampleRate : 100;
+    ORKGaitBiquadInitialize(&analyzer->verticalLowPass, ORKGaitBiquadTypeLowPass, ORKGaitVerticalLowPassFrequency, sampleRate);
+    ORKGaitBiquadInitialize(&analyzer->verticalHighPass, ORKGaitBiquadTypeHighPass, ORKGaitVerticalHighPassFrequency, sampleRate);
+    ORKGaitBiquadInitialize(&analyzer->yawLowPass, ORKGaitBiquadTypeLowPass, ORKGaitYawLowPassFrequency, sampleRate);
+}
+
+static void ORKGaitAnalyzerAddStep(ORKGaitAnalyzer *analyzer, double timestamp, double amplitude) {
+    if (analyzer->hasStep) {
+        double duration = timestamp - analyzer->lastStepTimestamp;
+        if (duration <= ORKGaitMaximumStepDuration) {
+            ORKRunningStatisticsAdd(&analyzer->stepDurations, duration);
+            // Alternate steps are (usually) taken by alternate feet
+            ORKRunningStatisticsAdd((analyzer->boutStepCount % 2) ? &analyzer->oddStepDurations : &analyzer->evenStepDurations, duration);
+            if (analyzer->boutStepCount > 0) {
+                ORKRunningStatisticsAdd(&analyzer->strideDurations, analyzer->previousStepDuration + duration);
+            }
+            analyzer->previousStepDuration = duration;
+            analyzer->boutStepCount++;
+        } else {
+            analyzer->boutStepCount = 0;
+        }
+    }
+    analyzer->hasStep = YES;
+    analyzer->lastStepTimestamp = timestamp;
+    analyzer->stepCount++;
+    analyzer->peakAmplitude = (analyzer->stepCount == 1) ? amplitude : analyzer->peakAmplitude + ORKGaitPeakAmplitudeSmoothing * (amplitude - analyzer->peakAmplitude);
+}
+
+static void ORKGaitAnalyzerEndTurn(ORKGaitAnalyzer *analyzer, double timestamp) {
+    if (fabs(analyzer->turnAngle) >= ORKGaitMinimumTurnAngle) {
+        analyzer->turnCount++;
+        analyzer->totalTurnDuration += timestamp - analyzer->turnStartTimestamp;
+        analyzer->totalTurnAngle += fabs(analyzer->turnAngle);
+    }
+    analyzer->turning = NO;
+    analyzer->turnAngle = 0;
+}
+
+void ORKGaitAnalyzerAddSample(ORKGaitAnalyzer *analyzer,
+                              double timestamp,
+                              const double userAcceleration[3],
+                              const double gravity[3],
+                              const double rotationRate[3]) {
+    double gravityMagnitude = sqrt(gravity[0] * gravity[0] + gravity[1] * gravity[1] + gravity[2] * gravity[2]);
+    if (gravityMagnitude <= 0) {
+        return;
+    }
+    
+    // Project onto the gravity axis, so the features do not depend on how the device is held.
+    // Gravity points down, so flip the sign to get upward acceleration and counterclockwise yaw.
+    double vertical = -(userAcceleration[0] * gravity[0] + userAcceleration[1] * gravity[1] + userAcceleration[2] * gravity[2]) / gravityMagnitude;
+    double yawRate = -(rotationRate[0] * gravity[0] + rotationRate[1] * gravity[1] + rotationRate[2] * gravity[2]) / gravityMagnitude;
+    
+    vertical = ORKGaitBiquadProcess(&analyzer->verticalHighPass, ORKGaitBiquadProcess(&analyzer->verticalLowPass, vertical));
+    yawRate = ORKGaitBiquadProcess(&analyzer->yawLowPass, yawRate);
+    
+    double interval = 0;
+    if (analyzer->sampleCount == 0) {
+        analyzer->firstTimestamp = timestamp;
+    } else {
+        interval = timestamp - analyzer->previousTimestamp;
+    }
+    
+    // A step is a local maximum above the adaptive threshold, at least a minimum step
+    // duration after the previous one. The detector re-arms when the signal goes negative.
+    if (analyzer->sampleCount >= 2 && analyzer->armed) {
+        double threshold = MAX(ORKGaitMinimumPeakAcceleration, ORKGaitAdaptiveThresholdRatio * analyzer->peakAmplitude);
+        double peak = analyzer->vertical1;
+        if (peak > threshold && peak > analyzer->vertical2 && peak >= vertical &&
+            (!analyzer->hasStep || (analyzer->previousTimestamp - analyzer->lastStepTimestamp) >= ORKGaitMinimumStepDuration)) {
+            ORKGaitAnalyzerAddStep(analyzer, analyzer->previousTimestamp, peak);
+            analyzer->armed = NO;
+        }
+    }
+    if (vertical < 0) {
+        analyzer->armed = YES;
+    }
+    analyzer->vertical2 = analyzer->vertical1;
+    analyzer->vertical1 = vertical;
+    
+    // Integrate the yaw rate while it stays above the turn threshold
+    if (fabs(yawRate) >= ORKGaitTurnRateThreshold) {
+        if (!analyzer->turning) {
+            analyzer->turning = YES;
+            analyzer->turnStartTimestamp = timestamp;
+            analyzer->turnAngle = 0;
+        } else if (interval > 0 && interval <= ORKGaitMaximumSampleInterval) {
+            analyzer->turnAngle += yawRate * interval;
+        }
+    } else if (analyzer->turning) {
+        ORKGaitAnalyzerEndTurn(analyzer, timestamp);
+    }
+    
+    analyzer->previousTimestamp = timestamp;
+    analyzer->sampleCount++;
+}
+
+ORKGaitSummary ORKGaitAnalyzerSummary(const ORKGaitAnalyzer *analyzer) {
+    ORKGaitSummary summary = {0};
+    if (analyzer->sampleCount == 0) {
+        return summary;
+    }
+    
+    // Count a turn still in progress at the end of the recording
+    ORKGaitAnalyzer turnState = *analyzer;
+    if (turnState.turning) {
+        ORKGaitAnalyzerEndTurn(&turnState, turnState.previousTimestamp);
+    }
+    
+    summary.duration = analyzer->previousTimestamp - analyzer->firstTimestamp;
+    summary.numberOfSteps = (NSInteger)analyzer->stepCount;
+    
+    const ORKRunningStatistics *steps = &analyzer->stepDurations;
+    if (steps->count > 0 && steps->mean > 0) {
+        summary.meanStepDuration = steps->mean;
+        summary.cadence = 60.0 / steps->mean;
+        summary.stepDurationVariability = ORKRunningStatisticsCoefficientOfVariation(steps);
+    }
+    summary.meanStrideDuration = analyzer->strideDurations.mean;
+    summary.strideDurationVariability = ORKRunningStatisticsCoefficientOfVariation(&analyzer->strideDurations);
+    
+    // Ratio of the shorter to the longer mean alternate step duration; 1 is perfectly symmetric.
+    double even = analyzer->evenStepDurations.mean;
+    double odd = analyzer->oddStepDurations.mean;
+    if (analyzer->evenStepDurations.count > 0 && analyzer->oddStepDurations.count > 0 && MAX(even, odd) > 0) {
+        summary.stepSymmetry = MIN(even, odd) / MAX(even, odd);
+    }
+    
+    summary.numberOfTurns = (NSInteger)turnState.turnCount;
+    if (turnState.turnCount > 0) {
+        summary.meanTurnDuration = turnState.totalTurnDuration / turnState.turnCount;
+        summary.meanTurnAngle = turnState.totalTurnAngle / turnState.turnCount * 180.0 / M_PI;
+    }
+    return summary;
+}
@@ -34,6 +34,39 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ Keys of the sample summary that `ORKHealthQuantityTypeRecorder` reports in the `userInfo` of its
+ file result. Values are in the recorder's `unit`. When no samples were recorded, the summary is
+ not reported.
+ */
+
+/// The unit the summary values are expressed in, as an `HKUnit` unit string.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryUnitKey ORK_AVAILABLE_DECL;
+
+/// The number of samples summarized.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryCountKey ORK_AVAILABLE_DECL;
+
+/// The sum of the sample values.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummarySumKey ORK_AVAILABLE_DECL;
+
+/// The smallest sample value.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryMinimumKey ORK_AVAILABLE_DECL;
+
+/// The largest sample value.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryMaximumKey ORK_AVAILABLE_DECL;
+
+/// The mean of the sample values.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryMeanKey ORK_AVAILABLE_DECL;
+
+/// The standard deviation of the sample values.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryStandardDeviationKey ORK_AVAILABLE_DECL;
+
+/// The duration, in seconds, of the window used for `ORKHealthQuantityTypeRecorderSummaryMaximumWindowSumKey`.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryWindowDurationKey ORK_AVAILABLE_DECL;
+
+/// The largest sum of sample values over any window of `ORKHealthQuantityTypeRecorderSummaryWindowDurationKey` seconds.
+ORK_EXTERN NSString *const ORKHealthQuantityTypeRecorderSummaryMaximumWindowSumKey ORK_AVAILABLE_DECL;
+
 @class ORKHealthQuantityTypeRecorder;
 
 @protocol ORKHealthQuantityTypeRecorderDelegate <ORKRecorderDelegate>
@@ -47,6 +80,9 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  The `ORKHealthQuantityTypeRecorder` class represents a recorder for collecting real time sample data from HealthKit, such as heart rate, during
  an active task.
+ 
+ Samples are written from a background queue. The `userInfo` of the file result summarizes the
+ sample values, keyed by the `ORKHealthQuantityTypeRecorderSummary...Key` constants.
  */
 ORK_CLASS_AVAILABLE
 @interface ORKHealthQuantityTypeRecorder : ORKRecorder
@@ -57,6 +93,26 @@ ORK_CLASS_AVAILABLE
 
 @property (nonatomic, copy, readonly, nullable) HKQuantitySample *lastSample;
 
+/**
+ The maximum number of samples requested by the next anchored query.
+ 
+ The limit adapts to the sample rate observed in the previous batch, and grows while batches come
+ back full.
+ */
+@property (readonly) NSUInteger queryLimit;
+
+/// The number of anchored queries issued since recording started.
+@property (readonly) NSUInteger numberOfQueries;
+
+/// The number of samples fetched since recording started.
+@property (readonly) NSUInteger numberOfFetchedSamples;
+
+/// The mean time from issuing an anchored query to receiving its results.
+@property (readonly) NSTimeInterval averageQueryLatency;
+
+/// The longest time from issuing an anchored query to receiving its results.
+@property (readonly) NSTimeInterval maximumQueryLatency;
+
 /**
  Returns an initialized health quantity type recorder using the specified quantity type and unit.
  
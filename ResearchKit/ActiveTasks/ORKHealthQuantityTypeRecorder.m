@@ -34,7 +34,20 @@
 #import "ORKDataLogger.h"
 #import "ORKRecorder_Private.h"
 #import "ORKRecorder_Internal.h"
+#import "ORKHealthQuantityTypeRecorder_Internal.h"
 #import "HKSample+ORKJSONDictionary.h"
+#import "ORKRunningStatistics.h"
+
+
+NSString *const ORKHealthQuantityTypeRecorderSummaryUnitKey = @"unit";
+NSString *const ORKHealthQuantityTypeRecorderSummaryCountKey = @"count";
+NSString *const ORKHealthQuantityTypeRecorderSummarySumKey = @"sum";
+NSString *const ORKHealthQuantityTypeRecorderSummaryMinimumKey = @"minimum";
+NSString *const ORKHealthQuantityTypeRecorderSummaryMaximumKey = @"maximum";
+NSString *const ORKHealthQuantityTypeRecorderSummaryMeanKey = @"mean";
+NSString *const ORKHealthQuantityTypeRecorderSummaryStandardDeviationKey = @"standardDeviation";
+NSString *const ORKHealthQuantityTypeRecorderSummaryWindowDurationKey = @"windowDuration";
+NSString *const ORKHealthQuantityTypeRecorderSummaryMaximumWindowSumKey = @"maximumWindowSum";
 
 
 @interface ORKHealthQuantityTypeRecorder () {
@@ -48,6 +61,23 @@
     HKQueryAnchor *_anchor;
     NSUInteger _anchorValue;
     HKQuantitySample *_lastSample;
+    BOOL _preparedToStop;
+    
+    // Anchored query state and counters, guarded by @synchronized (self)
+    BOOL _queryInFlight;
+    BOOL _needsFetch;
+    NSUInteger _queryLimit;
+    NSUInteger _numberOfQueries;
+    NSUInteger _numberOfFetchedSamples;
+    NSTimeInterval _totalQueryLatency;
+    NSTimeInterval _maximumQueryLatency;
+    
+    // Serial queue on which samples are converted, logged and summarized
+    dispatch_queue_t _queue;
+    // Whether the log still takes samples; owned by _queue and cleared when the log is closed
+    BOOL _acceptsSamples;
+    ORKRunningStatistics _statistics;
+    ORKSlidingWindowSum _window;
 }
 
 @end
@@ -67,6 +97,11 @@
 @end
 #endif
 
+static const NSUInteger _HealthAnchoredQueryMinimumLimit = 100;
+static const NSUInteger _HealthAnchoredQueryMaximumLimit = 2000;
+static const NSTimeInterval _HealthAnchoredQueryBatchDuration = 30;
+static const NSTimeInterval _HealthSummaryWindowDuration = 60;
+
 @implementation ORKHealthQuantityTypeRecorder
 
 - (instancetype)initWithIdentifier:(NSString *)identifier
@@ -86,12 +121,15 @@
         self.continuesInBackground = YES;
         _anchorValue = HKAnchoredObjectQueryNoAnchor;
         _anchor = [HKQueryAnchor anchorFromValue:_anchorValue];
+        _queryLimit = _HealthAnchoredQueryMinimumLimit;
+        _queue = dispatch_queue_create("org.researchkit.healthquantityrecorder", DISPATCH_QUEUE_SERIAL);
     }
     return self;
 }
 
 - (void)dealloc {
     [_logger finishCurrentLog];
+    ORKSlidingWindowSumDestroy(&_window);
 }
 
 - (void)updateMostRecentSample:(HKQuantitySample *)sample {
@@ -105,57 +143,122 @@
     }
 }
 
-static const NSInteger _HealthAnchoredQueryLimit = 100;
+/// Sizes the next anchored query to hold about `_HealthAnchoredQueryBatchDuration` worth of samples at
+/// the rate observed in the last batch, and at least doubles it while the recorder is catching up.
+NSUInteger ORKHealthAnchoredQueryLimit(NSUInteger limit, NSUInteger resultCount, NSTimeInterval span) {
+    NSUInteger newLimit = _HealthAnchoredQueryMinimumLimit;
+    if (resultCount > 1 && span > 0) {
+        double sampleRate = resultCount / span;
+        newLimit = (NSUInteger)MIN(ceil(sampleRate * _HealthAnchoredQueryBatchDuration), (double)_HealthAnchoredQueryMaximumLimit);
+    }
+    if (resultCount >= limit) {
+        newLimit = MAX(newLimit, limit * 2);
+    }
+    return MIN(MAX(newLimit, _HealthAnchoredQueryMinimumLimit), _HealthAnchoredQueryMaximumLimit);
+}
 
-- (void)query_logResults:(NSArray *)results withAnchor:(HKQueryAnchor*)newAnchor anchorValue:(NSUInteger)anchorValue {
+- (void)query_logResults:(NSArray *)results {
     
     NSUInteger resultCount = results.count;
     if (resultCount == 0) {
         return;
     }
     
-    // Do conversion to dictionary on whatever queue we happen to be on.
-    NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:resultCount];
-    [results enumerateObjectsUsingBlock:^(HKQuantitySample *sample, NSUInteger idx, BOOL *stop) {
-        [dictionaries addObject:[sample ork_JSONDictionaryWithOptions:ORKSampleIncludeSource|ORKSampleIncludeMetadata unit:_unit]];
-    }];
-    
     dispatch_async(dispatch_get_main_queue(), ^{
         [self updateMostRecentSample:results.lastObject];
+    });
+    
+    // Conversion, file writes and the summary stay off the main queue; only UI-facing updates hop back.
+    dispatch_async(_queue, ^{
+        // The results handler may have seen the recorder running just before it stopped and closed the log
+        if (!_acceptsSamples) {
+            return;
+        }
+        NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:resultCount];
+        for (HKQuantitySample *sample in results) {
+            [dictionaries addObject:[sample ork_JSONDictionaryWithOptions:ORKSampleIncludeSource|ORKSampleIncludeMetadata unit:_unit]];
+        }
         
         NSError *error = nil;
         if (![_logger appendObjects:dictionaries error:&error]) {
             // Logger writes are unrecoverable
-            [self finishRecordingWithError:error];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self finishRecordingWithError:error];
+            });
             return;
         }
         
-        _anchor = newAnchor;
-        _anchorValue = anchorValue;
-        
-        if (resultCount == _HealthAnchoredQueryLimit) {
-            // Do another fetch immediately rather than wait for an observation
-            [self doFetchNewData];
+        for (HKQuantitySample *sample in results) {
+            double value = [sample.quantity doubleValueForUnit:_unit];
+            ORKRunningStatisticsAdd(&_statistics, value);
+            ORKSlidingWindowSumAdd(&_window, sample.endDate.timeIntervalSinceReferenceDate, value);
         }
     });
 }
 
+- (void)query_handleResults:(NSArray *)results anchor:(HKQueryAnchor *)newAnchor anchorValue:(NSUInteger)anchorValue issueTime:(NSTimeInterval)issueTime error:(NSError *)error {
+    NSTimeInterval latency = [NSDate timeIntervalSinceReferenceDate] - issueTime;
+    BOOL fetchAgain = NO;
+    BOOL isRecording = NO;
+    @synchronized (self) {
+        isRecording = _isRecording;
+        _queryInFlight = NO;
+        _numberOfQueries++;
+        _numberOfFetchedSamples += results.count;
+        _totalQueryLatency += latency;
+        _maximumQueryLatency = MAX(_maximumQueryLatency, latency);
+        
+        if (error) {
+            // An error in the query's not the end of the world: we'll probably get another chance. Just log it.
+            ORK_Log_Warning(@"Anchored query error: %@", error);
+        } else {
+            _anchor = newAnchor;
+            _anchorValue = anchorValue;
+            // A full batch means more samples are waiting; do another fetch immediately rather than wait for an observation
+            fetchAgain = (results.count >= _queryLimit);
+            NSTimeInterval span = [((HKSample *)results.lastObject).endDate timeIntervalSinceDate:((HKSample *)results.firstObject).startDate];
+            _queryLimit = ORKHealthAnchoredQueryLimit(_queryLimit, results.count, span);
+        }
+        fetchAgain = fetchAgain || _needsFetch;
+    }
+    
+    // The next query runs while this batch is being encoded and written.
+    if (fetchAgain) {
+        [self doFetchNewData];
+    }
+    if (!error && isRecording) {
+        [self query_logResults:results];
+    }
+}
+
 - (void)doFetchNewData {
-    if (!_healthStore || !_isRecording) {
-        return;
+    HKQueryAnchor *anchor = nil;
+    NSUInteger anchorValue = 0;
+    NSUInteger limit = 0;
+    NSPredicate *predicate = nil;
+    @synchronized (self) {
+        if (!_healthStore || !_isRecording) {
+            return;
+        }
+        if (_queryInFlight) {
+            // Anchored queries are serialized so that each starts from the previous one's anchor
+            _needsFetch = YES;
+            return;
+        }
+        NSAssert(_samplePredicate != nil, @"Sample predicate should be non-nil if recording");
+        _queryInFlight = YES;
+        _needsFetch = NO;
+        anchor = _anchor;
+        anchorValue = _anchorValue;
+        limit = _queryLimit;
+        predicate = _samplePredicate;
     }
-    NSAssert(_samplePredicate != nil, @"Sample predicate should be non-nil if recording");
     
     ORKWeakTypeOf(self) weakSelf = self;
+    NSTimeInterval issueTime = [NSDate timeIntervalSinceReferenceDate];
     void (^handleResults)(NSArray <__kindof HKSample *> *, HKQueryAnchor *, NSUInteger, NSError *) = ^ (NSArray *results, HKQueryAnchor *newAnchor, NSUInteger newAnchorValue, NSError *error) {
-                                                if (error) {
-                                                    // An error in the query's not the end of the world: we'll probably get another chance. Just log it.
-                                                    ORK_Log_Warning(@"Anchored query error: %@", error);
-                                                    return;
-                                                }
-        
         ORKStrongTypeOf(self) strongSelf = weakSelf;
-        [strongSelf query_logResults:results withAnchor:newAnchor anchorValue:newAnchorValue];
+        [strongSelf query_handleResults:results anchor:newAnchor anchorValue:newAnchorValue issueTime:issueTime error:error];
     };
     
     
@@ -163,9 +266,9 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
     if ([HKAnchoredObjectQuery instancesRespondToSelector:@selector(initWithType:predicate:anchor:limit:resultsHandler:)]) {
                                                 
         anchoredQuery = [[HKAnchoredObjectQuery alloc] initWithType:_quantityType
-                                                          predicate:_samplePredicate
-                                                             anchor:_anchor
-                                                              limit:_HealthAnchoredQueryLimit
+                                                          predicate:predicate
+                                                             anchor:anchor
+                                                              limit:limit
                                                      resultsHandler:
                          ^(HKAnchoredObjectQuery *query, NSArray *sampleObjects, NSArray *deletedObjects, HKQueryAnchor *newAnchor, NSError *error) {
                              handleResults(sampleObjects, newAnchor, 0, error);
@@ -174,9 +277,9 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
     else if ([HKAnchoredObjectQuery instancesRespondToSelector:@selector(initWithType:predicate:anchor:limit:completionHandler:)]) {
                                                 
         anchoredQuery = [[HKAnchoredObjectQuery alloc] initWithType:_quantityType
-                                                          predicate:_samplePredicate
-                                                             anchor:_anchorValue
-                                                              limit:_HealthAnchoredQueryLimit
+                                                          predicate:predicate
+                                                             anchor:anchorValue
+                                                              limit:limit
                                                   completionHandler:
                          ^(HKAnchoredObjectQuery *query, NSArray<__kindof HKSample *> *results, NSUInteger newAnchor, NSError *error) {
                              handleResults(results, nil, newAnchor, error);
@@ -188,6 +291,40 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
     [_healthStore executeQuery:anchoredQuery];
 }
 
+- (NSUInteger)numberOfQueries {
+    @synchronized (self) {
+        return _numberOfQueries;
+    }
+}
+
+- (NSUInteger)numberOfFetchedSamples {
+    @synchronized (self) {
+        return _numberOfFetchedSamples;
+    }
+}
+
+- (NSTimeInterval)averageQueryLatency {
+    @synchronized (self) {
+        return (_numberOfQueries > 0) ? _totalQueryLatency / _numberOfQueries : 0;
+    }
+}
+
+- (NSTimeInterval)maximumQueryLatency {
+    @synchronized (self) {
+        return _maximumQueryLatency;
+    }
+}
+
+- (NSUInteger)queryLimit {
+    @synchronized (self) {
+        return _queryLimit;
+    }
+}
+
+- (HKHealthStore *)createHealthStore {
+    return [HKHealthStore new];
+}
+
 - (void)start {
     [super start];
     
@@ -200,16 +337,9 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
         }
     }
     
-    if (![HKHealthStore isHealthDataAvailable]) {
-        [self finishRecordingWithError:[NSError errorWithDomain:NSCocoaErrorDomain
-                                                           code:NSFeatureUnsupportedError
-                                                       userInfo:@{@"recorder": self}]];
-        return;
-    }
-    
     if (!_healthStore) {
         // Get a new obsever query
-        _healthStore = [HKHealthStore new];
+        _healthStore = [self createHealthStore];
     } else {
         // Reset
         if (_observerQuery) {
@@ -218,8 +348,30 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
         }
     }
     
+    if (![[_healthStore class] isHealthDataAvailable]) {
+        [self finishRecordingWithError:[NSError errorWithDomain:NSCocoaErrorDomain
+                                                           code:NSFeatureUnsupportedError
+                                                       userInfo:@{@"recorder": self}]];
+        return;
+    }
+    
     _lastSample = nil;
-    _samplePredicate = [HKQuery predicateForSamplesWithStartDate:[NSDate date] endDate:nil options:HKQueryOptionStrictStartDate];
+    dispatch_sync(_queue, ^{
+        _statistics = ORKRunningStatisticsMake();
+        ORKSlidingWindowSumDestroy(&_window);
+        ORKSlidingWindowSumInitialize(&_window, _HealthSummaryWindowDuration);
+        _acceptsSamples = YES;
+    });
+    @synchronized (self) {
+        _samplePredicate = [HKQuery predicateForSamplesWithStartDate:[NSDate date] endDate:nil options:HKQueryOptionStrictStartDate];
+        _queryInFlight = NO;
+        _needsFetch = NO;
+        _queryLimit = _HealthAnchoredQueryMinimumLimit;
+        _numberOfQueries = 0;
+        _numberOfFetchedSamples = 0;
+        _totalQueryLatency = 0;
+        _maximumQueryLatency = 0;
+    }
     
     NSAssert(!_observerQuery, @"observer query should not exist if not recording");
     
@@ -230,20 +382,22 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
                       updateHandler:^(HKObserverQuery *query, HKObserverQueryCompletionHandler completionHandler, NSError *error) {
                           ORKStrongTypeOf(self) strongSelf = weakSelf;
                           
-                          dispatch_async(dispatch_get_main_queue(), ^{
-                              if (error) {
+                          if (error) {
+                              dispatch_async(dispatch_get_main_queue(), ^{
                                   [strongSelf finishRecordingWithError:error];
-                              } else {
-                                  [strongSelf doFetchNewData];
-                              }
-                          });
+                              });
+                          } else {
+                              [strongSelf doFetchNewData];
+                          }
                           
                           // Immediately signal receipt. We've fired off to either finish or do a new fetch.
                           completionHandler();
                           
                       }];
     
-    _isRecording = YES;
+    @synchronized (self) {
+        _isRecording = YES;
+    }
     [_healthStore executeQuery:_observerQuery];
 }
 
@@ -251,21 +405,56 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
     return _quantityType.identifier;
 }
 
-- (void)stop {
+- (NSDictionary *)userInfo {
+    __block NSDictionary *userInfo = nil;
+    dispatch_sync(_queue, ^{
+        if (_statistics.count == 0) {
+            return;
+        }
+        userInfo = @{ ORKHealthQuantityTypeRecorderSummaryUnitKey: _unit.unitString,
+                      ORKHealthQuantityTypeRecorderSummaryCountKey: @(_statistics.count),
+                      ORKHealthQuantityTypeRecorderSummarySumKey: @(_statistics.sum),
+                      ORKHealthQuantityTypeRecorderSummaryMinimumKey: @(_statistics.minimum),
+                      ORKHealthQuantityTypeRecorderSummaryMaximumKey: @(_statistics.maximum),
+                      ORKHealthQuantityTypeRecorderSummaryMeanKey: @(_statistics.mean),
+                      ORKHealthQuantityTypeRecorderSummaryStandardDeviationKey: @(ORKRunningStatisticsStandardDeviation(&_statistics)),
+                      ORKHealthQuantityTypeRecorderSummaryWindowDurationKey: @(_HealthSummaryWindowDuration),
+                      ORKHealthQuantityTypeRecorderSummaryMaximumWindowSumKey: @(_window.maximumSum) };
+    });
+    return userInfo;
+}
+
+- (void)prepareToStopInGroup:(dispatch_group_t)group {
     if (!_isRecording) {
         return;
     }
     
     [self doStopRecording];
-    [_logger finishCurrentLog];
+    _preparedToStop = YES;
+    // Close the log behind any pending writes
+    ORKDataLogger *logger = _logger;
+    dispatch_group_async(group, _queue, ^{
+        _acceptsSamples = NO;
+        [self finishCurrentLogOfLogger:logger];
+    });
+}
+
+- (void)stop {
+    if (!_isRecording && !_preparedToStop) {
+        return;
+    }
+    _preparedToStop = NO;
     
-    NSError *error = nil;
-    __block NSURL *fileUrl = nil;
-    [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
-        fileUrl = logFileUrl;
-    } error:&error];
+    [self doStopRecording];
+    // Let any pending writes land before the log is closed
+    dispatch_sync(_queue, ^{
+        _acceptsSamples = NO;
+    });
+    [self finishCurrentLogOfLogger:_logger];
     
-    [self reportFileResultWithFile:fileUrl error:error];
+    NSURL *fileUrl = _logger.lastFinishedLogFileURL;
+    
+    [self reportFileResultWithFile:fileUrl error:nil];
     
     [super stop];
 }
@@ -276,8 +465,10 @@ static const NSInteger _HealthAnchoredQueryLimit = 100;
         [_healthStore stopQuery:_observerQuery];
         _observerQuery = nil;
         
-        _samplePredicate = nil;
-        _isRecording = NO;
+        @synchronized (self) {
+            _samplePredicate = nil;
+            _isRecording = NO;
+        }
         
         [self updateMostRecentSample:nil];
     }
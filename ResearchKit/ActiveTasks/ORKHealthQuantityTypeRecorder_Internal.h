@@ -0,0 +1,63 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKHealthQuantityTypeRecorder.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Returns the limit for the next anchored query, given the limit of the last one and the number of
+ samples it returned over `span` seconds.
+ 
+ The limit holds about 30 seconds of samples at the observed rate, at least doubles while batches
+ come back full, and stays between 100 and 2000.
+ */
+ORK_EXTERN NSUInteger ORKHealthAnchoredQueryLimit(NSUInteger limit, NSUInteger resultCount, NSTimeInterval span);
+
+@interface ORKHealthQuantityTypeRecorder ()
+
+- (HKHealthStore *)createHealthStore;
+
+// Issues an anchored query, or marks one as needed if a query is already in flight.
+- (void)doFetchNewData;
+
+- (void)query_handleResults:(nullable NSArray<HKSample *> *)results
+                     anchor:(nullable HKQueryAnchor *)newAnchor
+                anchorValue:(NSUInteger)anchorValue
+                  issueTime:(NSTimeInterval)issueTime
+                      error:(nullable NSError *)error;
+
+- (void)query_logResults:(NSArray<HKSample *> *)results;
+
+@end
+
+NS_ASSUME_NONNULL_END
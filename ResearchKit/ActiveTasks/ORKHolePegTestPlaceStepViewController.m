@@ -35,6 +35,7 @@
 #import "ORKActiveStepViewController_internal.h"
 #import "ORKStepViewController_internal.h"
 #import "ORKActiveStepView.h"
+#import "ORKRunningStatistics.h"
 #import "ORKHelpers.h"
 
 
@@ -49,7 +50,11 @@
 @end
 
 
-@implementation ORKHolePegTestPlaceStepViewController
+@implementation ORKHolePegTestPlaceStepViewController {
+    // Summaries of the sample times and distances, updated as each sample is saved
+    ORKRunningStatistics _timeStatistics;
+    ORKRunningStatistics _distanceStatistics;
+}
 
 - (instancetype)initWithStep:(ORKStep *)step {
     self = [super initWithStep:step];
@@ -88,6 +93,8 @@
     self.successes = 0;
     self.failures = 0;
     self.samples = [NSMutableArray array];
+    _timeStatistics = ORKRunningStatisticsMake();
+    _distanceStatistics = ORKRunningStatisticsMake();
     [self.holePegTestPlaceContentView setProgress:0.001f animated:NO];
     
     [super start];
@@ -109,11 +116,9 @@
     holePegTestResult.totalSuccesses = self.successes;
     holePegTestResult.totalFailures = self.failures;
     holePegTestResult.totalTime = [self holePegTestPlaceStep].stepDuration - self.timeRemaining;
-    double totalDistance = 0.0;
-    for (ORKHolePegTestSample *sample in self.samples) {
-        totalDistance += sample.distance;
-    }
-    holePegTestResult.totalDistance = totalDistance;
+    holePegTestResult.totalDistance = _distanceStatistics.sum;
+    holePegTestResult.meanTime = _timeStatistics.mean;
+    holePegTestResult.timeStandardDeviation = ORKRunningStatisticsStandardDeviation(&_timeStatistics);
     holePegTestResult.samples = self.samples;
 
     [results addObject:holePegTestResult];
@@ -129,6 +134,8 @@
     sample.distance = distance;
     self.sampleStart = CACurrentMediaTime();
     
+    ORKRunningStatisticsAdd(&_timeStatistics, sample.time);
+    ORKRunningStatisticsAdd(&_distanceStatistics, sample.distance);
     [self.samples addObject:sample];
 }
 
@@ -35,6 +35,7 @@
 #import "ORKActiveStepViewController_internal.h"
 #import "ORKStepViewController_internal.h"
 #import "ORKActiveStepView.h"
+#import "ORKRunningStatistics.h"
 #import "ORKHelpers.h"
 
 
@@ -49,7 +50,11 @@
 @end
 
 
-@implementation ORKHolePegTestRemoveStepViewController
+@implementation ORKHolePegTestRemoveStepViewController {
+    // Summaries of the sample times and distances, updated as each sample is saved
+    ORKRunningStatistics _timeStatistics;
+    ORKRunningStatistics _distanceStatistics;
+}
 
 - (instancetype)initWithStep:(ORKStep *)step {
     self = [super initWithStep:step];
@@ -94,6 +99,8 @@
     self.successes = 0;
     self.failures = 0;
     self.samples = [NSMutableArray array];
+    _timeStatistics = ORKRunningStatisticsMake();
+    _distanceStatistics = ORKRunningStatisticsMake();
     [self.holePegTestRemoveContentView setProgress:0.001f animated:NO];
     
     [super start];
@@ -115,11 +122,9 @@
     holePegTestResult.totalSuccesses = self.successes;
     holePegTestResult.totalFailures = self.failures;
     holePegTestResult.totalTime = [self holePegTestRemoveStep].stepDuration - self.timeRemaining;
-    double totalDistance = 0.0;
-    for (ORKHolePegTestSample *sample in self.samples) {
-        totalDistance += sample.distance;
-    }
-    holePegTestResult.totalDistance = totalDistance;
+    holePegTestResult.totalDistance = _distanceStatistics.sum;
+    holePegTestResult.meanTime = _timeStatistics.mean;
+    holePegTestResult.timeStandardDeviation = ORKRunningStatisticsStandardDeviation(&_timeStatistics);
     holePegTestResult.samples = self.samples;
     
     [results addObject:holePegTestResult];
@@ -135,6 +140,8 @@
     sample.distance = distance;
     self.sampleStart = CACurrentMediaTime();
     
+    ORKRunningStatisticsAdd(&_timeStatistics, sample.time);
+    ORKRunningStatisticsAdd(&_distanceStatistics, sample.distance);
     [self.samples addObject:sample];
 }
 
@@ -0,0 +1,116 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+#import <CoreLocation/CoreLocation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ `ORKLocationFilter` is a streaming filter for the locations received by `ORKLocationRecorder`.
+ 
+ Locations go through three optional stages, in order:
+ 
+ 1. Smoothing: a Kalman filter on the coordinate, which weighs each fix by its horizontal accuracy.
+ 2. Coalescing: a location is dropped unless it is at least `minimumDistance` away from, and
+    `minimumTimeInterval` after, the last location kept.
+ 3. Simplification: the kept locations are buffered in windows, and each window is simplified
+    with the Douglas-Peucker algorithm, so that no dropped location is more than
+    `simplificationTolerance` away from the simplified track.
+ 
+ Locations with an invalid horizontal accuracy are always dropped. The running distance and
+ speed summary is computed on the locations kept by the coalescing stage.
+ */
+@interface ORKLocationFilter : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an initialized location filter.
+ 
+ @param minimumDistance             The minimum distance between two kept locations, or 0.
+ @param minimumTimeInterval         The minimum time interval between two kept locations, or 0.
+ @param smoothsLocations            Whether locations are smoothed before coalescing.
+ @param simplificationTolerance     The Douglas-Peucker tolerance, or 0 to not simplify.
+ 
+ @return An initialized location filter.
+ */
+- (instancetype)initWithMinimumDistance:(CLLocationDistance)minimumDistance
+                    minimumTimeInterval:(NSTimeInterval)minimumTimeInterval
+                       smoothsLocations:(BOOL)smoothsLocations
+                simplificationTolerance:(CLLocationDistance)simplificationTolerance NS_DESIGNATED_INITIALIZER;
+
+/**
+ Adds locations, in chronological order, and returns the filtered locations that are complete.
+ 
+ When simplifying, locations are returned a window at a time.
+ */
+- (NSArray<CLLocation *> *)filterLocations:(NSArray<CLLocation *> *)locations;
+
+/**
+ Returns the filtered locations still held by the filter, and empties it.
+ */
+- (NSArray<CLLocation *> *)flush;
+
+@property (nonatomic, readonly) CLLocationDistance minimumDistance;
+@property (nonatomic, readonly) NSTimeInterval minimumTimeInterval;
+@property (nonatomic, readonly) BOOL smoothsLocations;
+@property (nonatomic, readonly) CLLocationDistance simplificationTolerance;
+
+/**
+ The number of locations added to the filter.
+ */
+@property (nonatomic, readonly) NSUInteger numberOfLocations;
+
+/**
+ The length of the track of kept locations, in meters.
+ */
+@property (nonatomic, readonly) CLLocationDistance totalDistance;
+
+/**
+ The time between the first and the last kept locations.
+ */
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/**
+ The total distance divided by the duration, in meters per second.
+ */
+@property (nonatomic, readonly) CLLocationSpeed averageSpeed;
+
+/**
+ The highest speed between two consecutive kept locations, in meters per second.
+ */
+@property (nonatomic, readonly) CLLocationSpeed maximumSpeed;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,218 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKLocationFilter.h"
+
+
+// Expected change of position per second, for the Kalman filter process noise (walking and running)
+static const double ORKLocationFilterProcessNoise = 3.0;    // m/s
+// Locations simplified together; the last location of a window starts the next one
+static const NSUInteger ORKLocationFilterWindowLength = 32;
+static const double ORKLocationFilterEarthRadius = 6371000.0;    // m
+
+@implementation ORKLocationFilter {
+    // Kalman state: smoothed coordinate and its variance in square meters
+    BOOL _hasEstimate;
+    CLLocationCoordinate2D _estimate;
+    double _variance;
+    NSDate *_estimateTimestamp;
+    
+    CLLocation *_firstKeptLocation;
+    CLLocation *_lastKeptLocation;
+    NSMutableArray<CLLocation *> *_window;
+}
+
+- (instancetype)initWithMinimumDistance:(CLLocationDistance)minimumDistance
+                    minimumTimeInterval:(NSTimeInterval)minimumTimeInterval
+                       smoothsLocations:(BOOL)smoothsLocations
+                simplificationTolerance:(CLLocationDistance)simplificationTolerance {
+    self = [super init];
+    if (self) {
+        _minimumDistance = MAX(minimumDistance, 0);
+        _minimumTimeInterval = MAX(minimumTimeInterval, 0);
+        _smoothsLocations = smoothsLocations;
+        _simplificationTolerance = MAX(simplificationTolerance, 0);
+        _window = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (NSTimeInterval)duration {
+    return [_lastKeptLocation.timestamp timeIntervalSinceDate:_firstKeptLocation.timestamp];
+}
+
+- (CLLocationSpeed)averageSpeed {
+    NSTimeInterval duration = self.duration;
+    return (duration > 0) ? _totalDistance / duration : 0;
+}
+
+- (NSArray<CLLocation *> *)filterLocations:(NSArray<CLLocation *> *)locations {
+    NSMutableArray<CLLocation *> *output = [NSMutableArray array];
+    for (CLLocation *location in locations) {
+        _numberOfLocations++;
+        if (location.horizontalAccuracy < 0) {
+            continue;
+        }
+        CLLocation *smoothedLocation = _smoothsLocations ? [self smoothLocation:location] : location;
+        if (![self keepLocation:smoothedLocation]) {
+            continue;
+        }
+        
+        if (_simplificationTolerance <= 0) {
+            [output addObject:smoothedLocation];
+            continue;
+        }
+        [_window addObject:smoothedLocation];
+        if (_window.count >= ORKLocationFilterWindowLength) {
+            NSArray<CLLocation *> *simplified = [self simplifyLocations:_window];
+            [output addObjectsFromArray:[simplified subarrayWithRange:NSMakeRange(0, simplified.count - 1)]];
+            [_window removeAllObjects];
+            [_window addObject:simplified.lastObject];
+        }
+    }
+    return [output copy];
+}
+
+- (NSArray<CLLocation *> *)flush {
+    NSArray<CLLocation *> *output = [self simplifyLocations:_window];
+    [_window removeAllObjects];
+    return output;
+}
+
+#pragma mark Smoothing
+
+- (CLLocation *)smoothLocation:(CLLocation *)location {
+    double measurementVariance = location.horizontalAccuracy * location.horizontalAccuracy;
+    if (!_hasEstimate) {
+        _hasEstimate = YES;
+        _estimate = location.coordinate;
+        _variance = measurementVariance;
+    } else {
+        NSTimeInterval interval = MAX([location.timestamp timeIntervalSinceDate:_estimateTimestamp], 0);
+        _variance += interval * ORKLocationFilterProcessNoise * ORKLocationFilterProcessNoise;
+        double gain = (_variance + measurementVariance > 0) ? _variance / (_variance + measurementVariance) : 1;
+        _estimate.latitude += gain * (location.coordinate.latitude - _estimate.latitude);
+        _estimate.longitude += gain * (location.coordinate.longitude - _estimate.longitude);
+        _variance *= (1 - gain);
+    }
+    _estimateTimestamp = location.timestamp;
+    
+    return [[CLLocation alloc] initWithCoordinate:_estimate
+                                         altitude:location.altitude
+                               horizontalAccuracy:sqrt(_variance)
+                                 verticalAccuracy:location.verticalAccuracy
+                                           course:location.course
+                                            speed:location.speed
+                                        timestamp:location.timestamp];
+}
+
+#pragma mark Coalescing
+
+- (BOOL)keepLocation:(CLLocation *)location {
+    if (_lastKeptLocation) {
+        CLLocationDistance distance = [location distanceFromLocation:_lastKeptLocation];
+        NSTimeInterval interval = [location.timestamp timeIntervalSinceDate:_lastKeptLocation.timestamp];
+        if (distance < _minimumDistance || interval < _minimumTimeInterval) {
+            return NO;
+        }
+        _totalDistance += distance;
+        if (interval > 0) {
+            _maximumSpeed = MAX(_maximumSpeed, distance / interval);
+        }
+    } else {
+        _firstKeptLocation = location;
+    }
+    _lastKeptLocation = location;
+    return YES;
+}
+
+#pragma mark Simplification
+
+// Distance, in meters, from a point to a segment, on a local equirectangular projection
+static double ORKLocationFilterSegmentDistance(CLLocationCoordinate2D point, CLLocationCoordinate2D start, CLLocationCoordinate2D end) {
+    double scale = ORKLocationFilterEarthRadius * M_PI / 180;
+    double longitudeScale = scale * cos(start.latitude * M_PI / 180);
+    double px = (point.longitude - start.longitude) * longitudeScale;
+    double py = (point.latitude - start.latitude) * scale;
+    double ex = (end.longitude - start.longitude) * longitudeScale;
+    double ey = (end.latitude - start.latitude) * scale;
+    
+    double lengthSquared = ex * ex + ey * ey;
+    double t = (lengthSquared > 0) ? MIN(MAX((px * ex + py * ey) / lengthSquared, 0), 1) : 0;
+    return hypot(px - t * ex, py - t * ey);
+}
+
+static void ORKLocationFilterDouglasPeucker(const CLLocationCoordinate2D *coordinates, NSUInteger first, NSUInteger last, double tolerance, BOOL *kept) {
+    if (last <= first + 1) {
+        return;
+    }
+    double maximumDistance = 0;
+    NSUInteger farthest = first;
+    for (NSUInteger i = first + 1; i < last; i++) {
+        double distance = ORKLocationFilterSegmentDistance(coordinates[i], coordinates[first], coordinates[last]);
+        if (distance > maximumDistance) {
+            maximumDistance = distance;
+            farthest = i;
+        }
+    }
+    if (maximumDistance > tolerance) {
+        kept[farthest] = YES;
+        ORKLocationFilterDouglasPeucker(coordinates, first, farthest, tolerance, kept);
+        ORKLocationFilterDouglasPeucker(coordinates, farthest, last, tolerance, kept);
+    }
+}
+
+- (NSArray<CLLocation *> *)simplifyLocations:(NSArray<CLLocation *> *)locations {
+    NSUInteger count = locations.count;
+    if (count <= 2) {
+        return [locations copy];
+    }
+    
+    CLLocationCoordinate2D coordinates[count];
+    BOOL kept[count];
+    for (NSUInteger i = 0; i < count; i++) {
+        coordinates[i] = locations[i].coordinate;
+        kept[i] = NO;
+    }
+    kept[0] = YES;
+    kept[count - 1] = YES;
+    ORKLocationFilterDouglasPeucker(coordinates, 0, count - 1, _simplificationTolerance, kept);
+    
+    NSMutableArray<CLLocation *> *simplified = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (kept[i]) {
+            [simplified addObject:locations[i]];
+        }
+    }
+    return [simplified copy];
+}
+
+@end
@@ -65,6 +65,48 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, strong, nullable, readonly) CLLocationManager *locationManager;
 
+/**
+ The minimum distance, in meters, between two filtered locations.
+ 
+ See `minimumDistance` on `ORKLocationRecorderConfiguration`.
+ */
+@property (nonatomic) CLLocationDistance minimumDistance;
+
+/**
+ The minimum time interval between two filtered locations.
+ 
+ See `minimumTimeInterval` on `ORKLocationRecorderConfiguration`.
+ */
+@property (nonatomic) NSTimeInterval minimumTimeInterval;
+
+/**
+ A Boolean value indicating whether locations are smoothed before they are filtered.
+ 
+ See `smoothsLocations` on `ORKLocationRecorderConfiguration`.
+ */
+@property (nonatomic) BOOL smoothsLocations;
+
+/**
+ The tolerance, in meters, of the simplification of the filtered locations.
+ 
+ See `simplificationTolerance` on `ORKLocationRecorderConfiguration`.
+ */
+@property (nonatomic) CLLocationDistance simplificationTolerance;
+
+/**
+ Whether the recorder records every location, or only the filtered locations.
+ 
+ See `outputMode` on `ORKLocationRecorderConfiguration`.
+ */
+@property (nonatomic) ORKLocationOutputMode outputMode;
+
+/**
+ A Boolean value indicating whether the recorder summarizes the movement while it records.
+ 
+ See `summarizesMovement` on `ORKLocationRecorderConfiguration`.
+ */
+@property (nonatomic) BOOL summarizesMovement;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -33,6 +33,8 @@
 #import <CoreLocation/CoreLocation.h>
 #import "CLLocation+ORKJSONDictionary.h"
 #import "ORKDataLogger.h"
+#import "ORKLocationFilter.h"
+#import "ORKHelpers.h"
 #import "ORKRecorder_Internal.h"
 #import "ORKRecorder_Private.h"
 
@@ -41,12 +43,13 @@
     ORKDataLogger *_logger;
     NSError *_recordingError;
     BOOL _started;
+    
+    ORKLocationFilter *_filter;
+    NSUInteger _recordedLocationCount;
 }
 
 @property (nonatomic, strong, nullable) CLLocationManager *locationManager;
 
-@property (nonatomic) NSTimeInterval uptime;
-
 @end
 
 
@@ -84,6 +87,14 @@
         }
     }
     
+    if (self.outputMode == ORKLocationOutputModeFiltered || self.summarizesMovement) {
+        _filter = [[ORKLocationFilter alloc] initWithMinimumDistance:self.minimumDistance
+                                                 minimumTimeInterval:self.minimumTimeInterval
+                                                    smoothsLocations:self.smoothsLocations
+                                             simplificationTolerance:self.simplificationTolerance];
+    }
+    _recordedLocationCount = 0;
+    
     self.locationManager = [self createLocationManager];
     if ([CLLocationManager authorizationStatus] <= kCLAuthorizationStatusDenied) {
         [self.locationManager requestWhenInUseAuthorization];
@@ -99,7 +110,6 @@
         return;
     }
     
-    self.uptime = [NSProcessInfo processInfo].systemUptime;
     [self.locationManager startUpdatingLocation];
 }
 
@@ -109,35 +119,83 @@
     self.locationManager = nil;
 }
 
+- (void)flushFilteredLocations {
+    NSError *error = nil;
+    if (!_recordingError && self.outputMode == ORKLocationOutputModeFiltered) {
+        // Locations held by the simplification window
+        if (![self logLocations:[_filter flush] error:&error]) {
+            _recordingError = error;
+        }
+    }
+}
+
+- (void)prepareToStopInGroup:(dispatch_group_t)group {
+    [self doStopRecording];
+    [self flushFilteredLocations];
+    [super prepareToStopInGroup:group];
+}
+
 - (void)stop {
     [self doStopRecording];
-    [_logger finishCurrentLog];
+    [self flushFilteredLocations];
     
     NSError *error = _recordingError;
     _recordingError = nil;
-    __block NSURL *fileUrl = nil;
-    [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
-        fileUrl = logFileUrl;
-    } error:&error];
+    [self finishCurrentLogOfLogger:_logger];
+    
+    NSURL *fileUrl = _logger.lastFinishedLogFileURL;
+    
+    ORKLocationSummaryResult *summaryResult = nil;
+    if (fileUrl && !error && self.summarizesMovement) {
+        summaryResult = [self summaryResult];
+    }
+    _filter = nil;
     
     [self reportFileResultWithFile:fileUrl error:error];
     
+    id<ORKRecorderDelegate> localDelegate = self.delegate;
+    if (summaryResult && [localDelegate respondsToSelector:@selector(recorder:didCompleteWithResult:)]) {
+        [localDelegate recorder:self didCompleteWithResult:summaryResult];
+    }
+    
     [super stop];
 }
 
+- (BOOL)logLocations:(NSArray<CLLocation *> *)locations error:(NSError **)error {
+    if (locations.count == 0) {
+        return YES;
+    }
+    NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:locations.count];
+    for (CLLocation *location in locations) {
+        [dictionaries addObject:[location ork_JSONDictionary]];
+    }
+    BOOL success = [_logger appendObjects:dictionaries error:error];
+    if (success) {
+        _recordedLocationCount += locations.count;
+    }
+    return success;
+}
+
+- (ORKLocationSummaryResult *)summaryResult {
+    ORKLocationSummaryResult *result = [[ORKLocationSummaryResult alloc] initWithIdentifier:[self.identifier stringByAppendingString:@"_summary"]];
+    result.startDate = self.startDate;
+    result.numberOfLocations = _filter.numberOfLocations;
+    result.numberOfRecordedLocations = _recordedLocationCount;
+    result.totalDistance = _filter.totalDistance;
+    result.duration = _filter.duration;
+    result.averageSpeed = _filter.averageSpeed;
+    result.maximumSpeed = _filter.maximumSpeed;
+    return result;
+}
+
 - (void)locationManager:(CLLocationManager *)manager
      didUpdateLocations:(NSArray *)locations {
     BOOL success = YES;
     NSParameterAssert(locations.count >= 0);
     NSError *error = nil;
     if (locations) {
-        NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:locations.count];
-        [locations enumerateObjectsUsingBlock:^(CLLocation *obj, NSUInteger idx, BOOL *stop) {
-            NSDictionary *d = [obj ork_JSONDictionary];
-            [dictionaries addObject:d];
-        }];
-        
-        success = [_logger appendObjects:dictionaries error:&error];
+        NSArray<CLLocation *> *filteredLocations = [_filter filterLocations:locations];
+        success = [self logLocations:(self.outputMode == ORKLocationOutputModeFiltered) ? filteredLocations : locations error:&error];
     }
     if (!success) {
         dispatch_async(dispatch_get_main_queue(), ^{
@@ -176,14 +234,39 @@
 }
 
 - (ORKRecorder *)recorderForStep:(ORKStep *)step outputDirectory:(NSURL *)outputDirectory {
-    return [[ORKLocationRecorder alloc] initWithIdentifier:self.identifier step:step outputDirectory:outputDirectory];
+    ORKLocationRecorder *recorder = [[ORKLocationRecorder alloc] initWithIdentifier:self.identifier step:step outputDirectory:outputDirectory];
+    recorder.minimumDistance = self.minimumDistance;
+    recorder.minimumTimeInterval = self.minimumTimeInterval;
+    recorder.smoothsLocations = self.smoothsLocations;
+    recorder.simplificationTolerance = self.simplificationTolerance;
+    recorder.outputMode = self.outputMode;
+    recorder.summarizesMovement = self.summarizesMovement;
+    return recorder;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
     self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_DOUBLE(aDecoder, minimumDistance);
+        ORK_DECODE_DOUBLE(aDecoder, minimumTimeInterval);
+        ORK_DECODE_BOOL(aDecoder, smoothsLocations);
+        ORK_DECODE_DOUBLE(aDecoder, simplificationTolerance);
+        ORK_DECODE_ENUM(aDecoder, outputMode);
+        ORK_DECODE_BOOL(aDecoder, summarizesMovement);
+    }
     return self;
 }
 
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_DOUBLE(aCoder, minimumDistance);
+    ORK_ENCODE_DOUBLE(aCoder, minimumTimeInterval);
+    ORK_ENCODE_BOOL(aCoder, smoothsLocations);
+    ORK_ENCODE_DOUBLE(aCoder, simplificationTolerance);
+    ORK_ENCODE_ENUM(aCoder, outputMode);
+    ORK_ENCODE_BOOL(aCoder, summarizesMovement);
+}
+
 + (BOOL)supportsSecureCoding {
     return YES;
 }
@@ -191,7 +274,14 @@
 - (BOOL)isEqual:(id)object {
     BOOL isParentSame = [super isEqual:object];
     
-    return isParentSame;
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.minimumDistance == castObject.minimumDistance) &&
+            (self.minimumTimeInterval == castObject.minimumTimeInterval) &&
+            (self.smoothsLocations == castObject.smoothsLocations) &&
+            (self.simplificationTolerance == castObject.simplificationTolerance) &&
+            (self.outputMode == castObject.outputMode) &&
+            (self.summarizesMovement == castObject.summarizesMovement));
 }
 
 - (ORKPermissionMask)requestedPermissionMask {
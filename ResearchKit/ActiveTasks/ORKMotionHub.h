@@ -0,0 +1,115 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+#import <CoreMotion/CoreMotion.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Fans a single `CMMotionManager` out to every recorder that needs motion data.
+ 
+ Each sensor stream (accelerometer, device motion) is started when its first
+ subscriber is added and stopped when its last subscriber is removed. The
+ stream runs at the highest frequency requested by its subscribers; each
+ subscriber receives a decimated stream at (approximately) its own frequency.
+ 
+ Subscriber handlers are called on the queue passed when subscribing, or on the
+ hub's serial delivery queue if none is passed.
+ */
+@interface ORKMotionHub : NSObject
+
+/**
+ The process-wide hub, backed by a single lazily created `CMMotionManager`.
+ */
++ (ORKMotionHub *)sharedHub;
+
+/**
+ Creates a hub backed by the given manager. Used by tests to substitute a
+ manager double that injects samples through the handlers the hub registers.
+ */
+- (instancetype)initWithMotionManager:(nullable CMMotionManager *)motionManager NS_DESIGNATED_INITIALIZER;
+
+/**
+ Whether the accelerometer is available on this device.
+ */
+@property (nonatomic, readonly, getter=isAccelerometerAvailable) BOOL accelerometerAvailable;
+
+/**
+ Whether device motion is available on this device.
+ */
+@property (nonatomic, readonly, getter=isDeviceMotionAvailable) BOOL deviceMotionAvailable;
+
+/**
+ The current accelerometer stream frequency, in Hz, or 0 when the stream is not running.
+ */
+@property (nonatomic, readonly) double accelerometerFrequency;
+
+/**
+ The current device motion stream frequency, in Hz, or 0 when the stream is not running.
+ */
+@property (nonatomic, readonly) double deviceMotionFrequency;
+
+/**
+ Adds an accelerometer subscriber and returns an opaque token to pass to `removeSubscriber:`.
+ The handler is retained until the subscriber is removed.
+ */
+- (id<NSObject>)addAccelerometerSubscriberWithFrequency:(double)frequency
+                                                  queue:(nullable NSOperationQueue *)queue
+                                                handler:(CMAccelerometerHandler)handler;
+
+/**
+ Adds a device motion subscriber and returns an opaque token to pass to `removeSubscriber:`.
+ The handler is retained until the subscriber is removed.
+ */
+- (id<NSObject>)addDeviceMotionSubscriberWithFrequency:(double)frequency
+                                                 queue:(nullable NSOperationQueue *)queue
+                                               handler:(CMDeviceMotionHandler)handler;
+
+/**
+ Removes a subscriber, stopping its stream if it was the last one.
+ 
+ No handler call for the subscriber starts after this method returns, including
+ deliveries already queued to the subscriber's queue.
+ */
+- (void)removeSubscriber:(id<NSObject>)subscriber;
+
+/**
+ Fan-out entry points, called with each sample the manager delivers. Exposed
+ so the decimation and delivery logic can be exercised without CoreMotion.
+ */
+- (void)distributeAccelerometerData:(nullable CMAccelerometerData *)data error:(nullable NSError *)error;
+- (void)distributeDeviceMotion:(nullable CMDeviceMotion *)motion error:(nullable NSError *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
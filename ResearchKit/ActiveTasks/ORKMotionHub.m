@@ -0,0 +1,281 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKMotionHub.h"
+#import "ORKHelpers.h"
+
+
+// Tolerance on the decimation phase, so ratios like 1/3 deliver on the third sample.
+static const double ORKMotionHubPhaseTolerance = 1e-6;
+
+
+@interface ORKMotionHubSubscriber : NSObject
+
+- (instancetype)initWithFrequency:(double)frequency queue:(NSOperationQueue *)queue handler:(id)handler;
+
+@property (nonatomic, readonly) double frequency;
+
+@property (nonatomic, strong, readonly) NSOperationQueue *queue;
+
+@property (nonatomic, copy, readonly) id handler;
+
+// Decimation accumulator; a sample is delivered each time it reaches 1.
+@property (nonatomic) double phase;
+
+// Cleared when the subscriber is removed, so deliveries still queued are dropped.
+@property (atomic, getter=isActive) BOOL active;
+
+@end
+
+
+@implementation ORKMotionHubSubscriber
+
+- (instancetype)initWithFrequency:(double)frequency queue:(NSOperationQueue *)queue handler:(id)handler {
+    self = [super init];
+    if (self) {
+        _frequency = (frequency > 0) ? frequency : 1;
+        _queue = queue;
+        _handler = [handler copy];
+        // Start primed, so the first sample of the stream is always delivered.
+        _phase = 1.0;
+        _active = YES;
+    }
+    return self;
+}
+
+- (BOOL)shouldDeliverSampleAtStreamFrequency:(double)streamFrequency {
+    _phase += (streamFrequency > 0) ? MIN(_frequency / streamFrequency, 1.0) : 1.0;
+    if (_phase >= 1.0 - ORKMotionHubPhaseTolerance) {
+        _phase = MAX(_phase - 1.0, 0);
+        return YES;
+    }
+    return NO;
+}
+
+- (void)deliver:(void (^)(void))block {
+    NSOperationQueue *queue = _queue;
+    BOOL onQueue = (queue == [NSOperationQueue currentQueue]) || (queue == [NSOperationQueue mainQueue] && [NSThread isMainThread]);
+    if (!queue || onQueue) {
+        if (self.isActive) {
+            block();
+        }
+    } else {
+        // Checked when the operation runs, since the subscriber may have been removed meanwhile.
+        [queue addOperationWithBlock:^{
+            if (self.isActive) {
+                block();
+            }
+        }];
+    }
+}
+
+@end
+
+
+@implementation ORKMotionHub {
+    CMMotionManager *_motionManager;
+    NSOperationQueue *_deliveryQueue;
+    NSMutableArray<ORKMotionHubSubscriber *> *_accelerometerSubscribers;
+    NSMutableArray<ORKMotionHubSubscriber *> *_deviceMotionSubscribers;
+}
+
++ (ORKMotionHub *)sharedHub {
+    static ORKMotionHub *sharedHub = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedHub = [[ORKMotionHub alloc] initWithMotionManager:nil];
+    });
+    return sharedHub;
+}
+
+- (instancetype)init {
+    return [self initWithMotionManager:nil];
+}
+
+- (instancetype)initWithMotionManager:(CMMotionManager *)motionManager {
+    self = [super init];
+    if (self) {
+        _motionManager = motionManager;
+        _deliveryQueue = [NSOperationQueue new];
+        _deliveryQueue.name = @"ORKMotionHub";
+        _deliveryQueue.maxConcurrentOperationCount = 1;
+        _accelerometerSubscribers = [NSMutableArray new];
+        _deviceMotionSubscribers = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (CMMotionManager *)motionManager {
+    @synchronized (self) {
+        if (!_motionManager) {
+            _motionManager = [CMMotionManager new];
+        }
+        return _motionManager;
+    }
+}
+
+- (BOOL)isAccelerometerAvailable {
+    return self.motionManager.accelerometerAvailable;
+}
+
+- (BOOL)isDeviceMotionAvailable {
+    return self.motionManager.deviceMotionAvailable;
+}
+
+static double ORKMotionHubMaximumFrequency(NSArray<ORKMotionHubSubscriber *> *subscribers) {
+    double frequency = 0;
+    for (ORKMotionHubSubscriber *subscriber in subscribers) {
+        frequency = MAX(frequency, subscriber.frequency);
+    }
+    return frequency;
+}
+
+#pragma mark Subscription
+
+- (id<NSObject>)addAccelerometerSubscriberWithFrequency:(double)frequency queue:(NSOperationQueue *)queue handler:(CMAccelerometerHandler)handler {
+    ORKThrowInvalidArgumentExceptionIfNil(handler);
+    ORKMotionHubSubscriber *subscriber = [[ORKMotionHubSubscriber alloc] initWithFrequency:frequency queue:queue handler:handler];
+    CMMotionManager *manager = self.motionManager;
+    @synchronized (self) {
+        BOOL wasRunning = (_accelerometerSubscribers.count > 0);
+        [_accelerometerSubscribers addObject:subscriber];
+        double streamFrequency = ORKMotionHubMaximumFrequency(_accelerometerSubscribers);
+        if (streamFrequency != _accelerometerFrequency) {
+            _accelerometerFrequency = streamFrequency;
+            manager.accelerometerUpdateInterval = 1.0 / streamFrequency;
+        }
+        if (!wasRunning) {
+            ORKWeakTypeOf(self) weakSelf = self;
+            [manager startAccelerometerUpdatesToQueue:_deliveryQueue withHandler:^(CMAccelerometerData *data, NSError *error) {
+                [weakSelf distributeAccelerometerData:data error:error];
+            }];
+        }
+    }
+    return subscriber;
+}
+
+- (id<NSObject>)addDeviceMotionSubscriberWithFrequency:(double)frequency queue:(NSOperationQueue *)queue handler:(CMDeviceMotionHandler)handler {
+    ORKThrowInvalidArgumentExceptionIfNil(handler);
+    ORKMotionHubSubscriber *subscriber = [[ORKMotionHubSubscriber alloc] initWithFrequency:frequency queue:queue handler:handler];
+    CMMotionManager *manager = self.motionManager;
+    @synchronized (self) {
+        BOOL wasRunning = (_deviceMotionSubscribers.count > 0);
+        [_deviceMotionSubscribers addObject:subscriber];
+        double streamFrequency = ORKMotionHubMaximumFrequency(_deviceMotionSubscribers);
+        if (streamFrequency != _deviceMotionFrequency) {
+            _deviceMotionFrequency = streamFrequency;
+            manager.deviceMotionUpdateInterval = 1.0 / streamFrequency;
+        }
+        if (!wasRunning) {
+            ORKWeakTypeOf(self) weakSelf = self;
+            [manager startDeviceMotionUpdatesToQueue:_deliveryQueue withHandler:^(CMDeviceMotion *motion, NSError *error) {
+                [weakSelf distributeDeviceMotion:motion error:error];
+            }];
+        }
+    }
+    return subscriber;
+}
+
+- (void)removeSubscriber:(id<NSObject>)subscriber {
+    if (!subscriber) {
+        return;
+    }
+    CMMotionManager *manager = self.motionManager;
+    @synchronized (self) {
+        if ([subscriber isKindOfClass:[ORKMotionHubSubscriber class]]) {
+            ((ORKMotionHubSubscriber *)subscriber).active = NO;
+        }
+        if ([_accelerometerSubscribers containsObject:subscriber]) {
+            [_accelerometerSubscribers removeObject:subscriber];
+            if (_accelerometerSubscribers.count == 0) {
+                [manager stopAccelerometerUpdates];
+                _accelerometerFrequency = 0;
+            } else {
+                double streamFrequency = ORKMotionHubMaximumFrequency(_accelerometerSubscribers);
+                if (streamFrequency != _accelerometerFrequency) {
+                    _accelerometerFrequency = streamFrequency;
+                    manager.accelerometerUpdateInterval = 1.0 / streamFrequency;
+                }
+            }
+        } else if ([_deviceMotionSubscribers containsObject:subscriber]) {
+            [_deviceMotionSubscribers removeObject:subscriber];
+            if (_deviceMotionSubscribers.count == 0) {
+                [manager stopDeviceMotionUpdates];
+                _deviceMotionFrequency = 0;
+            } else {
+                double streamFrequency = ORKMotionHubMaximumFrequency(_deviceMotionSubscribers);
+                if (streamFrequency != _deviceMotionFrequency) {
+                    _deviceMotionFrequency = streamFrequency;
+                    manager.deviceMotionUpdateInterval = 1.0 / streamFrequency;
+                }
+            }
+        }
+    }
+}
+
+#pragma mark Fan-out
+
+- (void)distributeAccelerometerData:(CMAccelerometerData *)data error:(NSError *)error {
+    NSArray<ORKMotionHubSubscriber *> *subscribers = nil;
+    double streamFrequency = 0;
+    @synchronized (self) {
+        subscribers = [_accelerometerSubscribers copy];
+        streamFrequency = _accelerometerFrequency;
+    }
+    for (ORKMotionHubSubscriber *subscriber in subscribers) {
+        // Errors are always delivered; samples are decimated per subscriber.
+        if (error || [subscriber shouldDeliverSampleAtStreamFrequency:streamFrequency]) {
+            CMAccelerometerHandler handler = subscriber.handler;
+            [subscriber deliver:^{
+                handler(data, error);
+            }];
+        }
+    }
+}
+
+- (void)distributeDeviceMotion:(CMDeviceMotion *)motion error:(NSError *)error {
+    NSArray<ORKMotionHubSubscriber *> *subscribers = nil;
+    double streamFrequency = 0;
+    @synchronized (self) {
+        subscribers = [_deviceMotionSubscribers copy];
+        streamFrequency = _deviceMotionFrequency;
+    }
+    for (ORKMotionHubSubscriber *subscriber in subscribers) {
+        if (error || [subscriber shouldDeliverSampleAtStreamFrequency:streamFrequency]) {
+            CMDeviceMotionHandler handler = subscriber.handler;
+            [subscriber deliver:^{
+                handler(motion, error);
+            }];
+        }
+    }
+}
+
+@end
@@ -37,6 +37,7 @@
 #import "ORKVerticalContainerView.h"
 #import "ORKActiveStepView.h"
 #import "ORKPSATKeyboardView.h"
+#import "ORKRunningStatistics.h"
 #import "ORKHelpers.h"
 
 
@@ -50,10 +51,15 @@
 @property (nonatomic, strong) ORKActiveStepTimer *clearDigitsTimer;
 @property (nonatomic, assign) NSTimeInterval answerStart;
 @property (nonatomic, assign) NSTimeInterval answerEnd;
+@property (nonatomic, assign) NSInteger totalCorrect;
+@property (nonatomic, assign) NSInteger totalDyad;
 
 @end
 
-@implementation ORKPSATStepViewController
+@implementation ORKPSATStepViewController {
+    // Summary of the sample times, updated as each sample is saved
+    ORKRunningStatistics _timeStatistics;
+}
 
 - (instancetype)initWithStep:(ORKStep *)step {
     self = [super initWithStep:step];
@@ -118,23 +124,11 @@
     }
     PSATResult.length = [self psatStep].seriesLength;
     PSATResult.initialDigit = self.digits[0].integerValue;
-    NSInteger totalCorrect = 0;
-    BOOL previousAnswerCorrect = NO;
-    NSInteger totalDyad = 0;
-    CGFloat totalTime = 0.0;
-    for (ORKPSATSample *sample in self.samples) {
-        totalTime += sample.time;
-        if (sample.isCorrect) {
-            totalCorrect++;
-            if (previousAnswerCorrect) {
-                totalDyad++;
-            }
-        }
-        previousAnswerCorrect = sample.isCorrect;
-    }
-    PSATResult.totalCorrect = totalCorrect;
-    PSATResult.totalTime = totalTime;
-    PSATResult.totalDyad = totalDyad;
+    PSATResult.totalCorrect = self.totalCorrect;
+    PSATResult.totalTime = _timeStatistics.sum;
+    PSATResult.meanTime = _timeStatistics.mean;
+    PSATResult.timeStandardDeviation = ORKRunningStatisticsStandardDeviation(&_timeStatistics);
+    PSATResult.totalDyad = self.totalDyad;
     PSATResult.samples = self.samples;
 
     [results addObject:PSATResult];
@@ -151,6 +145,9 @@
     [self.psatContentView setProgress:0.001 animated:NO];
     self.currentAnswer = -1;
     self.samples = [NSMutableArray array];
+    self.totalCorrect = 0;
+    self.totalDyad = 0;
+    _timeStatistics = ORKRunningStatisticsMake();
     
     if ([self psatStep].presentationMode & ORKPSATPresentationModeVisual &&
         ([self psatStep].interStimulusInterval - [self psatStep].stimulusDuration) > 0.05 ) {
@@ -223,6 +220,14 @@
     sample.answer = self.currentAnswer;
     sample.time = self.answerEnd == 0 ? [self psatStep].interStimulusInterval : self.answerEnd - self.answerStart;
     
+    if (sample.isCorrect) {
+        self.totalCorrect++;
+        if ([self.samples.lastObject isCorrect]) {
+            self.totalDyad++;
+        }
+    }
+    ORKRunningStatisticsAdd(&_timeStatistics, sample.time);
+    
     [self.samples addObject:sample];
 }
 
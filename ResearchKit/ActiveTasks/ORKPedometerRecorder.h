@@ -49,6 +49,11 @@ NS_ASSUME_NONNULL_BEGIN
  
  The accelerometer recorder continues to record if the application enters the
  background using UIApplication's background task support.
+ 
+ The `userInfo` of the file result summarizes the recording: `numberOfSteps`, `distance`,
+ `floorsAscended`, `floorsDescended`, `duration`, `meanStepsPerMinute`, and
+ `maximumStepsPerMinute` (the highest step rate over any one-minute window, or over the whole
+ recording if it is shorter than a minute, so it is never below the mean).
  */
 ORK_CLASS_AVAILABLE
 @interface ORKPedometerRecorder : ORKRecorder
@@ -35,11 +35,18 @@
 #import "ORKRecorder_Internal.h"
 #import "ORKRecorder_Private.h"
 #import "ORKHelpers.h"
+#import "ORKRunningStatistics.h"
 
 
+static const NSTimeInterval ORKPedometerRecorderRateWindowDuration = 60;
+
 @interface ORKPedometerRecorder () {
     ORKDataLogger *_logger;
     BOOL _isRecording;
+    
+    // Running summary, updated as the data is logged; guarded by @synchronized (self)
+    CMPedometerData *_summaryData;
+    ORKSlidingWindowSum _stepWindow;
 }
 
 @property (nonatomic, strong) CMPedometer *pedometer;
@@ -63,6 +70,19 @@
 
 - (void)dealloc {
     [_logger finishCurrentLog];
+    ORKSlidingWindowSumDestroy(&_stepWindow);
+}
+
+- (void)updateSummaryWithData:(CMPedometerData *)pedometerData {
+    @synchronized (self) {
+        // Pedometer data is cumulative since the start of the recording
+        if (!_summaryData) {
+            ORKSlidingWindowSumSetStartTime(&_stepWindow, pedometerData.startDate.timeIntervalSinceReferenceDate);
+        }
+        NSInteger newSteps = pedometerData.numberOfSteps.integerValue - _summaryData.numberOfSteps.integerValue;
+        ORKSlidingWindowSumAdd(&_stepWindow, pedometerData.endDate.timeIntervalSinceReferenceDate, MAX(newSteps, 0));
+        _summaryData = pedometerData;
+    }
 }
 
 - (void)updateStatisticsWithData:(CMPedometerData *)pedometerData {
@@ -90,6 +110,11 @@
     _lastUpdateDate = nil;
     _totalNumberOfSteps = 0;
     _totalDistance = -1;
+    @synchronized (self) {
+        _summaryData = nil;
+        ORKSlidingWindowSumDestroy(&_stepWindow);
+        ORKSlidingWindowSumInitialize(&_stepWindow, ORKPedometerRecorderRateWindowDuration);
+    }
     
     if (!_logger) {
         NSError *error = nil;
@@ -116,6 +141,9 @@
         BOOL success = NO;
         if (pedometerData) {
             success = [_logger append:[pedometerData ork_JSONDictionary] error:&error];
+            if (success) {
+                [weakSelf updateSummaryWithData:pedometerData];
+            }
             dispatch_async(dispatch_get_main_queue(), ^{
                 ORKStrongTypeOf(self) strongSelf = weakSelf;
                 [strongSelf updateStatisticsWithData:pedometerData];
@@ -134,18 +162,32 @@
     return @"pedometer";
 }
 
+- (NSDictionary *)userInfo {
+    @synchronized (self) {
+        if (!_summaryData) {
+            return nil;
+        }
+        NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
+        NSInteger numberOfSteps = _summaryData.numberOfSteps.integerValue;
+        NSTimeInterval duration = [_summaryData.endDate timeIntervalSinceDate:_summaryData.startDate];
+        userInfo[@"numberOfSteps"] = @(numberOfSteps);
+        userInfo[@"distance"] = _summaryData.distance;
+        userInfo[@"floorsAscended"] = _summaryData.floorsAscended;
+        userInfo[@"floorsDescended"] = _summaryData.floorsDescended;
+        userInfo[@"duration"] = @(duration);
+        userInfo[@"meanStepsPerMinute"] = @((duration > 0) ? numberOfSteps * 60 / duration : 0);
+        userInfo[@"maximumStepsPerMinute"] = @(_stepWindow.maximumRate * 60);
+        return [userInfo copy];
+    }
+}
+
 - (void)stop {
     [self doStopRecording];
-    [_logger finishCurrentLog];
+    [self finishCurrentLogOfLogger:_logger];
     
-    NSError *error = nil;
-    __block NSURL *fileUrl = nil;
-    [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
-        fileUrl = logFileUrl;
-    }
-                     error:&error];
+    NSURL *fileUrl = _logger.lastFinishedLogFileURL;
     
-    [self reportFileResultWithFile:fileUrl error:error];
+    [self reportFileResultWithFile:fileUrl error:nil];
     
     [super stop];
 }
@@ -176,6 +176,19 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, readonly, nullable) NSDictionary *recorderSettings;
 
+/**
+ A Boolean value indicating whether the recorder extracts voice features while it records.
+ 
+ When the value of this property is `YES`, the microphone input is analyzed as it is captured, and
+ the recorder returns a second `ORKFileResult` object, after the audio file result, pointing to
+ a compact JSON file of per-frame features (level, zero-crossing rate, pitch, spectral centroid
+ and flatness) and their summary (including jitter and shimmer estimates). The summary is also
+ set as the `userInfo` of that result.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic) BOOL extractsVoiceFeatures;
+
 /**
  Returns an initialized audio recorder configuration using the specified settings.
  
@@ -225,6 +238,30 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, readonly) double frequency;
 
+/**
+ A Boolean value indicating whether the recorder extracts gait features while it records.
+ 
+ When the value of this property is `YES`, each device motion sample is analyzed as it is
+ received, in constant memory, and the recorder returns an `ORKGaitResult` object with the
+ step, cadence, stride variability, symmetry, and turn features, after its `ORKFileResult` object.
+ The identifier of the gait result is the recorder identifier followed by `_gait`.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic) BOOL extractsGaitFeatures;
+
+/**
+ A Boolean value indicating whether the recorder estimates the tremor spectrum while it records.
+ 
+ When the value of this property is `YES`, the user acceleration and rotation rate are analyzed
+ as they are received, and the recorder returns an `ORKTremorSpectrumResult` object with the
+ power in the 3-12 Hz tremor band and its dominant frequency, after its `ORKFileResult` object.
+ The identifier of the tremor spectrum result is the recorder identifier followed by `_tremor`.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic) BOOL extractsTremorSpectrum;
+
 /**
  Returns an initialized device motion recorder configuration using the specified frequency.
  
@@ -311,11 +348,66 @@ ORK_CLASS_AVAILABLE
  of an `ORKActiveStep` object, include that step in a task, and present it with
  a task view controller.
  
- No additional parameters besides the identifier are required.
+ No additional parameters besides the identifier are required. Long walks produce dense,
+ redundant locations; you can reduce them with the filtering properties below, which are applied
+ as the locations are received. The filtered locations are recorded instead of the raw ones when
+ `outputMode` is `ORKLocationOutputModeFiltered`.
  */
 ORK_CLASS_AVAILABLE
 @interface ORKLocationRecorderConfiguration : ORKRecorderConfiguration
 
+/**
+ The minimum distance, in meters, between two filtered locations.
+ 
+ A location closer than this to the previous filtered location is dropped.
+ The default value of this property is 0.
+ */
+@property (nonatomic) double minimumDistance;
+
+/**
+ The minimum time interval between two filtered locations.
+ 
+ A location received sooner than this after the previous filtered location is dropped.
+ The default value of this property is 0.
+ */
+@property (nonatomic) NSTimeInterval minimumTimeInterval;
+
+/**
+ A Boolean value indicating whether locations are smoothed with a Kalman filter, which weighs
+ each location by its horizontal accuracy, before the distance and time thresholds are applied.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic) BOOL smoothsLocations;
+
+/**
+ The tolerance, in meters, of the Douglas-Peucker simplification of the filtered locations.
+ 
+ Locations are simplified in windows of 32 locations, so that no dropped location is further
+ than the tolerance from the simplified track. The default value of this property is 0, which
+ disables simplification.
+ */
+@property (nonatomic) double simplificationTolerance;
+
+/**
+ Whether the recorder records every location, or only the filtered locations.
+ 
+ The default value of this property is `ORKLocationOutputModeRaw`.
+ */
+@property (nonatomic) ORKLocationOutputMode outputMode;
+
+/**
+ A Boolean value indicating whether the recorder summarizes the movement while it records.
+ 
+ When the value of this property is `YES`, the recorder returns an `ORKLocationSummaryResult`
+ object with the distance covered and the speed, computed on the filtered locations, after its
+ `ORKFileResult` object. The identifier of the summary result is the recorder identifier
+ followed by `_summary`.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic) BOOL summarizesMovement;
+
 /**
  Returns an initialized location recorder configuration.
  
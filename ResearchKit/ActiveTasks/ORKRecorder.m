@@ -35,6 +35,7 @@
 #import "ORKRecorder_Private.h"
 #import "ORKHelpers.h"
 #import "ORKDataLogger.h"
+#import "ORKSessionClock.h"
 
 
 @implementation ORKRecorderConfiguration
@@ -100,6 +101,9 @@
 @implementation ORKRecorder {
     UIBackgroundTaskIdentifier _backgroundTask;
     NSUUID *_recorderUUID;
+    __weak ORKDataLogger *_dataLogger;
+    // The first failure to finish a log since the last result was reported; guarded by @synchronized (self)
+    NSError *_logFinishError;
 }
 
 + (instancetype)new {
@@ -129,6 +133,13 @@
 - (void)viewController:(UIViewController *)viewController willStartStepWithView:(UIView *)view {
 }
 
+- (ORKSessionClock *)sessionClock {
+    if (!_sessionClock) {
+        _sessionClock = [ORKSessionClock new];
+    }
+    return _sessionClock;
+}
+
 - (void)start {
     if (self.continuesInBackground) {
         UIApplication *app = [UIApplication sharedApplication];
@@ -141,7 +152,9 @@
             [app endBackgroundTask:oldTask];
         }
     }
-    self.startDate = [NSDate date];
+    ORKSessionClock *clock = self.sessionClock;
+    _startUptime = [clock currentUptime];
+    self.startDate = [clock dateForUptime:_startUptime];
 }
 
 - (void)stop {
@@ -149,6 +162,31 @@
     [self reset];
 }
 
+- (void)doStopRecording {
+}
+
+- (void)prepareToStopInGroup:(dispatch_group_t)group {
+    [self doStopRecording];
+    
+    ORKDataLogger *logger = _dataLogger;
+    if (logger) {
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            [self finishCurrentLogOfLogger:logger];
+        });
+    }
+}
+
+- (void)finishCurrentLogOfLogger:(ORKDataLogger *)logger {
+    NSError *error = nil;
+    if (![logger finishCurrentLogWithError:&error]) {
+        @synchronized (self) {
+            if (!_logFinishError) {
+                _logFinishError = error;
+            }
+        }
+    }
+}
+
 - (void)finishRecordingWithError:(NSError *)error {
     // NOTE. This method may be called multiple times (once when someone tries
     // to finish, and another time with -stop is actually called.
@@ -206,14 +244,34 @@
     NSString *logName = [identifier stringByReplacingOccurrencesOfString:@"-" withString:@"_"];
     
     // Class B data protection for temporary file during active task logging.
-    ORKDataLogger *logger = [[ORKDataLogger alloc] initWithDirectory:workingDir logName:logName formatter:[ORKJSONLogFormatter new] delegate:nil];
+    ORKJSONLogFormatter *formatter = [ORKJSONLogFormatter new];
+    formatter.header = [self logHeader];
+    ORKDataLogger *logger = [[ORKDataLogger alloc] initWithDirectory:workingDir logName:logName formatter:formatter delegate:nil];
     
     logger.fileProtectionMode = ORKFileProtectionCompleteUnlessOpen;
+    _dataLogger = logger;
     return logger;
 }
 
+/*
+ Timing metadata written at the head of each JSON log, so samples timestamped in
+ system uptime (CoreMotion, UITouch) can be placed on the step's session timeline:
+ sessionTime = timestamp - sessionReferenceUptime.
+ */
+- (NSDictionary *)logHeader {
+    ORKSessionClock *clock = self.sessionClock;
+    // Loggers may be created just before -start; fall back to the current time.
+    NSTimeInterval startUptime = (_startUptime > 0) ? _startUptime : [clock currentUptime];
+    return @{ @"recorderType": [self recorderType],
+              @"sessionReferenceDate": ORKStringFromDateISO8601(clock.referenceDate),
+              @"sessionReferenceUptime": [NSDecimalNumber numberWithDouble:clock.referenceUptime],
+              @"recorderStartUptime": [NSDecimalNumber numberWithDouble:startUptime],
+              @"recorderStartOffset": [NSDecimalNumber numberWithDouble:[clock timeIntervalForUptime:startUptime]] };
+}
+
 - (void)reset {
     _recorderUUID = [NSUUID UUID];
+    _startUptime = 0;
 }
 
 - (NSString *)mimeType {
@@ -233,6 +291,12 @@
 }
 
 - (void)reportFileResultWithFile:(NSURL *)fileUrl error:(NSError *)error {
+    @synchronized (self) {
+        if (!error) {
+            error = _logFinishError;
+        }
+        _logFinishError = nil;
+    }
     
     id<ORKRecorderDelegate> localDelegate = self.delegate;
     if (fileUrl && !error) {
@@ -35,6 +35,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class ORKDataLogger;
+@class ORKSessionClock;
 
 @interface ORKRecorder ()
 
@@ -46,6 +47,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, copy, nullable) NSDate *startDate;
 
+/**
+ The clock shared by all the recorders of a step. The step view controller assigns
+ it before starting the recorders; a recorder started without one creates its own.
+ */
+@property (nonatomic, strong, null_resettable) ORKSessionClock *sessionClock;
+
+/**
+ The session clock uptime at which the recorder started, or 0 if it has not started.
+ */
+@property (nonatomic, readonly) NSTimeInterval startUptime;
+
 - (NSString *)recorderType;
 
 - (nullable ORKDataLogger *)makeJSONDataLoggerWithError:(NSError * _Nullable *)error NS_REQUIRES_SUPER;
@@ -54,6 +66,22 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)reportFileResultWithFile:(NSURL *)fileUrl error:(nullable NSError *)error;
 
+// Stops capturing data without reporting a result. Subclasses override; the default does nothing.
+- (void)doStopRecording;
+
+/*
+ Stops capturing data and closes the current log of the recorder's data logger on a background
+ queue tracked by `group`. A step calls this on all of its recorders and waits for the group
+ before calling -stop on each, so their log files are finished concurrently.
+ */
+- (void)prepareToStopInGroup:(dispatch_group_t)group;
+
+/*
+ Closes the current log of `logger`. If the log cannot be finished, the error is reported to the
+ delegate by the next -reportFileResultWithFile:error: that has no error of its own.
+ */
+- (void)finishCurrentLogOfLogger:(ORKDataLogger *)logger;
+
 - (nullable NSURL *)recordingDirectoryURL;
 
 @end
@@ -0,0 +1,129 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Running count, sum, extrema, mean and variance of a stream of values, updated in constant
+ time and memory as each value is added (Welford's algorithm).
+ 
+ Step view controllers that collect samples keep one of these per measured quantity so that
+ their result summaries do not have to walk the samples again.
+ */
+typedef struct ORKRunningStatistics {
+    NSUInteger count;
+    double sum;
+    double mean;
+    double sumOfSquaredDeviations;
+    double minimum;
+    double maximum;
+} ORKRunningStatistics;
+
+/**
+ Returns empty statistics.
+ */
+ORK_EXTERN ORKRunningStatistics ORKRunningStatisticsMake(void);
+
+/**
+ Adds one value.
+ */
+ORK_EXTERN void ORKRunningStatisticsAdd(ORKRunningStatistics *statistics, double value);
+
+/**
+ The unbiased sample variance, or 0 for fewer than two values.
+ */
+ORK_EXTERN double ORKRunningStatisticsVariance(const ORKRunningStatistics *statistics);
+
+/**
+ The sample standard deviation, or 0 for fewer than two values.
+ */
+ORK_EXTERN double ORKRunningStatisticsStandardDeviation(const ORKRunningStatistics *statistics);
+
+/**
+ The standard deviation relative to the mean, or 0 when it is undefined.
+ */
+ORK_EXTERN double ORKRunningStatisticsCoefficientOfVariation(const ORKRunningStatistics *statistics);
+
+/**
+ One value of an `ORKSlidingWindowSum`.
+ */
+typedef struct ORKSlidingWindowEntry {
+    NSTimeInterval time;
+    double value;
+} ORKSlidingWindowEntry;
+
+/**
+ The sum of the values added within a sliding time window, and the largest such sum so far,
+ for example the number of steps in the last minute and the most steps in any minute.
+ 
+ Values are added in time order to a ring buffer that holds one window of values. Each value is
+ taken to have accumulated since the previous one, so when a start time is set the window also
+ tracks the largest rate, the sum divided by the time it actually covers. Until a full window has
+ elapsed since the start time, that is the elapsed time rather than `windowDuration`.
+ */
+typedef struct ORKSlidingWindowSum {
+    NSTimeInterval windowDuration;
+    NSTimeInterval startTime;
+    ORKSlidingWindowEntry *entries;
+    NSUInteger capacity;
+    NSUInteger head;
+    NSUInteger count;
+    double sum;
+    double maximumSum;
+    double maximumRate;
+} ORKSlidingWindowSum;
+
+/**
+ Resets the window. Call `ORKSlidingWindowSumDestroy` to release its storage.
+ */
+ORK_EXTERN void ORKSlidingWindowSumInitialize(ORKSlidingWindowSum *window, NSTimeInterval windowDuration);
+
+/**
+ Releases the storage of the window.
+ */
+ORK_EXTERN void ORKSlidingWindowSumDestroy(ORKSlidingWindowSum *window);
+
+/**
+ Sets the time from which the first value accumulated. Rates are not tracked until it is set.
+ */
+ORK_EXTERN void ORKSlidingWindowSumSetStartTime(ORKSlidingWindowSum *window, NSTimeInterval startTime);
+
+/**
+ Adds a value at a time no earlier than the previous value, and drops the values that are
+ `windowDuration` or more older.
+ */
+ORK_EXTERN void ORKSlidingWindowSumAdd(ORKSlidingWindowSum *window, NSTimeInterval time, double value);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,128 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKRunningStatistics.h"
+
+
+ORKRunningStatistics ORKRunningStatisticsMake(void) {
+    ORKRunningStatistics statistics = {0};
+    return statistics;
+}
+
+void ORKRunningStatisticsAdd(ORKRunningStatistics *statistics, double value) {
+    statistics->count++;
+    statistics->sum += value;
+    if (statistics->count == 1) {
+        statistics->minimum = value;
+        statistics->maximum = value;
+    } else {
+        statistics->minimum = MIN(statistics->minimum, value);
+        statistics->maximum = MAX(statistics->maximum, value);
+    }
+    double delta = value - statistics->mean;
+    statistics->mean += delta / statistics->count;
+    statistics->sumOfSquaredDeviations += delta * (value - statistics->mean);
+}
+
+double ORKRunningStatisticsVariance(const ORKRunningStatistics *statistics) {
+    if (statistics->count < 2) {
+        return 0;
+    }
+    return statistics->sumOfSquaredDeviations / (statistics->count - 1);
+}
+
+double ORKRunningStatisticsStandardDeviation(const ORKRunningStatistics *statistics) {
+    return sqrt(ORKRunningStatisticsVariance(statistics));
+}
+
+double ORKRunningStatisticsCoefficientOfVariation(const ORKRunningStatistics *statistics) {
+    if (statistics->count < 2 || statistics->mean <= 0) {
+        return 0;
+    }
+    return ORKRunningStatisticsStandardDeviation(statistics) / statistics->mean;
+}
+
+void ORKSlidingWindowSumInitialize(ORKSlidingWindowSum *window, NSTimeInterval windowDuration) {
+    memset(window, 0, sizeof(ORKSlidingWindowSum));
+    window->windowDuration = windowDuration;
+    window->startTime = NAN;
+}
+
+void ORKSlidingWindowSumSetStartTime(ORKSlidingWindowSum *window, NSTimeInterval startTime) {
+    window->startTime = startTime;
+}
+
+void ORKSlidingWindowSumDestroy(ORKSlidingWindowSum *window) {
+    free(window->entries);
+    ORKSlidingWindowSumInitialize(window, window->windowDuration);
+}
+
+static BOOL ORKSlidingWindowSumGrow(ORKSlidingWindowSum *window) {
+    NSUInteger capacity = MAX(window->capacity * 2, 64);
+    ORKSlidingWindowEntry *entries = malloc(capacity * sizeof(ORKSlidingWindowEntry));
+    if (entries == NULL) {
+        return NO;
+    }
+    // Unwrap the ring, oldest entry first
+    for (NSUInteger i = 0; i < window->count; i++) {
+        entries[i] = window->entries[(window->head + i) % window->capacity];
+    }
+    free(window->entries);
+    window->entries = entries;
+    window->capacity = capacity;
+    window->head = 0;
+    return YES;
+}
+
+void ORKSlidingWindowSumAdd(ORKSlidingWindowSum *window, NSTimeInterval time, double value) {
+    while (window->count > 0) {
+        ORKSlidingWindowEntry *oldest = &window->entries[window->head];
+        if (time - oldest->time < window->windowDuration) {
+            break;
+        }
+        window->sum -= oldest->value;
+        window->head = (window->head + 1) % window->capacity;
+        window->count--;
+    }
+    if (window->count == window->capacity && !ORKSlidingWindowSumGrow(window)) {
+        return;
+    }
+    
+    window->entries[(window->head + window->count) % window->capacity] = (ORKSlidingWindowEntry){ .time = time, .value = value };
+    window->count++;
+    window->sum += value;
+    window->maximumSum = MAX(window->maximumSum, window->sum);
+    
+    NSTimeInterval coveredDuration = MIN(window->windowDuration, time - window->startTime);
+    if (coveredDuration > 0) {
+        window->maximumRate = MAX(window->maximumRate, window->sum / coveredDuration);
+    }
+}
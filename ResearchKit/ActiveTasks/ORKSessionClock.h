@@ -0,0 +1,81 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A monotonic clock shared by all the recorders of an active step.
+ 
+ The clock captures a single reference point on creation, pairing the wall
+ clock date with the system uptime (the base used by `mach_absolute_time`,
+ `NSProcessInfo.systemUptime`, CoreMotion sample timestamps and
+ `UITouch.timestamp`). Uptime readings from any of those sources can then be
+ expressed relative to the same origin, so streams from different sensors can
+ be aligned without comparing wall clock dates.
+ */
+@interface ORKSessionClock : NSObject
+
+/**
+ The wall clock date at the reference point.
+ */
+@property (nonatomic, copy, readonly) NSDate *referenceDate;
+
+/**
+ The system uptime, in seconds, at the reference point.
+ */
+@property (nonatomic, readonly) NSTimeInterval referenceUptime;
+
+/**
+ The current system uptime, in seconds, read from `mach_absolute_time`.
+ */
+- (NSTimeInterval)currentUptime;
+
+/**
+ Seconds elapsed since the reference point.
+ */
+- (NSTimeInterval)currentTimeInterval;
+
+/**
+ Converts an uptime reading into seconds since the reference point.
+ */
+- (NSTimeInterval)timeIntervalForUptime:(NSTimeInterval)uptime;
+
+/**
+ Converts an uptime reading into a wall clock date anchored at the reference point.
+ */
+- (NSDate *)dateForUptime:(NSTimeInterval)uptime;
+
+@end
+
+NS_ASSUME_NONNULL_END
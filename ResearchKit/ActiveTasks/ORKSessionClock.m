@@ -0,0 +1,81 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSessionClock.h"
+#include <mach/mach_time.h>
+
+
+static NSTimeInterval ORKUptimeFromMachTime(uint64_t machTime) {
+    static mach_timebase_info_data_t timebaseInfo;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        (void)mach_timebase_info(&timebaseInfo);
+    });
+    // Split the conversion to avoid overflowing the multiplication on long uptimes.
+    uint64_t seconds = machTime / NSEC_PER_SEC;
+    uint64_t remainder = machTime % NSEC_PER_SEC;
+    double scale = (double)timebaseInfo.numer / (double)timebaseInfo.denom;
+    return (seconds * scale) + (remainder * scale) / NSEC_PER_SEC;
+}
+
+@implementation ORKSessionClock
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        // Bracket the wall clock read with two uptime reads and take the midpoint,
+        // so the pairing error is bounded by half the (sub-microsecond) bracket.
+        uint64_t before = mach_absolute_time();
+        NSDate *date = [NSDate date];
+        uint64_t after = mach_absolute_time();
+        _referenceDate = [date copy];
+        _referenceUptime = ORKUptimeFromMachTime(before + (after - before) / 2);
+    }
+    return self;
+}
+
+- (NSTimeInterval)currentUptime {
+    return ORKUptimeFromMachTime(mach_absolute_time());
+}
+
+- (NSTimeInterval)currentTimeInterval {
+    return [self timeIntervalForUptime:[self currentUptime]];
+}
+
+- (NSTimeInterval)timeIntervalForUptime:(NSTimeInterval)uptime {
+    return uptime - _referenceUptime;
+}
+
+- (NSDate *)dateForUptime:(NSTimeInterval)uptime {
+    return [_referenceDate dateByAddingTimeInterval:[self timeIntervalForUptime:uptime]];
+}
+
+@end
@@ -0,0 +1,133 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+#import <ResearchKit/ORKDefines.h>
+#import "ORKRunningStatistics.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKTappingSample;
+
+/**
+ One tap, as stored by `ORKTappingAnalyzer`. The timestamp is relative to the first tap, and
+ the location is in the step view's coordinates.
+ */
+typedef struct ORKTappingPackedSample {
+    double timestamp;
+    float x;
+    float y;
+    uint8_t buttonIdentifier;
+} ORKTappingPackedSample;
+
+/**
+ `ORKTappingAnalyzer` stores the taps of a tapping interval test in a contiguous array of
+ packed samples, and scores them online as they are added.
+ 
+ Only taps on a button are scored; taps beside the buttons are stored but otherwise ignored.
+ The interval between two consecutive button taps feeds running interval statistics, and a
+ least squares fit of the interval against time, whose slope shows fatigue (a positive slope
+ means tapping slows down). A pair of consecutive button taps on different buttons counts as
+ an alternation.
+ */
+typedef struct ORKTappingAnalyzer {
+    ORKTappingPackedSample *samples;
+    NSUInteger count;
+    NSUInteger capacity;
+    
+    NSUInteger buttonTapCount;
+    double previousButtonTapTimestamp;
+    uint8_t previousButtonIdentifier;
+    NSUInteger alternationCount;
+    
+    // Tap intervals, and the sums for their regression against time
+    ORKRunningStatistics intervals;
+    double sumOfTimes;
+    double sumOfSquaredTimes;
+    double sumOfTimeIntervalProducts;
+} ORKTappingAnalyzer;
+
+/**
+ The scores of the taps added so far.
+ */
+typedef struct ORKTappingSummary {
+    NSUInteger numberOfTaps;
+    NSUInteger numberOfButtonTaps;
+    NSTimeInterval meanTapInterval;
+    double tapIntervalVariability;      // Coefficient of variation of the tap interval
+    double alternationAccuracy;         // Fraction of consecutive button taps that alternate
+    double fatigueSlope;                // Change of the tap interval, in seconds per second
+} ORKTappingSummary;
+
+/**
+ Resets the analyzer. Call `ORKTappingAnalyzerDestroy` to release its storage.
+ */
+ORK_EXTERN void ORKTappingAnalyzerInitialize(ORKTappingAnalyzer *analyzer);
+
+/**
+ Releases the storage of the analyzer.
+ */
+ORK_EXTERN void ORKTappingAnalyzerDestroy(ORKTappingAnalyzer *analyzer);
+
+/**
+ Adds one tap. `buttonIdentifier` is an `ORKTappingButtonIdentifier`.
+ */
+ORK_EXTERN void ORKTappingAnalyzerAddSample(ORKTappingAnalyzer *analyzer,
+                                            NSTimeInterval timestamp,
+                                            double x,
+                                            double y,
+                                            NSInteger buttonIdentifier);
+
+/**
+ Returns the scores of the taps added so far.
+ */
+ORK_EXTERN ORKTappingSummary ORKTappingAnalyzerSummary(const ORKTappingAnalyzer *analyzer);
+
+/**
+ Returns a new `ORKTappingSample` object for each tap added so far.
+ */
+ORK_EXTERN NSArray<ORKTappingSample *> *ORKTappingAnalyzerCopySampleObjects(const ORKTappingAnalyzer *analyzer);
+
+/**
+ Serializes tapping samples in a compact binary format: a one byte version, followed by
+ 13 bytes per sample (little endian 32-bit float timestamp, x and y, and one byte for the
+ button identifier).
+ */
+ORK_EXTERN NSData *ORKTappingPackedSampleDataFromSamples(NSArray<ORKTappingSample *> *samples);
+
+/**
+ Deserializes tapping samples from the format of `ORKTappingPackedSampleDataFromSamples`.
+ Returns `nil` if the data is not in that format.
+ */
+ORK_EXTERN NSArray<ORKTappingSample *> * _Nullable ORKTappingSamplesFromPackedSampleData(NSData *data);
+
+NS_ASSUME_NONNULL_END
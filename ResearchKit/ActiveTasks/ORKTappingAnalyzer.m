@@ -0,0 +1,154 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTappingAnalyzer.h"
+#import "ORKResult.h"
+
+
+static const uint8_t ORKTappingPackedSampleDataVersion = 1;
+static const NSUInteger ORKTappingPackedSampleRecordLength = 3 * sizeof(NSSwappedFloat) + sizeof(uint8_t);
+static const NSUInteger ORKTappingAnalyzerInitialCapacity = 256;
+
+void ORKTappingAnalyzerInitialize(ORKTappingAnalyzer *analyzer) {
+    memset(analyzer, 0, sizeof(ORKTappingAnalyzer));
+}
+
+void ORKTappingAnalyzerDestroy(ORKTappingAnalyzer *analyzer) {
+    free(analyzer->samples);
+    ORKTappingAnalyzerInitialize(analyzer);
+}
+
+void ORKTappingAnalyzerAddSample(ORKTappingAnalyzer *analyzer, NSTimeInterval timestamp, double x, double y, NSInteger buttonIdentifier) {
+    if (analyzer->count == analyzer->capacity) {
+        NSUInteger capacity = MAX(ORKTappingAnalyzerInitialCapacity, analyzer->capacity * 2);
+        ORKTappingPackedSample *samples = realloc(analyzer->samples, capacity * sizeof(ORKTappingPackedSample));
+        if (samples == NULL) {
+            return;
+        }
+        analyzer->samples = samples;
+        analyzer->capacity = capacity;
+    }
+    analyzer->samples[analyzer->count++] = (ORKTappingPackedSample){
+        .timestamp = timestamp,
+        .x = x,
+        .y = y,
+        .buttonIdentifier = (uint8_t)buttonIdentifier
+    };
+    
+    if (buttonIdentifier == ORKTappingButtonIdentifierNone) {
+        return;
+    }
+    if (analyzer->buttonTapCount > 0) {
+        double interval = timestamp - analyzer->previousButtonTapTimestamp;
+        ORKRunningStatisticsAdd(&analyzer->intervals, interval);
+        analyzer->sumOfTimes += timestamp;
+        analyzer->sumOfSquaredTimes += timestamp * timestamp;
+        analyzer->sumOfTimeIntervalProducts += timestamp * interval;
+        if (buttonIdentifier != analyzer->previousButtonIdentifier) {
+            analyzer->alternationCount++;
+        }
+    }
+    analyzer->buttonTapCount++;
+    analyzer->previousButtonTapTimestamp = timestamp;
+    analyzer->previousButtonIdentifier = (uint8_t)buttonIdentifier;
+}
+
+ORKTappingSummary ORKTappingAnalyzerSummary(const ORKTappingAnalyzer *analyzer) {
+    ORKTappingSummary summary = {0};
+    summary.numberOfTaps = analyzer->count;
+    summary.numberOfButtonTaps = analyzer->buttonTapCount;
+    
+    const ORKRunningStatistics *intervals = &analyzer->intervals;
+    if (intervals->count == 0) {
+        return summary;
+    }
+    summary.meanTapInterval = intervals->mean;
+    summary.tapIntervalVariability = ORKRunningStatisticsCoefficientOfVariation(intervals);
+    summary.alternationAccuracy = (double)analyzer->alternationCount / intervals->count;
+    
+    double n = intervals->count;
+    double denominator = n * analyzer->sumOfSquaredTimes - analyzer->sumOfTimes * analyzer->sumOfTimes;
+    if (intervals->count > 1 && denominator > 0) {
+        summary.fatigueSlope = (n * analyzer->sumOfTimeIntervalProducts - analyzer->sumOfTimes * intervals->sum) / denominator;
+    }
+    return summary;
+}
+
+NSArray<ORKTappingSample *> *ORKTappingAnalyzerCopySampleObjects(const ORKTappingAnalyzer *analyzer) {
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:analyzer->count];
+    for (NSUInteger i = 0; i < analyzer->count; i++) {
+        const ORKTappingPackedSample *packedSample = &analyzer->samples[i];
+        ORKTappingSample *sample = [[ORKTappingSample alloc] init];
+        sample.timestamp = packedSample->timestamp;
+        sample.location = CGPointMake(packedSample->x, packedSample->y);
+        sample.buttonIdentifier = packedSample->buttonIdentifier;
+        [samples addObject:sample];
+    }
+    return [samples copy];
+}
+
+NSData *ORKTappingPackedSampleDataFromSamples(NSArray<ORKTappingSample *> *samples) {
+    NSMutableData *data = [NSMutableData dataWithCapacity:1 + samples.count * ORKTappingPackedSampleRecordLength];
+    [data appendBytes:&ORKTappingPackedSampleDataVersion length:sizeof(uint8_t)];
+    for (ORKTappingSample *sample in samples) {
+        NSSwappedFloat values[3] = {
+            NSSwapHostFloatToLittle(sample.timestamp),
+            NSSwapHostFloatToLittle(sample.location.x),
+            NSSwapHostFloatToLittle(sample.location.y)
+        };
+        uint8_t buttonIdentifier = (uint8_t)sample.buttonIdentifier;
+        [data appendBytes:values length:sizeof(values)];
+        [data appendBytes:&buttonIdentifier length:sizeof(uint8_t)];
+    }
+    return [data copy];
+}
+
+NSArray<ORKTappingSample *> *ORKTappingSamplesFromPackedSampleData(NSData *data) {
+    const uint8_t *bytes = data.bytes;
+    if (data.length < 1 || bytes[0] != ORKTappingPackedSampleDataVersion ||
+        (data.length - 1) % ORKTappingPackedSampleRecordLength != 0) {
+        return nil;
+    }
+    
+    NSUInteger count = (data.length - 1) / ORKTappingPackedSampleRecordLength;
+    NSMutableArray *samples = [NSMutableArray arrayWithCapacity:count];
+    const uint8_t *record = bytes + 1;
+    for (NSUInteger i = 0; i < count; i++, record += ORKTappingPackedSampleRecordLength) {
+        NSSwappedFloat values[3];
+        memcpy(values, record, sizeof(values));
+        ORKTappingSample *sample = [[ORKTappingSample alloc] init];
+        sample.timestamp = NSSwapLittleFloatToHost(values[0]);
+        sample.location = CGPointMake(NSSwapLittleFloatToHost(values[1]), NSSwapLittleFloatToHost(values[2]));
+        sample.buttonIdentifier = record[sizeof(values)];
+        [samples addObject:sample];
+    }
+    return [samples copy];
+}
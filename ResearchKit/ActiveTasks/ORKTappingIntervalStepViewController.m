@@ -38,20 +38,25 @@
 #import "ORKResult.h"
 #import "ORKHelpers.h"
 #import "ORKActiveStepView.h"
+#import "ORKTappingAnalyzer.h"
 
 
 @interface ORKTappingIntervalStepViewController () <UIGestureRecognizerDelegate>
 
-@property (nonatomic, strong) NSMutableArray *samples;
-
 @end
 
 
 @implementation ORKTappingIntervalStepViewController {
     ORKTappingContentView *_tappingContentView;
     NSTimeInterval _tappingStart;
+    BOOL _tapping;
     BOOL _expired;
     
+    // Packed samples and online scores of the taps
+    ORKTappingAnalyzer _analyzer;
+    // Sample objects for the result, made from the analyzer when first needed after a tap
+    NSArray<ORKTappingSample *> *_sampleObjects;
+    
     CGRect _buttonRect1;
     CGRect _buttonRect2;
     CGSize _viewSize;
@@ -69,6 +74,10 @@
     return self;
 }
 
+- (void)dealloc {
+    ORKTappingAnalyzerDestroy(&_analyzer);
+}
+
 - (void)initializeInternalButtonItems {
     [super initializeInternalButtonItems];
     
@@ -125,7 +134,17 @@
     tappingResult.buttonRect2 = _buttonRect2;
     tappingResult.stepViewSize = _viewSize;
     
-    tappingResult.samples = _samples;
+    if (_tapping) {
+        ORKTappingSummary summary = ORKTappingAnalyzerSummary(&_analyzer);
+        if (!_sampleObjects) {
+            _sampleObjects = ORKTappingAnalyzerCopySampleObjects(&_analyzer);
+        }
+        tappingResult.samples = _sampleObjects;
+        tappingResult.meanTapInterval = summary.meanTapInterval;
+        tappingResult.tapIntervalVariability = summary.tapIntervalVariability;
+        tappingResult.alternationAccuracy = summary.alternationAccuracy;
+        tappingResult.fatigueSlope = summary.fatigueSlope;
+    }
     
     [results addObject:tappingResult];
     sResult.results = [results copy];
@@ -134,7 +153,7 @@
 }
 
 - (void)receiveTouch:(UITouch *)touch onButton:(ORKTappingButtonIdentifier)buttonIdentifier {
-    if (_expired || self.samples == nil) {
+    if (_expired || !_tapping) {
         return;
     }
     
@@ -150,12 +169,8 @@
     // Add new sample
     mediaTime = mediaTime-_tappingStart;
     
-    ORKTappingSample *sample = [[ORKTappingSample alloc] init];
-    sample.buttonIdentifier = buttonIdentifier;
-    sample.location = location;
-    sample.timestamp = mediaTime;
-
-    [self.samples addObject:sample];
+    ORKTappingAnalyzerAddSample(&_analyzer, mediaTime, location.x, location.y, buttonIdentifier);
+    _sampleObjects = nil;
     
     if (buttonIdentifier == ORKTappingButtonIdentifierLeft || buttonIdentifier == ORKTappingButtonIdentifierRight) {
         _hitButtonCount++;
@@ -188,9 +203,11 @@
 
 - (IBAction)buttonPressed:(id)button forEvent:(UIEvent *)event {
     
-    if (self.samples == nil) {
+    if (!_tapping) {
         // Start timer on first touch event on button
-        _samples = [NSMutableArray array];
+        _tapping = YES;
+        ORKTappingAnalyzerDestroy(&_analyzer);
+        _sampleObjects = nil;
         _hitButtonCount = 0;
         [self start];
     }
@@ -38,6 +38,22 @@ ORK_CLASS_AVAILABLE
 
 @property (nonatomic, assign) NSTimeInterval toneDuration;
 
+/**
+ The kind of stimulus presented at each test frequency.
+ 
+ The default value is `ORKAudioStimulusTypePureTone`.
+ */
+@property (nonatomic, assign) ORKAudioStimulusType stimulusType;
+
+/**
+ An optional calibration table mapping test frequencies in hertz to the peak amplitude,
+ from 0 to 1, of the stimulus at the end of its fade-in.
+ 
+ See `calibrationTable` on `ORKAudioGenerator` for how the table is interpolated.
+ The default value is `nil`, which uses a fixed amplitude for all frequencies.
+ */
+@property (nonatomic, copy, nullable) NSDictionary<NSNumber *, NSNumber *> *calibrationTable;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -55,6 +55,8 @@
 - (instancetype)copyWithZone:(NSZone *)zone {
     ORKToneAudiometryStep *step = [super copyWithZone:zone];
     step.toneDuration = self.toneDuration;
+    step.stimulusType = self.stimulusType;
+    step.calibrationTable = self.calibrationTable;
     return step;
 }
 
@@ -62,6 +64,8 @@
     self = [super initWithCoder:aDecoder];
     if (self) {
         ORK_DECODE_DOUBLE(aDecoder, toneDuration);
+        ORK_DECODE_ENUM(aDecoder, stimulusType);
+        ORK_DECODE_OBJ_MUTABLE_DICTIONARY(aDecoder, calibrationTable, NSNumber, NSNumber);
     }
     return self;
 }
@@ -69,6 +73,8 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder {
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_DOUBLE(aCoder, toneDuration);
+    ORK_ENCODE_ENUM(aCoder, stimulusType);
+    ORK_ENCODE_OBJ(aCoder, calibrationTable);
 }
 
 + (BOOL)supportsSecureCoding {
@@ -80,7 +86,9 @@
 
     __typeof(self) castObject = object;
     return (isParentSame &&
-            (self.toneDuration == castObject.toneDuration)) ;
+            (self.toneDuration == castObject.toneDuration) &&
+            (self.stimulusType == castObject.stimulusType) &&
+            ORKEqualObjects(self.calibrationTable, castObject.calibrationTable)) ;
 }
 
 @end
@@ -90,6 +90,8 @@
     self.currentTestIndex = 0;
     self.testingFrequencies = @[@250, @500, @1000, @2000, @4000, @8000];
     self.audioGenerator = [ORKAudioGenerator new];
+    self.audioGenerator.calibrationTable = self.toneAudiometryStep.calibrationTable;
+    [self.audioGenerator prepareStimulus:self.toneAudiometryStep.stimulusType atFrequencies:self.testingFrequencies];
 }
 
 - (void)viewDidAppear:(BOOL)animated {
@@ -207,9 +209,10 @@
                                         caption:(channel == ORKAudioChannelLeft) ? [NSString stringWithFormat:ORKLocalizedString(@"TONE_LABEL_%@_LEFT", nil), ORKLocalizedStringFromNumber(frequency)] : [NSString stringWithFormat:ORKLocalizedString(@"TONE_LABEL_%@_RIGHT", nil), ORKLocalizedStringFromNumber(frequency)]
                                        animated:YES];
 
-    [self.audioGenerator playSoundAtFrequency:frequency.doubleValue
-                                    onChannel:channel
-                               fadeInDuration:SoundDuration];
+    [self.audioGenerator playStimulus:self.toneAudiometryStep.stimulusType
+                          atFrequency:frequency.doubleValue
+                            onChannel:channel
+                       fadeInDuration:SoundDuration];
 
     ORKWeakTypeOf(self)weakSelf = self;
     dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SoundDuration * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
@@ -0,0 +1,168 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <ResearchKit/ORKDefines.h>
+#include <stdint.h>
+
+
+/**
+ Number of frames rendered in parallel by the tone synthesizer kernel.
+ */
+#define ORKToneSynthesizerLaneCount 4
+
+/**
+ Number of cascaded band-pass sections used for narrow band noise.
+ */
+#define ORKToneSynthesizerNoiseSectionCount 2
+
+typedef enum ORKToneSynthesizerSource {
+    ORKToneSynthesizerSourceOscillator = 0,
+    ORKToneSynthesizerSourceWaveform,
+    ORKToneSynthesizerSourceNoise
+} ORKToneSynthesizerSource;
+
+/**
+ `ORKToneSynthesizer` is the state of a block-based audio stimulus synthesizer.
+
+ The kernel is plain C and does not touch any Objective-C object, so it is safe to call
+ from a real-time audio render callback, and it can be exercised offline by rendering
+ into an ordinary buffer. Rendering never allocates: stimuli that are expensive to compute
+ per frame (pulsed and warble tones) are precomputed into a periodic waveform owned by the
+ caller, and the render call only loops over it.
+
+ For pure tones, the phase is kept in an accumulator and re-anchored at the start of each
+ rendered block; within a block, `ORKToneSynthesizerLaneCount` interleaved recursive
+ oscillators each advance by `ORKToneSynthesizerLaneCount` frames per step, so the inner
+ loop has no transcendental calls and no dependency between adjacent frames.
+
+ The fade-in envelope follows `amplitude * 10^(2 * fadeInFactor - 2)`, with `fadeInFactor`
+ rising linearly from 0 to 1 over the fade-in duration. Because that curve is geometric in
+ the frame index, it is applied with a precomputed per-frame ratio.
+ */
+typedef struct ORKToneSynthesizer {
+    double sampleRate;
+    double amplitude;
+    double frequency;
+    ORKToneSynthesizerSource source;
+
+    double phase;
+    double phaseIncrement;
+    double laneOffsetReal[ORKToneSynthesizerLaneCount];
+    double laneOffsetImaginary[ORKToneSynthesizerLaneCount];
+    double laneRotationReal;
+    double laneRotationImaginary;
+
+    const float *waveform;
+    uint32_t waveformLength;
+    uint32_t waveformPosition;
+
+    uint32_t noiseSeed;
+    double noiseGain;
+    double noiseCoefficients[5];
+    double noiseHistory[ORKToneSynthesizerNoiseSectionCount][4];
+
+    double fadeInFactor;
+    double fadeInIncrement;
+    double fadeInRatio[ORKToneSynthesizerLaneCount];
+    double fadeInLaneRatio;
+} ORKToneSynthesizer;
+
+/**
+ Resets the synthesizer to a silent state at the specified sample rate and peak amplitude.
+ */
+ORK_EXTERN void ORKToneSynthesizerInitialize(ORKToneSynthesizer *synthesizer, double sampleRate, double amplitude);
+
+/**
+ Sets the peak amplitude reached at the end of the fade-in, from 0 to 1.
+ */
+ORK_EXTERN void ORKToneSynthesizerSetAmplitude(ORKToneSynthesizer *synthesizer, double amplitude);
+
+/**
+ Plays a pure tone at the specified frequency, in hertz. The phase is kept, so the change is click-free.
+ */
+ORK_EXTERN void ORKToneSynthesizerSetFrequency(ORKToneSynthesizer *synthesizer, double frequency);
+
+/**
+ Loops over a precomputed, unit amplitude periodic waveform. The buffer is not copied and
+ must stay valid until the synthesizer stops rendering it.
+ */
+ORK_EXTERN void ORKToneSynthesizerSetWaveform(ORKToneSynthesizer *synthesizer, const float *waveform, uint32_t length);
+
+/**
+ Returns the gain that scales narrow band noise so that its RMS level matches a pure tone of
+ the same amplitude. The gain is measured over one second of filtered noise, so compute it
+ ahead of playback; it does not touch any shared state and is safe to call on any thread.
+ */
+ORK_EXTERN double ORKToneSynthesizerNarrowBandNoiseGain(double sampleRate, double centerFrequency, uint32_t seed);
+
+/**
+ Plays noise band-limited to one third of an octave around the center frequency, scaled by
+ `gain`, as returned by `ORKToneSynthesizerNarrowBandNoiseGain` for the same parameters.
+ */
+ORK_EXTERN void ORKToneSynthesizerSetNarrowBandNoise(ORKToneSynthesizer *synthesizer, double centerFrequency, uint32_t seed, double gain);
+
+/**
+ Restarts the fade-in envelope. A duration of zero or less starts the stimulus at full amplitude.
+ */
+ORK_EXTERN void ORKToneSynthesizerStartFadeIn(ORKToneSynthesizer *synthesizer, double fadeInDuration);
+
+/**
+ Renders `frameCount` mono frames into `buffer` and advances the synthesizer state.
+ */
+ORK_EXTERN void ORKToneSynthesizerRender(ORKToneSynthesizer *synthesizer, float *buffer, uint32_t frameCount);
+
+/**
+ Returns the peak amplitude of the next frame to be rendered, from 0 to `amplitude`.
+ */
+ORK_EXTERN double ORKToneSynthesizerCurrentAmplitude(const ORKToneSynthesizer *synthesizer);
+
+/**
+ Returns the number of frames in one period of a pulsed tone waveform.
+ */
+ORK_EXTERN uint32_t ORKToneSynthesizerPulsedToneLength(double sampleRate);
+
+/**
+ Fills `buffer` with one period of a pulsed tone: 200 ms on, 200 ms off, with 20 ms raised-cosine ramps.
+ */
+ORK_EXTERN void ORKToneSynthesizerFillPulsedTone(float *buffer, uint32_t length, double sampleRate, double frequency);
+
+/**
+ Returns the number of frames in one period of a warble tone waveform.
+ */
+ORK_EXTERN uint32_t ORKToneSynthesizerWarbleToneLength(double sampleRate);
+
+/**
+ Fills `buffer` with one period of a warble tone, sinusoidally frequency modulated by ±5% at 5 Hz.
+
+ The carrier is rounded to a whole number of cycles per period, so the waveform loops
+ without discontinuity.
+ */
+ORK_EXTERN void ORKToneSynthesizerFillWarbleTone(float *buffer, uint32_t length, double sampleRate, double frequency);
@@ -0,0 +1,302 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "ORKToneSynthesizer.h"
+
+#include <math.h>
+#include <string.h>
+
+
+static const double ORKToneSynthesizerTwoPi = 2.0 * M_PI;
+
+static const double ORKPulsedToneOnDuration = 0.2;
+static const double ORKPulsedToneOffDuration = 0.2;
+static const double ORKPulsedToneRampDuration = 0.02;
+
+static const double ORKWarbleToneModulationRate = 5.0;
+static const double ORKWarbleToneModulationDepth = 0.05;
+static const double ORKWarbleTonePeriod = 1.0;
+
+// Q of a band-pass filter one third of an octave wide: sqrt(2^(1/3)) / (2^(1/3) - 1).
+static const double ORKNarrowBandNoiseQ = 4.318473046963146;
+
+static double ORKToneSynthesizerFadeInGain(const ORKToneSynthesizer *synthesizer, double fadeInFactor) {
+    return synthesizer->amplitude * pow(10, 2 * fadeInFactor - 2);
+}
+
+static float ORKToneSynthesizerNextNoiseSample(uint32_t *seed) {
+    // xorshift32, mapped to [-1, 1)
+    uint32_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *seed = x;
+    return (float)((double)x / 2147483648.0 - 1.0);
+}
+
+static double ORKToneSynthesizerFilterNoiseSample(ORKToneSynthesizer *synthesizer, double sample) {
+    const double *c = synthesizer->noiseCoefficients;
+    for (int section = 0; section < ORKToneSynthesizerNoiseSectionCount; section++) {
+        double *h = synthesizer->noiseHistory[section];
+        double output = c[0] * sample + c[1] * h[0] + c[2] * h[1] - c[3] * h[2] - c[4] * h[3];
+        h[1] = h[0];
+        h[0] = sample;
+        h[3] = h[2];
+        h[2] = output;
+        sample = output;
+    }
+    return sample;
+}
+
+void ORKToneSynthesizerInitialize(ORKToneSynthesizer *synthesizer, double sampleRate, double amplitude) {
+    memset(synthesizer, 0, sizeof(ORKToneSynthesizer));
+    synthesizer->sampleRate = sampleRate;
+    synthesizer->amplitude = amplitude;
+    ORKToneSynthesizerSetFrequency(synthesizer, 0);
+    ORKToneSynthesizerStartFadeIn(synthesizer, 0);
+}
+
+void ORKToneSynthesizerSetAmplitude(ORKToneSynthesizer *synthesizer, double amplitude) {
+    synthesizer->amplitude = fmin(fmax(amplitude, 0), 1);
+}
+
+void ORKToneSynthesizerSetFrequency(ORKToneSynthesizer *synthesizer, double frequency) {
+    synthesizer->source = ORKToneSynthesizerSourceOscillator;
+    synthesizer->frequency = frequency;
+    synthesizer->phaseIncrement = ORKToneSynthesizerTwoPi * frequency / synthesizer->sampleRate;
+    for (int lane = 0; lane < ORKToneSynthesizerLaneCount; lane++) {
+        synthesizer->laneOffsetReal[lane] = cos(lane * synthesizer->phaseIncrement);
+        synthesizer->laneOffsetImaginary[lane] = sin(lane * synthesizer->phaseIncrement);
+    }
+    synthesizer->laneRotationReal = cos(ORKToneSynthesizerLaneCount * synthesizer->phaseIncrement);
+    synthesizer->laneRotationImaginary = sin(ORKToneSynthesizerLaneCount * synthesizer->phaseIncrement);
+}
+
+void ORKToneSynthesizerSetWaveform(ORKToneSynthesizer *synthesizer, const float *waveform, uint32_t length) {
+    synthesizer->source = (waveform && length > 0) ? ORKToneSynthesizerSourceWaveform : ORKToneSynthesizerSourceOscillator;
+    synthesizer->waveform = waveform;
+    synthesizer->waveformLength = length;
+    synthesizer->waveformPosition = 0;
+}
+
+void ORKToneSynthesizerSetNarrowBandNoise(ORKToneSynthesizer *synthesizer, double centerFrequency, uint32_t seed, double gain) {
+    synthesizer->source = ORKToneSynthesizerSourceNoise;
+    synthesizer->frequency = centerFrequency;
+    
+    // RBJ band-pass with 0 dB peak gain, normalized by a0.
+    double w0 = ORKToneSynthesizerTwoPi * centerFrequency / synthesizer->sampleRate;
+    double alpha = sin(w0) / (2 * ORKNarrowBandNoiseQ);
+    double a0 = 1 + alpha;
+    synthesizer->noiseCoefficients[0] = alpha / a0;
+    synthesizer->noiseCoefficients[1] = 0;
+    synthesizer->noiseCoefficients[2] = -alpha / a0;
+    synthesizer->noiseCoefficients[3] = -2 * cos(w0) / a0;
+    synthesizer->noiseCoefficients[4] = (1 - alpha) / a0;
+    
+    synthesizer->noiseSeed = seed ? seed : 1;
+    synthesizer->noiseGain = gain;
+    memset(synthesizer->noiseHistory, 0, sizeof(synthesizer->noiseHistory));
+}
+
+double ORKToneSynthesizerNarrowBandNoiseGain(double sampleRate, double centerFrequency, uint32_t seed) {
+    // Measure the filtered level over one second on a scratch synthesizer, so the noise can be
+    // scaled to the RMS of a unit amplitude sine.
+    ORKToneSynthesizer scratch;
+    ORKToneSynthesizerInitialize(&scratch, sampleRate, 1);
+    ORKToneSynthesizerSetNarrowBandNoise(&scratch, centerFrequency, seed, 1);
+    
+    uint32_t measuredFrames = (uint32_t)sampleRate;
+    double sumOfSquares = 0;
+    for (uint32_t frame = 0; frame < measuredFrames; frame++) {
+        double sample = ORKToneSynthesizerFilterNoiseSample(&scratch, ORKToneSynthesizerNextNoiseSample(&scratch.noiseSeed));
+        sumOfSquares += sample * sample;
+    }
+    double rms = (measuredFrames > 0) ? sqrt(sumOfSquares / measuredFrames) : 0;
+    return (rms > 0) ? M_SQRT1_2 / rms : 0;
+}
+
+void ORKToneSynthesizerStartFadeIn(ORKToneSynthesizer *synthesizer, double fadeInDuration) {
+    if (fadeInDuration > 0) {
+        synthesizer->fadeInFactor = 0;
+        synthesizer->fadeInIncrement = 1.0 / (synthesizer->sampleRate * fadeInDuration);
+    } else {
+        synthesizer->fadeInFactor = 1;
+        synthesizer->fadeInIncrement = 0;
+    }
+    double ratio = pow(10, 2 * synthesizer->fadeInIncrement);
+    for (int lane = 0; lane < ORKToneSynthesizerLaneCount; lane++) {
+        synthesizer->fadeInRatio[lane] = pow(ratio, lane);
+    }
+    synthesizer->fadeInLaneRatio = pow(ratio, ORKToneSynthesizerLaneCount);
+}
+
+static void ORKToneSynthesizerRenderOscillator(ORKToneSynthesizer *synthesizer, float *buffer, uint32_t frameCount) {
+    const double rotationReal = synthesizer->laneRotationReal;
+    const double rotationImaginary = synthesizer->laneRotationImaginary;
+    
+    // Anchor every lane on the exact phase once per block, so rounding errors of the
+    // recursive oscillator cannot accumulate across blocks.
+    const double anchorReal = cos(synthesizer->phase);
+    const double anchorImaginary = sin(synthesizer->phase);
+    
+    double real[ORKToneSynthesizerLaneCount];
+    double imaginary[ORKToneSynthesizerLaneCount];
+    for (int lane = 0; lane < ORKToneSynthesizerLaneCount; lane++) {
+        real[lane] = anchorReal * synthesizer->laneOffsetReal[lane] - anchorImaginary * synthesizer->laneOffsetImaginary[lane];
+        imaginary[lane] = anchorReal * synthesizer->laneOffsetImaginary[lane] + anchorImaginary * synthesizer->laneOffsetReal[lane];
+    }
+    
+    uint32_t frame = 0;
+    for (; frame + ORKToneSynthesizerLaneCount <= frameCount; frame += ORKToneSynthesizerLaneCount) {
+        for (int lane = 0; lane < ORKToneSynthesizerLaneCount; lane++) {
+            buffer[frame + lane] = (float)imaginary[lane];
+            
+            double rotatedReal = real[lane] * rotationReal - imaginary[lane] * rotationImaginary;
+            imaginary[lane] = real[lane] * rotationImaginary + imaginary[lane] * rotationReal;
+            real[lane] = rotatedReal;
+        }
+    }
+    for (int lane = 0; frame < frameCount; frame++, lane++) {
+        buffer[frame] = (float)imaginary[lane];
+    }
+    
+    synthesizer->phase = fmod(synthesizer->phase + frameCount * synthesizer->phaseIncrement, ORKToneSynthesizerTwoPi);
+}
+
+static void ORKToneSynthesizerRenderWaveform(ORKToneSynthesizer *synthesizer, float *buffer, uint32_t frameCount) {
+    uint32_t position = synthesizer->waveformPosition;
+    while (frameCount > 0) {
+        uint32_t count = synthesizer->waveformLength - position;
+        if (count > frameCount) {
+            count = frameCount;
+        }
+        memcpy(buffer, synthesizer->waveform + position, count * sizeof(float));
+        buffer += count;
+        frameCount -= count;
+        position += count;
+        if (position == synthesizer->waveformLength) {
+            position = 0;
+        }
+    }
+    synthesizer->waveformPosition = position;
+}
+
+static void ORKToneSynthesizerRenderNoise(ORKToneSynthesizer *synthesizer, float *buffer, uint32_t frameCount) {
+    const double noiseGain = synthesizer->noiseGain;
+    for (uint32_t frame = 0; frame < frameCount; frame++) {
+        double sample = ORKToneSynthesizerFilterNoiseSample(synthesizer, ORKToneSynthesizerNextNoiseSample(&synthesizer->noiseSeed));
+        buffer[frame] = (float)(sample * noiseGain);
+    }
+}
+
+static void ORKToneSynthesizerApplyEnvelope(ORKToneSynthesizer *synthesizer, float *buffer, uint32_t frameCount) {
+    const double amplitude = synthesizer->amplitude;
+    const double fadeInLaneRatio = synthesizer->fadeInLaneRatio;
+    const double startGain = ORKToneSynthesizerFadeInGain(synthesizer, synthesizer->fadeInFactor);
+    
+    double gain[ORKToneSynthesizerLaneCount];
+    for (int lane = 0; lane < ORKToneSynthesizerLaneCount; lane++) {
+        gain[lane] = fmin(startGain * synthesizer->fadeInRatio[lane], amplitude);
+    }
+    
+    uint32_t frame = 0;
+    for (; frame + ORKToneSynthesizerLaneCount <= frameCount; frame += ORKToneSynthesizerLaneCount) {
+        for (int lane = 0; lane < ORKToneSynthesizerLaneCount; lane++) {
+            buffer[frame + lane] = (float)(buffer[frame + lane] * gain[lane]);
+            gain[lane] = fmin(gain[lane] * fadeInLaneRatio, amplitude);
+        }
+    }
+    for (int lane = 0; frame < frameCount; frame++, lane++) {
+        buffer[frame] = (float)(buffer[frame] * gain[lane]);
+    }
+    
+    synthesizer->fadeInFactor = fmin(synthesizer->fadeInFactor + frameCount * synthesizer->fadeInIncrement, 1);
+}
+
+void ORKToneSynthesizerRender(ORKToneSynthesizer *synthesizer, float *buffer, uint32_t frameCount) {
+    switch (synthesizer->source) {
+        case ORKToneSynthesizerSourceOscillator:
+            ORKToneSynthesizerRenderOscillator(synthesizer, buffer, frameCount);
+            break;
+        case ORKToneSynthesizerSourceWaveform:
+            ORKToneSynthesizerRenderWaveform(synthesizer, buffer, frameCount);
+            break;
+        case ORKToneSynthesizerSourceNoise:
+            ORKToneSynthesizerRenderNoise(synthesizer, buffer, frameCount);
+            break;
+    }
+    ORKToneSynthesizerApplyEnvelope(synthesizer, buffer, frameCount);
+}
+
+double ORKToneSynthesizerCurrentAmplitude(const ORKToneSynthesizer *synthesizer) {
+    return ORKToneSynthesizerFadeInGain(synthesizer, synthesizer->fadeInFactor);
+}
+
+uint32_t ORKToneSynthesizerPulsedToneLength(double sampleRate) {
+    return (uint32_t)lround((ORKPulsedToneOnDuration + ORKPulsedToneOffDuration) * sampleRate);
+}
+
+void ORKToneSynthesizerFillPulsedTone(float *buffer, uint32_t length, double sampleRate, double frequency) {
+    const double phaseIncrement = ORKToneSynthesizerTwoPi * frequency / sampleRate;
+    for (uint32_t frame = 0; frame < length; frame++) {
+        double time = frame / sampleRate;
+        double gate;
+        if (time >= ORKPulsedToneOnDuration) {
+            gate = 0;
+        } else if (time < ORKPulsedToneRampDuration) {
+            gate = 0.5 * (1 - cos(M_PI * time / ORKPulsedToneRampDuration));
+        } else if (time > ORKPulsedToneOnDuration - ORKPulsedToneRampDuration) {
+            gate = 0.5 * (1 - cos(M_PI * (ORKPulsedToneOnDuration - time) / ORKPulsedToneRampDuration));
+        } else {
+            gate = 1;
+        }
+        buffer[frame] = (float)(gate * sin(phaseIncrement * frame));
+    }
+}
+
+uint32_t ORKToneSynthesizerWarbleToneLength(double sampleRate) {
+    return (uint32_t)lround(ORKWarbleTonePeriod * sampleRate);
+}
+
+void ORKToneSynthesizerFillWarbleTone(float *buffer, uint32_t length, double sampleRate, double frequency) {
+    double period = length / sampleRate;
+    double carrierCycles = fmax(round(frequency * period), 1);
+    double modulationCycles = fmax(round(ORKWarbleToneModulationRate * period), 1);
+    double carrierFrequency = carrierCycles / period;
+    double modulationFrequency = modulationCycles / period;
+    double modulationIndex = ORKWarbleToneModulationDepth * carrierFrequency / modulationFrequency;
+    for (uint32_t frame = 0; frame < length; frame++) {
+        double time = frame / sampleRate;
+        double phase = ORKToneSynthesizerTwoPi * carrierFrequency * time
+                     + modulationIndex * (1 - cos(ORKToneSynthesizerTwoPi * modulationFrequency * time));
+        buffer[frame] = (float)sin(phase);
+    }
+}
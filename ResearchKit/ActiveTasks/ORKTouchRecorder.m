@@ -38,7 +38,7 @@
 
 @protocol ORKTouchRecordingDelegate <NSObject>
 
-- (void)view:(UIView *)view didDetectTouch:(UITouch *)touch;
+- (void)view:(UIView *)view didDetectTouches:(NSSet<UITouch *> *)touches;
 
 @end
 
@@ -53,10 +53,7 @@
 @implementation ORKTouchGestureRecognizer
 
 - (void)reportTouches:(NSSet *)touches {
-    
-    for (UITouch *touch in touches) {
-        [self.eventDelegate view:self.view didDetectTouch:touch];
-    }
+    [self.eventDelegate view:self.view didDetectTouches:touches];
 }
 
 - (void)touchesBegan:(NSSet *)touches withEvent:(UIEvent *)event {
@@ -87,14 +84,17 @@
 
 @interface ORKTouchRecorder () <ORKTouchRecordingDelegate> {
     ORKDataLogger *_logger;
+    
+    // Index of each active touch, keyed by identity; a touch is removed when it ends
+    NSMapTable<UITouch *, NSNumber *> *_touchIndexes;
+    NSUInteger _touchCount;
+    
+    // Reused for the samples of each touch event
+    NSMutableArray<NSDictionary *> *_samples;
 }
 
 @property (nonatomic, strong) ORKTouchGestureRecognizer *gestureRecognizer;
 
-@property (nonatomic, strong) NSMutableArray *touchArray;
-
-@property (nonatomic) NSTimeInterval uptime;
-
 @property (nonatomic, strong) NSError *recordingError;
 
 @end
@@ -127,8 +127,10 @@
         
         [super start];
         
-        self.touchArray = [NSMutableArray array];
-        _uptime = [NSProcessInfo processInfo].systemUptime;
+        _touchIndexes = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                              valueOptions:NSPointerFunctionsStrongMemory];
+        _touchCount = 0;
+        _samples = [NSMutableArray array];
     } else {
         @throw [NSException exceptionWithName:NSGenericException
                                        reason:@"No touch capture view provided"
@@ -146,15 +148,11 @@
 
 - (void)stop {
     [self doStopRecording];
-    [_logger finishCurrentLog];
+    [self finishCurrentLogOfLogger:_logger];
     
-    NSError *error = nil;
-    __block NSURL *fileUrl = nil;
-    [_logger enumerateLogs:^(NSURL *logFileUrl, BOOL *stop) {
-        fileUrl = logFileUrl;
-    } error:&error];
+    NSURL *fileUrl = _logger.lastFinishedLogFileURL;
     
-    [self reportFileResultWithFile:fileUrl error:error];
+    [self reportFileResultWithFile:fileUrl error:nil];
     
     [super stop];
 }
@@ -164,6 +162,7 @@
         [self.touchView removeGestureRecognizer:self.gestureRecognizer];
         _touchView = nil;
     }
+    [_touchIndexes removeAllObjects];
 }
 
 - (void)finishRecordingWithError:(NSError *)error {
@@ -187,14 +186,30 @@
 
 #pragma mark - ORKTouchRecordingDelegate
 
-- (void)view:(UIView *)view didDetectTouch:(UITouch *)touch {
+- (void)view:(UIView *)view didDetectTouches:(NSSet<UITouch *> *)touches {
+    if (touches.count == 0) {
+        return;
+    }
     
-    if ([self.touchArray containsObject:touch] == NO) {
-        [self.touchArray addObject:touch];
+    [_samples removeAllObjects];
+    for (UITouch *touch in touches) {
+        NSNumber *index = [_touchIndexes objectForKey:touch];
+        if (index == nil) {
+            index = @(_touchCount++);
+            [_touchIndexes setObject:index forKey:touch];
+        }
+        [_samples addObject:[touch ork_JSONDictionaryInView:view index:index.unsignedIntegerValue]];
+        
+        UITouchPhase phase = touch.phase;
+        if (phase == UITouchPhaseEnded || phase == UITouchPhaseCancelled) {
+            [_touchIndexes removeObjectForKey:touch];
+        }
     }
     
     NSError *error = nil;
-    if (![_logger append:[touch ork_JSONDictionaryInView:view allTouches:self.touchArray] error:&error]) {
+    BOOL success = [_logger appendObjects:_samples error:&error];
+    [_samples removeAllObjects];
+    if (!success) {
         assert(error != nil);
         [self finishRecordingWithError:error];
     }
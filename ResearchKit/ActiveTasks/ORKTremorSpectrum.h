@@ -0,0 +1,115 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+@import Accelerate;
+#import <ResearchKit/ORKDefines.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The signals analyzed by `ORKTremorSpectrum`. The spectrum of each signal is the sum of the
+ spectra of its three axes, so it does not depend on how the device is held.
+ */
+typedef NS_ENUM(NSInteger, ORKTremorSpectrumSignal) {
+    ORKTremorSpectrumSignalUserAcceleration = 0,
+    ORKTremorSpectrumSignalRotationRate,
+    ORKTremorSpectrumSignalCount
+};
+
+/**
+ `ORKTremorSpectrum` estimates the power spectral density of device motion with Welch's
+ method, incrementally, as samples are received.
+ 
+ Samples are written to a ring buffer per axis. Every half segment, the latest segment of
+ about 2.5 seconds (rounded up to a power of two) is detrended, Hann-windowed, and
+ transformed with a real FFT, and its periodogram is added to a running average.
+ Memory use is constant: one segment per axis, and one averaged spectrum per signal.
+ */
+typedef struct ORKTremorSpectrum {
+    double sampleRate;
+    vDSP_Length segmentLength;
+    vDSP_Length log2SegmentLength;
+    vDSP_Length hopLength;
+    FFTSetup fftSetup;
+    
+    float *window;
+    double windowPower;
+    
+    // Ring buffer of the latest segment, one per axis (3 per signal)
+    float *ring[ORKTremorSpectrumSignalCount * 3];
+    vDSP_Length writeIndex;
+    uint64_t sampleCount;
+    vDSP_Length samplesSinceSegment;
+    
+    // Scratch
+    float *segment;
+    float *periodogram;
+    DSPSplitComplex split;
+    
+    // Sum of the periodograms of each signal, segmentLength / 2 + 1 bins
+    float *periodogramSum[ORKTremorSpectrumSignalCount];
+    uint64_t segmentCount;
+} ORKTremorSpectrum;
+
+/**
+ Allocates the analysis buffers for the given sample rate. Call `ORKTremorSpectrumDestroy` to free them.
+ */
+ORK_EXTERN void ORKTremorSpectrumInitialize(ORKTremorSpectrum *spectrum, double sampleRate);
+
+ORK_EXTERN void ORKTremorSpectrumDestroy(ORKTremorSpectrum *spectrum);
+
+/**
+ Adds one sample of each signal. Acceleration is in g, and rotation rate in radians per second.
+ */
+ORK_EXTERN void ORKTremorSpectrumAddSample(ORKTremorSpectrum *spectrum,
+                                           const double userAcceleration[_Nonnull 3],
+                                           const double rotationRate[_Nonnull 3]);
+
+/**
+ Returns the power of a signal between two frequencies (inclusive), in squared signal units,
+ averaged over the segments analyzed so far; 0 if no segment is complete.
+ */
+ORK_EXTERN double ORKTremorSpectrumBandPower(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal, double lowerFrequency, double upperFrequency);
+
+/**
+ Returns the power of a signal over all frequencies above 0 Hz.
+ */
+ORK_EXTERN double ORKTremorSpectrumTotalPower(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal);
+
+/**
+ Returns the frequency of the spectral peak between two frequencies, interpolated between bins;
+ 0 if no segment is complete.
+ */
+ORK_EXTERN double ORKTremorSpectrumDominantFrequency(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal, double lowerFrequency, double upperFrequency);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,211 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTremorSpectrum.h"
+
+
+static const double ORKTremorSpectrumSegmentDuration = 2.5;
+static const vDSP_Length ORKTremorSpectrumMinimumSegmentLength = 16;
+
+void ORKTremorSpectrumInitialize(ORKTremorSpectrum *spectrum, double sampleRate) {
+    memset(spectrum, 0, sizeof(ORKTremorSpectrum));
+    spectrum->sampleRate = (sampleRate > 0) ? sampleRate : 100;
+    
+    vDSP_Length length = ORKTremorSpectrumMinimumSegmentLength;
+    while (length < spectrum->sampleRate * ORKTremorSpectrumSegmentDuration) {
+        length <<= 1;
+    }
+    spectrum->segmentLength = length;
+    spectrum->log2SegmentLength = (vDSP_Length)log2(length);
+    spectrum->hopLength = length / 2;
+    spectrum->fftSetup = vDSP_create_fftsetup(spectrum->log2SegmentLength, kFFTRadix2);
+    
+    spectrum->window = calloc(length, sizeof(float));
+    vDSP_hann_window(spectrum->window, length, vDSP_HANN_DENORM);
+    float windowPower = 0;
+    vDSP_svesq(spectrum->window, 1, &windowPower, length);
+    spectrum->windowPower = windowPower;
+    
+    for (NSInteger axis = 0; axis < ORKTremorSpectrumSignalCount * 3; axis++) {
+        spectrum->ring[axis] = calloc(length, sizeof(float));
+    }
+    spectrum->segment = calloc(length, sizeof(float));
+    spectrum->periodogram = calloc(length / 2 + 1, sizeof(float));
+    spectrum->split.realp = calloc(length / 2, sizeof(float));
+    spectrum->split.imagp = calloc(length / 2, sizeof(float));
+    for (NSInteger signal = 0; signal < ORKTremorSpectrumSignalCount; signal++) {
+        spectrum->periodogramSum[signal] = calloc(length / 2 + 1, sizeof(float));
+    }
+}
+
+void ORKTremorSpectrumDestroy(ORKTremorSpectrum *spectrum) {
+    if (spectrum->fftSetup) {
+        vDSP_destroy_fftsetup(spectrum->fftSetup);
+    }
+    free(spectrum->window);
+    for (NSInteger axis = 0; axis < ORKTremorSpectrumSignalCount * 3; axis++) {
+        free(spectrum->ring[axis]);
+    }
+    free(spectrum->segment);
+    free(spectrum->periodogram);
+    free(spectrum->split.realp);
+    free(spectrum->split.imagp);
+    for (NSInteger signal = 0; signal < ORKTremorSpectrumSignalCount; signal++) {
+        free(spectrum->periodogramSum[signal]);
+    }
+    memset(spectrum, 0, sizeof(ORKTremorSpectrum));
+}
+
+// Adds the squared FFT magnitudes of the latest segment of one axis to its signal's sum.
+static void ORKTremorSpectrumAddAxisPeriodogram(ORKTremorSpectrum *spectrum, NSInteger axis) {
+    vDSP_Length length = spectrum->segmentLength;
+    vDSP_Length half = length / 2;
+    float *segment = spectrum->segment;
+    
+    // Unroll the ring buffer, oldest sample first
+    const float *ring = spectrum->ring[axis];
+    vDSP_Length head = spectrum->writeIndex;
+    memcpy(segment, ring + head, (length - head) * sizeof(float));
+    memcpy(segment + (length - head), ring, head * sizeof(float));
+    
+    // Remove the mean, so slow drifts and offsets don't leak into the low bins, and taper
+    float mean = 0;
+    vDSP_meanv(segment, 1, &mean, length);
+    mean = -mean;
+    vDSP_vsadd(segment, 1, &mean, segment, 1, length);
+    vDSP_vmul(segment, 1, spectrum->window, 1, segment, 1, length);
+    
+    DSPSplitComplex *split = &spectrum->split;
+    vDSP_ctoz((const DSPComplex *)segment, 2, split, 1, half);
+    vDSP_fft_zrip(spectrum->fftSetup, split, 1, spectrum->log2SegmentLength, kFFTDirection_Forward);
+    
+    // The DC and Nyquist terms are packed into the first element
+    float *periodogram = spectrum->periodogram;
+    float nyquist = split->imagp[0];
+    split->imagp[0] = 0;
+    vDSP_zvmags(split, 1, periodogram, 1, half);
+    periodogram[half] = nyquist * nyquist;
+    
+    float *sum = spectrum->periodogramSum[axis / 3];
+    vDSP_vadd(sum, 1, periodogram, 1, sum, 1, half + 1);
+}
+
+void ORKTremorSpectrumAddSample(ORKTremorSpectrum *spectrum,
+                                const double userAcceleration[3],
+                                const double rotationRate[3]) {
+    vDSP_Length index = spectrum->writeIndex;
+    for (NSInteger component = 0; component < 3; component++) {
+        spectrum->ring[component][index] = (float)userAcceleration[component];
+        spectrum->ring[3 + component][index] = (float)rotationRate[component];
+    }
+    spectrum->writeIndex = (index + 1 == spectrum->segmentLength) ? 0 : index + 1;
+    spectrum->sampleCount++;
+    spectrum->samplesSinceSegment++;
+    
+    // Analyze a segment every hop, once the first segment is complete (50% overlap)
+    if (spectrum->sampleCount >= spectrum->segmentLength && spectrum->samplesSinceSegment >= spectrum->hopLength) {
+        for (NSInteger axis = 0; axis < ORKTremorSpectrumSignalCount * 3; axis++) {
+            ORKTremorSpectrumAddAxisPeriodogram(spectrum, axis);
+        }
+        spectrum->segmentCount++;
+        spectrum->samplesSinceSegment = 0;
+    }
+}
+
+/*
+ One-sided power spectral density of a bin, in squared units per hertz. vDSP_fft_zrip returns
+ twice the DFT, hence the factor of 4 on the squared magnitudes; bins other than DC and Nyquist
+ fold in the negative frequencies.
+ */
+static double ORKTremorSpectrumDensity(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal, vDSP_Length bin) {
+    vDSP_Length half = spectrum->segmentLength / 2;
+    double scale = 1.0 / (4.0 * spectrum->sampleRate * spectrum->windowPower * spectrum->segmentCount);
+    if (bin > 0 && bin < half) {
+        scale *= 2;
+    }
+    return spectrum->periodogramSum[signal][bin] * scale;
+}
+
+static void ORKTremorSpectrumBinRange(const ORKTremorSpectrum *spectrum, double lowerFrequency, double upperFrequency, vDSP_Length *first, vDSP_Length *last) {
+    double resolution = spectrum->sampleRate / spectrum->segmentLength;
+    vDSP_Length half = spectrum->segmentLength / 2;
+    *first = (vDSP_Length)MAX(ceil(lowerFrequency / resolution - 1e-9), 0);
+    *last = (vDSP_Length)MIN(floor(upperFrequency / resolution + 1e-9), (double)half);
+}
+
+double ORKTremorSpectrumBandPower(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal, double lowerFrequency, double upperFrequency) {
+    if (spectrum->segmentCount == 0) {
+        return 0;
+    }
+    vDSP_Length first, last;
+    ORKTremorSpectrumBinRange(spectrum, lowerFrequency, upperFrequency, &first, &last);
+    double power = 0;
+    for (vDSP_Length bin = first; bin <= last; bin++) {
+        power += ORKTremorSpectrumDensity(spectrum, signal, bin);
+    }
+    return power * spectrum->sampleRate / spectrum->segmentLength;
+}
+
+double ORKTremorSpectrumTotalPower(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal) {
+    double resolution = spectrum->sampleRate / spectrum->segmentLength;
+    return ORKTremorSpectrumBandPower(spectrum, signal, resolution, spectrum->sampleRate / 2);
+}
+
+double ORKTremorSpectrumDominantFrequency(const ORKTremorSpectrum *spectrum, ORKTremorSpectrumSignal signal, double lowerFrequency, double upperFrequency) {
+    if (spectrum->segmentCount == 0) {
+        return 0;
+    }
+    vDSP_Length first, last;
+    ORKTremorSpectrumBinRange(spectrum, lowerFrequency, upperFrequency, &first, &last);
+    if (first > last) {
+        return 0;
+    }
+    const float *sum = spectrum->periodogramSum[signal];
+    vDSP_Length peak = first;
+    for (vDSP_Length bin = first + 1; bin <= last; bin++) {
+        if (sum[bin] > sum[peak]) {
+            peak = bin;
+        }
+    }
+    
+    // Parabolic interpolation on the log spectrum around the peak bin
+    double offset = 0;
+    if (peak > 0 && peak < spectrum->segmentLength / 2 && sum[peak] > 0 && sum[peak - 1] > 0 && sum[peak + 1] > 0) {
+        double left = log(sum[peak - 1]);
+        double center = log(sum[peak]);
+        double right = log(sum[peak + 1]);
+        double denominator = left - 2 * center + right;
+        if (denominator < 0) {
+            offset = MAX(MIN(0.5 * (left - right) / denominator, 0.5), -0.5);
+        }
+    }
+    return (peak + offset) * spectrum->sampleRate / spectrum->segmentLength;
+}
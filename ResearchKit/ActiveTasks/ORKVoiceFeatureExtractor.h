@@ -0,0 +1,95 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+@import Foundation;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The `ORKVoiceFeatureExtractor` class computes acoustic features of a voice recording in a
+ streaming fashion, as PCM buffers are captured.
+ 
+ Audio is analyzed in Hann-windowed frames of about 40 ms (rounded up to a power of two),
+ advancing by half a frame. For each frame the extractor records the RMS level, zero-crossing
+ rate, peak amplitude, an autocorrelation pitch estimate (60-500 Hz), the spectral centroid
+ and the spectral flatness. Summary statistics, including frame-to-frame jitter and shimmer
+ estimates over consecutive voiced frames, are maintained incrementally.
+ 
+ Memory use is constant per frame of audio: only the per-frame features are kept, never the samples.
+ The extractor is not thread-safe; append samples from one thread at a time.
+ */
+@interface ORKVoiceFeatureExtractor : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an initialized feature extractor for mono audio at the specified sample rate.
+ 
+ @param sampleRate      The sample rate of the audio, in hertz.
+ 
+ @return An initialized feature extractor.
+ */
+- (instancetype)initWithSampleRate:(double)sampleRate NS_DESIGNATED_INITIALIZER;
+
+/// The sample rate of the audio, in hertz.
+@property (nonatomic, readonly) double sampleRate;
+
+/// The number of samples in an analysis frame.
+@property (nonatomic, readonly) NSUInteger frameLength;
+
+/// The number of samples between the starts of consecutive analysis frames.
+@property (nonatomic, readonly) NSUInteger hopLength;
+
+/// The number of frames analyzed so far.
+@property (nonatomic, readonly) NSUInteger frameCount;
+
+/**
+ Appends mono floating point samples, in the range -1 to 1, and analyzes every frame they complete.
+ 
+ @param samples     The samples to append.
+ @param count       The number of samples.
+ */
+- (void)appendSamples:(const float *)samples count:(NSUInteger)count;
+
+/**
+ Returns the summary statistics of the frames analyzed so far. All values are JSON serializable.
+ */
+- (NSDictionary<NSString *, NSNumber *> *)summary;
+
+/**
+ Returns the summary and the per-frame feature tracks as a JSON-serializable dictionary.
+ */
+- (NSDictionary<NSString *, id> *)JSONObject;
+
+@end
+
+NS_ASSUME_NONNULL_END
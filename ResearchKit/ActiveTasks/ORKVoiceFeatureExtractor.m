@@ -0,0 +1,316 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKVoiceFeatureExtractor.h"
+
+@import Accelerate;
+
+
+static const double ORKVoiceFeatureFrameDuration = 0.04;
+static const double ORKVoiceFeatureMinimumPitch = 60.0;
+static const double ORKVoiceFeatureMaximumPitch = 500.0;
+static const double ORKVoiceFeatureVoicingThreshold = 0.45;
+static const double ORKVoiceFeatureSilenceLevel = -50.0;
+static const double ORKVoiceFeatureFloorLevel = -120.0;
+
+typedef struct ORKVoiceFeatureFrame {
+    float level;
+    float zeroCrossingRate;
+    float peak;
+    float pitch;
+    float spectralCentroid;
+    float spectralFlatness;
+} ORKVoiceFeatureFrame;
+
+static inline double ORKVoiceFeatureNormalizedAutocorrelation(const float *autocorrelation, const float *windowAutocorrelation, NSUInteger lag) {
+    return (autocorrelation[lag] / autocorrelation[0]) / (windowAutocorrelation[lag] / windowAutocorrelation[0]);
+}
+
+
+@implementation ORKVoiceFeatureExtractor {
+    NSUInteger _fftLength;
+    vDSP_Length _fftLog2Length;
+    FFTSetup _fftSetup;
+    
+    float *_pending;
+    NSUInteger _pendingCount;
+    
+    float *_window;
+    float *_windowAutocorrelation;
+    float *_padded;
+    DSPSplitComplex _split;
+    
+    NSMutableData *_frames;
+    
+    // Running summary
+    double _levelSum;
+    double _zeroCrossingRateSum;
+    double _spectralCentroidSum;
+    double _spectralFlatnessSum;
+    NSUInteger _voicedCount;
+    double _pitchSum;
+    double _pitchSumOfSquares;
+    double _periodSum;
+    double _voicedPeakSum;
+    NSUInteger _perturbationCount;
+    double _periodDifferenceSum;
+    double _peakDifferenceSum;
+    BOOL _previousFrameVoiced;
+    double _previousPeriod;
+    double _previousPeak;
+}
+
+- (instancetype)initWithSampleRate:(double)sampleRate {
+    self = [super init];
+    if (self) {
+        _sampleRate = sampleRate;
+        _frameLength = 1;
+        while (_frameLength < sampleRate * ORKVoiceFeatureFrameDuration) {
+            _frameLength <<= 1;
+        }
+        _hopLength = _frameLength / 2;
+        
+        // Zero pad to twice the frame length, so the autocorrelation is linear rather than circular.
+        _fftLength = _frameLength * 2;
+        _fftLog2Length = (vDSP_Length)log2(_fftLength);
+        _fftSetup = vDSP_create_fftsetup(_fftLog2Length, kFFTRadix2);
+        
+        _pending = calloc(_frameLength, sizeof(float));
+        _window = calloc(_frameLength, sizeof(float));
+        _windowAutocorrelation = calloc(_fftLength, sizeof(float));
+        _padded = calloc(_fftLength, sizeof(float));
+        _split.realp = calloc(_fftLength / 2, sizeof(float));
+        _split.imagp = calloc(_fftLength / 2, sizeof(float));
+        _frames = [NSMutableData data];
+        
+        vDSP_hann_window(_window, _frameLength, vDSP_HANN_DENORM);
+        
+        // The autocorrelation of the window itself, used to undo its taper (Boersma, 1993).
+        memcpy(_padded, _window, _frameLength * sizeof(float));
+        [self autocorrelatePaddedBuffer];
+        memcpy(_windowAutocorrelation, _padded, _fftLength * sizeof(float));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    vDSP_destroy_fftsetup(_fftSetup);
+    free(_pending);
+    free(_window);
+    free(_windowAutocorrelation);
+    free(_padded);
+    free(_split.realp);
+    free(_split.imagp);
+}
+
+- (NSUInteger)frameCount {
+    return _frames.length / sizeof(ORKVoiceFeatureFrame);
+}
+
+- (void)appendSamples:(const float *)samples count:(NSUInteger)count {
+    while (count > 0) {
+        NSUInteger copied = MIN(count, _frameLength - _pendingCount);
+        memcpy(_pending + _pendingCount, samples, copied * sizeof(float));
+        _pendingCount += copied;
+        samples += copied;
+        count -= copied;
+        
+        if (_pendingCount == _frameLength) {
+            [self analyzePendingFrame];
+            memmove(_pending, _pending + _hopLength, (_frameLength - _hopLength) * sizeof(float));
+            _pendingCount = _frameLength - _hopLength;
+        }
+    }
+}
+
+// Forward transform of `_padded` into `_split`, packed as vDSP_fft_zrip output.
+- (void)transformPaddedBuffer {
+    vDSP_ctoz((const DSPComplex *)_padded, 2, &_split, 1, _fftLength / 2);
+    vDSP_fft_zrip(_fftSetup, &_split, 1, _fftLog2Length, FFT_FORWARD);
+}
+
+// Replaces `_split` by its power spectrum, then `_padded` by its inverse transform.
+- (void)autocorrelateSplit {
+    float dc = _split.realp[0] * _split.realp[0];
+    float nyquist = _split.imagp[0] * _split.imagp[0];
+    vDSP_zvmags(&_split, 1, _split.realp, 1, _fftLength / 2);
+    vDSP_vclr(_split.imagp, 1, _fftLength / 2);
+    _split.realp[0] = dc;
+    _split.imagp[0] = nyquist;
+    vDSP_fft_zrip(_fftSetup, &_split, 1, _fftLog2Length, FFT_INVERSE);
+    vDSP_ztoc(&_split, 1, (DSPComplex *)_padded, 2, _fftLength / 2);
+}
+
+- (void)autocorrelatePaddedBuffer {
+    [self transformPaddedBuffer];
+    [self autocorrelateSplit];
+}
+
+- (void)analyzePendingFrame {
+    const vDSP_Length frameLength = _frameLength;
+    ORKVoiceFeatureFrame frame;
+    
+    float rms = 0;
+    vDSP_rmsqv(_pending, 1, &rms, frameLength);
+    frame.level = (float)MAX(20 * log10(rms), ORKVoiceFeatureFloorLevel);
+    
+    vDSP_maxmgv(_pending, 1, &frame.peak, frameLength);
+    
+    NSUInteger crossings = 0;
+    for (NSUInteger i = 1; i < frameLength; i++) {
+        crossings += ((_pending[i - 1] < 0) != (_pending[i] < 0));
+    }
+    frame.zeroCrossingRate = (float)(crossings * _sampleRate / (frameLength - 1));
+    
+    vDSP_vmul(_pending, 1, _window, 1, _padded, 1, frameLength);
+    vDSP_vclr(_padded + frameLength, 1, _fftLength - frameLength);
+    [self transformPaddedBuffer];
+    
+    // Spectral summaries over the bins between DC and Nyquist.
+    const NSUInteger binCount = _fftLength / 2;
+    double powerSum = 0;
+    double weightedSum = 0;
+    double logPowerSum = 0;
+    for (NSUInteger bin = 1; bin < binCount; bin++) {
+        double power = (double)_split.realp[bin] * _split.realp[bin] + (double)_split.imagp[bin] * _split.imagp[bin] + 1e-20;
+        powerSum += power;
+        weightedSum += power * bin;
+        logPowerSum += log(power);
+    }
+    frame.spectralCentroid = (float)(weightedSum / powerSum * _sampleRate / _fftLength);
+    frame.spectralFlatness = (float)(exp(logPowerSum / (binCount - 1)) / (powerSum / (binCount - 1)));
+    
+    // Pitch from the window-corrected, normalized autocorrelation.
+    [self autocorrelateSplit];
+    frame.pitch = 0;
+    if (_padded[0] > 0 && frame.level > ORKVoiceFeatureSilenceLevel) {
+        NSUInteger minimumLag = (NSUInteger)floor(_sampleRate / ORKVoiceFeatureMaximumPitch);
+        NSUInteger maximumLag = MIN((NSUInteger)ceil(_sampleRate / ORKVoiceFeatureMinimumPitch), frameLength / 2);
+        double bestValue = 0;
+        NSUInteger bestLag = 0;
+        for (NSUInteger lag = minimumLag; lag <= maximumLag; lag++) {
+            double value = ORKVoiceFeatureNormalizedAutocorrelation(_padded, _windowAutocorrelation, lag);
+            if (value > bestValue) {
+                bestValue = value;
+                bestLag = lag;
+            }
+        }
+        if (bestValue > ORKVoiceFeatureVoicingThreshold && bestLag > minimumLag && bestLag < maximumLag) {
+            double before = ORKVoiceFeatureNormalizedAutocorrelation(_padded, _windowAutocorrelation, bestLag - 1);
+            double after = ORKVoiceFeatureNormalizedAutocorrelation(_padded, _windowAutocorrelation, bestLag + 1);
+            double curvature = before - 2 * bestValue + after;
+            double offset = (curvature < 0) ? 0.5 * (before - after) / curvature : 0;
+            frame.pitch = (float)(_sampleRate / (bestLag + offset));
+        }
+    }
+    
+    [_frames appendBytes:&frame length:sizeof(frame)];
+    [self updateSummaryWithFrame:&frame];
+}
+
+- (void)updateSummaryWithFrame:(const ORKVoiceFeatureFrame *)frame {
+    _levelSum += frame->level;
+    _zeroCrossingRateSum += frame->zeroCrossingRate;
+    _spectralCentroidSum += frame->spectralCentroid;
+    _spectralFlatnessSum += frame->spectralFlatness;
+    
+    BOOL voiced = (frame->pitch > 0);
+    if (voiced) {
+        double period = 1.0 / frame->pitch;
+        _voicedCount++;
+        _pitchSum += frame->pitch;
+        _pitchSumOfSquares += (double)frame->pitch * frame->pitch;
+        _periodSum += period;
+        _voicedPeakSum += frame->peak;
+        if (_previousFrameVoiced) {
+            _perturbationCount++;
+            _periodDifferenceSum += fabs(period - _previousPeriod);
+            _peakDifferenceSum += fabs(frame->peak - _previousPeak);
+        }
+        _previousPeriod = period;
+        _previousPeak = frame->peak;
+    }
+    _previousFrameVoiced = voiced;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)summary {
+    NSUInteger frameCount = self.frameCount;
+    double frames = MAX(frameCount, 1);
+    double voiced = MAX(_voicedCount, 1);
+    double meanPitch = _pitchSum / voiced;
+    double pitchVariance = MAX(_pitchSumOfSquares / voiced - meanPitch * meanPitch, 0);
+    double jitter = (_perturbationCount > 0) ? (_periodDifferenceSum / _perturbationCount) / (_periodSum / voiced) : 0;
+    double shimmer = (_perturbationCount > 0 && _voicedPeakSum > 0) ? (_peakDifferenceSum / _perturbationCount) / (_voicedPeakSum / voiced) : 0;
+    
+    return @{ @"frameCount": @(frameCount),
+              @"voicedFrameFraction": @(_voicedCount / frames),
+              @"meanLevel": @(_levelSum / frames),
+              @"meanZeroCrossingRate": @(_zeroCrossingRateSum / frames),
+              @"meanSpectralCentroid": @(_spectralCentroidSum / frames),
+              @"meanSpectralFlatness": @(_spectralFlatnessSum / frames),
+              @"meanPitch": @(meanPitch),
+              @"pitchStandardDeviation": @(sqrt(pitchVariance)),
+              @"jitter": @(jitter),
+              @"shimmer": @(shimmer) };
+}
+
+- (NSDictionary<NSString *, id> *)JSONObject {
+    NSUInteger frameCount = self.frameCount;
+    const ORKVoiceFeatureFrame *frames = _frames.bytes;
+    
+    NSMutableArray *level = [NSMutableArray arrayWithCapacity:frameCount];
+    NSMutableArray *zeroCrossingRate = [NSMutableArray arrayWithCapacity:frameCount];
+    NSMutableArray *peak = [NSMutableArray arrayWithCapacity:frameCount];
+    NSMutableArray *pitch = [NSMutableArray arrayWithCapacity:frameCount];
+    NSMutableArray *spectralCentroid = [NSMutableArray arrayWithCapacity:frameCount];
+    NSMutableArray *spectralFlatness = [NSMutableArray arrayWithCapacity:frameCount];
+    for (NSUInteger i = 0; i < frameCount; i++) {
+        [level addObject:@(frames[i].level)];
+        [zeroCrossingRate addObject:@(frames[i].zeroCrossingRate)];
+        [peak addObject:@(frames[i].peak)];
+        [pitch addObject:@(frames[i].pitch)];
+        [spectralCentroid addObject:@(frames[i].spectralCentroid)];
+        [spectralFlatness addObject:@(frames[i].spectralFlatness)];
+    }
+    
+    return @{ @"sampleRate": @(_sampleRate),
+              @"frameLength": @(_frameLength),
+              @"hopLength": @(_hopLength),
+              @"summary": [self summary],
+              @"frames": @{ @"level": level,
+                            @"zeroCrossingRate": zeroCrossingRate,
+                            @"peak": peak,
+                            @"pitch": pitch,
+                            @"spectralCentroid": spectralCentroid,
+                            @"spectralFlatness": spectralFlatness } };
+}
+
+@end
@@ -37,7 +37,11 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface UITouch (ORKJSONDictionary)
 
-- (NSDictionary *)ork_JSONDictionaryInView:(UIView *)view allTouches:(NSArray *)allTouches;
+/**
+ Returns the JSON dictionary of the touch, where `index` identifies the touch among the touches
+ of the recording.
+ */
+- (NSDictionary *)ork_JSONDictionaryInView:(UIView *)view index:(NSUInteger)index;
 
 @end
 
@@ -34,14 +34,14 @@
 
 @implementation UITouch (ORKJSONDictionary)
 
-- (NSDictionary *)ork_JSONDictionaryInView:(UIView *)view allTouches:(NSArray *)allTouches {
+- (NSDictionary *)ork_JSONDictionaryInView:(UIView *)view index:(NSUInteger)index {
     CGPoint point = [self locationInView:view];
     
     CGRect touchViewBounds = view.bounds;
     
     NSDictionary *dictionary = @{@"timestamp": [NSDecimalNumber numberWithDouble:self.timestamp],
                                  @"phase": @(self.phase),
-                                 @"index": @([allTouches indexOfObject:self]),
+                                 @"index": @(index),
                                  @"x": @(point.x),
                                  @"y": @(point.y),
                                  @"width": @(touchViewBounds.size.width),
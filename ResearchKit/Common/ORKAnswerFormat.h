@@ -154,6 +154,7 @@ typedef NS_ENUM(NSInteger, ORKNumberFormattingStyle) {
 @class ORKValuePickerAnswerFormat;
 @class ORKImageChoiceAnswerFormat;
 @class ORKTextChoiceAnswerFormat;
+@class ORKSearchableChoiceAnswerFormat;
 @class ORKBooleanAnswerFormat;
 @class ORKNumericAnswerFormat;
 @class ORKTimeOfDayAnswerFormat;
@@ -233,6 +234,8 @@ ORK_CLASS_AVAILABLE
 + (ORKTextChoiceAnswerFormat *)choiceAnswerFormatWithStyle:(ORKChoiceAnswerStyle)style
                                                textChoices:(NSArray<ORKTextChoice *> *)textChoices;
 
++ (ORKSearchableChoiceAnswerFormat *)searchableChoiceAnswerFormatWithChoicesFileURL:(NSURL *)choicesFileURL;
+
 + (ORKNumericAnswerFormat *)decimalAnswerFormatWithUnit:(nullable NSString *)unit;
 + (ORKNumericAnswerFormat *)integerAnswerFormatWithUnit:(nullable NSString *)unit;
 
@@ -769,6 +772,51 @@ ORK_CLASS_AVAILABLE
 @end
 
 
+/**
+ The `ORKSearchableChoiceAnswerFormat` class represents an answer format that lets participants
+ find and pick one choice from a very large list, such as a list of medications or diagnosis codes,
+ by typing part of its text.
+ 
+ The choices are read from a UTF-8 text file with one choice per line. Each line holds the text of
+ the choice, optionally followed by a tab and the value to report, and optionally by a further tab
+ and the detail text. When a line has no value, its text is used as the value. The file is memory
+ mapped and indexed in the background when the question is first presented, so the choices are
+ never all held in memory; only the best matches for the current search are displayed.
+ 
+ The searchable choice answer format can only be used with an `ORKQuestionStep` object. It reports
+ itself as being of the single choice question type, and produces an `ORKChoiceQuestionResult`
+ object whose answer is an array containing the value of the selected choice.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKSearchableChoiceAnswerFormat : ORKAnswerFormat
+
++ (instancetype)new NS_UNAVAILABLE;
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Returns an initialized searchable choice answer format using the specified choices file.
+ 
+ @param choicesFileURL  The URL of a local file containing the choices, one per line.
+ 
+ @return An initialized searchable choice answer format.
+ */
+- (instancetype)initWithChoicesFileURL:(NSURL *)choicesFileURL NS_DESIGNATED_INITIALIZER;
+
+/**
+ The URL of the local file containing the choices. (read-only)
+ */
+@property (copy, readonly) NSURL *choicesFileURL;
+
+/**
+ The maximum number of matching choices that are displayed for a search.
+ 
+ The default value of this property is 50.
+ */
+@property NSUInteger maximumNumberOfResults;
+
+@end
+
+
 /**
  The `ORKBooleanAnswerFormat` class behaves the same as the `ORKTextChoiceAnswerFormat` class,
  except that it is preconfigured to use only Yes and No answers.
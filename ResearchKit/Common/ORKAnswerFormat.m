@@ -40,6 +40,7 @@
 #import "ORKHealthAnswerFormat.h"
 #import "ORKResult_Private.h"
 #import "ORKChoiceAnswerFormatHelper.h"
+#import "ORKSearchableChoiceIndex.h"
 
 
 NSString *const EmailValidationRegex = @"[A-Z0-9a-z._%+-]+@[A-Za-z0-9.-]+\\.[A-Za-z]{2,6}";
@@ -303,6 +304,10 @@ NSNumberFormatterStyle ORKNumberFormattingStyleConvert(ORKNumberFormattingStyle
     return [[ORKTextChoiceAnswerFormat alloc] initWithStyle:style textChoices:textChoices];
 }
 
++ (ORKSearchableChoiceAnswerFormat *)searchableChoiceAnswerFormatWithChoicesFileURL:(NSURL *)choicesFileURL {
+    return [[ORKSearchableChoiceAnswerFormat alloc] initWithChoicesFileURL:choicesFileURL];
+}
+
 + (ORKNumericAnswerFormat *)decimalAnswerFormatWithUnit:(NSString *)unit {
     return [[ORKNumericAnswerFormat alloc] initWithStyle:ORKNumericAnswerStyleDecimal unit:unit minimum:nil maximum:nil];
 }
@@ -774,6 +779,114 @@ static NSArray *ork_processTextChoices(NSArray<ORKTextChoice *> *textChoices) {
 @end
 
 
+#pragma mark - ORKSearchableChoiceAnswerFormat
+
+static const NSUInteger ORKSearchableChoiceDefaultMaximumNumberOfResults = 50;
+
+@implementation ORKSearchableChoiceAnswerFormat {
+    ORKSearchableChoiceIndex *_choiceIndex;
+}
+
++ (instancetype)new {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithChoicesFileURL:(NSURL *)choicesFileURL {
+    self = [super init];
+    if (self) {
+        _choicesFileURL = [choicesFileURL copy];
+        _maximumNumberOfResults = ORKSearchableChoiceDefaultMaximumNumberOfResults;
+    }
+    return self;
+}
+
+- (void)validateParameters {
+    [super validateParameters];
+    
+    if (!_choicesFileURL.isFileURL) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException
+                                       reason:@"The choices of a searchable choice answer format must be in a local file."
+                                     userInfo:nil];
+    }
+    if (_maximumNumberOfResults == 0) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException
+                                       reason:@"The maximum number of results must be greater than zero."
+                                     userInfo:nil];
+    }
+}
+
+- (ORKSearchableChoiceIndex *)choiceIndex {
+    // Shared by everything presenting this answer format, so the file is indexed only once
+    @synchronized (self) {
+        if (!_choiceIndex) {
+            _choiceIndex = [[ORKSearchableChoiceIndex alloc] initWithFileURL:_choicesFileURL];
+        }
+        return _choiceIndex;
+    }
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKSearchableChoiceAnswerFormat *answerFormat = [[[self class] allocWithZone:zone] initWithChoicesFileURL:_choicesFileURL];
+    answerFormat->_maximumNumberOfResults = _maximumNumberOfResults;
+    answerFormat->_choiceIndex = [self choiceIndex];
+    return answerFormat;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            ORKEqualObjects(self.choicesFileURL, castObject.choicesFileURL) &&
+            (_maximumNumberOfResults == castObject.maximumNumberOfResults));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ _choicesFileURL.hash ^ _maximumNumberOfResults;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_URL_BOOKMARK(aDecoder, choicesFileURL);
+        ORK_DECODE_INTEGER(aDecoder, maximumNumberOfResults);
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_URL_BOOKMARK(aCoder, choicesFileURL);
+    ORK_ENCODE_INTEGER(aCoder, maximumNumberOfResults);
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (ORKQuestionType)questionType {
+    return ORKQuestionTypeSingleChoice;
+}
+
+- (Class)questionResultClass {
+    return [ORKChoiceQuestionResult class];
+}
+
+- (NSString *)stringForAnswer:(id)answer {
+    id value = [answer isKindOfClass:[NSArray class]] ? [(NSArray *)answer firstObject] : nil;
+    if (value == nil) {
+        return nil;
+    }
+    return [[self choiceIndex] textChoiceForValue:value].text;
+}
+
+@end
+
+
 #pragma mark - ORKTextChoice
 
 @implementation ORKTextChoice {
@@ -944,16 +1057,22 @@ static NSArray *ork_processTextChoices(NSArray<ORKTextChoice *> *textChoices) {
 
 #pragma mark - ORKBooleanAnswerFormat
 
-@implementation ORKBooleanAnswerFormat
+@implementation ORKBooleanAnswerFormat {
+    // The Boolean format has no options, so its implied choice format never changes once built.
+    ORKTextChoiceAnswerFormat *_impliedAnswerFormat;
+}
 
 - (ORKQuestionType)questionType {
     return ORKQuestionTypeBoolean;
 }
 
 - (ORKAnswerFormat *)impliedAnswerFormat {
-    return [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleSingleChoice
-                                            textChoices:@[[ORKTextChoice choiceWithText:ORKLocalizedString(@"BOOL_YES",nil) value:@(YES)],
-                                                          [ORKTextChoice choiceWithText:ORKLocalizedString(@"BOOL_NO",nil) value:@(NO)]]];
+    if (!_impliedAnswerFormat) {
+        _impliedAnswerFormat = [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleSingleChoice
+                                                                textChoices:@[[ORKTextChoice choiceWithText:ORKLocalizedString(@"BOOL_YES",nil) value:@(YES)],
+                                                                              [ORKTextChoice choiceWithText:ORKLocalizedString(@"BOOL_NO",nil) value:@(NO)]]];
+    }
+    return _impliedAnswerFormat;
 }
 
 - (Class)questionResultClass {
@@ -2069,6 +2188,12 @@ static NSArray *ork_processTextChoices(NSArray<ORKTextChoice *> *textChoices) {
     return (_maximumLength == 0 || text.length <= _maximumLength);
 }
 
+- (void)setValidationRegex:(NSString *)validationRegex {
+    _validationRegex = [validationRegex copy];
+    // Compiled lazily on the next validation
+    _cachedRegEx = nil;
+}
+
 - (BOOL)isTextRegexValidWithString:(NSString *)text {
     BOOL isValid = YES;
     if (self.validationRegex) {
@@ -52,6 +52,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (nullable NSNumber *)selectedIndexForAnswer:(nullable id)answer;
 - (NSArray *)selectedIndexesForAnswer:(nullable id)answer;
 
+// Indexes of text choices that are exclusive of all other choices.
+- (NSIndexSet *)exclusiveChoiceIndexes;
+
 - (nullable NSString *)stringForChoiceAnswer:(id)answer;
 
 @end
@@ -38,6 +38,9 @@
 @implementation ORKChoiceAnswerFormatHelper {
     NSArray *_choices;
     BOOL _isValuePicker;
+    // Built on first lookup; maps each choice value to the index of the first choice that has it.
+    NSDictionary<id, NSNumber *> *_indexesByValue;
+    NSIndexSet *_exclusiveChoiceIndexes;
 }
 
 - (instancetype)initWithAnswerFormat:(ORKAnswerFormat *)answerFormat {
@@ -69,6 +72,29 @@
     return _choices.count;
 }
 
+- (NSDictionary<id, NSNumber *> *)indexesByValue {
+    if (!_indexesByValue) {
+        NSMutableDictionary<id, NSNumber *> *indexesByValue = [NSMutableDictionary dictionaryWithCapacity:_choices.count];
+        [_choices enumerateObjectsUsingBlock:^(id<ORKAnswerOption> choice, NSUInteger index, BOOL *stop) {
+            id value = choice.value;
+            if (value && indexesByValue[value] == nil) {
+                indexesByValue[value] = @(index);
+            }
+        }];
+        _indexesByValue = [indexesByValue copy];
+    }
+    return _indexesByValue;
+}
+
+- (NSIndexSet *)exclusiveChoiceIndexes {
+    if (!_exclusiveChoiceIndexes) {
+        _exclusiveChoiceIndexes = [_choices indexesOfObjectsPassingTest:^BOOL(id choice, NSUInteger index, BOOL *stop) {
+            return [choice isKindOfClass:[ORKTextChoice class]] && ((ORKTextChoice *)choice).exclusive;
+        }];
+    }
+    return _exclusiveChoiceIndexes;
+}
+
 - (id<ORKAnswerOption>)answerOptionAtIndex:(NSUInteger)index {
     if (index >= _choices.count) {
         return nil;
@@ -135,26 +161,21 @@
         
         NSAssert([answer isKindOfClass:[ORKChoiceQuestionResult answerClass] ], @"Wrong answer type");
         
+        NSDictionary<id, NSNumber *> *indexesByValue = [self indexesByValue];
         for (id answerValue in (NSArray *)answer) {
-            id<ORKAnswerOption> matchedChoice = nil;
-            for ( id<ORKAnswerOption> choice in _choices) {
-                if ([choice.value isEqual:answerValue]) {
-                    matchedChoice = choice;
-                    break;
-                }
-            }
+            NSNumber *matchedIndex = indexesByValue[answerValue];
             
-            if (nil == matchedChoice) {
+            if (nil == matchedIndex) {
+                // Choices without a value are answered by their index
                 NSAssert([answerValue isKindOfClass:[NSNumber class]], @"");
-                if (_isValuePicker) {
-                    matchedChoice = _choices[((NSNumber *)answerValue).unsignedIntegerValue + 1];
-                } else {
-                    matchedChoice = _choices[((NSNumber *)answerValue).unsignedIntegerValue];
+                NSUInteger index = ((NSNumber *)answerValue).unsignedIntegerValue + (_isValuePicker ? 1 : 0);
+                if (index < _choices.count) {
+                    matchedIndex = @(index);
                 }
             }
             
-            if (matchedChoice) {
-                [indexArray addObject:@([_choices indexOfObject:matchedChoice])];
+            if (matchedIndex) {
+                [indexArray addObject:matchedIndex];
             }
         }
     }
@@ -42,6 +42,7 @@
 #import "ORKChoiceViewCell.h"
 #import "ORKSkin.h"
 #import "ORKCaption1Label.h"
+#import "ORKTextMeasurementCache.h"
 #import "ORKFormSectionTitleLabel.h"
 #import "ORKStep_Private.h"
 #import "ORKTextChoiceCellGroup.h"
@@ -98,15 +99,10 @@
 }
 
 - (CGFloat)labelWidth {
-    static ORKCaption1Label *sharedLabel;
-    
-    if (sharedLabel == nil) {
-        sharedLabel = [ORKCaption1Label new];
-    }
-    
-    sharedLabel.text = _formItem.text;
-    
-    return [sharedLabel textRectForBounds:CGRectInfinite limitedToNumberOfLines:1].size.width;
+    CGSize size = [[ORKTextMeasurementCache sharedCache] sizeOfString:_formItem.text
+                                                                 font:[ORKCaption1Label defaultFont]
+                                                                width:CGFLOAT_MAX];
+    return ceil(size.width);
 }
 
 @end
@@ -134,7 +130,11 @@
 @end
 
 
-@implementation ORKTableSection
+@implementation ORKTableSection {
+    // The widest label is measured once per font, rather than for every cell the section creates.
+    CGFloat _maxLabelWidth;
+    UIFont *_maxLabelWidthFont;
+}
 
 - (instancetype)initWithSectionIndex:(NSUInteger)index {
     self = [super init];
@@ -151,6 +151,8 @@
 }
 
 - (void)addFormItem:(ORKFormItem *)item {
+    _maxLabelWidthFont = nil;
+    
     if ([[item impliedAnswerFormat] isKindOfClass:[ORKTextChoiceAnswerFormat class]]) {
         _hasChoiceRows = YES;
         ORKTextChoiceAnswerFormat *textChoiceAnswerFormat = (ORKTextChoiceAnswerFormat *)[item impliedAnswerFormat];
@@ -172,12 +174,20 @@
 }
 
 - (CGFloat)maxLabelWidth {
+    UIFont *font = [ORKCaption1Label defaultFont];
+    if ([font isEqual:_maxLabelWidthFont]) {
+        return _maxLabelWidth;
+    }
+    
     CGFloat max = 0;
     for (ORKTableCellItem *item in self.items) {
-        if (item.labelWidth > max) {
-            max = item.labelWidth;
+        CGFloat labelWidth = item.labelWidth;
+        if (labelWidth > max) {
+            max = labelWidth;
         }
     }
+    _maxLabelWidth = max;
+    _maxLabelWidthFont = font;
     return max;
 }
 
@@ -290,6 +300,14 @@
     NSMutableArray<ORKTableSection *> *_sections;
     BOOL _skipped;
     ORKFormItemCell *_currentFirstResponderCell;
+    
+    // Answer state per form item, updated as each answer changes so that button updates do not
+    // revalidate the whole form. Rebuilt when the step or the saved answers are replaced.
+    BOOL _answerStateIsCurrent;
+    NSDictionary<NSString *, ORKFormItem *> *_formItemsByIdentifier;
+    NSMutableSet<NSString *> *_answeredIdentifiers;
+    NSMutableSet<NSString *> *_invalidAnswerIdentifiers;
+    NSMutableSet<NSString *> *_missingRequiredAnswerIdentifiers;
 }
 
 - (instancetype)ORKFormStepViewController_initWithResult:(ORKResult *)result {
@@ -430,6 +448,7 @@
     }
     [_savedAnswers removeObjectForKey:identifier];
     _savedAnswerDates[identifier] = [NSDate date];
+    [self updateAnswerStateForIdentifier:identifier];
 }
 
 - (void)setAnswer:(id)answer forIdentifier:(NSString *)identifier {
@@ -452,6 +471,65 @@
     _savedAnswerDates[identifier] = [NSDate date];
     _savedSystemCalendars[identifier] = [NSCalendar currentCalendar];
     _savedSystemTimeZones[identifier] = [NSTimeZone systemTimeZone];
+    [self updateAnswerStateForIdentifier:identifier];
+}
+
+- (void)setSavedAnswers:(NSMutableDictionary *)savedAnswers {
+    _savedAnswers = savedAnswers;
+    _answerStateIsCurrent = NO;
+}
+
+- (void)updateAnswerStateForIdentifier:(NSString *)identifier {
+    if (!_answerStateIsCurrent) {
+        // Built from scratch on next use
+        return;
+    }
+    id answer = _savedAnswers[identifier];
+    ORKFormItem *item = _formItemsByIdentifier[identifier];
+    BOOL answered = (ORKIsAnswerEmpty(answer) == NO);
+    BOOL valid = answered && (!item || [item.impliedAnswerFormat isAnswerValid:answer]);
+    
+    if (answered) {
+        [_answeredIdentifiers addObject:identifier];
+    } else {
+        [_answeredIdentifiers removeObject:identifier];
+    }
+    if (answered && !valid) {
+        [_invalidAnswerIdentifiers addObject:identifier];
+    } else {
+        [_invalidAnswerIdentifiers removeObject:identifier];
+    }
+    if (item && !item.optional && !valid) {
+        [_missingRequiredAnswerIdentifiers addObject:identifier];
+    } else {
+        [_missingRequiredAnswerIdentifiers removeObject:identifier];
+    }
+}
+
+- (void)updateAnswerStateIfNeeded {
+    if (_answerStateIsCurrent) {
+        return;
+    }
+    NSMutableDictionary<NSString *, ORKFormItem *> *formItemsByIdentifier = [NSMutableDictionary new];
+    for (ORKFormItem *item in [self formItems]) {
+        if (item.identifier) {
+            formItemsByIdentifier[item.identifier] = item;
+        }
+    }
+    _formItemsByIdentifier = [formItemsByIdentifier copy];
+    _answeredIdentifiers = [NSMutableSet new];
+    _invalidAnswerIdentifiers = [NSMutableSet new];
+    _missingRequiredAnswerIdentifiers = [NSMutableSet new];
+    _answerStateIsCurrent = YES;
+    
+    for (NSString *identifier in _formItemsByIdentifier) {
+        [self updateAnswerStateForIdentifier:identifier];
+    }
+    for (NSString *identifier in _savedAnswers) {
+        if (!_formItemsByIdentifier[identifier]) {
+            [self updateAnswerStateForIdentifier:identifier];
+        }
+    }
 }
 
 // Override to monitor button title change
@@ -477,6 +555,7 @@
 
 - (void)stepDidChange {
     [super stepDidChange];
+    _answerStateIsCurrent = NO;
 
     [_tableContainer removeFromSuperview];
     _tableContainer = nil;
@@ -594,29 +673,18 @@
 }
 
 - (NSInteger)numberOfAnsweredFormItems {
-    return [self numberOfAnsweredFormItemsInDictionary:self.savedAnswers];
+    [self updateAnswerStateIfNeeded];
+    return _answeredIdentifiers.count;
 }
 
 - (BOOL)allAnsweredFormItemsAreValid {
-    for (ORKFormItem *item in [self formItems]) {
-        id answer = _savedAnswers[item.identifier];
-        if (ORKIsAnswerEmpty(answer) == NO && ![item.impliedAnswerFormat isAnswerValid:answer]) {
-            return NO;
-        }
-    }
-    return YES;
+    [self updateAnswerStateIfNeeded];
+    return (_invalidAnswerIdentifiers.count == 0);
 }
 
 - (BOOL)allNonOptionalFormItemsHaveAnswers {
-    for (ORKFormItem *item in [self formItems]) {
-        if (!item.optional) {
-            id answer = _savedAnswers[item.identifier];
-            if (ORKIsAnswerEmpty(answer) || ![item.impliedAnswerFormat isAnswerValid:answer]) {
-                return NO;
-            }
-        }
-    }
-    return YES;
+    [self updateAnswerStateIfNeeded];
+    return (_missingRequiredAnswerIdentifiers.count == 0);
 }
 
 - (BOOL)continueButtonEnabled {
@@ -761,96 +829,114 @@
     return [self numberOfRowsInSection:section];
 }
 
+static NSString *const _ORKChoiceCellReuseIdentifierPrefix = @"ORKChoiceViewCell-";
+
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
-    NSString *identifier = [NSString stringWithFormat:@"%ld-%ld",(long)indexPath.section, (long)indexPath.row];
+    ORKTableSection *section = (ORKTableSection *)_sections[indexPath.section];
+    ORKTableCellItem *cellItem = [section items][indexPath.row];
+    ORKFormItem *formItem = cellItem.formItem;
+    id answer = _savedAnswers[formItem.identifier];
+    
+    if (section.textChoiceCellGroup) {
+        // The rows of a choice section share one reuse identifier, so a long list only keeps its visible
+        // rows alive, and the group rebinds the choice text and selection to whichever cell is dequeued.
+        // Each section has its own identifier: a group tracks the cells it has bound, so a cell must not
+        // move to another section's group while the first one still maps a choice to it.
+        ORKTextChoiceCellGroup *group = section.textChoiceCellGroup;
+        if (!ORKEqualObjects(group.answer, answer)) {
+            [group setAnswer:answer];
+        }
+        NSString *reuseIdentifier = [_ORKChoiceCellReuseIdentifierPrefix stringByAppendingFormat:@"%ld", (long)indexPath.section];
+        ORKChoiceViewCell *choiceCell = [tableView dequeueReusableCellWithIdentifier:reuseIdentifier];
+        if (choiceCell) {
+            [group configureCell:choiceCell atIndexPath:indexPath];
+        } else {
+            choiceCell = [group cellAtIndexPath:indexPath withReuseIdentifier:reuseIdentifier];
+        }
+        choiceCell.userInteractionEnabled = !self.readOnlyMode;
+        return choiceCell;
+    }
+    
+    // Form item cells are built around their form item and hold editing state, so each keeps its own identifier.
+    NSString *identifier = formItem.identifier ? [@"formItem-" stringByAppendingString:formItem.identifier] : [NSString stringWithFormat:@"%ld-%ld", (long)indexPath.section, (long)indexPath.row];
     
     UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:identifier];
     
     if (cell == nil) {
-        ORKTableSection *section = (ORKTableSection *)_sections[indexPath.section];
-        ORKTableCellItem *cellItem = [section items][indexPath.row];
-        ORKFormItem *formItem = cellItem.formItem;
-        id answer = _savedAnswers[formItem.identifier];
+        ORKAnswerFormat *answerFormat = [cellItem.formItem impliedAnswerFormat];
+        ORKQuestionType type = answerFormat.questionType;
         
-        if (section.textChoiceCellGroup) {
-            [section.textChoiceCellGroup setAnswer:answer];
-            cell = [section.textChoiceCellGroup cellAtIndexPath:indexPath withReuseIdentifier:identifier];
-        } else {
-            ORKAnswerFormat *answerFormat = [cellItem.formItem impliedAnswerFormat];
-            ORKQuestionType type = answerFormat.questionType;
-            
-            Class class = nil;
-            switch (type) {
-                case ORKQuestionTypeSingleChoice:
-                case ORKQuestionTypeMultipleChoice: {
-                    if ([formItem.impliedAnswerFormat isKindOfClass:[ORKImageChoiceAnswerFormat class]]) {
-                        class = [ORKFormItemImageSelectionCell class];
-                    } else if ([formItem.impliedAnswerFormat isKindOfClass:[ORKValuePickerAnswerFormat class]]) {
-                        class = [ORKFormItemPickerCell class];
-                    }
-                    break;
-                }
-                    
-                case ORKQuestionTypeDateAndTime:
-                case ORKQuestionTypeDate:
-                case ORKQuestionTypeTimeOfDay:
-                case ORKQuestionTypeTimeInterval:
-                case ORKQuestionTypeHeight: {
+        Class class = nil;
+        switch (type) {
+            case ORKQuestionTypeSingleChoice:
+            case ORKQuestionTypeMultipleChoice: {
+                if ([formItem.impliedAnswerFormat isKindOfClass:[ORKImageChoiceAnswerFormat class]]) {
+                    class = [ORKFormItemImageSelectionCell class];
+                } else if ([formItem.impliedAnswerFormat isKindOfClass:[ORKValuePickerAnswerFormat class]]) {
                     class = [ORKFormItemPickerCell class];
-                    break;
-                }
-                    
-                case ORKQuestionTypeDecimal:
-                case ORKQuestionTypeInteger: {
-                    class = [ORKFormItemNumericCell class];
-                    break;
                 }
-                    
-                case ORKQuestionTypeText: {
-                    if ([formItem.answerFormat isKindOfClass:[ORKConfirmTextAnswerFormat class]]) {
-                        class = [ORKFormItemConfirmTextCell class];
+                break;
+            }
+                
+            case ORKQuestionTypeDateAndTime:
+            case ORKQuestionTypeDate:
+            case ORKQuestionTypeTimeOfDay:
+            case ORKQuestionTypeTimeInterval:
+            case ORKQuestionTypeHeight: {
+                class = [ORKFormItemPickerCell class];
+                break;
+            }
+                
+            case ORKQuestionTypeDecimal:
+            case ORKQuestionTypeInteger: {
+                class = [ORKFormItemNumericCell class];
+                break;
+            }
+                
+            case ORKQuestionTypeText: {
+                if ([formItem.answerFormat isKindOfClass:[ORKConfirmTextAnswerFormat class]]) {
+                    class = [ORKFormItemConfirmTextCell class];
+                } else {
+                    ORKTextAnswerFormat *textFormat = (ORKTextAnswerFormat *)answerFormat;
+                    if (!textFormat.multipleLines) {
+                        class = [ORKFormItemTextFieldCell class];
                     } else {
-                        ORKTextAnswerFormat *textFormat = (ORKTextAnswerFormat *)answerFormat;
-                        if (!textFormat.multipleLines) {
-                            class = [ORKFormItemTextFieldCell class];
-                        } else {
-                            class = [ORKFormItemTextCell class];
-                        }
+                        class = [ORKFormItemTextCell class];
                     }
-                    break;
-                }
-                    
-                case ORKQuestionTypeScale: {
-                    class = [ORKFormItemScaleCell class];
-                    break;
                 }
-                    
-                case ORKQuestionTypeLocation: {
-                    class = [ORKFormItemLocationCell class];
-                    break;
-                }
-                    
-                default:
-                    NSAssert(NO, @"SHOULD NOT FALL IN HERE %@ %@", @(type), answerFormat);
-                    break;
+                break;
             }
-            
-            if (class) {
-                if ([class isSubclassOfClass:[ORKChoiceViewCell class]]) {
-                    NSAssert(NO, @"SHOULD NOT FALL IN HERE");
-                } else {
-                    ORKFormItemCell *formCell = nil;
-                    formCell = [[class alloc] initWithReuseIdentifier:identifier formItem:formItem answer:answer maxLabelWidth:section.maxLabelWidth delegate:self];
-                    [_formItemCells addObject:formCell];
-                    [formCell setExpectedLayoutWidth:self.tableView.bounds.size.width];
-                    formCell.selectionStyle = UITableViewCellSelectionStyleNone;
-                    formCell.defaultAnswer = _savedDefaults[formItem.identifier];
-                    if (!_savedAnswers) {
-                        _savedAnswers = [NSMutableDictionary new];
-                    }
-                    formCell.savedAnswers = _savedAnswers;
-                    cell = formCell;
+                
+            case ORKQuestionTypeScale: {
+                class = [ORKFormItemScaleCell class];
+                break;
+            }
+                
+            case ORKQuestionTypeLocation: {
+                class = [ORKFormItemLocationCell class];
+                break;
+            }
+                
+            default:
+                NSAssert(NO, @"SHOULD NOT FALL IN HERE %@ %@", @(type), answerFormat);
+                break;
+        }
+        
+        if (class) {
+            if ([class isSubclassOfClass:[ORKChoiceViewCell class]]) {
+                NSAssert(NO, @"SHOULD NOT FALL IN HERE");
+            } else {
+                ORKFormItemCell *formCell = nil;
+                formCell = [[class alloc] initWithReuseIdentifier:identifier formItem:formItem answer:answer maxLabelWidth:section.maxLabelWidth delegate:self];
+                [_formItemCells addObject:formCell];
+                [formCell setExpectedLayoutWidth:self.tableView.bounds.size.width];
+                formCell.selectionStyle = UITableViewCellSelectionStyleNone;
+                formCell.defaultAnswer = _savedDefaults[formItem.identifier];
+                if (!_savedAnswers) {
+                    _savedAnswers = [NSMutableDictionary new];
                 }
+                formCell.savedAnswers = _savedAnswers;
+                cell = formCell;
             }
         }
     }
@@ -913,9 +999,11 @@
 }
 
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath {
-
-    if ([[self tableView:tableView cellForRowAtIndexPath:indexPath] isKindOfClass:[ORKChoiceViewCell class]]) {
-        ORKTableCellItem *cellItem = ([_sections[indexPath.section] items][indexPath.row]);
+    // Choice rows are exactly the rows of sections with a text choice group; asking the data source
+    // for the cell here would build a cell for every row measured.
+    ORKTableSection *section = _sections[indexPath.section];
+    if (section.textChoiceCellGroup) {
+        ORKTableCellItem *cellItem = section.items[indexPath.row];
         return [ORKChoiceViewCell suggestedCellHeightForShortText:cellItem.choice.text LongText:cellItem.choice.detailText inTableView:_tableView];
     }
     return UITableViewAutomaticDimension;
@@ -1004,7 +1092,7 @@ static NSString *const _ORKOriginalAnswersRestoreKey = @"originalAnswers";
 - (void)decodeRestorableStateWithCoder:(NSCoder *)coder {
     [super decodeRestorableStateWithCoder:coder];
     
-    _savedAnswers = [coder decodeObjectOfClass:[NSMutableDictionary class] forKey:_ORKSavedAnswersRestoreKey];
+    self.savedAnswers = [coder decodeObjectOfClass:[NSMutableDictionary class] forKey:_ORKSavedAnswersRestoreKey];
     _savedAnswerDates = [coder decodeObjectOfClass:[NSMutableDictionary class] forKey:_ORKSavedAnswerDatesRestoreKey];
     _savedSystemCalendars = [coder decodeObjectOfClass:[NSMutableDictionary class] forKey:_ORKSavedSystemCalendarsRestoreKey];
     _savedSystemTimeZones = [coder decodeObjectOfClass:[NSMutableDictionary class] forKey:_ORKSavedSystemTimeZonesRestoreKey];
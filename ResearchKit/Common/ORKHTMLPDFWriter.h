@@ -35,6 +35,8 @@
 
 @interface ORKHTMLPDFWriter : NSObject
 
++ (CGSize)defaultPageSize;
+
 - (void)writePDFFromHTML:(NSString *)html withCompletionBlock:(void (^)(NSData *data, NSError *error))completionBlock;
 
 @end
@@ -290,6 +290,14 @@ void ORKValidateArrayForObjectsOfClass(NSArray *array, Class expectedObjectClass
 
 void ORKRemoveConstraintsForRemovedViews(NSMutableArray *constraints, NSArray *removedViews);
 
+/*
+ Makes `constraints` the active set in place of `activeConstraints`, without removing and re-adding
+ constraints that did not change. An existing constraint that matches a new one in everything but
+ its constant is kept, with the new constant. Returns the active constraints, in the order of
+ `constraints`, with each new constraint replaced by the existing one it matched.
+ */
+NSArray<NSLayoutConstraint *> *ORKUpdateActiveConstraints(NSArray<NSLayoutConstraint *> *activeConstraints, NSArray<NSLayoutConstraint *> *constraints);
+
 extern const double ORKDoubleInvalidValue;
 
 extern const CGFloat ORKCGFloatInvalidValue;
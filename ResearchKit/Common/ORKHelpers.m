@@ -35,6 +35,7 @@
 #import <UIKit/UIKit.h>
 #import "ORKSkin.h"
 #import "ORKTypes.h"
+#import "ORKTextMeasurementCache.h"
 
 
 NSURL *ORKCreateRandomBaseURL() {
@@ -164,10 +165,9 @@ NSString *ORKFileProtectionFromMode(ORKFileProtectionMode mode) {
 }
 
 CGFloat ORKExpectedLabelHeight(UILabel *label) {
-    CGSize expectedLabelSize = [label.text boundingRectWithSize:CGSizeMake(label.frame.size.width, CGFLOAT_MAX)
-                                                        options:NSStringDrawingUsesLineFragmentOrigin
-                                                     attributes:@{ NSFontAttributeName : label.font }
-                                                        context:nil].size;
+    CGSize expectedLabelSize = [[ORKTextMeasurementCache sharedCache] sizeOfString:label.text
+                                                                              font:label.font
+                                                                             width:label.frame.size.width];
     return expectedLabelSize.height;
 }
 
@@ -530,6 +530,61 @@ void ORKRemoveConstraintsForRemovedViews(NSMutableArray *constraints, NSArray *r
     }
 }
 
+// Everything but the constant, so equivalent constraints share a key. Items are compared by identity.
+static NSString *ORKConstraintEquivalenceKey(NSLayoutConstraint *constraint) {
+    return [NSString stringWithFormat:@"%p.%ld.%ld.%p.%ld.%a.%a",
+            constraint.firstItem,
+            (long)constraint.firstAttribute,
+            (long)constraint.relation,
+            constraint.secondItem,
+            (long)constraint.secondAttribute,
+            (double)constraint.multiplier,
+            (double)constraint.priority];
+}
+
+NSArray<NSLayoutConstraint *> *ORKUpdateActiveConstraints(NSArray<NSLayoutConstraint *> *activeConstraints, NSArray<NSLayoutConstraint *> *constraints) {
+    // Unmatched active constraints by equivalence key, in their original order.
+    NSMutableDictionary<NSString *, NSMutableArray<NSLayoutConstraint *> *> *unmatchedConstraints = [NSMutableDictionary dictionaryWithCapacity:activeConstraints.count];
+    for (NSLayoutConstraint *activeConstraint in activeConstraints) {
+        NSString *key = ORKConstraintEquivalenceKey(activeConstraint);
+        NSMutableArray<NSLayoutConstraint *> *equivalentConstraints = unmatchedConstraints[key];
+        if (!equivalentConstraints) {
+            equivalentConstraints = [NSMutableArray new];
+            unmatchedConstraints[key] = equivalentConstraints;
+        }
+        [equivalentConstraints addObject:activeConstraint];
+    }
+    NSMutableArray<NSLayoutConstraint *> *resultConstraints = [NSMutableArray arrayWithCapacity:constraints.count];
+    NSMutableArray<NSLayoutConstraint *> *addedConstraints = [NSMutableArray new];
+    
+    for (NSLayoutConstraint *constraint in constraints) {
+        NSMutableArray<NSLayoutConstraint *> *equivalentConstraints = unmatchedConstraints[ORKConstraintEquivalenceKey(constraint)];
+        if (equivalentConstraints.count == 0) {
+            [resultConstraints addObject:constraint];
+            [addedConstraints addObject:constraint];
+        } else {
+            // Reuse the existing constraint, so the layout engine only sees a constant change.
+            NSLayoutConstraint *existingConstraint = equivalentConstraints.firstObject;
+            [equivalentConstraints removeObjectAtIndex:0];
+            if (existingConstraint.constant != constraint.constant) {
+                existingConstraint.constant = constraint.constant;
+            }
+            if (!existingConstraint.active) {
+                [addedConstraints addObject:existingConstraint];
+            }
+            [resultConstraints addObject:existingConstraint];
+        }
+    }
+    
+    NSMutableArray<NSLayoutConstraint *> *removedConstraints = [NSMutableArray new];
+    for (NSArray<NSLayoutConstraint *> *equivalentConstraints in unmatchedConstraints.objectEnumerator) {
+        [removedConstraints addObjectsFromArray:equivalentConstraints];
+    }
+    [NSLayoutConstraint deactivateConstraints:removedConstraints];
+    [NSLayoutConstraint activateConstraints:addedConstraints];
+    return resultConstraints;
+}
+
 const double ORKDoubleInvalidValue = DBL_MAX;
 
 const CGFloat ORKCGFloatInvalidValue = CGFLOAT_MAX;
@@ -156,7 +156,11 @@ typedef NS_OPTIONS(NSUInteger, ORKPredefinedTaskOption) {
     ORKPredefinedTaskOptionExcludeHeartRate = (1 << 6),
     
     /// Exclude audio data collection.
-    ORKPredefinedTaskOptionExcludeAudio = (1 << 7)
+    ORKPredefinedTaskOptionExcludeAudio = (1 << 7),
+    
+    /// Include an `ORKGaitResult` computed on the device from the device motion data of the walking
+    /// steps. Has no effect on tasks without walking steps, or when device motion is excluded.
+    ORKPredefinedTaskOptionIncludeGaitFeatures = (1 << 8)
 } ORK_ENUM_AVAILABLE;
 
 /**
@@ -225,6 +229,8 @@ typedef NS_OPTIONS(NSUInteger, ORKPredefinedTaskHandOption) {
  the user is asked to turn and reverse direction.
  
  The data collected by this task can include accelerometer, device motion, and pedometer data.
+ Include `ORKPredefinedTaskOptionIncludeGaitFeatures` in `options` to also receive an
+ `ORKGaitResult` for each walking step.
  
  @param identifier              The task identifier to use for this task, appropriate to the study.
  @param intendedUseDescription  A localized string describing the intended use of the data
@@ -265,6 +271,8 @@ typedef NS_OPTIONS(NSUInteger, ORKPredefinedTaskHandOption) {
  concentration.
  
  The data collected by this task can include accelerometer, device motion, and pedometer data.
+ Include `ORKPredefinedTaskOptionIncludeGaitFeatures` in `options` to also receive an
+ `ORKGaitResult` for each walking step.
  
  @param identifier              The task identifier to use for this task, appropriate to the study.
  @param intendedUseDescription  A localized string describing the intended use of the data
@@ -798,8 +798,10 @@ void ORKStepArrayAddStep(NSMutableArray *array, ORKStep *step) {
                                                                                                           frequency:100]];
             }
             if (!(ORKPredefinedTaskOptionExcludeDeviceMotion & options)) {
-                [recorderConfigurations addObject:[[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:ORKDeviceMotionRecorderIdentifier
-                                                                                                         frequency:100]];
+                ORKDeviceMotionRecorderConfiguration *deviceMotionConfiguration = [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:ORKDeviceMotionRecorderIdentifier
+                                                                                                                                         frequency:100];
+                deviceMotionConfiguration.extractsGaitFeatures = (options & ORKPredefinedTaskOptionIncludeGaitFeatures) != 0;
+                [recorderConfigurations addObject:deviceMotionConfiguration];
             }
 
             ORKWalkingTaskStep *walkingStep = [[ORKWalkingTaskStep alloc] initWithIdentifier:ORKShortWalkOutboundStepIdentifier];
@@ -827,8 +829,10 @@ void ORKStepArrayAddStep(NSMutableArray *array, ORKStep *step) {
                                                                                                           frequency:100]];
             }
             if (!(ORKPredefinedTaskOptionExcludeDeviceMotion & options)) {
-                [recorderConfigurations addObject:[[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:ORKDeviceMotionRecorderIdentifier
-                                                                                                         frequency:100]];
+                ORKDeviceMotionRecorderConfiguration *deviceMotionConfiguration = [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:ORKDeviceMotionRecorderIdentifier
+                                                                                                                                         frequency:100];
+                deviceMotionConfiguration.extractsGaitFeatures = (options & ORKPredefinedTaskOptionIncludeGaitFeatures) != 0;
+                [recorderConfigurations addObject:deviceMotionConfiguration];
             }
 
             ORKWalkingTaskStep *walkingStep = [[ORKWalkingTaskStep alloc] initWithIdentifier:ORKShortWalkReturnStepIdentifier];
@@ -935,8 +939,10 @@ void ORKStepArrayAddStep(NSMutableArray *array, ORKStep *step) {
                                                                                                           frequency:100]];
             }
             if (!(ORKPredefinedTaskOptionExcludeDeviceMotion & options)) {
-                [recorderConfigurations addObject:[[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:ORKDeviceMotionRecorderIdentifier
-                                                                                                         frequency:100]];
+                ORKDeviceMotionRecorderConfiguration *deviceMotionConfiguration = [[ORKDeviceMotionRecorderConfiguration alloc] initWithIdentifier:ORKDeviceMotionRecorderIdentifier
+                                                                                                                                         frequency:100];
+                deviceMotionConfiguration.extractsGaitFeatures = (options & ORKPredefinedTaskOptionIncludeGaitFeatures) != 0;
+                [recorderConfigurations addObject:deviceMotionConfiguration];
             }
             
             ORKWalkingTaskStep *walkingStep = [[ORKWalkingTaskStep alloc] initWithIdentifier:ORKShortWalkOutboundStepIdentifier];
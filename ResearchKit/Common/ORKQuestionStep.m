@@ -163,14 +163,18 @@
     return [impliedAnswerFormat isKindOfClass:[ORKTextAnswerFormat class]] && ![(ORKTextAnswerFormat *)impliedAnswerFormat multipleLines];
 }
 
+- (BOOL)isFormatSearchableChoice {
+    return [[self impliedAnswerFormat] isKindOfClass:[ORKSearchableChoiceAnswerFormat class]];
+}
+
 - (BOOL)isFormatFitsChoiceCells {
-    return ((self.questionType == ORKQuestionTypeSingleChoice && ![self isFormatChoiceWithImageOptions] && ![self isFormatChoiceValuePicker]) ||
+    return ((self.questionType == ORKQuestionTypeSingleChoice && ![self isFormatChoiceWithImageOptions] && ![self isFormatChoiceValuePicker] && ![self isFormatSearchableChoice]) ||
             (self.questionType == ORKQuestionTypeMultipleChoice && ![self isFormatChoiceWithImageOptions]) ||
             self.questionType == ORKQuestionTypeBoolean);
 }
 
 - (BOOL)formatRequiresTableView {
-    return [self isFormatFitsChoiceCells];
+    return [self isFormatFitsChoiceCells] || [self isFormatSearchableChoice];
 }
 
 @end
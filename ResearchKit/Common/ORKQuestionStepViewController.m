@@ -52,6 +52,7 @@
 #import "ORKTableContainerView.h"
 #import "ORKStep_Private.h"
 #import "ORKTextChoiceCellGroup.h"
+#import "ORKSearchableChoiceIndex.h"
 #import "ORKStepHeaderView_Internal.h"
 #import "ORKNavigationContainerView_Internal.h"
 #import "ORKQuestionStepView.h"
@@ -62,8 +63,14 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
     ORKQuestionSection_COUNT
 };
 
+typedef NS_ENUM(NSInteger, ORKSearchableChoiceSection) {
+    ORKSearchableChoiceSectionSearchField = 0,
+    ORKSearchableChoiceSectionResults,
+    ORKSearchableChoiceSection_COUNT
+};
+
 
-@interface ORKQuestionStepViewController () <UITableViewDataSource,UITableViewDelegate, ORKSurveyAnswerCellDelegate> {
+@interface ORKQuestionStepViewController () <UITableViewDataSource,UITableViewDelegate, ORKSurveyAnswerCellDelegate, UISearchBarDelegate> {
     id _answer;
     
     ORKTableContainerView *_tableContainer;
@@ -76,6 +83,12 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
     
     ORKTextChoiceCellGroup *_choiceCellGroup;
     
+    // Searchable choices: only the current matches are kept, as indexes into the choice index
+    ORKSearchableChoiceIndex *_searchableChoiceIndex;
+    NSArray<NSNumber *> *_searchResults;
+    UISearchBar *_searchBar;
+    UITableViewCell *_searchBarCell;
+    
     id _defaultAnswer;
     
     BOOL _visible;
@@ -148,6 +161,12 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
         _headerView = nil;
         _continueSkipView = nil;
         
+        _searchBar.delegate = nil;
+        _searchBar = nil;
+        _searchBarCell = nil;
+        _searchResults = nil;
+        _searchableChoiceIndex = nil;
+        
         [_questionView removeFromSuperview];
         _questionView = nil;
         
@@ -180,6 +199,9 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
                 _continueSkipView.skipEnabled = [self skipButtonEnabled];
                 _continueSkipView.skipButton.accessibilityTraits = UIAccessibilityTraitStaticText;
             }
+            if ([self.questionStep isFormatSearchableChoice]) {
+                [self setUpSearchableChoices];
+            }
             [_tableContainer setNeedsLayout];
         } else if (self.step) {
             _questionView = [ORKQuestionStepView new];
@@ -535,13 +557,130 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
     self.hasChangedAnswer = YES;
 }
 
+#pragma mark - Searchable choices
+
+- (void)setUpSearchableChoices {
+    _searchableChoiceIndex = [(ORKSearchableChoiceAnswerFormat *)_answerFormat choiceIndex];
+    _searchResults = @[];
+    
+    _searchBar = [UISearchBar new];
+    _searchBar.delegate = self;
+    _searchBar.searchBarStyle = UISearchBarStyleMinimal;
+    _searchBar.placeholder = ORKLocalizedString(@"PLACEHOLDER_SEARCH_CHOICES", nil);
+    _searchBar.autocorrectionType = UITextAutocorrectionTypeNo;
+    _searchBar.userInteractionEnabled = !self.readOnlyMode;
+    
+    [self searchChoicesWithQuery:nil];
+    
+    // Start from the text of a previous answer, looked up off the main thread since it scans the file
+    id value = [self.answer isKindOfClass:[NSArray class]] ? [(NSArray *)self.answer firstObject] : nil;
+    if (value) {
+        ORKSearchableChoiceIndex *choiceIndex = _searchableChoiceIndex;
+        UISearchBar *searchBar = _searchBar;
+        ORKWeakTypeOf(self) weakSelf = self;
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            NSString *text = [choiceIndex textChoiceForValue:value].text;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                ORKStrongTypeOf(self) strongSelf = weakSelf;
+                if (text && strongSelf && strongSelf->_searchBar == searchBar && searchBar.text.length == 0) {
+                    searchBar.text = text;
+                    [strongSelf searchChoicesWithQuery:text];
+                }
+            });
+        });
+    }
+}
+
+- (void)searchChoicesWithQuery:(NSString *)query {
+    ORKSearchableChoiceAnswerFormat *answerFormat = (ORKSearchableChoiceAnswerFormat *)_answerFormat;
+    UISearchBar *searchBar = _searchBar;
+    ORKWeakTypeOf(self) weakSelf = self;
+    [_searchableChoiceIndex searchWithQuery:query
+                     maximumNumberOfResults:answerFormat.maximumNumberOfResults
+                                 completion:^(NSArray<NSNumber *> *choiceIndexes) {
+                                     ORKStrongTypeOf(self) strongSelf = weakSelf;
+                                     if (strongSelf == nil || strongSelf->_searchBar != searchBar) {
+                                         return;
+                                     }
+                                     strongSelf->_searchResults = choiceIndexes;
+                                     [strongSelf.tableView reloadSections:[NSIndexSet indexSetWithIndex:ORKSearchableChoiceSectionResults]
+                                                         withRowAnimation:UITableViewRowAnimationNone];
+                                 }];
+}
+
+- (ORKTextChoice *)searchResultAtIndex:(NSInteger)index {
+    if (index < 0 || index >= (NSInteger)_searchResults.count) {
+        return nil;
+    }
+    return [_searchableChoiceIndex textChoiceAtIndex:_searchResults[index].unsignedIntegerValue];
+}
+
+- (UITableViewCell *)searchableChoiceCellForTableView:(UITableView *)tableView atIndexPath:(NSIndexPath *)indexPath {
+    if (indexPath.section == ORKSearchableChoiceSectionSearchField) {
+        if (_searchBarCell == nil) {
+            _searchBarCell = [[UITableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:nil];
+            _searchBarCell.selectionStyle = UITableViewCellSelectionStyleNone;
+            _searchBar.translatesAutoresizingMaskIntoConstraints = NO;
+            [_searchBarCell.contentView addSubview:_searchBar];
+            NSDictionary *views = @{@"searchBar": _searchBar};
+            [NSLayoutConstraint activateConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"H:|[searchBar]|" options:(NSLayoutFormatOptions)0 metrics:nil views:views]];
+            [NSLayoutConstraint activateConstraints:[NSLayoutConstraint constraintsWithVisualFormat:@"V:|[searchBar]|" options:(NSLayoutFormatOptions)0 metrics:nil views:views]];
+        }
+        return _searchBarCell;
+    }
+    
+    NSString *identifier = NSStringFromClass([ORKChoiceViewCell class]);
+    ORKChoiceViewCell *cell = [tableView dequeueReusableCellWithIdentifier:identifier];
+    if (cell == nil) {
+        cell = [[ORKChoiceViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:identifier];
+    }
+    ORKTextChoice *textChoice = [self searchResultAtIndex:indexPath.row];
+    cell.immediateNavigation = [self isStepImmediateNavigation];
+    cell.shortLabel.text = textChoice.text;
+    cell.longLabel.text = textChoice.detailText;
+    cell.selectedItem = (textChoice != nil && [self isSearchableChoiceSelected:textChoice]);
+    cell.userInteractionEnabled = !self.readOnlyMode;
+    [cell setNeedsLayout];
+    return cell;
+}
+
+- (BOOL)isSearchableChoiceSelected:(ORKTextChoice *)textChoice {
+    id answer = self.answer;
+    return [answer isKindOfClass:[NSArray class]] && [(NSArray *)answer containsObject:textChoice.value];
+}
+
+- (CGFloat)heightForSearchableChoiceRowAtIndexPath:(NSIndexPath *)indexPath {
+    if (indexPath.section == ORKSearchableChoiceSectionSearchField) {
+        return [_searchBar sizeThatFits:CGSizeMake(_tableView.bounds.size.width, CGFLOAT_MAX)].height;
+    }
+    ORKTextChoice *textChoice = [self searchResultAtIndex:indexPath.row];
+    return [ORKChoiceViewCell suggestedCellHeightForShortText:textChoice.text LongText:textChoice.detailText inTableView:_tableView];
+}
+
+#pragma mark - UISearchBarDelegate
+
+- (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText {
+    [self searchChoicesWithQuery:searchText];
+}
+
+- (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar {
+    [searchBar resignFirstResponder];
+}
+
 #pragma mark - UITableViewDataSource
 
 - (NSInteger)numberOfSectionsInTableView:(UITableView *)tableView {
+    if ([self.questionStep isFormatSearchableChoice]) {
+        return ORKSearchableChoiceSection_COUNT;
+    }
     return ORKQuestionSection_COUNT;
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
+    if ([self.questionStep isFormatSearchableChoice]) {
+        return (section == ORKSearchableChoiceSectionSearchField) ? 1 : _searchResults.count;
+    }
+    
     ORKAnswerFormat *impliedAnswerFormat = [_answerFormat impliedAnswerFormat];
     
     if (section == ORKQuestionSectionAnswer) {
@@ -620,16 +759,23 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
     // Section for Answer Area
     //////////////////////////////////
     
+    if ([self.questionStep isFormatSearchableChoice]) {
+        return [self searchableChoiceCellForTableView:tableView atIndexPath:indexPath];
+    }
+    
     static NSString *identifier = nil;
 
     assert (self.questionStep.isFormatFitsChoiceCells);
     
-    identifier = [NSStringFromClass([self class]) stringByAppendingFormat:@"%@", @(indexPath.row)];
+    identifier = NSStringFromClass([ORKChoiceViewCell class]);
     
+    // Choice cells are reused across rows; the group binds each dequeued cell to its choice.
     ORKChoiceViewCell *cell = [tableView dequeueReusableCellWithIdentifier:identifier];
     
     if (cell == nil) {
         cell = [_choiceCellGroup cellAtIndexPath:indexPath withReuseIdentifier:identifier];
+    } else {
+        [_choiceCellGroup configureCell:cell atIndexPath:indexPath];
     }
     
     cell.userInteractionEnabled = !self.readOnlyMode;
@@ -681,6 +827,9 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
 #pragma mark - UITableViewDelegate
 
 - (NSIndexPath *)tableView:(UITableView *)tableView willSelectRowAtIndexPath:(NSIndexPath *)indexPath {
+    if ([self.questionStep isFormatSearchableChoice]) {
+        return (indexPath.section == ORKSearchableChoiceSectionResults) ? indexPath : nil;
+    }
     if (indexPath.section != ORKQuestionSectionAnswer) {
         return nil;
     }
@@ -691,22 +840,39 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
 }
 
 - (BOOL)tableView:(UITableView *)tableView shouldHighlightRowAtIndexPath:(NSIndexPath *)indexPath {
+    if ([self.questionStep isFormatSearchableChoice]) {
+        return indexPath.section == ORKSearchableChoiceSectionResults;
+    }
     return indexPath.section == ORKQuestionSectionAnswer;
 }
 
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
     [tableView deselectRowAtIndexPath:indexPath animated:YES];
     
-    [_choiceCellGroup didSelectCellAtIndexPath:indexPath];
+    BOOL searchableChoice = [self.questionStep isFormatSearchableChoice];
+    if (!searchableChoice) {
+        [_choiceCellGroup didSelectCellAtIndexPath:indexPath];
+    }
     
     // Capture `isStepImmediateNavigation` before saving an answer.
     BOOL immediateNavigation = [self isStepImmediateNavigation];
     
-    id answer = (self.questionStep.questionType == ORKQuestionTypeBoolean) ? [_choiceCellGroup answerForBoolean] :[_choiceCellGroup answer];
+    id answer = nil;
+    if (searchableChoice) {
+        ORKTextChoice *textChoice = [self searchResultAtIndex:indexPath.row];
+        answer = textChoice ? @[textChoice.value] : ORKNullAnswerValue();
+        [_searchBar resignFirstResponder];
+    } else {
+        answer = (self.questionStep.questionType == ORKQuestionTypeBoolean) ? [_choiceCellGroup answerForBoolean] :[_choiceCellGroup answer];
+    }
     
     [self saveAnswer:answer];
     self.hasChangedAnswer = YES;
     
+    if (searchableChoice) {
+        [tableView reloadSections:[NSIndexSet indexSetWithIndex:ORKSearchableChoiceSectionResults] withRowAnimation:UITableViewRowAnimationNone];
+    }
+    
     if (immediateNavigation) {
         // Proceed as continueButton tapped
         ORKSuppressPerformSelectorWarning(
@@ -715,6 +881,10 @@ typedef NS_ENUM(NSInteger, ORKQuestionSection) {
 }
 
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath {
+    if ([self.questionStep isFormatSearchableChoice]) {
+        return [self heightForSearchableChoiceRowAtIndexPath:indexPath];
+    }
+    
     CGFloat height = [ORKSurveyAnswerCell suggestedCellHeightForView:tableView];
     
     switch (self.questionStep.questionType) {
@@ -40,6 +40,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)isFormatChoiceWithImageOptions;
 - (BOOL)isFormatFitsChoiceCells;
 - (BOOL)isFormatTextfield;
+- (BOOL)isFormatSearchableChoice;
 
 - (BOOL)formatRequiresTableView;
 
@@ -234,6 +234,45 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic) CGRect buttonRect2;
 
+/**
+ The mean interval between two consecutive taps on a button, in seconds.
+ */
+@property (nonatomic) NSTimeInterval meanTapInterval;
+
+/**
+ The variability of the rhythm, as the coefficient of variation (the standard deviation
+ divided by the mean) of the interval between two consecutive taps on a button.
+ */
+@property (nonatomic) double tapIntervalVariability;
+
+/**
+ The fraction of consecutive taps on a button that alternate between the two buttons.
+ */
+@property (nonatomic) double alternationAccuracy;
+
+/**
+ The slope of the least squares fit of the tap interval against time, in seconds per second.
+ 
+ A positive value indicates that tapping slows down over the course of the step.
+ */
+@property (nonatomic) double fatigueSlope;
+
+/**
+ Returns the samples in a compact binary format, suitable for transmission to a server:
+ a one byte version, followed by 13 bytes per sample (little endian 32-bit float timestamp,
+ x and y coordinates, and one byte for the button identifier).
+ */
+- (NSData *)packedSampleData;
+
+/**
+ Returns the samples encoded in `packedSampleData`, or `nil` if the data is not valid.
+ 
+ @param packedSampleData    Data returned by `packedSampleData`.
+ 
+ @return An array of `ORKTappingSample` objects, or `nil`.
+ */
++ (nullable NSArray<ORKTappingSample *> *)samplesWithPackedSampleData:(NSData *)packedSampleData;
+
 @end
 
 
@@ -677,6 +716,16 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, assign) NSTimeInterval totalTime;
 
+/**
+ The mean time needed to answer an addition (that is, the mean of all the samples times).
+ */
+@property (nonatomic, assign) NSTimeInterval meanTime;
+
+/**
+ The standard deviation of the time needed to answer an addition.
+ */
+@property (nonatomic, assign) NSTimeInterval timeStandardDeviation;
+
 /**
  The initial digit.
  */
@@ -789,6 +838,16 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, assign) double totalDistance;
 
+/**
+ The mean time of a peg move (ie. the mean of all samples time).
+ */
+@property (nonatomic, assign) NSTimeInterval meanTime;
+
+/**
+ The standard deviation of the time of a peg move.
+ */
+@property (nonatomic, assign) NSTimeInterval timeStandardDeviation;
+
 /**
  An array of collected samples, in which each item is an `ORKHolePegTestSample`
  object that represents a peg move.
@@ -940,6 +999,188 @@ ORK_CLASS_AVAILABLE
 @end
 
 
+/**
+ The `ORKGaitResult` class records gait features computed on the device from device motion
+ data during a walking step.
+ 
+ A gait result is generated by an `ORKDeviceMotionRecorder` object whose configuration has
+ `extractsGaitFeatures` set, in addition to the recorder's `ORKFileResult` object. The features
+ can be used to triage a session without analyzing the raw motion data.
+ 
+ Steps are detected from the vertical acceleration of the device, and turns from its rotation
+ about the vertical axis, so the features do not depend on how the device is held.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKGaitResult : ORKResult
+
+/**
+ The duration of the analyzed motion data, in seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval duration;
+
+/**
+ The number of steps detected.
+ */
+@property (nonatomic, assign) NSInteger numberOfSteps;
+
+/**
+ The walking cadence, in steps per minute.
+ */
+@property (nonatomic, assign) double cadence;
+
+/**
+ The mean time between consecutive steps, in seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval meanStepDuration;
+
+/**
+ The coefficient of variation of the step duration.
+ */
+@property (nonatomic, assign) double stepDurationVariability;
+
+/**
+ The mean stride (two consecutive steps) duration, in seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval meanStrideDuration;
+
+/**
+ The coefficient of variation of the stride duration.
+ */
+@property (nonatomic, assign) double strideDurationVariability;
+
+/**
+ The ratio of the shorter to the longer mean duration of alternate steps, from 0 to 1.
+ 
+ A value of 1 indicates that steps taken by either foot last equally long.
+ */
+@property (nonatomic, assign) double stepSymmetry;
+
+/**
+ The number of turns detected. A turn is a sustained rotation of at least 45 degrees.
+ */
+@property (nonatomic, assign) NSInteger numberOfTurns;
+
+/**
+ The mean duration of the turns detected, in seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval meanTurnDuration;
+
+/**
+ The mean angle of the turns detected, in degrees.
+ */
+@property (nonatomic, assign) double meanTurnAngle;
+
+@end
+
+
+/**
+ The `ORKTremorSpectrumResult` class records the power spectrum features of device motion,
+ computed on the device while recording.
+ 
+ A tremor spectrum result is generated by an `ORKDeviceMotionRecorder` object whose configuration
+ has `extractsTremorSpectrum` set, in addition to the recorder's `ORKFileResult` object.
+ 
+ Power is estimated with Welch's method over overlapping segments of about 2.5 seconds.
+ The spectrum of each signal sums the spectra of its three axes, so the features do not
+ depend on how the device is held.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKTremorSpectrumResult : ORKResult
+
+/**
+ The lower edge of the tremor frequency band, in hertz.
+ */
+@property (nonatomic, assign) double lowerBandFrequency;
+
+/**
+ The upper edge of the tremor frequency band, in hertz.
+ */
+@property (nonatomic, assign) double upperBandFrequency;
+
+/**
+ The number of overlapping segments averaged into the spectrum.
+ */
+@property (nonatomic, assign) NSInteger numberOfSegments;
+
+/**
+ The power of the user acceleration within the tremor band, in g squared.
+ */
+@property (nonatomic, assign) double userAccelerationBandPower;
+
+/**
+ The power of the user acceleration over all frequencies above 0 Hz, in g squared.
+ */
+@property (nonatomic, assign) double userAccelerationTotalPower;
+
+/**
+ The frequency of the highest user acceleration spectral peak within the tremor band, in hertz.
+ */
+@property (nonatomic, assign) double userAccelerationDominantFrequency;
+
+/**
+ The power of the rotation rate within the tremor band, in radians squared per second squared.
+ */
+@property (nonatomic, assign) double rotationRateBandPower;
+
+/**
+ The power of the rotation rate over all frequencies above 0 Hz, in radians squared per second squared.
+ */
+@property (nonatomic, assign) double rotationRateTotalPower;
+
+/**
+ The frequency of the highest rotation rate spectral peak within the tremor band, in hertz.
+ */
+@property (nonatomic, assign) double rotationRateDominantFrequency;
+
+@end
+
+
+/**
+ The `ORKLocationSummaryResult` class records a summary of the movement measured by location,
+ computed on the device while recording.
+ 
+ A location summary result is generated by an `ORKLocationRecorder` object whose configuration
+ has `summarizesMovement` set, in addition to the recorder's `ORKFileResult` object.
+ 
+ Distance and speed are computed on the locations kept by the recorder's location filter, that
+ is after smoothing and the distance and time thresholds, but before simplification.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKLocationSummaryResult : ORKResult
+
+/**
+ The number of locations received from CoreLocation.
+ */
+@property (nonatomic, assign) NSInteger numberOfLocations;
+
+/**
+ The number of locations recorded in the recorder's file.
+ */
+@property (nonatomic, assign) NSInteger numberOfRecordedLocations;
+
+/**
+ The distance covered, in meters.
+ */
+@property (nonatomic, assign) double totalDistance;
+
+/**
+ The time between the first and the last filtered locations.
+ */
+@property (nonatomic, assign) NSTimeInterval duration;
+
+/**
+ The distance covered divided by the duration, in meters per second.
+ */
+@property (nonatomic, assign) double averageSpeed;
+
+/**
+ The highest speed between two consecutive filtered locations, in meters per second.
+ */
+@property (nonatomic, assign) double maximumSpeed;
+
+@end
+
+
 /**
  The `ORKTextQuestionResult` class represents the answer to a question or
  form item that uses an `ORKTextAnswerFormat` format.
@@ -1337,6 +1578,28 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, copy, nullable) NSArray <UIBezierPath *> *signaturePath;
 
+/**
+ The sampled strokes of the signature in a compact, delta-encoded form.
+ 
+ Each stroke is a sequence of samples, each with a location in the signature view's coordinate
+ space, a timestamp relative to the start of the signature, and the normalized force (or, on
+ devices without force sensing, a pressure estimated from the speed of the stroke). The data is
+ typically a small fraction of the size of `signatureImage`.
+ 
+ Use `rasterizedSignatureImageWithScale:lineColor:` to draw the strokes into an image.
+ */
+@property (nonatomic, copy, nullable) NSData *signatureStrokeData;
+
+/**
+ Draws the strokes in `signatureStrokeData` into an image the size of the signature view.
+ 
+ @param scale       The scale factor of the image. Pass 0 to use the scale factor of the main screen.
+ @param lineColor   The color of the strokes.
+ 
+ @return An image of the signature, or `nil` if there is no valid stroke data.
+ */
+- (nullable UIImage *)rasterizedSignatureImageWithScale:(CGFloat)scale lineColor:(UIColor *)lineColor;
+
 @end
 
 NS_ASSUME_NONNULL_END
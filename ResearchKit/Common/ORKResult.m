@@ -36,11 +36,13 @@
 #import "ORKStep.h"
 #import "ORKHelpers.h"
 #import "ORKRecorder_Internal.h"
+#import "ORKTappingAnalyzer.h"
 #import "ORKQuestionStep.h"
 #import "ORKFormStep.h"
 #import "ORKAnswerFormat_Internal.h"
 #import "ORKConsentDocument.h"
 #import "ORKConsentSignature.h"
+#import "ORKSignatureStrokes.h"
 #import <CoreMotion/CoreMotion.h>
 #import <CoreLocation/CoreLocation.h>
 
@@ -624,6 +626,10 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
     ORK_ENCODE_CGRECT(aCoder, buttonRect1);
     ORK_ENCODE_CGRECT(aCoder, buttonRect2);
     ORK_ENCODE_CGSIZE(aCoder, stepViewSize);
+    ORK_ENCODE_DOUBLE(aCoder, meanTapInterval);
+    ORK_ENCODE_DOUBLE(aCoder, tapIntervalVariability);
+    ORK_ENCODE_DOUBLE(aCoder, alternationAccuracy);
+    ORK_ENCODE_DOUBLE(aCoder, fatigueSlope);
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
@@ -633,6 +639,10 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
         ORK_DECODE_CGRECT(aDecoder, buttonRect1);
         ORK_DECODE_CGRECT(aDecoder, buttonRect2);
         ORK_DECODE_CGSIZE(aDecoder, stepViewSize);
+        ORK_DECODE_DOUBLE(aDecoder, meanTapInterval);
+        ORK_DECODE_DOUBLE(aDecoder, tapIntervalVariability);
+        ORK_DECODE_DOUBLE(aDecoder, alternationAccuracy);
+        ORK_DECODE_DOUBLE(aDecoder, fatigueSlope);
     }
     return self;
 }
@@ -649,7 +659,11 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
             ORKEqualObjects(self.samples, castObject.samples) &&
             CGRectEqualToRect(self.buttonRect1, castObject.buttonRect1) &&
             CGRectEqualToRect(self.buttonRect2, castObject.buttonRect2) &&
-            CGSizeEqualToSize(self.stepViewSize, castObject.stepViewSize));
+            CGSizeEqualToSize(self.stepViewSize, castObject.stepViewSize) &&
+            (self.meanTapInterval == castObject.meanTapInterval) &&
+            (self.tapIntervalVariability == castObject.tapIntervalVariability) &&
+            (self.alternationAccuracy == castObject.alternationAccuracy) &&
+            (self.fatigueSlope == castObject.fatigueSlope));
 }
 
 - (NSUInteger)hash {
@@ -662,9 +676,21 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
     result.buttonRect1 = self.buttonRect1;
     result.buttonRect2 = self.buttonRect2;
     result.stepViewSize = self.stepViewSize;
+    result.meanTapInterval = self.meanTapInterval;
+    result.tapIntervalVariability = self.tapIntervalVariability;
+    result.alternationAccuracy = self.alternationAccuracy;
+    result.fatigueSlope = self.fatigueSlope;
     return result;
 }
 
+- (NSData *)packedSampleData {
+    return ORKTappingPackedSampleDataFromSamples(self.samples ? : @[]);
+}
+
++ (NSArray<ORKTappingSample *> *)samplesWithPackedSampleData:(NSData *)packedSampleData {
+    return ORKTappingSamplesFromPackedSampleData(packedSampleData);
+}
+
 - (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
     return [NSString stringWithFormat:@"%@; samples: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], self.samples, self.descriptionSuffix];
 }
@@ -825,6 +851,230 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
 @end
 
 
+@implementation ORKGaitResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_DOUBLE(aCoder, duration);
+    ORK_ENCODE_INTEGER(aCoder, numberOfSteps);
+    ORK_ENCODE_DOUBLE(aCoder, cadence);
+    ORK_ENCODE_DOUBLE(aCoder, meanStepDuration);
+    ORK_ENCODE_DOUBLE(aCoder, stepDurationVariability);
+    ORK_ENCODE_DOUBLE(aCoder, meanStrideDuration);
+    ORK_ENCODE_DOUBLE(aCoder, strideDurationVariability);
+    ORK_ENCODE_DOUBLE(aCoder, stepSymmetry);
+    ORK_ENCODE_INTEGER(aCoder, numberOfTurns);
+    ORK_ENCODE_DOUBLE(aCoder, meanTurnDuration);
+    ORK_ENCODE_DOUBLE(aCoder, meanTurnAngle);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_DOUBLE(aDecoder, duration);
+        ORK_DECODE_INTEGER(aDecoder, numberOfSteps);
+        ORK_DECODE_DOUBLE(aDecoder, cadence);
+        ORK_DECODE_DOUBLE(aDecoder, meanStepDuration);
+        ORK_DECODE_DOUBLE(aDecoder, stepDurationVariability);
+        ORK_DECODE_DOUBLE(aDecoder, meanStrideDuration);
+        ORK_DECODE_DOUBLE(aDecoder, strideDurationVariability);
+        ORK_DECODE_DOUBLE(aDecoder, stepSymmetry);
+        ORK_DECODE_INTEGER(aDecoder, numberOfTurns);
+        ORK_DECODE_DOUBLE(aDecoder, meanTurnDuration);
+        ORK_DECODE_DOUBLE(aDecoder, meanTurnAngle);
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.duration == castObject.duration) &&
+            (self.numberOfSteps == castObject.numberOfSteps) &&
+            (self.cadence == castObject.cadence) &&
+            (self.meanStepDuration == castObject.meanStepDuration) &&
+            (self.stepDurationVariability == castObject.stepDurationVariability) &&
+            (self.meanStrideDuration == castObject.meanStrideDuration) &&
+            (self.strideDurationVariability == castObject.strideDurationVariability) &&
+            (self.stepSymmetry == castObject.stepSymmetry) &&
+            (self.numberOfTurns == castObject.numberOfTurns) &&
+            (self.meanTurnDuration == castObject.meanTurnDuration) &&
+            (self.meanTurnAngle == castObject.meanTurnAngle));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ self.numberOfSteps ^ self.numberOfTurns;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKGaitResult *result = [super copyWithZone:zone];
+    result.duration = self.duration;
+    result.numberOfSteps = self.numberOfSteps;
+    result.cadence = self.cadence;
+    result.meanStepDuration = self.meanStepDuration;
+    result.stepDurationVariability = self.stepDurationVariability;
+    result.meanStrideDuration = self.meanStrideDuration;
+    result.strideDurationVariability = self.strideDurationVariability;
+    result.stepSymmetry = self.stepSymmetry;
+    result.numberOfTurns = self.numberOfTurns;
+    result.meanTurnDuration = self.meanTurnDuration;
+    result.meanTurnAngle = self.meanTurnAngle;
+    return result;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; steps: %@; cadence: %@; stepSymmetry: %@; strideVariability: %@; turns: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], @(self.numberOfSteps), @(self.cadence), @(self.stepSymmetry), @(self.strideDurationVariability), @(self.numberOfTurns), self.descriptionSuffix];
+}
+
+@end
+
+
+@implementation ORKTremorSpectrumResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_DOUBLE(aCoder, lowerBandFrequency);
+    ORK_ENCODE_DOUBLE(aCoder, upperBandFrequency);
+    ORK_ENCODE_INTEGER(aCoder, numberOfSegments);
+    ORK_ENCODE_DOUBLE(aCoder, userAccelerationBandPower);
+    ORK_ENCODE_DOUBLE(aCoder, userAccelerationTotalPower);
+    ORK_ENCODE_DOUBLE(aCoder, userAccelerationDominantFrequency);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateBandPower);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateTotalPower);
+    ORK_ENCODE_DOUBLE(aCoder, rotationRateDominantFrequency);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_DOUBLE(aDecoder, lowerBandFrequency);
+        ORK_DECODE_DOUBLE(aDecoder, upperBandFrequency);
+        ORK_DECODE_INTEGER(aDecoder, numberOfSegments);
+        ORK_DECODE_DOUBLE(aDecoder, userAccelerationBandPower);
+        ORK_DECODE_DOUBLE(aDecoder, userAccelerationTotalPower);
+        ORK_DECODE_DOUBLE(aDecoder, userAccelerationDominantFrequency);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateBandPower);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateTotalPower);
+        ORK_DECODE_DOUBLE(aDecoder, rotationRateDominantFrequency);
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.lowerBandFrequency == castObject.lowerBandFrequency) &&
+            (self.upperBandFrequency == castObject.upperBandFrequency) &&
+            (self.numberOfSegments == castObject.numberOfSegments) &&
+            (self.userAccelerationBandPower == castObject.userAccelerationBandPower) &&
+            (self.userAccelerationTotalPower == castObject.userAccelerationTotalPower) &&
+            (self.userAccelerationDominantFrequency == castObject.userAccelerationDominantFrequency) &&
+            (self.rotationRateBandPower == castObject.rotationRateBandPower) &&
+            (self.rotationRateTotalPower == castObject.rotationRateTotalPower) &&
+            (self.rotationRateDominantFrequency == castObject.rotationRateDominantFrequency));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ self.numberOfSegments;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKTremorSpectrumResult *result = [super copyWithZone:zone];
+    result.lowerBandFrequency = self.lowerBandFrequency;
+    result.upperBandFrequency = self.upperBandFrequency;
+    result.numberOfSegments = self.numberOfSegments;
+    result.userAccelerationBandPower = self.userAccelerationBandPower;
+    result.userAccelerationTotalPower = self.userAccelerationTotalPower;
+    result.userAccelerationDominantFrequency = self.userAccelerationDominantFrequency;
+    result.rotationRateBandPower = self.rotationRateBandPower;
+    result.rotationRateTotalPower = self.rotationRateTotalPower;
+    result.rotationRateDominantFrequency = self.rotationRateDominantFrequency;
+    return result;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; band: %@-%@ Hz; segments: %@; userAccelerationBandPower: %@; userAccelerationDominantFrequency: %@; rotationRateBandPower: %@; rotationRateDominantFrequency: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], @(self.lowerBandFrequency), @(self.upperBandFrequency), @(self.numberOfSegments), @(self.userAccelerationBandPower), @(self.userAccelerationDominantFrequency), @(self.rotationRateBandPower), @(self.rotationRateDominantFrequency), self.descriptionSuffix];
+}
+
+@end
+
+
+@implementation ORKLocationSummaryResult
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    ORK_ENCODE_INTEGER(aCoder, numberOfLocations);
+    ORK_ENCODE_INTEGER(aCoder, numberOfRecordedLocations);
+    ORK_ENCODE_DOUBLE(aCoder, totalDistance);
+    ORK_ENCODE_DOUBLE(aCoder, duration);
+    ORK_ENCODE_DOUBLE(aCoder, averageSpeed);
+    ORK_ENCODE_DOUBLE(aCoder, maximumSpeed);
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        ORK_DECODE_INTEGER(aDecoder, numberOfLocations);
+        ORK_DECODE_INTEGER(aDecoder, numberOfRecordedLocations);
+        ORK_DECODE_DOUBLE(aDecoder, totalDistance);
+        ORK_DECODE_DOUBLE(aDecoder, duration);
+        ORK_DECODE_DOUBLE(aDecoder, averageSpeed);
+        ORK_DECODE_DOUBLE(aDecoder, maximumSpeed);
+    }
+    return self;
+}
+
++ (BOOL)supportsSecureCoding {
+    return YES;
+}
+
+- (BOOL)isEqual:(id)object {
+    BOOL isParentSame = [super isEqual:object];
+    
+    __typeof(self) castObject = object;
+    return (isParentSame &&
+            (self.numberOfLocations == castObject.numberOfLocations) &&
+            (self.numberOfRecordedLocations == castObject.numberOfRecordedLocations) &&
+            (self.totalDistance == castObject.totalDistance) &&
+            (self.duration == castObject.duration) &&
+            (self.averageSpeed == castObject.averageSpeed) &&
+            (self.maximumSpeed == castObject.maximumSpeed));
+}
+
+- (NSUInteger)hash {
+    return super.hash ^ self.numberOfLocations;
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone {
+    ORKLocationSummaryResult *result = [super copyWithZone:zone];
+    result.numberOfLocations = self.numberOfLocations;
+    result.numberOfRecordedLocations = self.numberOfRecordedLocations;
+    result.totalDistance = self.totalDistance;
+    result.duration = self.duration;
+    result.averageSpeed = self.averageSpeed;
+    result.maximumSpeed = self.maximumSpeed;
+    return result;
+}
+
+- (NSString *)descriptionWithNumberOfPaddingSpaces:(NSUInteger)numberOfPaddingSpaces {
+    return [NSString stringWithFormat:@"%@; locations: %@/%@; distance: %@; duration: %@; averageSpeed: %@; maximumSpeed: %@%@", [self descriptionPrefixWithNumberOfPaddingSpaces:numberOfPaddingSpaces], @(self.numberOfRecordedLocations), @(self.numberOfLocations), @(self.totalDistance), @(self.duration), @(self.averageSpeed), @(self.maximumSpeed), self.descriptionSuffix];
+}
+
+@end
+
+
 @implementation ORKPSATSample
 
 + (BOOL)supportsSecureCoding {
@@ -889,6 +1139,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
     ORK_ENCODE_INTEGER(aCoder, totalCorrect);
     ORK_ENCODE_INTEGER(aCoder, totalDyad);
     ORK_ENCODE_DOUBLE(aCoder, totalTime);
+    ORK_ENCODE_DOUBLE(aCoder, meanTime);
+    ORK_ENCODE_DOUBLE(aCoder, timeStandardDeviation);
     ORK_ENCODE_INTEGER(aCoder, initialDigit);
     ORK_ENCODE_OBJ(aCoder, samples);
 }
@@ -903,6 +1155,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
         ORK_DECODE_INTEGER(aDecoder, totalCorrect);
         ORK_DECODE_INTEGER(aDecoder, totalDyad);
         ORK_DECODE_DOUBLE(aDecoder, totalTime);
+        ORK_DECODE_DOUBLE(aDecoder, meanTime);
+        ORK_DECODE_DOUBLE(aDecoder, timeStandardDeviation);
         ORK_DECODE_INTEGER(aDecoder, initialDigit);
         ORK_DECODE_OBJ_ARRAY(aDecoder, samples, ORKPSATSample);
     }
@@ -926,6 +1180,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
             (self.totalCorrect == castObject.totalCorrect) &&
             (self.totalDyad == castObject.totalDyad) &&
             (self.totalTime == castObject.totalTime) &&
+            (self.meanTime == castObject.meanTime) &&
+            (self.timeStandardDeviation == castObject.timeStandardDeviation) &&
             (self.initialDigit == castObject.initialDigit) &&
             ORKEqualObjects(self.samples, castObject.samples)) ;
 }
@@ -943,6 +1199,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
     result.totalCorrect = self.totalCorrect;
     result.totalDyad = self.totalDyad;
     result.totalTime = self.totalTime;
+    result.meanTime = self.meanTime;
+    result.timeStandardDeviation = self.timeStandardDeviation;
     result.initialDigit = self.initialDigit;
     result.samples = [self.samples copy];
     return result;
@@ -968,6 +1226,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
     ORK_ENCODE_INTEGER(aCoder, totalFailures);
     ORK_ENCODE_DOUBLE(aCoder, totalTime);
     ORK_ENCODE_DOUBLE(aCoder, totalDistance);
+    ORK_ENCODE_DOUBLE(aCoder, meanTime);
+    ORK_ENCODE_DOUBLE(aCoder, timeStandardDeviation);
     ORK_ENCODE_OBJ(aCoder, samples);
 }
 
@@ -983,6 +1243,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
         ORK_DECODE_INTEGER(aDecoder, totalFailures);
         ORK_DECODE_DOUBLE(aDecoder, totalTime);
         ORK_DECODE_DOUBLE(aDecoder, totalDistance);
+        ORK_DECODE_DOUBLE(aDecoder, meanTime);
+        ORK_DECODE_DOUBLE(aDecoder, timeStandardDeviation);
         ORK_DECODE_OBJ_ARRAY(aDecoder, samples, ORKToneAudiometrySample);
     }
     return self;
@@ -1006,6 +1268,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
             (self.totalFailures == castObject.totalFailures) &&
             (self.totalTime == castObject.totalTime) &&
             (self.totalDistance == castObject.totalDistance) &&
+            (self.meanTime == castObject.meanTime) &&
+            (self.timeStandardDeviation == castObject.timeStandardDeviation) &&
             ORKEqualObjects(self.samples, castObject.samples)) ;
 }
 
@@ -1024,6 +1288,8 @@ const NSUInteger NumberOfPaddingSpacesForIndentationLevel = 4;
     result.totalFailures = self.totalFailures;
     result.totalTime = self.totalTime;
     result.totalDistance = self.totalDistance;
+    result.meanTime = self.meanTime;
+    result.timeStandardDeviation = self.timeStandardDeviation;
     result.samples = [self.samples copy];
     return result;
 }
@@ -2138,6 +2404,7 @@ static NSString *const RegionIdentifierKey = @"region.identifier";
     [super encodeWithCoder:aCoder];
     ORK_ENCODE_IMAGE(aCoder, signatureImage);
     ORK_ENCODE_OBJ(aCoder, signaturePath);
+    ORK_ENCODE_OBJ(aCoder, signatureStrokeData);
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder {
@@ -2145,6 +2412,7 @@ static NSString *const RegionIdentifierKey = @"region.identifier";
     if (self) {
         ORK_DECODE_IMAGE(aDecoder, signatureImage);
         ORK_DECODE_OBJ_ARRAY(aDecoder, signaturePath, UIBezierPath);
+        ORK_DECODE_OBJ_CLASS(aDecoder, signatureStrokeData, NSData);
     }
     return self;
 }
@@ -2163,14 +2431,24 @@ static NSString *const RegionIdentifierKey = @"region.identifier";
     __typeof(self) castObject = object;
     return (isParentSame &&
             ORKEqualObjects(self.signatureImage, castObject.signatureImage) &&
-            ORKEqualObjects(self.signaturePath, castObject.signaturePath));
+            ORKEqualObjects(self.signaturePath, castObject.signaturePath) &&
+            ORKEqualObjects(self.signatureStrokeData, castObject.signatureStrokeData));
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone {
     ORKSignatureResult *result = [super copyWithZone:zone];
     result->_signatureImage = [_signatureImage copy];
     result->_signaturePath = ORKArrayCopyObjects(_signaturePath);
+    result->_signatureStrokeData = [_signatureStrokeData copy];
     return result;
 }
 
+- (UIImage *)rasterizedSignatureImageWithScale:(CGFloat)scale lineColor:(UIColor *)lineColor {
+    if (!_signatureStrokeData) {
+        return nil;
+    }
+    ORKSignatureStrokes *strokes = [[ORKSignatureStrokes alloc] initWithData:_signatureStrokeData];
+    return [strokes imageWithScale:scale lineColor:lineColor];
+}
+
 @end
@@ -0,0 +1,82 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKTextChoice;
+
+/**
+ Searches the choices of an `ORKSearchableChoiceAnswerFormat`.
+ 
+ The choice file is memory mapped and only the line offsets, the sort order and a trigram index are
+ kept in memory; `ORKTextChoice` objects are created on demand for the rows that are displayed.
+ The index is built on a private queue by the first search.
+ */
+@interface ORKSearchableChoiceIndex : NSObject
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, copy, readonly) NSURL *fileURL;
+
+// Number of choices in the file. Zero until the index has been built.
+@property (readonly) NSUInteger count;
+
+/*
+ Searches asynchronously. Choices whose text starts with the query come first, followed by choices
+ that contain it, each in sorted order. An empty query lists the choices in sorted order.
+ 
+ Searches are serialized, and a search that is superseded by a later call before it finishes is
+ abandoned without calling its completion. Call from the main queue; the completion is called
+ on the main queue.
+ */
+- (void)searchWithQuery:(nullable NSString *)query
+ maximumNumberOfResults:(NSUInteger)maximumNumberOfResults
+             completion:(void (^)(NSArray<NSNumber *> *choiceIndexes))completion;
+
+// Synchronous search, building the index if needed.
+- (NSArray<NSNumber *> *)choiceIndexesMatchingQuery:(nullable NSString *)query
+                             maximumNumberOfResults:(NSUInteger)maximumNumberOfResults;
+
+- (nullable ORKTextChoice *)textChoiceAtIndex:(NSUInteger)index;
+
+/*
+ The choice with the given value. Uses a binary search once the index has been built, and otherwise
+ scans the file. The last resolved choice is cached, since summaries ask for the same answer repeatedly.
+ */
+- (nullable ORKTextChoice *)textChoiceForValue:(id)value;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,630 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSearchableChoiceIndex.h"
+
+#import "ORKAnswerFormat.h"
+
+#import "ORKHelpers.h"
+
+
+// Each line of the choice file is `text`, `text<TAB>value` or `text<TAB>value<TAB>detailText`.
+typedef struct {
+    uint32_t location;
+    uint32_t length;
+} ORKSearchableChoiceLine;
+
+typedef struct {
+    uint64_t trigram;
+    uint32_t choiceIndex;
+} ORKSearchableChoiceTrigramEntry;
+
+// How many candidates are verified between checks for a newer search
+static const NSUInteger ORKSearchableChoiceCancellationInterval = 256;
+
+static NSString *ORKSearchableChoiceFoldedString(NSString *string) {
+    return [string stringByFoldingWithOptions:(NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch) locale:nil];
+}
+
+static NSString *ORKSearchableChoiceField(const char *bytes, ORKSearchableChoiceLine line, NSUInteger fieldIndex) {
+    const char *start = bytes + line.location;
+    const char *end = start + line.length;
+    for (NSUInteger field = 0; field < fieldIndex && start < end; field++) {
+        const char *tab = memchr(start, '\t', end - start);
+        if (tab == NULL) {
+            return nil;
+        }
+        start = tab + 1;
+    }
+    const char *tab = memchr(start, '\t', end - start);
+    const char *fieldEnd = tab ? tab : end;
+    if (fieldIndex > 0 && fieldEnd == start) {
+        return nil;
+    }
+    return [[NSString alloc] initWithBytes:start length:(fieldEnd - start) encoding:NSUTF8StringEncoding];
+}
+
+// Byte range of the value of a choice, which is the text when the line has no value field
+static ORKSearchableChoiceLine ORKSearchableChoiceValueRange(const char *bytes, ORKSearchableChoiceLine line) {
+    const char *start = bytes + line.location;
+    const char *end = start + line.length;
+    const char *tab = memchr(start, '\t', end - start);
+    if (tab) {
+        const char *valueStart = tab + 1;
+        const char *valueEnd = memchr(valueStart, '\t', end - valueStart) ? : end;
+        if (valueEnd > valueStart) {
+            return (ORKSearchableChoiceLine){ (uint32_t)(valueStart - bytes), (uint32_t)(valueEnd - valueStart) };
+        }
+    }
+    const char *textEnd = tab ? : end;
+    return (ORKSearchableChoiceLine){ line.location, (uint32_t)(textEnd - start) };
+}
+
+static int ORKSearchableChoiceCompareBytes(const char *a, NSUInteger aLength, const char *b, NSUInteger bLength) {
+    int result = memcmp(a, b, MIN(aLength, bLength));
+    if (result == 0 && aLength != bLength) {
+        result = aLength < bLength ? -1 : 1;
+    }
+    return result;
+}
+
+static ORKTextChoice *ORKSearchableChoiceMakeTextChoice(const char *bytes, ORKSearchableChoiceLine line) {
+    NSString *text = ORKSearchableChoiceField(bytes, line, 0);
+    if (text.length == 0) {
+        return nil;
+    }
+    NSString *value = ORKSearchableChoiceField(bytes, line, 1) ? : text;
+    NSString *detailText = ORKSearchableChoiceField(bytes, line, 2);
+    return [ORKTextChoice choiceWithText:text detailText:detailText value:value exclusive:NO];
+}
+
+static void ORKSearchableChoiceEnumerateLines(NSData *data, void (^block)(ORKSearchableChoiceLine line, BOOL *stop)) {
+    const char *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger location = 0;
+    BOOL stop = NO;
+    while (location < length && !stop) {
+        const char *newline = memchr(bytes + location, '\n', length - location);
+        NSUInteger end = newline ? (NSUInteger)(newline - bytes) : length;
+        NSUInteger lineLength = end - location;
+        if (lineLength > 0 && bytes[end - 1] == '\r') {
+            lineLength--;
+        }
+        if (lineLength > 0) {
+            block((ORKSearchableChoiceLine){ (uint32_t)location, (uint32_t)lineLength }, &stop);
+        }
+        location = end + 1;
+    }
+}
+
+static void ORKSearchableChoiceEnumerateTrigrams(NSString *foldedString, void (^block)(uint64_t trigram)) {
+    NSUInteger length = foldedString.length;
+    if (length < 3) {
+        return;
+    }
+    unichar *characters = malloc(length * sizeof(unichar));
+    [foldedString getCharacters:characters range:NSMakeRange(0, length)];
+    for (NSUInteger index = 0; index + 2 < length; index++) {
+        block(((uint64_t)characters[index] << 32) | ((uint64_t)characters[index + 1] << 16) | (uint64_t)characters[index + 2]);
+    }
+    free(characters);
+}
+
+static int ORKSearchableChoiceCompareTrigramEntries(const void *a, const void *b) {
+    const ORKSearchableChoiceTrigramEntry *entryA = a;
+    const ORKSearchableChoiceTrigramEntry *entryB = b;
+    if (entryA->trigram != entryB->trigram) {
+        return entryA->trigram < entryB->trigram ? -1 : 1;
+    }
+    if (entryA->choiceIndex != entryB->choiceIndex) {
+        return entryA->choiceIndex < entryB->choiceIndex ? -1 : 1;
+    }
+    return 0;
+}
+
+
+@implementation ORKSearchableChoiceIndex {
+    dispatch_queue_t _queue;
+    NSUInteger _searchGeneration;
+    
+    // Built once on _queue and immutable afterwards
+    NSData *_data;
+    NSData *_lines;             // ORKSearchableChoiceLine per choice, in file order
+    NSData *_sortedIndexes;     // uint32_t choice indexes, ordered by folded text
+    NSData *_ranks;             // uint32_t position of each choice in _sortedIndexes
+    NSData *_trigrams;          // uint64_t unique trigrams, ascending
+    NSData *_postingOffsets;    // uint32_t start of each trigram's postings, plus an end marker
+    NSData *_postings;          // uint32_t choice indexes, ascending within each trigram
+    NSData *_valueIndexes;      // uint32_t choice indexes, ordered by the bytes of their value
+    
+    // The most recently resolved value, since summaries ask for the same answer repeatedly
+    NSString *_lastResolvedValue;
+    ORKTextChoice *_lastResolvedChoice;
+    
+    // The previous query of three or more characters and all of its matches, for type-ahead
+    NSString *_previousFoldedQuery;
+    NSIndexSet *_previousMatches;
+}
+
+- (instancetype)init {
+    ORKThrowMethodUnavailableException();
+}
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL {
+    self = [super init];
+    if (self) {
+        _fileURL = [fileURL copy];
+        _queue = dispatch_queue_create("org.researchkit.searchablechoiceindex", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    NSData *lines = nil;
+    @synchronized (self) {
+        lines = _lines;
+    }
+    return lines.length / sizeof(ORKSearchableChoiceLine);
+}
+
+#pragma mark Index
+
+- (BOOL)queue_buildIndexIfNeeded {
+    if (_lines) {
+        return YES;
+    }
+    
+    NSError *error = nil;
+    NSData *data = [NSData dataWithContentsOfURL:_fileURL options:NSDataReadingMappedIfSafe error:&error];
+    if (data == nil) {
+        ORK_Log_Error(@"Could not read choices from %@: %@", _fileURL, error);
+        return NO;
+    }
+    if (data.length > UINT32_MAX) {
+        ORK_Log_Error(@"Choices file %@ is too large", _fileURL);
+        return NO;
+    }
+    
+    const char *bytes = data.bytes;
+    NSMutableData *lines = [NSMutableData new];
+    NSMutableArray<NSString *> *foldedTexts = [NSMutableArray new];
+    NSMutableData *trigramEntries = [NSMutableData new];
+    
+    ORKSearchableChoiceEnumerateLines(data, ^(ORKSearchableChoiceLine line, BOOL *stop) {
+        NSString *text = ORKSearchableChoiceField(bytes, line, 0);
+        if (text.length == 0) {
+            return;
+        }
+        uint32_t choiceIndex = (uint32_t)foldedTexts.count;
+        NSString *foldedText = ORKSearchableChoiceFoldedString(text);
+        [lines appendBytes:&line length:sizeof(line)];
+        [foldedTexts addObject:foldedText];
+        ORKSearchableChoiceEnumerateTrigrams(foldedText, ^(uint64_t trigram) {
+            ORKSearchableChoiceTrigramEntry entry = { trigram, choiceIndex };
+            [trigramEntries appendBytes:&entry length:sizeof(entry)];
+        });
+    });
+    
+    NSUInteger count = foldedTexts.count;
+    
+    // Sort order, by folded text. Literal comparison keeps all choices with a given prefix contiguous.
+    NSMutableArray<NSNumber *> *order = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [order addObject:@(index)];
+    }
+    [order sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        return [foldedTexts[a.unsignedIntegerValue] compare:foldedTexts[b.unsignedIntegerValue] options:NSLiteralSearch];
+    }];
+    NSMutableData *sortedIndexes = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    NSMutableData *ranks = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    uint32_t *sorted = sortedIndexes.mutableBytes;
+    uint32_t *rank = ranks.mutableBytes;
+    for (NSUInteger position = 0; position < count; position++) {
+        uint32_t choiceIndex = (uint32_t)order[position].unsignedIntegerValue;
+        sorted[position] = choiceIndex;
+        rank[choiceIndex] = (uint32_t)position;
+    }
+    
+    // Trigram postings, stored as one flat array with an offset table
+    NSUInteger entryCount = trigramEntries.length / sizeof(ORKSearchableChoiceTrigramEntry);
+    ORKSearchableChoiceTrigramEntry *entries = trigramEntries.mutableBytes;
+    qsort(entries, entryCount, sizeof(ORKSearchableChoiceTrigramEntry), ORKSearchableChoiceCompareTrigramEntries);
+    NSMutableData *trigrams = [NSMutableData new];
+    NSMutableData *postingOffsets = [NSMutableData new];
+    NSMutableData *postings = [NSMutableData new];
+    for (NSUInteger index = 0; index < entryCount; index++) {
+        ORKSearchableChoiceTrigramEntry entry = entries[index];
+        BOOL newTrigram = (index == 0 || entries[index - 1].trigram != entry.trigram);
+        if (!newTrigram && entries[index - 1].choiceIndex == entry.choiceIndex) {
+            // Trigram repeated within one choice
+            continue;
+        }
+        if (newTrigram) {
+            uint32_t offset = (uint32_t)(postings.length / sizeof(uint32_t));
+            [trigrams appendBytes:&entry.trigram length:sizeof(uint64_t)];
+            [postingOffsets appendBytes:&offset length:sizeof(uint32_t)];
+        }
+        [postings appendBytes:&entry.choiceIndex length:sizeof(uint32_t)];
+    }
+    uint32_t endOffset = (uint32_t)(postings.length / sizeof(uint32_t));
+    [postingOffsets appendBytes:&endOffset length:sizeof(uint32_t)];
+    
+    // Value order, so answers can be resolved with a binary search
+    const ORKSearchableChoiceLine *lineBytes = lines.bytes;
+    [order sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        ORKSearchableChoiceLine valueA = ORKSearchableChoiceValueRange(bytes, lineBytes[a.unsignedIntegerValue]);
+        ORKSearchableChoiceLine valueB = ORKSearchableChoiceValueRange(bytes, lineBytes[b.unsignedIntegerValue]);
+        int result = ORKSearchableChoiceCompareBytes(bytes + valueA.location, valueA.length, bytes + valueB.location, valueB.length);
+        if (result == 0) {
+            // The first of several choices with the same value wins, as in a scan of the file
+            return [a compare:b];
+        }
+        return result < 0 ? NSOrderedAscending : (result > 0 ? NSOrderedDescending : NSOrderedSame);
+    }];
+    NSMutableData *valueIndexes = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    uint32_t *byValue = valueIndexes.mutableBytes;
+    for (NSUInteger position = 0; position < count; position++) {
+        byValue[position] = (uint32_t)order[position].unsignedIntegerValue;
+    }
+    
+    _sortedIndexes = sortedIndexes;
+    _ranks = ranks;
+    _trigrams = trigrams;
+    _postingOffsets = postingOffsets;
+    _postings = postings;
+    @synchronized (self) {
+        _data = data;
+        _lines = lines;
+        _valueIndexes = valueIndexes;
+    }
+    return YES;
+}
+
+- (NSString *)queue_foldedTextAtIndex:(uint32_t)choiceIndex {
+    const ORKSearchableChoiceLine *lines = _lines.bytes;
+    return ORKSearchableChoiceFoldedString(ORKSearchableChoiceField(_data.bytes, lines[choiceIndex], 0));
+}
+
+// First position in sorted order whose folded text is not less than the query
+- (NSUInteger)queue_lowerBoundForFoldedQuery:(NSString *)foldedQuery {
+    const uint32_t *sorted = _sortedIndexes.bytes;
+    NSUInteger low = 0;
+    NSUInteger high = _sortedIndexes.length / sizeof(uint32_t);
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if ([[self queue_foldedTextAtIndex:sorted[middle]] compare:foldedQuery options:NSLiteralSearch] == NSOrderedAscending) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+- (BOOL)queue_getPostings:(const uint32_t **)postings count:(NSUInteger *)count forTrigram:(uint64_t)trigram {
+    const uint64_t *trigrams = _trigrams.bytes;
+    NSUInteger low = 0;
+    NSUInteger high = _trigrams.length / sizeof(uint64_t);
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (trigrams[middle] < trigram) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == _trigrams.length / sizeof(uint64_t) || trigrams[low] != trigram) {
+        return NO;
+    }
+    const uint32_t *offsets = _postingOffsets.bytes;
+    *postings = (const uint32_t *)_postings.bytes + offsets[low];
+    *count = offsets[low + 1] - offsets[low];
+    return YES;
+}
+
+// Choices that contain every trigram of the query; a superset of the choices containing the query
+- (NSIndexSet *)queue_trigramCandidatesForFoldedQuery:(NSString *)foldedQuery {
+    __block NSMutableData *candidates = nil;
+    __block BOOL missingTrigram = NO;
+    ORKSearchableChoiceEnumerateTrigrams(foldedQuery, ^(uint64_t trigram) {
+        if (missingTrigram) {
+            return;
+        }
+        const uint32_t *postings = NULL;
+        NSUInteger postingCount = 0;
+        if (![self queue_getPostings:&postings count:&postingCount forTrigram:trigram]) {
+            missingTrigram = YES;
+            return;
+        }
+        if (candidates == nil) {
+            candidates = [NSMutableData dataWithBytes:postings length:postingCount * sizeof(uint32_t)];
+            return;
+        }
+        // Intersect the two ascending lists in place
+        uint32_t *current = candidates.mutableBytes;
+        NSUInteger currentCount = candidates.length / sizeof(uint32_t);
+        NSUInteger read = 0, other = 0, write = 0;
+        while (read < currentCount && other < postingCount) {
+            if (current[read] < postings[other]) {
+                read++;
+            } else if (current[read] > postings[other]) {
+                other++;
+            } else {
+                current[write++] = current[read++];
+                other++;
+            }
+        }
+        candidates.length = write * sizeof(uint32_t);
+    });
+    
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet new];
+    if (!missingTrigram) {
+        const uint32_t *indexes = candidates.bytes;
+        NSUInteger candidateCount = candidates.length / sizeof(uint32_t);
+        for (NSUInteger index = 0; index < candidateCount; index++) {
+            [indexSet addIndex:indexes[index]];
+        }
+    }
+    return indexSet;
+}
+
+- (BOOL)isSearchGenerationCurrent:(NSUInteger)generation {
+    if (generation == 0) {
+        // Synchronous searches are never abandoned
+        return YES;
+    }
+    @synchronized (self) {
+        return generation == _searchGeneration;
+    }
+}
+
+#pragma mark Search
+
+- (NSArray<NSNumber *> *)queue_choiceIndexesMatchingQuery:(NSString *)query
+                                   maximumNumberOfResults:(NSUInteger)maximumNumberOfResults
+                                               generation:(NSUInteger)generation {
+    if (![self queue_buildIndexIfNeeded]) {
+        return @[];
+    }
+    
+    const uint32_t *sorted = _sortedIndexes.bytes;
+    const uint32_t *ranks = _ranks.bytes;
+    NSUInteger count = _sortedIndexes.length / sizeof(uint32_t);
+    NSMutableArray<NSNumber *> *results = [NSMutableArray new];
+    
+    NSString *foldedQuery = ORKSearchableChoiceFoldedString([query stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] ? : @"");
+    if (foldedQuery.length == 0) {
+        for (NSUInteger position = 0; position < count && results.count < maximumNumberOfResults; position++) {
+            [results addObject:@(sorted[position])];
+        }
+        return results;
+    }
+    
+    // Prefix matches are contiguous in sorted order
+    NSMutableIndexSet *prefixMatches = [NSMutableIndexSet new];
+    for (NSUInteger position = [self queue_lowerBoundForFoldedQuery:foldedQuery];
+         position < count && results.count < maximumNumberOfResults;
+         position++) {
+        if (![[self queue_foldedTextAtIndex:sorted[position]] hasPrefix:foldedQuery]) {
+            break;
+        }
+        [results addObject:@(sorted[position])];
+        [prefixMatches addIndex:sorted[position]];
+    }
+    if (results.count >= maximumNumberOfResults) {
+        return results;
+    }
+    
+    NSUInteger remaining = maximumNumberOfResults - results.count;
+    if (foldedQuery.length < 3) {
+        // Too short for the trigram index; scan in sorted order until there are enough matches
+        for (NSUInteger position = 0; position < count && remaining > 0; position++) {
+            if (position % ORKSearchableChoiceCancellationInterval == 0 && ![self isSearchGenerationCurrent:generation]) {
+                return nil;
+            }
+            uint32_t choiceIndex = sorted[position];
+            if (![prefixMatches containsIndex:choiceIndex] &&
+                [[self queue_foldedTextAtIndex:choiceIndex] rangeOfString:foldedQuery options:NSLiteralSearch].location != NSNotFound) {
+                [results addObject:@(choiceIndex)];
+                remaining--;
+            }
+        }
+        return results;
+    }
+    
+    // A query containing the previous query can only match choices that the previous query matched,
+    // so typing ahead filters the previous matches instead of going back to the index.
+    NSIndexSet *candidates = nil;
+    if (_previousFoldedQuery && [foldedQuery rangeOfString:_previousFoldedQuery options:NSLiteralSearch].location != NSNotFound) {
+        candidates = _previousMatches;
+    } else {
+        candidates = [self queue_trigramCandidatesForFoldedQuery:foldedQuery];
+    }
+    
+    NSMutableIndexSet *matches = [NSMutableIndexSet new];
+    __block NSUInteger verified = 0;
+    __block BOOL abandoned = NO;
+    [candidates enumerateIndexesUsingBlock:^(NSUInteger choiceIndex, BOOL *stop) {
+        if (verified++ % ORKSearchableChoiceCancellationInterval == 0 && ![self isSearchGenerationCurrent:generation]) {
+            abandoned = YES;
+            *stop = YES;
+            return;
+        }
+        if ([[self queue_foldedTextAtIndex:(uint32_t)choiceIndex] rangeOfString:foldedQuery options:NSLiteralSearch].location != NSNotFound) {
+            [matches addIndex:choiceIndex];
+        }
+    }];
+    if (abandoned) {
+        return nil;
+    }
+    _previousFoldedQuery = foldedQuery;
+    _previousMatches = matches;
+    
+    NSMutableArray<NSNumber *> *containingMatches = [NSMutableArray new];
+    [matches enumerateIndexesUsingBlock:^(NSUInteger choiceIndex, BOOL *stop) {
+        if (![prefixMatches containsIndex:choiceIndex]) {
+            [containingMatches addObject:@(choiceIndex)];
+        }
+    }];
+    [containingMatches sortUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        uint32_t rankA = ranks[a.unsignedIntegerValue];
+        uint32_t rankB = ranks[b.unsignedIntegerValue];
+        return rankA < rankB ? NSOrderedAscending : (rankA > rankB ? NSOrderedDescending : NSOrderedSame);
+    }];
+    [results addObjectsFromArray:[containingMatches subarrayWithRange:NSMakeRange(0, MIN(remaining, containingMatches.count))]];
+    return results;
+}
+
+- (void)searchWithQuery:(NSString *)query
+ maximumNumberOfResults:(NSUInteger)maximumNumberOfResults
+             completion:(void (^)(NSArray<NSNumber *> *))completion {
+    NSUInteger generation = 0;
+    @synchronized (self) {
+        generation = ++_searchGeneration;
+    }
+    query = [query copy];
+    dispatch_async(_queue, ^{
+        if (![self isSearchGenerationCurrent:generation]) {
+            return;
+        }
+        NSArray<NSNumber *> *results = [self queue_choiceIndexesMatchingQuery:query
+                                                        maximumNumberOfResults:maximumNumberOfResults
+                                                                    generation:generation];
+        if (results == nil || ![self isSearchGenerationCurrent:generation]) {
+            return;
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            // Searches are started on the main queue, so this check cannot race with a newer one
+            if ([self isSearchGenerationCurrent:generation]) {
+                completion(results);
+            }
+        });
+    });
+}
+
+- (NSArray<NSNumber *> *)choiceIndexesMatchingQuery:(NSString *)query maximumNumberOfResults:(NSUInteger)maximumNumberOfResults {
+    __block NSArray<NSNumber *> *results = nil;
+    dispatch_sync(_queue, ^{
+        results = [self queue_choiceIndexesMatchingQuery:query maximumNumberOfResults:maximumNumberOfResults generation:0];
+    });
+    return results;
+}
+
+#pragma mark Choices
+
+- (ORKTextChoice *)textChoiceAtIndex:(NSUInteger)index {
+    NSData *lines = nil;
+    NSData *data = nil;
+    @synchronized (self) {
+        lines = _lines;
+        data = _data;
+    }
+    if (index >= lines.length / sizeof(ORKSearchableChoiceLine)) {
+        return nil;
+    }
+    return ORKSearchableChoiceMakeTextChoice(data.bytes, ((const ORKSearchableChoiceLine *)lines.bytes)[index]);
+}
+
+- (ORKTextChoice *)textChoiceForValue:(id)value {
+    if (![value isKindOfClass:[NSString class]]) {
+        // Values are read from the file as strings
+        return nil;
+    }
+    
+    NSData *lines = nil;
+    NSData *data = nil;
+    NSData *valueIndexes = nil;
+    @synchronized (self) {
+        if ([_lastResolvedValue isEqualToString:value]) {
+            return _lastResolvedChoice;
+        }
+        lines = _lines;
+        data = _data;
+        valueIndexes = _valueIndexes;
+    }
+    
+    ORKTextChoice *matchedChoice = nil;
+    if (lines) {
+        matchedChoice = [self textChoiceForValue:value data:data lines:lines valueIndexes:valueIndexes];
+    } else {
+        // No index yet; scan the file rather than build the whole index for one lookup
+        data = [NSData dataWithContentsOfURL:_fileURL options:NSDataReadingMappedIfSafe error:NULL];
+        const char *bytes = data.bytes;
+        __block ORKTextChoice *scannedChoice = nil;
+        ORKSearchableChoiceEnumerateLines(data, ^(ORKSearchableChoiceLine line, BOOL *stop) {
+            NSString *lineValue = ORKSearchableChoiceField(bytes, line, 1) ? : ORKSearchableChoiceField(bytes, line, 0);
+            if ([lineValue isEqual:value]) {
+                scannedChoice = ORKSearchableChoiceMakeTextChoice(bytes, line);
+                *stop = YES;
+            }
+        });
+        matchedChoice = scannedChoice;
+    }
+    
+    if (matchedChoice) {
+        @synchronized (self) {
+            _lastResolvedValue = [value copy];
+            _lastResolvedChoice = matchedChoice;
+        }
+    }
+    return matchedChoice;
+}
+
+- (ORKTextChoice *)textChoiceForValue:(NSString *)value data:(NSData *)data lines:(NSData *)lines valueIndexes:(NSData *)valueIndexes {
+    const char *bytes = data.bytes;
+    const ORKSearchableChoiceLine *lineBytes = lines.bytes;
+    const uint32_t *byValue = valueIndexes.bytes;
+    const char *valueBytes = value.UTF8String;
+    NSUInteger valueLength = [value lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    
+    NSUInteger low = 0;
+    NSUInteger high = valueIndexes.length / sizeof(uint32_t);
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        ORKSearchableChoiceLine range = ORKSearchableChoiceValueRange(bytes, lineBytes[byValue[middle]]);
+        if (ORKSearchableChoiceCompareBytes(bytes + range.location, range.length, valueBytes, valueLength) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == valueIndexes.length / sizeof(uint32_t)) {
+        return nil;
+    }
+    ORKSearchableChoiceLine line = lineBytes[byValue[low]];
+    ORKSearchableChoiceLine range = ORKSearchableChoiceValueRange(bytes, line);
+    if (ORKSearchableChoiceCompareBytes(bytes + range.location, range.length, valueBytes, valueLength) != 0) {
+        return nil;
+    }
+    return ORKSearchableChoiceMakeTextChoice(bytes, line);
+}
+
+@end
@@ -213,6 +213,7 @@
 @property (nonatomic, strong) ORKConsentSigningView *signingView;
 @property (nonatomic, strong) ORKNavigationContainerView *continueSkipView;
 @property (nonatomic, strong) NSArray <UIBezierPath *> *originalPath;
+@property (nonatomic, copy) NSData *originalStrokeData;
 
 @end
 
@@ -226,6 +227,7 @@
             [[(ORKStepResult *)result results] enumerateObjectsUsingBlock:^(ORKResult * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
                 if ([obj isKindOfClass:[ORKSignatureResult class]]) {
                     _originalPath = [(ORKSignatureResult*)obj signaturePath];
+                    _originalStrokeData = [(ORKSignatureResult*)obj signatureStrokeData];
                     *stop = YES;
                 }
             }];
@@ -240,6 +242,9 @@
     
     // set the original path and update state
     self.signatureView.signaturePath = self.originalPath;
+    if (self.originalPath) {
+        self.signatureView.signatureStrokeData = self.originalStrokeData;
+    }
     [self updateButtonStates];
 }
 
@@ -249,6 +254,7 @@
     if (self.signatureView.signatureExists) {
         ORKSignatureResult *sigResult = [[ORKSignatureResult alloc] initWithSignatureImage:self.signatureView.signatureImage
                                                                              signaturePath:self.signatureView.signaturePath];
+        sigResult.signatureStrokeData = self.signatureView.signatureStrokeData;
         parentResult.results = @[sigResult];
     }
     
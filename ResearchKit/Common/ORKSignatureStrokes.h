@@ -0,0 +1,84 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef struct {
+    CGPoint location;
+    // Seconds since the first sample of the signature.
+    NSTimeInterval timestamp;
+    // Force or stroke speed, normalized to the range 0...1.
+    CGFloat pressure;
+} ORKSignatureSample;
+
+/*
+ The sampled touch input of a signature, one stroke per touch, and its compact encoding.
+ 
+ The encoding starts with the bytes "ORKS" and a version byte, followed by unsigned LEB128
+ varints: the canvas width and height and the line width and variation (all in 1/100 pt),
+ then the number of strokes. Each stroke is its number of samples followed by, for every
+ sample, the zigzag-encoded differences from the previous sample of x and y (1/10 pt),
+ timestamp (ms) and pressure (1/255).
+ */
+@interface ORKSignatureStrokes : NSObject
+
+- (instancetype)initWithCanvasSize:(CGSize)canvasSize lineWidth:(CGFloat)lineWidth lineWidthVariation:(CGFloat)lineWidthVariation NS_DESIGNATED_INITIALIZER;
+
+/// Returns nil if the data is not a valid encoding.
+- (nullable instancetype)initWithData:(NSData *)data;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic) CGSize canvasSize;
+@property (nonatomic) CGFloat lineWidth;
+@property (nonatomic) CGFloat lineWidthVariation;
+
+@property (nonatomic, readonly) NSUInteger numberOfStrokes;
+@property (nonatomic, readonly) NSUInteger numberOfSamples;
+
+- (NSRange)sampleRangeOfStrokeAtIndex:(NSUInteger)strokeIndex;
+- (ORKSignatureSample)sampleAtIndex:(NSUInteger)sampleIndex;
+
+- (void)beginStroke;
+- (void)addSample:(ORKSignatureSample)sample;
+- (void)removeAllStrokes;
+
+- (NSData *)data;
+
+/// Draws the strokes into an image of the canvas size. Returns nil if the canvas is empty.
+- (nullable UIImage *)imageWithScale:(CGFloat)scale lineColor:(UIColor *)lineColor;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,270 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKSignatureStrokes.h"
+
+
+static const char ORKSignatureStrokesMagic[4] = { 'O', 'R', 'K', 'S' };
+static const uint8_t ORKSignatureStrokesVersion = 1;
+
+static const double SizeUnitsPerPoint = 100;
+static const double LocationUnitsPerPoint = 10;
+static const double TimestampUnitsPerSecond = 1000;
+static const double PressureUnits = 255;
+
+static void ORKAppendVarint(NSMutableData *data, uint64_t value) {
+    uint8_t bytes[10];
+    NSUInteger length = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        bytes[length++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    [data appendBytes:bytes length:length];
+}
+
+static BOOL ORKReadVarint(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, uint64_t *value) {
+    uint64_t result = 0;
+    for (NSUInteger shift = 0; shift < 64; shift += 7) {
+        if (*offset >= length) {
+            return NO;
+        }
+        uint8_t byte = bytes[(*offset)++];
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+static void ORKAppendSignedVarint(NSMutableData *data, int64_t value) {
+    ORKAppendVarint(data, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static BOOL ORKReadSignedVarint(const uint8_t *bytes, NSUInteger length, NSUInteger *offset, int64_t *value) {
+    uint64_t encoded = 0;
+    if (!ORKReadVarint(bytes, length, offset, &encoded)) {
+        return NO;
+    }
+    *value = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+    return YES;
+}
+
+static CGPoint ORKMidPoint(CGPoint p1, CGPoint p2) {
+    return CGPointMake((p1.x + p2.x) * 0.5, (p1.y + p2.y) * 0.5);
+}
+
+
+@implementation ORKSignatureStrokes {
+    NSMutableData *_samples;
+    NSMutableArray<NSNumber *> *_strokeStartIndexes;
+}
+
+- (instancetype)initWithCanvasSize:(CGSize)canvasSize lineWidth:(CGFloat)lineWidth lineWidthVariation:(CGFloat)lineWidthVariation {
+    self = [super init];
+    if (self) {
+        _canvasSize = canvasSize;
+        _lineWidth = lineWidth;
+        _lineWidthVariation = lineWidthVariation;
+        _samples = [NSMutableData data];
+        _strokeStartIndexes = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (instancetype)initWithData:(NSData *)data {
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = data.length;
+    if (length < sizeof(ORKSignatureStrokesMagic) + 1
+        || memcmp(bytes, ORKSignatureStrokesMagic, sizeof(ORKSignatureStrokesMagic)) != 0
+        || bytes[sizeof(ORKSignatureStrokesMagic)] != ORKSignatureStrokesVersion) {
+        return nil;
+    }
+    NSUInteger offset = sizeof(ORKSignatureStrokesMagic) + 1;
+    
+    uint64_t header[5];
+    for (NSUInteger index = 0; index < 5; index++) {
+        if (!ORKReadVarint(bytes, length, &offset, &header[index])) {
+            return nil;
+        }
+    }
+    self = [self initWithCanvasSize:CGSizeMake(header[0] / SizeUnitsPerPoint, header[1] / SizeUnitsPerPoint)
+                          lineWidth:header[2] / SizeUnitsPerPoint
+                 lineWidthVariation:header[3] / SizeUnitsPerPoint];
+    if (self) {
+        int64_t values[4] = { 0, 0, 0, 0 };
+        uint64_t numberOfStrokes = header[4];
+        for (uint64_t strokeIndex = 0; strokeIndex < numberOfStrokes; strokeIndex++) {
+            uint64_t numberOfSamples = 0;
+            // Every sample takes at least four bytes, which bounds corrupt counts.
+            if (!ORKReadVarint(bytes, length, &offset, &numberOfSamples) || numberOfSamples > (length - offset) / 4) {
+                return nil;
+            }
+            [self beginStroke];
+            for (uint64_t sampleIndex = 0; sampleIndex < numberOfSamples; sampleIndex++) {
+                for (NSUInteger index = 0; index < 4; index++) {
+                    int64_t delta = 0;
+                    if (!ORKReadSignedVarint(bytes, length, &offset, &delta)) {
+                        return nil;
+                    }
+                    values[index] += delta;
+                }
+                ORKSignatureSample sample;
+                sample.location = CGPointMake(values[0] / LocationUnitsPerPoint, values[1] / LocationUnitsPerPoint);
+                sample.timestamp = values[2] / TimestampUnitsPerSecond;
+                sample.pressure = values[3] / PressureUnits;
+                [self addSample:sample];
+            }
+        }
+        if (offset != length) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (NSUInteger)numberOfStrokes {
+    return _strokeStartIndexes.count;
+}
+
+- (NSUInteger)numberOfSamples {
+    return _samples.length / sizeof(ORKSignatureSample);
+}
+
+- (NSRange)sampleRangeOfStrokeAtIndex:(NSUInteger)strokeIndex {
+    NSUInteger start = _strokeStartIndexes[strokeIndex].unsignedIntegerValue;
+    NSUInteger end = (strokeIndex + 1 < _strokeStartIndexes.count) ? _strokeStartIndexes[strokeIndex + 1].unsignedIntegerValue : self.numberOfSamples;
+    return NSMakeRange(start, end - start);
+}
+
+- (ORKSignatureSample)sampleAtIndex:(NSUInteger)sampleIndex {
+    NSParameterAssert(sampleIndex < self.numberOfSamples);
+    return ((const ORKSignatureSample *)_samples.bytes)[sampleIndex];
+}
+
+- (void)beginStroke {
+    [_strokeStartIndexes addObject:@(self.numberOfSamples)];
+}
+
+- (void)addSample:(ORKSignatureSample)sample {
+    if (_strokeStartIndexes.count == 0) {
+        [self beginStroke];
+    }
+    [_samples appendBytes:&sample length:sizeof(sample)];
+}
+
+- (void)removeAllStrokes {
+    _samples.length = 0;
+    [_strokeStartIndexes removeAllObjects];
+}
+
+- (NSData *)data {
+    NSMutableData *data = [NSMutableData dataWithCapacity:16 + self.numberOfSamples * 5];
+    [data appendBytes:ORKSignatureStrokesMagic length:sizeof(ORKSignatureStrokesMagic)];
+    [data appendBytes:&ORKSignatureStrokesVersion length:1];
+    ORKAppendVarint(data, (uint64_t)llround(MAX(_canvasSize.width, 0) * SizeUnitsPerPoint));
+    ORKAppendVarint(data, (uint64_t)llround(MAX(_canvasSize.height, 0) * SizeUnitsPerPoint));
+    ORKAppendVarint(data, (uint64_t)llround(MAX(_lineWidth, 0) * SizeUnitsPerPoint));
+    ORKAppendVarint(data, (uint64_t)llround(MAX(_lineWidthVariation, 0) * SizeUnitsPerPoint));
+    ORKAppendVarint(data, _strokeStartIndexes.count);
+    
+    // Quantized values of the previous sample. Differences are taken between quantized values so
+    // rounding errors do not accumulate.
+    int64_t previous[4] = { 0, 0, 0, 0 };
+    const ORKSignatureSample *samples = _samples.bytes;
+    for (NSUInteger strokeIndex = 0; strokeIndex < _strokeStartIndexes.count; strokeIndex++) {
+        NSRange range = [self sampleRangeOfStrokeAtIndex:strokeIndex];
+        ORKAppendVarint(data, range.length);
+        for (NSUInteger sampleIndex = range.location; sampleIndex < NSMaxRange(range); sampleIndex++) {
+            ORKSignatureSample sample = samples[sampleIndex];
+            int64_t values[4] = { llround(sample.location.x * LocationUnitsPerPoint),
+                                  llround(sample.location.y * LocationUnitsPerPoint),
+                                  llround(sample.timestamp * TimestampUnitsPerSecond),
+                                  llround(MIN(MAX(sample.pressure, 0), 1) * PressureUnits) };
+            for (NSUInteger index = 0; index < 4; index++) {
+                ORKAppendSignedVarint(data, values[index] - previous[index]);
+                previous[index] = values[index];
+            }
+        }
+    }
+    return data;
+}
+
+- (UIImage *)imageWithScale:(CGFloat)scale lineColor:(UIColor *)lineColor {
+    if (_canvasSize.width <= 0 || _canvasSize.height <= 0) {
+        return nil;
+    }
+    
+    UIGraphicsBeginImageContextWithOptions(_canvasSize, NO, scale);
+    [lineColor setStroke];
+    [lineColor setFill];
+    
+    const ORKSignatureSample *samples = _samples.bytes;
+    for (NSUInteger strokeIndex = 0; strokeIndex < _strokeStartIndexes.count; strokeIndex++) {
+        NSRange range = [self sampleRangeOfStrokeAtIndex:strokeIndex];
+        if (range.length == 0) {
+            continue;
+        }
+        
+        // Same smoothing as ORKSignatureView: quadratic curves through the midpoints of the samples,
+        // each segment as wide as the pressure at its control point.
+        ORKSignatureSample first = samples[range.location];
+        CGFloat firstWidth = _lineWidth + first.pressure * _lineWidthVariation;
+        [[UIBezierPath bezierPathWithArcCenter:first.location radius:firstWidth / 2 startAngle:0 endAngle:2 * M_PI clockwise:YES] fill];
+        
+        CGPoint previousMidPoint = first.location;
+        for (NSUInteger sampleIndex = range.location + 1; sampleIndex < NSMaxRange(range); sampleIndex++) {
+            ORKSignatureSample control = samples[sampleIndex - 1];
+            ORKSignatureSample sample = samples[sampleIndex];
+            CGPoint midPoint = ORKMidPoint(control.location, sample.location);
+            
+            UIBezierPath *path = [UIBezierPath bezierPath];
+            path.lineCapStyle = kCGLineCapRound;
+            path.lineJoinStyle = kCGLineJoinRound;
+            path.lineWidth = _lineWidth + sample.pressure * _lineWidthVariation;
+            [path moveToPoint:previousMidPoint];
+            [path addQuadCurveToPoint:midPoint controlPoint:control.location];
+            if (sampleIndex + 1 == NSMaxRange(range)) {
+                [path addLineToPoint:sample.location];
+            }
+            [path stroke];
+            previousMidPoint = midPoint;
+        }
+    }
+    
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return image;
+}
+
+@end
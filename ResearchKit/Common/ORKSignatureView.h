@@ -66,6 +66,13 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, nullable) UIGestureRecognizer *signatureGestureRecognizer;
 @property (nonatomic, copy, nullable) NSArray <UIBezierPath *> *signaturePath;
 
+/**
+ The sampled strokes of the signature (locations, timestamps and pressure), in the compact
+ encoding of `ORKSignatureStrokes`. Setting `signaturePath` discards the strokes, so restore
+ them after the path.
+ */
+@property (nonatomic, copy, nullable) NSData *signatureStrokeData;
+
 - (UIImage *)signatureImage;
 
 @property (nonatomic, readonly) BOOL signatureExists;
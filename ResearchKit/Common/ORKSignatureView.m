@@ -31,6 +31,7 @@
 
 
 #import "ORKSignatureView.h"
+#import "ORKSignatureStrokes.h"
 #import "ORKSkin.h"
 #import "ORKSelectionTitleLabel.h"
 #import "ORKHelpers.h"
@@ -97,6 +98,8 @@ static const CGFloat DefaultLineWidth = 1;
 static const CGFloat DefaultLineWidthVariation = 3;
 static const CGFloat MaxPressureForStrokeVelocity = 9;
 static const CGFloat LineWidthStepValue = 0.25f;
+// Pause assumed between restored strokes and the first stroke drawn after restoring them.
+static const NSTimeInterval RestoredStrokesTimeGap = 0.5;
 
 @interface ORKSignatureView () <ORKSignatureGestureRecognizerDelegate> {
     CGPoint currentPoint;
@@ -107,6 +110,10 @@ static const CGFloat LineWidthStepValue = 0.25f;
     CGFloat maxPressure;
     // Time used only to calculate speed when force isn't available on the device.
     NSTimeInterval previousTouchTime;
+    // Time of the first sample of the signature, which sample timestamps are relative to.
+    NSTimeInterval firstSampleTime;
+    // Whether strokes were restored and firstSampleTime has not been set to continue them yet.
+    BOOL continuesRestoredStrokes;
 }
 
 @property (nonatomic, strong) UIBezierPath *currentPath;
@@ -119,6 +126,11 @@ static const CGFloat LineWidthStepValue = 0.25f;
 @implementation ORKSignatureView {
     NSLayoutConstraint *_heightConstraint;
     NSLayoutConstraint *_widthConstraint;
+    ORKSignatureStrokes *_strokes;
+    
+    // Committed paths are composited once into this bitmap, so drawing only strokes the current path.
+    CGContextRef _committedPathsContext;
+    CGFloat _committedPathsScale;
 }
 
 + (void)initialize {
@@ -136,10 +148,15 @@ static const CGFloat LineWidthStepValue = 0.25f;
         _lineWidthVariation = DefaultLineWidthVariation;
         [self makeSignatureGestureRecognizer];
         [self setUpConstraints];
+        _strokes = [[ORKSignatureStrokes alloc] initWithCanvasSize:CGSizeZero lineWidth:_lineWidth lineWidthVariation:_lineWidthVariation];
     }
     return self;
 }
 
+- (void)dealloc {
+    CGContextRelease(_committedPathsContext);
+}
+
 - (void)willMoveToWindow:(UIWindow *)newWindow {
     [super willMoveToWindow:newWindow];
     [self updateConstraintConstantsForWindow:newWindow];
@@ -182,12 +199,12 @@ static const CGFloat LineWidthStepValue = 0.25f;
 
 - (void)setBounds:(CGRect)bounds {
     [super setBounds:bounds];
-    [self setNeedsDisplay];
+    [self invalidateCommittedPaths];
 }
 
 - (void)setFrame:(CGRect)frame {
     [super setFrame:frame];
-    [self setNeedsDisplay];
+    [self invalidateCommittedPaths];
 }
 
 - (UIBezierPath *)pathWithRoundedStyle {
@@ -214,6 +231,11 @@ static const CGFloat LineWidthStepValue = 0.25f;
     return _lineColor;
 }
 
+- (void)setLineColor:(UIColor *)lineColor {
+    _lineColor = lineColor;
+    [self invalidateCommittedPaths];
+}
+
 - (NSMutableArray *)pathArray {
     if (_pathArray == nil) {
         _pathArray = [NSMutableArray new];
@@ -310,6 +332,18 @@ static const CGFloat LineWidthStepValue = 0.25f;
         previousTouchTime = touch.timestamp;
     }
     
+    if (_strokes.numberOfSamples == 0) {
+        firstSampleTime = touch.timestamp;
+    } else if (continuesRestoredStrokes) {
+        // Restored timestamps are relative to a touch from an earlier session, so place this stroke
+        // a short pause after the last restored sample.
+        ORKSignatureSample lastSample = [_strokes sampleAtIndex:_strokes.numberOfSamples - 1];
+        firstSampleTime = touch.timestamp - lastSample.timestamp - RestoredStrokesTimeGap;
+    }
+    continuesRestoredStrokes = NO;
+    [_strokes beginStroke];
+    [self addSampleAtPoint:currentPoint timestamp:touch.timestamp pressure:minPressure];
+    
     [self.currentPath moveToPoint:currentPoint];
     [self.currentPath addArcWithCenter:currentPoint radius:0.1 startAngle:0.0 endAngle:2.0 * M_PI clockwise:YES];
     [self gestureTouchesMoved:touches withEvent:event];
@@ -358,6 +392,8 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     pressure = MAX(minPressure, pressure);
     pressure = MIN(maxPressure, pressure);
     
+    [self addSampleAtPoint:point timestamp:touch.timestamp pressure:pressure];
+    
     CGFloat previousLineWidth = self.currentPath.lineWidth;
     CGFloat proposedLineWidth = ((pressure - minPressure) *
                                  self.lineWidthVariation /
@@ -412,6 +448,16 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 
 - (void)gestureTouchesEnded:(NSSet *)touches withEvent:(UIEvent *)event {
     [self commitCurrentPath];
+    // The committed path is now in the bitmap.
+    self.currentPath = nil;
+}
+
+- (void)addSampleAtPoint:(CGPoint)point timestamp:(NSTimeInterval)timestamp pressure:(CGFloat)pressure {
+    ORKSignatureSample sample;
+    sample.location = point;
+    sample.timestamp = timestamp - firstSampleTime;
+    sample.pressure = (maxPressure > minPressure) ? (pressure - minPressure) / (maxPressure - minPressure) : 0;
+    [_strokes addSample:sample];
 }
 
 - (void)commitCurrentPath {
@@ -421,10 +467,60 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
     }
     
     [self.pathArray addObject:self.currentPath];
+    if (_committedPathsContext) {
+        [self strokePath:self.currentPath inContext:_committedPathsContext];
+    }
     
     [self.delegate signatureViewDidEditImage:self];
 }
 
+#pragma mark Drawing
+
+- (void)strokePath:(UIBezierPath *)path inContext:(CGContextRef)context {
+    UIGraphicsPushContext(context);
+    [self.lineColor setStroke];
+    [path stroke];
+    UIGraphicsPopContext();
+}
+
+- (void)invalidateCommittedPaths {
+    CGContextRelease(_committedPathsContext);
+    _committedPathsContext = NULL;
+    [self setNeedsDisplay];
+}
+
+- (CGContextRef)committedPathsContext {
+    CGFloat scale = self.contentScaleFactor;
+    if (_committedPathsContext && _committedPathsScale != scale) {
+        CGContextRelease(_committedPathsContext);
+        _committedPathsContext = NULL;
+    }
+    
+    if (_committedPathsContext == NULL) {
+        size_t width = (size_t)ceil(CGRectGetWidth(self.bounds) * scale);
+        size_t height = (size_t)ceil(CGRectGetHeight(self.bounds) * scale);
+        if (width == 0 || height == 0) {
+            return NULL;
+        }
+        
+        CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+        _committedPathsContext = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+        CGColorSpaceRelease(colorSpace);
+        if (_committedPathsContext == NULL) {
+            return NULL;
+        }
+        _committedPathsScale = scale;
+        
+        // Flip to UIKit coordinates.
+        CGContextTranslateCTM(_committedPathsContext, 0, height);
+        CGContextScaleCTM(_committedPathsContext, scale, -scale);
+        for (UIBezierPath *path in self.pathArray) {
+            [self strokePath:path inContext:_committedPathsContext];
+        }
+    }
+    return _committedPathsContext;
+}
+
 - (void)drawRect:(CGRect)rect {
     [[UIColor whiteColor] setFill];
     CGContextFillRect(UIGraphicsGetCurrentContext(), rect);
@@ -440,9 +536,13 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
                                                              NSForegroundColorAttributeName: [[UIColor blackColor] colorWithAlphaComponent:0.2]}];
     }
     
-    for (UIBezierPath *path in self.pathArray) {
-        [self.lineColor setStroke];
-        [path stroke];
+    if (self.pathArray.count > 0) {
+        CGContextRef committedPathsContext = [self committedPathsContext];
+        if (committedPathsContext) {
+            CGImageRef committedPathsImage = CGBitmapContextCreateImage(committedPathsContext);
+            [[UIImage imageWithCGImage:committedPathsImage scale:_committedPathsScale orientation:UIImageOrientationUp] drawInRect:self.bounds];
+            CGImageRelease(committedPathsImage);
+        }
     }
     
     [self.lineColor setStroke];
@@ -456,8 +556,29 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
 - (void)setSignaturePath:(NSArray<UIBezierPath *> *)signaturePath {
     if (signaturePath) {
         _pathArray = [signaturePath mutableCopy];
-        [self setNeedsDisplay];
+        [_strokes removeAllStrokes];
+        [self invalidateCommittedPaths];
+    }
+}
+
+- (NSData *)signatureStrokeData {
+    if (_strokes.numberOfStrokes == 0) {
+        return nil;
+    }
+    _strokes.canvasSize = self.bounds.size;
+    _strokes.lineWidth = self.lineWidth;
+    _strokes.lineWidthVariation = self.lineWidthVariation;
+    return [_strokes data];
+}
+
+- (void)setSignatureStrokeData:(NSData *)signatureStrokeData {
+    ORKSignatureStrokes *strokes = signatureStrokeData ? [[ORKSignatureStrokes alloc] initWithData:signatureStrokeData] : nil;
+    if (strokes) {
+        _strokes = strokes;
+    } else {
+        [_strokes removeAllStrokes];
     }
+    continuesRestoredStrokes = (_strokes.numberOfSamples > 0);
 }
 
 - (UIImage *)signatureImage {
@@ -485,7 +606,8 @@ static CGPoint mmid_Point(CGPoint p1, CGPoint p2) {
         }
         
         [self.pathArray removeAllObjects];
-        [self setNeedsDisplayInRect:self.bounds];
+        [_strokes removeAllStrokes];
+        [self invalidateCommittedPaths];
     }
 }
 
@@ -55,6 +55,12 @@
     // If we don't do this, sometimes the label doesn't split onto two lines properly.
     CGFloat maxLabelLayoutWidth = MAX(self.bounds.size.width - sideMargin * 2 - layoutMargins.left - layoutMargins.right, 0);
     
+    // Frame and margin changes that keep the same label width need no new text measurement or constraint pass.
+    if (_captionLabel.preferredMaxLayoutWidth == maxLabelLayoutWidth &&
+        _instructionLabel.preferredMaxLayoutWidth == maxLabelLayoutWidth) {
+        return;
+    }
+    
     _captionLabel.preferredMaxLayoutWidth = maxLabelLayoutWidth;
     _instructionLabel.preferredMaxLayoutWidth = maxLabelLayoutWidth;
     [self setNeedsUpdateConstraints];
@@ -437,6 +437,21 @@ ORK_CLASS_AVAILABLE
  */
 @property (nonatomic, assign) BOOL showsProgressInNavigationBar;
 
+/**
+ A Boolean value indicating whether the task view controller builds the view controller for the
+ likely next step ahead of time.
+ 
+ When the value of this property is `YES`, the task view controller uses `stepAfterStep:withResult:`
+ to predict the next step while the participant is idle on the current one, and creates and lays
+ out that step's view controller so that moving to it is faster. A prefetched view controller is
+ discarded if the answers change the next step or its saved result. Steps whose view controllers
+ are supplied by the delegate through `taskViewController:viewControllerForStep:`, active steps,
+ and review steps are not prefetched.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic, assign) BOOL prefetchesStepViewControllers;
+
 /**
  The current step view controller.
  
@@ -161,6 +161,24 @@ static void *_ORKViewControllerToolbarObserverContext = &_ORKViewControllerToolb
 @end
 
 
+// A step view controller built ahead of navigation, with the saved result it was built from.
+@interface ORKPrefetchedStepViewController : NSObject
+
+@property (nonatomic, strong) ORKStep *step;
+@property (nonatomic, strong) ORKStepResult *savedResult;
+@property (nonatomic, strong) ORKStepViewController *viewController;
+
+@end
+
+
+@implementation ORKPrefetchedStepViewController
+
+@end
+
+
+// The most step view controllers kept prefetched; older ones are dropped first.
+static const NSUInteger ORKPrefetchedStepViewControllerLimit = 3;
+
 @interface ORKTaskViewController () <ORKViewControllerToolbarObserverDelegate, ORKScrollViewObserverDelegate> {
     NSMutableDictionary *_managedResults;
     NSMutableArray *_managedStepIdentifiers;
@@ -184,6 +202,8 @@ static void *_ORKViewControllerToolbarObserverContext = &_ORKViewControllerToolb
     
     NSString *_restoredTaskIdentifier;
     NSString *_restoredStepIdentifier;
+    
+    NSMutableArray<ORKPrefetchedStepViewController *> *_prefetchedStepViewControllers; // oldest first
 }
 
 @property (nonatomic, strong) UIImageView *hairline;
@@ -268,6 +288,7 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
     
     _managedResults = [NSMutableDictionary dictionary];
     _managedStepIdentifiers = [NSMutableArray array];
+    _prefetchedStepViewControllers = [NSMutableArray array];
     
     self.taskRunUUID = taskRunUUID;
     
@@ -344,6 +365,7 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
     
     _hasRequestedHealthData = NO;
     _task = task;
+    [self clearPrefetchedStepViewControllers];
 }
 
 - (UIBarButtonItem *)defaultCancelButtonItem {
@@ -678,6 +700,11 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
     }
 }
 
+- (void)didReceiveMemoryWarning {
+    [super didReceiveMemoryWarning];
+    [self clearPrefetchedStepViewControllers];
+}
+
 - (UIImageView *)findHairlineViewUnder:(UIView *)view {
     if ([view isKindOfClass:UIImageView.class] && view.bounds.size.height <= 1.0) {
         return (UIImageView *)view;
@@ -959,6 +986,8 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
         
         // Collect toolbarItems
         [strongSelf collectToolbarItemsFromViewController:viewController];
+        
+        [strongSelf schedulePrefetchOfNextStepViewController];
     }];
 }
 
@@ -1031,10 +1060,35 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
 }
 
 - (ORKStepViewController *)viewControllerForStep:(ORKStep *)step {
+    return [self viewControllerForStep:step allowPrefetched:YES];
+}
+
+- (ORKStepViewController *)viewControllerForStep:(ORKStep *)step allowPrefetched:(BOOL)allowPrefetched {
     if (step == nil) {
         return nil;
     }
     
+    ORKStepViewController *stepViewController = allowPrefetched ? [self dequeuePrefetchedViewControllerForStep:step] : nil;
+    if (!stepViewController) {
+        stepViewController = [self makeViewControllerForStep:step];
+    }
+    
+    [self setManagedResult:stepViewController.result forKey:step.identifier];
+    
+    _stepViewControllerObserver = [[ORKViewControllerToolbarObserver alloc] initWithTargetViewController:stepViewController delegate:self];
+    return stepViewController;
+}
+
+- (ORKStepResult *)savedResultForStep:(ORKStep *)step {
+    ORKStepResult *result = _managedResults[step.identifier];
+    if (!result) {
+        result = [_defaultResultSource stepResultForStepIdentifier:step.identifier];
+    }
+    return result;
+}
+
+// Creates and configures the view controller for a step, without registering it as the current one.
+- (ORKStepViewController *)makeViewControllerForStep:(ORKStep *)step {
     ORKStepViewController *stepViewController = nil;
     
     if ([self.delegate respondsToSelector:@selector(taskViewController:viewControllerForStep:)]) {
@@ -1059,11 +1113,7 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
         else {
             
             // Get the step result associated with this step
-            ORKStepResult *result = nil;
-            result = _managedResults[step.identifier];
-            if (!result ) {
-                result = [_defaultResultSource stepResultForStepIdentifier:step.identifier];
-            }
+            ORKStepResult *result = [self savedResultForStep:step];
             
             if (!result) {
                 result = [[ORKStepResult alloc] initWithIdentifier:step.identifier];
@@ -1096,8 +1146,6 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
     }
     
     stepViewController.outputDirectory = self.outputDirectory;
-    [self setManagedResult:stepViewController.result forKey:step.identifier];
-    
     
     if (stepViewController.cancelButtonItem == nil) {
         stepViewController.cancelButtonItem = [self defaultCancelButtonItem];
@@ -1111,10 +1159,99 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
     
     stepViewController.delegate = self;
     
-    _stepViewControllerObserver = [[ORKViewControllerToolbarObserver alloc] initWithTargetViewController:stepViewController delegate:self];
     return stepViewController;
 }
 
+#pragma mark - Step view controller prefetching
+
+- (void)setPrefetchesStepViewControllers:(BOOL)prefetchesStepViewControllers {
+    _prefetchesStepViewControllers = prefetchesStepViewControllers;
+    if (!prefetchesStepViewControllers) {
+        [self clearPrefetchedStepViewControllers];
+    }
+}
+
+- (void)clearPrefetchedStepViewControllers {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prefetchNextStepViewController) object:nil];
+    [_prefetchedStepViewControllers removeAllObjects];
+}
+
+- (void)schedulePrefetchOfNextStepViewController {
+    if (!_prefetchesStepViewControllers) {
+        return;
+    }
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prefetchNextStepViewController) object:nil];
+    // The default run loop mode does not run while the user is scrolling or dragging, so this waits for idle time
+    [self performSelector:@selector(prefetchNextStepViewController) withObject:nil afterDelay:0 inModes:@[NSDefaultRunLoopMode]];
+}
+
+- (BOOL)canPrefetchViewControllerForStep:(ORKStep *)step {
+    // Steps whose view controller may come from the delegate, review steps, which list the steps
+    // visited so far, and active steps, which prepare recorders and media, are built when shown.
+    return (step.identifier != nil &&
+            ![self.delegate respondsToSelector:@selector(taskViewController:viewControllerForStep:)] &&
+            ![step isKindOfClass:[ORKReviewStep class]] &&
+            ![step isKindOfClass:[ORKActiveStep class]]);
+}
+
+- (void)prefetchNextStepViewController {
+    ORKStepViewController *currentStepViewController = _currentStepViewController;
+    if (!_prefetchesStepViewControllers || !currentStepViewController ||
+        currentStepViewController.parentReviewStep || currentStepViewController.isBeingReviewed ||
+        ![self.task respondsToSelector:@selector(stepAfterStep:withResult:)]) {
+        return;
+    }
+    
+    // Answers may have changed the navigation since the last prefetch, so predict again
+    ORKStep *step = [self stepAfterStep:currentStepViewController.step];
+    if (![self canPrefetchViewControllerForStep:step] || [self prefetchedStepViewControllerForStep:step]) {
+        return;
+    }
+    
+    ORKPrefetchedStepViewController *prefetched = [ORKPrefetchedStepViewController new];
+    prefetched.step = step;
+    prefetched.savedResult = [self savedResultForStep:step];
+    prefetched.viewController = [self makeViewControllerForStep:step];
+    
+    // Build and lay out the view now, so the transition only has to put it on screen
+    UIView *view = prefetched.viewController.view;
+    view.frame = _pageViewController.view.bounds;
+    [view layoutIfNeeded];
+    
+    [_prefetchedStepViewControllers addObject:prefetched];
+    if (_prefetchedStepViewControllers.count > ORKPrefetchedStepViewControllerLimit) {
+        [_prefetchedStepViewControllers removeObjectAtIndex:0];
+    }
+    ORK_Log_Debug(@"Prefetched %@", prefetched.viewController);
+}
+
+// Returns the prefetched view controller for a step if it was built from the result the step would
+// be shown with now. A stale one is dropped.
+- (ORKPrefetchedStepViewController *)prefetchedStepViewControllerForStep:(ORKStep *)step {
+    for (ORKPrefetchedStepViewController *prefetched in _prefetchedStepViewControllers) {
+        if ([prefetched.step.identifier isEqualToString:step.identifier]) {
+            if ((prefetched.step == step || [prefetched.step isEqual:step]) &&
+                ORKEqualObjects(prefetched.savedResult, [self savedResultForStep:step])) {
+                return prefetched;
+            }
+            [_prefetchedStepViewControllers removeObject:prefetched];
+            return nil;
+        }
+    }
+    return nil;
+}
+
+- (ORKStepViewController *)dequeuePrefetchedViewControllerForStep:(ORKStep *)step {
+    if (!_prefetchesStepViewControllers) {
+        return nil;
+    }
+    ORKPrefetchedStepViewController *prefetched = [self prefetchedStepViewControllerForStep:step];
+    if (prefetched) {
+        [_prefetchedStepViewControllers removeObject:prefetched];
+    }
+    return prefetched.viewController;
+}
+
 - (BOOL)shouldDisplayProgressLabel {
     return self.showsProgressInNavigationBar && [_task respondsToSelector:@selector(progressOfCurrentStep:withResult:)] && self.currentStepViewController.step.showsProgress && !(self.currentStepViewController.parentReviewStep.isStandalone);
 }
@@ -1122,6 +1259,7 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
 #pragma mark - internal action Handlers
 
 - (void)finishWithReason:(ORKTaskViewControllerFinishReason)reason error:(NSError *)error {
+    [self clearPrefetchedStepViewControllers];
     ORKStrongTypeOf(self.delegate) strongDelegate = self.delegate;
     if ([strongDelegate respondsToSelector:@selector(taskViewController:didFinishWithReason:error:)]) {
         [strongDelegate taskViewController:self didFinishWithReason:reason error:error];
@@ -1303,6 +1441,9 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
         [self setManagedResult:stepViewController.result forKey:stepViewController.step.identifier];
     }
     
+    // An answer can change which step comes next
+    [self schedulePrefetchOfNextStepViewController];
+    
     ORKStrongTypeOf(self.delegate) strongDelegate = self.delegate;
     if ([strongDelegate respondsToSelector:@selector(taskViewController:didChangeResult:)]) {
         [strongDelegate taskViewController:self didChangeResult:[self result]];
@@ -1356,7 +1497,8 @@ static NSString *const _ChildNavigationControllerRestorationKey = @"childNavigat
     if (reviewStepViewController.reviewStep && reviewStepViewController.reviewStep.isStandalone) {
         _defaultResultSource = reviewStepViewController.reviewStep.resultSource;
     }
-    ORKStepViewController *stepViewController = [self viewControllerForStep:step];
+    // The reviewed step is shown with review settings, so it is never taken from the prefetched ones
+    ORKStepViewController *stepViewController = [self viewControllerForStep:step allowPrefetched:NO];
     _defaultResultSource = resultSource;
     NSAssert(stepViewController != nil, @"A non-nil step should always generate a step view controller");
     stepViewController.continueButtonTitle = ORKLocalizedString(@"BUTTON_SAVE", nil);
@@ -45,8 +45,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic, strong, nullable) id answer;
 
+// Returns the live cell bound to the choice at indexPath, creating one if there is none.
 - (nullable ORKChoiceViewCell *)cellAtIndexPath:(NSIndexPath *)indexPath withReuseIdentifier:(nullable NSString *)identifier;
 
+// Binds a cell dequeued from a table view to the choice at indexPath, including its selection state.
+- (void)configureCell:(ORKChoiceViewCell *)cell atIndexPath:(NSIndexPath *)indexPath;
+
 - (BOOL)containsIndexPath:(NSIndexPath *)indexPath;
 
 - (void)didSelectCellAtIndexPath:(NSIndexPath *)indexPath;
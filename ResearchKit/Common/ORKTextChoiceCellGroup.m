@@ -40,7 +40,11 @@
     BOOL _immediateNavigation;
     NSIndexPath *_beginningIndexPath;
     
-    NSMutableDictionary *_cells;
+    // Selection is kept by index, so cells can be reused by the table view and rebound on dequeue.
+    NSMutableIndexSet *_selectedIndexes;
+    // The live cells bound to each choice index, and the reverse; neither retains the cells.
+    NSMapTable<NSNumber *, ORKChoiceViewCell *> *_cells;
+    NSMapTable<ORKChoiceViewCell *, NSNumber *> *_cellIndexes;
 }
 
 - (instancetype)initWithTextChoiceAnswerFormat:(ORKTextChoiceAnswerFormat *)answerFormat
@@ -53,7 +57,9 @@
         _helper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
         _singleChoice = answerFormat.style == ORKChoiceAnswerStyleSingleChoice;
         _immediateNavigation = immediateNavigation;
-        _cells = [NSMutableDictionary new];
+        _selectedIndexes = [NSMutableIndexSet new];
+        _cells = [NSMapTable strongToWeakObjectsMapTable];
+        _cellIndexes = [NSMapTable weakToStrongObjectsMapTable];
         [self setAnswer:answer];
     }
     return self;
@@ -74,50 +80,59 @@
         return nil;
     }
     
-    return [self cellAtIndex:indexPath.row-_beginningIndexPath.row withReuseIdentifier:identifier];
-}
-
-- (ORKChoiceViewCell *)cellAtIndex:(NSUInteger)index withReuseIdentifier:(NSString *)identifier {
-    ORKChoiceViewCell *cell = _cells[@(index)];
-    
+    NSUInteger index = indexPath.row - _beginningIndexPath.row;
+    ORKChoiceViewCell *cell = [_cells objectForKey:@(index)];
     if (cell == nil) {
         cell = [[ORKChoiceViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:identifier];
-        cell.immediateNavigation = _immediateNavigation;
-        ORKTextChoice *textChoice = [_helper textChoiceAtIndex:index];
-        cell.shortLabel.text = textChoice.text;
-        cell.longLabel.text = textChoice.detailText;
-        
-        _cells[@(index)] = cell;
-        
-        [self setSelectedIndexes:[_helper selectedIndexesForAnswer:_answer]];
+        [self bindCell:cell toIndex:index];
     }
-    
     return cell;
 }
 
+- (void)configureCell:(ORKChoiceViewCell *)cell atIndexPath:(NSIndexPath *)indexPath {
+    if ([self containsIndexPath:indexPath] == NO) {
+        return;
+    }
+    [self bindCell:cell toIndex:indexPath.row - _beginningIndexPath.row];
+}
+
+- (void)bindCell:(ORKChoiceViewCell *)cell toIndex:(NSUInteger)index {
+    NSNumber *previousIndex = [_cellIndexes objectForKey:cell];
+    if (previousIndex && [_cells objectForKey:previousIndex] == cell) {
+        [_cells removeObjectForKey:previousIndex];
+    }
+    [_cells setObject:cell forKey:@(index)];
+    [_cellIndexes setObject:@(index) forKey:cell];
+    
+    cell.immediateNavigation = _immediateNavigation;
+    ORKTextChoice *textChoice = [_helper textChoiceAtIndex:index];
+    cell.shortLabel.text = textChoice.text;
+    cell.longLabel.text = textChoice.detailText;
+    cell.selectedItem = [_selectedIndexes containsIndex:index];
+    [cell setNeedsLayout];
+}
+
 - (void)didSelectCellAtIndex:(NSUInteger)index {
-    ORKChoiceViewCell *touchedCell = [self cellAtIndex:index withReuseIdentifier:nil];
-        
+    // Only the cells whose state changes are updated, so a toggle does not touch every choice.
+    NSMutableIndexSet *changedIndexes = [NSMutableIndexSet indexSetWithIndex:index];
     if (_singleChoice) {
-        touchedCell.selectedItem = YES;
-        for (ORKChoiceViewCell *cell in _cells.allValues) {
-            if (cell != touchedCell) {
-                cell.selectedItem = NO;
-            }
-        }
+        [changedIndexes addIndexes:_selectedIndexes];
+        [_selectedIndexes removeAllIndexes];
+        [_selectedIndexes addIndex:index];
+    } else if ([_selectedIndexes containsIndex:index]) {
+        [_selectedIndexes removeIndex:index];
     } else {
-        touchedCell.selectedItem = !touchedCell.selectedItem;
-        if (touchedCell.selectedItem) {
-            ORKTextChoice *touchedChoice = [_helper textChoiceAtIndex:index];
-            for (NSNumber *num in _cells.allKeys) {
-                ORKChoiceViewCell *cell = _cells[num];
-                ORKTextChoice *choice = [_helper textChoiceAtIndex:num.unsignedIntegerValue];
-                if (cell != touchedCell && (touchedChoice.exclusive || (cell.selectedItem && choice.exclusive))) {
-                    cell.selectedItem = NO;
-                }
-            }
+        NSIndexSet *exclusiveIndexes = [_helper exclusiveChoiceIndexes];
+        if ([exclusiveIndexes containsIndex:index]) {
+            [changedIndexes addIndexes:_selectedIndexes];
+            [_selectedIndexes removeAllIndexes];
+        } else if (exclusiveIndexes.count > 0) {
+            [changedIndexes addIndexes:exclusiveIndexes];
+            [_selectedIndexes removeIndexes:exclusiveIndexes];
         }
+        [_selectedIndexes addIndex:index];
     }
+    [self updateCellsAtIndexes:changedIndexes];
     
     _answer = [_helper answerForSelectedIndexes:[self selectedIndexes]];
 }
@@ -138,30 +153,34 @@
 }
 
 - (void)setSelectedIndexes:(NSArray *)indexes {
-    for (NSUInteger index = 0; index < self.size; index++ ) {
-        BOOL selected = [indexes containsObject:@(index)];
-        
-        if (selected) {
-            // In case the cell has not been created, need to create cell
-            ORKChoiceViewCell *cell = [self cellAtIndex:index withReuseIdentifier:nil];
-            cell.selectedItem = YES;
-        } else {
-            // It is ok to not create the cell at here
-            ORKChoiceViewCell *cell = _cells[@(index)];
-            cell.selectedItem = NO;
-        }
+    [_selectedIndexes removeAllIndexes];
+    for (NSNumber *index in indexes) {
+        [_selectedIndexes addIndex:index.unsignedIntegerValue];
     }
+    [self updateCells];
 }
 
-- (NSArray *)selectedIndexes {
-    NSMutableArray *indexes = [NSMutableArray new];
-    
-    for (NSUInteger index = 0; index < self.size; index++ ) {
-        ORKChoiceViewCell *cell = _cells[@(index)];
-        if (cell.selectedItem) {
-            [indexes addObject:@(index)];
-        }
+- (void)updateCells {
+    for (NSNumber *index in _cells) {
+        [_cells objectForKey:index].selectedItem = [_selectedIndexes containsIndex:index.unsignedIntegerValue];
+    }
+}
+
+- (void)updateCellsAtIndexes:(NSIndexSet *)indexes {
+    if (indexes.count > _cells.count) {
+        [self updateCells];
+        return;
     }
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [_cells objectForKey:@(index)].selectedItem = [_selectedIndexes containsIndex:index];
+    }];
+}
+
+- (NSArray *)selectedIndexes {
+    NSMutableArray *indexes = [NSMutableArray arrayWithCapacity:_selectedIndexes.count];
+    [_selectedIndexes enumerateIndexesUsingBlock:^(NSUInteger index, BOOL *stop) {
+        [indexes addObject:@(index)];
+    }];
     
     return [indexes copy];
 }
@@ -0,0 +1,139 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKTextMeasurementCache.h"
+
+
+static const NSUInteger ORKTextMeasurementCacheCountLimit = 500;
+
+@interface ORKTextMeasurementKey : NSObject <NSCopying>
+
+- (instancetype)initWithString:(NSString *)string font:(UIFont *)font width:(CGFloat)width;
+
+@end
+
+
+@implementation ORKTextMeasurementKey {
+    NSString *_string;
+    UIFont *_font;
+    CGFloat _width;
+}
+
+- (instancetype)initWithString:(NSString *)string font:(UIFont *)font width:(CGFloat)width {
+    self = [super init];
+    if (self) {
+        _string = [string copy];
+        _font = font;
+        _width = width;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if ([self class] != [object class]) {
+        return NO;
+    }
+    
+    __typeof(self) castObject = object;
+    return (_width == castObject->_width &&
+            [_string isEqualToString:castObject->_string] &&
+            [_font isEqual:castObject->_font]);
+}
+
+- (NSUInteger)hash {
+    // Converting a width such as CGFLOAT_MAX to an integer is undefined, so hash it as a number
+    return _string.hash ^ _font.hash ^ @(_width).hash;
+}
+
+@end
+
+
+@implementation ORKTextMeasurementCache {
+    NSCache *_sizes;
+}
+
++ (instancetype)sharedCache {
+    static dispatch_once_t onceToken;
+    static id sharedInstance = nil;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[[self class] alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _sizes = [NSCache new];
+        _sizes.countLimit = ORKTextMeasurementCacheCountLimit;
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(contentSizeCategoryDidChange:)
+                                                     name:UIContentSizeCategoryDidChangeNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)contentSizeCategoryDidChange:(NSNotification *)notification {
+    [self removeAllSizes];
+}
+
+- (void)removeAllSizes {
+    [_sizes removeAllObjects];
+}
+
+- (CGSize)sizeOfString:(NSString *)string font:(UIFont *)font width:(CGFloat)width {
+    if (string.length == 0 || font == nil) {
+        return CGSizeZero;
+    }
+    
+    ORKTextMeasurementKey *key = [[ORKTextMeasurementKey alloc] initWithString:string font:font width:width];
+    NSValue *size = [_sizes objectForKey:key];
+    if (!size) {
+        CGRect rect = [string boundingRectWithSize:CGSizeMake(width, CGFLOAT_MAX)
+                                           options:NSStringDrawingUsesLineFragmentOrigin
+                                        attributes:@{ NSFontAttributeName : font }
+                                           context:nil];
+        size = [NSValue valueWithCGSize:rect.size];
+        [_sizes setObject:size forKey:key];
+    }
+    return size.CGSizeValue;
+}
+
+@end
@@ -93,6 +93,24 @@ typedef NS_ENUM(NSInteger, ORKAudioChannel) {
 } ORK_ENUM_AVAILABLE;
 
 
+/**
+ Audio stimulus constants, used by the tone audiometry task.
+ */
+typedef NS_ENUM(NSInteger, ORKAudioStimulusType) {
+    /// A continuous pure sinusoid tone.
+    ORKAudioStimulusTypePureTone = 0,
+    
+    /// A pure tone switched on and off, 200 ms on and 200 ms off, with 20 ms ramps.
+    ORKAudioStimulusTypePulsedTone,
+    
+    /// A tone frequency modulated by ±5% at a 5 Hz rate.
+    ORKAudioStimulusTypeWarbleTone,
+    
+    /// Noise band-limited to one third of an octave around the frequency.
+    ORKAudioStimulusTypeNarrowBandNoise
+} ORK_ENUM_AVAILABLE;
+
+
 /**
  Body side constants.
  */
@@ -156,3 +174,15 @@ typedef NS_ENUM(NSInteger, ORKMeasurementSystem) {
     /// United States customary system.
     ORKMeasurementSystemUSC,
 } ORK_ENUM_AVAILABLE;
+
+
+/**
+ Output modes of `ORKLocationRecorder`.
+ */
+typedef NS_ENUM(NSInteger, ORKLocationOutputMode) {
+    /// Every location received from CoreLocation is recorded.
+    ORKLocationOutputModeRaw = 0,
+    
+    /// Only the locations produced by the location filter are recorded.
+    ORKLocationOutputModeFiltered
+} ORK_ENUM_AVAILABLE;
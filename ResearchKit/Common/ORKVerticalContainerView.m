@@ -419,15 +419,14 @@ static const CGFloat AssumedStatusBarHeight = 20;
 }
 
 - (void)updateConstraints {
-    [NSLayoutConstraint deactivateConstraints:_variableConstraints];
-    [_variableConstraints removeAllObjects];
-    
-    if (!_variableConstraints) {
-        _variableConstraints = [NSMutableArray new];
-    }
+    // Build the full set of constraints, then diff it against the active set so that
+    // passes which change nothing structural do not churn the layout engine.
+    NSArray *previousConstraints = _variableConstraints;
+    _variableConstraints = [NSMutableArray new];
 
     _continueContainerToContainerBottomConstraint = nil;
     _continueContainerToScrollContainerBottomConstraint = nil;
+    _stepViewCenterInStepViewContainerConstraint = nil;
     
     NSArray *views = @[_headerView, _customViewContainer, _continueSkipContainer, _stepViewContainer];
     
@@ -626,7 +625,22 @@ static const CGFloat AssumedStatusBarHeight = 20;
     
     [self prepareCustomViewContainerConstraints];
     [self prepareStepViewContainerConstraints];
-    [NSLayoutConstraint activateConstraints:_variableConstraints];
+    
+    NSArray *constraints = _variableConstraints;
+    NSArray *activeConstraints = ORKUpdateActiveConstraints(previousConstraints, constraints);
+    NSLayoutConstraint *(^activeConstraint)(NSLayoutConstraint *) = ^NSLayoutConstraint *(NSLayoutConstraint *constraint) {
+        return constraint ? activeConstraints[[constraints indexOfObjectIdenticalTo:constraint]] : nil;
+    };
+    _variableConstraints = [activeConstraints mutableCopy];
+    
+    _headerMinimumHeightConstraint = activeConstraint(_headerMinimumHeightConstraint);
+    _illustrationHeightConstraint = activeConstraint(_illustrationHeightConstraint);
+    _stepViewCenterInStepViewContainerConstraint = activeConstraint(_stepViewCenterInStepViewContainerConstraint);
+    _stepViewToContinueConstraint = activeConstraint(_stepViewToContinueConstraint);
+    _stepViewToContinueMinimumConstraint = activeConstraint(_stepViewToContinueMinimumConstraint);
+    _topToIllustrationConstraint = activeConstraint(_topToIllustrationConstraint);
+    _continueContainerToScrollContainerBottomConstraint = activeConstraint(_continueContainerToScrollContainerBottomConstraint);
+    _continueContainerToContainerBottomConstraint = activeConstraint(_continueContainerToContainerBottomConstraint);
 
     [self updateLayoutMargins];
 
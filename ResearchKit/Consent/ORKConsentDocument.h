@@ -40,6 +40,34 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ The `ORKConsentPDFBatchMetrics` class reports the throughput of a batch of PDF documents
+ generated by `[ORKConsentDocument makePDFsWithSignatureSets:PDFHandler:completionHandler:]`.
+ */
+ORK_CLASS_AVAILABLE
+@interface ORKConsentPDFBatchMetrics : NSObject
+
++ (instancetype)new NS_UNAVAILABLE;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// The number of PDF documents generated.
+@property (nonatomic, readonly) NSUInteger numberOfDocuments;
+
+/// The total size of the generated PDF documents, in bytes.
+@property (nonatomic, readonly) unsigned long long numberOfBytes;
+
+/// The time spent preparing the content shared by all documents, in seconds.
+@property (nonatomic, readonly) NSTimeInterval templateDuration;
+
+/// The time from the start of the batch until the last document was generated, in seconds.
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+/// The number of documents generated per second, or 0 if the duration is 0.
+@property (nonatomic, readonly) double documentsPerSecond;
+
+@end
+
+
 /**
  The `ORKConsentDocument` class represents the content of an informed consent
  document, which is a document that's used to obtain informed consent from participants
@@ -145,9 +173,23 @@ ORK_CLASS_AVAILABLE
 
 /// @name PDF generation
 
+/**
+ A Boolean value indicating whether PDF files are laid out directly with TextKit, rather than
+ printed from the HTML of the document.
+ 
+ Direct layout is faster, runs on a background queue, and can generate many documents
+ concurrently, but it does not use the HTML styling, so the generated PDF looks different. It
+ applies only to documents without HTML (`htmlReviewContent`, or a section with `htmlContent`);
+ other documents are always printed from HTML.
+ 
+ The default value of this property is `NO`.
+ */
+@property (nonatomic, assign) BOOL usesNativePDFRendering;
+
 /**
  Initializer with ORKHTMLPDFWriter parameter. Allows for injecting mock dependency for the
- purposes of isolated unit testing.
+ purposes of isolated unit testing. A document created with this initializer always generates
+ its PDF through the writer.
 
  @param writer              The instance of the ORKHTMLPDFWriter upon which the class depends.
  @param sectionFormatter    An instance of ORKConsentSectionFormatter
@@ -161,13 +203,37 @@ ORK_CLASS_AVAILABLE
  Writes the document's content into a PDF file.
  
  The PDF is generated in a form suitable for printing. This is done asynchronously,
- so the PDF data is returned through a completion block.
+ so the PDF data is returned through a completion block. When `usesNativePDFRendering` is `YES`
+ and the document contains no HTML, the content is laid out on a background queue and the
+ completion block is called on the main queue.
  
  @param handler     The handler block for generated PDF data. When successful, the returned
                     data represents a complete PDF document that represents the consent.
  */
 - (void)makePDFWithCompletionHandler:(void (^)(NSData * _Nullable PDFData, NSError * _Nullable error))handler;
 
+/**
+ Writes one PDF file for each set of signatures, for example to export the signed consent of
+ many participants.
+ 
+ All documents share the document's title, sections and signature page content, which are
+ prepared only once; only the signatures are substituted. When `usesNativePDFRendering` is `YES`
+ and the document contains no HTML, the documents are generated concurrently on background
+ queues. Otherwise they are generated one after the other.
+ 
+ The document's own `signatures` are ignored.
+ 
+ @param signatureSets       The signatures to place in each generated document.
+ @param PDFHandler          The handler block to call on the main queue with each generated
+                            document and the index of its signature set. Documents may be
+                            delivered out of order.
+ @param completionHandler   The handler block to call on the main queue after the last document,
+                            or when an error stops the batch.
+ */
+- (void)makePDFsWithSignatureSets:(NSArray<NSArray<ORKConsentSignature *> *> *)signatureSets
+                       PDFHandler:(void (^)(NSUInteger index, NSData *PDFData))PDFHandler
+                completionHandler:(void (^)(ORKConsentPDFBatchMetrics * _Nullable metrics, NSError * _Nullable error))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -34,6 +34,7 @@
 #import "ORKConsentSection_Internal.h"
 #import "ORKConsentSignature.h"
 #import "ORKHTMLPDFWriter.h"
+#import "ORKConsentPDFRenderer.h"
 #import "ORKErrors.h"
 #import "ORKHelpers.h"
 #import "ORKHeadlineLabel.h"
@@ -43,6 +44,34 @@
 #import "ORKConsentSignatureFormatter.h"
 
 
+@implementation ORKConsentPDFBatchMetrics
+
+- (instancetype)initWithNumberOfDocuments:(NSUInteger)numberOfDocuments
+                            numberOfBytes:(unsigned long long)numberOfBytes
+                         templateDuration:(NSTimeInterval)templateDuration
+                                 duration:(NSTimeInterval)duration {
+    self = [super init];
+    if (self) {
+        _numberOfDocuments = numberOfDocuments;
+        _numberOfBytes = numberOfBytes;
+        _templateDuration = templateDuration;
+        _duration = duration;
+    }
+    return self;
+}
+
+- (double)documentsPerSecond {
+    return (_duration > 0) ? _numberOfDocuments / _duration : 0;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; documents: %lu; bytes: %llu; template: %.3fs; duration: %.3fs; %.1f documents/s>",
+            self.class.description, self, (unsigned long)_numberOfDocuments, _numberOfBytes, _templateDuration, _duration, self.documentsPerSecond];
+}
+
+@end
+
+
 @implementation ORKConsentDocument {
     NSMutableArray<ORKConsentSignature *> *_signatures;
 }
@@ -51,8 +80,8 @@
 
 - (instancetype)init {
     return [self initWithHTMLPDFWriter:[[ORKHTMLPDFWriter alloc] init]
-            consentSectionFormatter:[[ORKConsentSectionFormatter alloc] init]
-            consentSignatureFormatter:[[ORKConsentSignatureFormatter alloc] init]];
+               consentSectionFormatter:[[ORKConsentSectionFormatter alloc] init]
+             consentSignatureFormatter:[[ORKConsentSignatureFormatter alloc] init]];
 }
 
 - (instancetype)initWithHTMLPDFWriter:(ORKHTMLPDFWriter *)writer
@@ -76,6 +105,16 @@
     return [_signatures copy];
 }
 
+- (ORKConsentPDFRenderer *)nativePDFRenderer {
+    if (!_usesNativePDFRendering || ![ORKConsentPDFRenderer canRenderDocument:self]) {
+        return nil;
+    }
+    if (!_PDFRenderer) {
+        _PDFRenderer = [[ORKConsentPDFRenderer alloc] init];
+    }
+    return _PDFRenderer;
+}
+
 #pragma mark - Public
 
 - (void)addSignature:(ORKConsentSignature *)signature {
@@ -86,6 +125,15 @@
 }
 
 - (void)makePDFWithCompletionHandler:(void (^)(NSData *data, NSError *error))completionBlock {
+    ORKConsentPDFRenderer *renderer = [self nativePDFRenderer];
+    if (renderer) {
+        // Plain text documents are laid out directly, off the main thread.
+        [renderer renderPDFForDocument:self completion:^(NSData *data) {
+            completionBlock(data, nil);
+        }];
+        return;
+    }
+    
     [_writer writePDFFromHTML:[self htmlForMobile:NO withTitle:nil detail:nil]
           withCompletionBlock:^(NSData *data, NSError *error) {
         if (error) {
@@ -98,6 +146,72 @@
     }];
 }
 
+- (void)makePDFsWithSignatureSets:(NSArray<NSArray<ORKConsentSignature *> *> *)signatureSets
+                       PDFHandler:(void (^)(NSUInteger index, NSData *PDFData))PDFHandler
+                completionHandler:(void (^)(ORKConsentPDFBatchMetrics *metrics, NSError *error))completionHandler {
+    ORKConsentPDFRenderer *renderer = [self nativePDFRenderer];
+    if (renderer) {
+        [renderer renderPDFsForDocument:self
+                              signatureSets:signatureSets
+                                 PDFHandler:PDFHandler
+                                 completion:^(ORKConsentPDFBatchMetrics *metrics) {
+                                     completionHandler(metrics, nil);
+                                 }];
+        return;
+    }
+    
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    NSArray<NSString *> *htmls = nil;
+    if (_htmlReviewContent) {
+        // Review content replaces the signatures, so every document is the same.
+        htmls = @[[self htmlForMobile:NO withTitle:nil detail:nil]];
+    } else {
+        NSString *body = [self htmlBodyForMobile:NO withTitle:nil detail:nil];
+        NSMutableArray<NSString *> *documentHTMLs = [NSMutableArray arrayWithCapacity:signatureSets.count];
+        for (NSArray<ORKConsentSignature *> *signatures in signatureSets) {
+            NSString *documentBody = [body stringByAppendingString:[self htmlForSignatures:signatures]];
+            [documentHTMLs addObject:[[self class] wrapHTMLBody:documentBody mobile:NO]];
+        }
+        htmls = documentHTMLs;
+    }
+    CFAbsoluteTime templateDuration = CFAbsoluteTimeGetCurrent() - startTime;
+    
+    // The writer drives a web view on the main thread, so documents are written one at a time.
+    ORKHTMLPDFWriter *writer = _writer;
+    __block unsigned long long numberOfBytes = 0;
+    __block void (^writeDocumentAtIndex)(NSUInteger index);
+    void (^writeDocument)(NSUInteger) = ^(NSUInteger index) {
+        if (index >= signatureSets.count) {
+            writeDocumentAtIndex = nil;
+            completionHandler([[ORKConsentPDFBatchMetrics alloc] initWithNumberOfDocuments:signatureSets.count
+                                                                             numberOfBytes:numberOfBytes
+                                                                          templateDuration:templateDuration
+                                                                                  duration:CFAbsoluteTimeGetCurrent() - startTime], nil);
+            return;
+        }
+        BOOL sharesDocument = (htmls.count == 1);
+        NSString *html = sharesDocument ? htmls.firstObject : htmls[index];
+        [writer writePDFFromHTML:html withCompletionBlock:^(NSData *data, NSError *error) {
+            if (error) {
+                writeDocumentAtIndex = nil;
+                completionHandler(nil, error);
+                return;
+            }
+            NSUInteger lastIndex = sharesDocument ? signatureSets.count - 1 : index;
+            for (NSUInteger documentIndex = index; documentIndex <= lastIndex; documentIndex++) {
+                numberOfBytes += data.length;
+                PDFHandler(documentIndex, data);
+            }
+            // Let the writer finish with its web view before reusing it.
+            dispatch_async(dispatch_get_main_queue(), ^{
+                writeDocumentAtIndex(lastIndex + 1);
+            });
+        }];
+    };
+    writeDocumentAtIndex = writeDocument;
+    writeDocumentAtIndex(0);
+}
+
 #pragma mark - Private
 
 - (NSString *)mobileHTMLWithTitle:(NSString *)title detail:(NSString *)detail {
@@ -105,6 +219,19 @@
 }
 
 + (NSString *)cssStyleSheet:(BOOL)mobile {
+    if (!mobile) {
+        // The print style sheet does not depend on dynamic type, so it is only built once.
+        static NSString *printStyleSheet = nil;
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            printStyleSheet = [self buildCSSStyleSheet:NO];
+        });
+        return printStyleSheet;
+    }
+    return [self buildCSSStyleSheet:YES];
+}
+
++ (NSString *)buildCSSStyleSheet:(BOOL)mobile {
     NSMutableString *css = [@"@media print { .pagebreak { page-break-before: always; } }\n" mutableCopy];
     if (mobile) {
         [css appendString:@".header { margin-top: 36px ; margin-bottom: 30px; text-align: center; }\n"];
@@ -147,7 +274,7 @@
     [css appendString:@".grid:after { content: \"\"; display: table; clear: both; }\n"];
     [css appendString:@".border { -webkit-box-sizing: border-box; box-sizing: border-box; }\n"];
     
-    return css;
+    return [css copy];
 }
 
 + (NSString *)wrapHTMLBody:(NSString *)body mobile:(BOOL)mobile {
@@ -163,6 +290,23 @@
 }
 
 - (NSString *)htmlForMobile:(BOOL)mobile withTitle:(NSString *)title detail:(NSString *)detail {
+    NSString *body = [self htmlBodyForMobile:mobile withTitle:title detail:detail];
+    if (!mobile && !_htmlReviewContent) {
+        body = [body stringByAppendingString:[self htmlForSignatures:self.signatures]];
+    }
+    return [[self class] wrapHTMLBody:body mobile:mobile];
+}
+
+- (NSString *)htmlForSignatures:(NSArray<ORKConsentSignature *> *)signatures {
+    NSMutableString *html = [NSMutableString new];
+    for (ORKConsentSignature *signature in signatures) {
+        [html appendFormat:@"%@", [_signatureFormatter HTMLForSignature:signature]];
+    }
+    return html;
+}
+
+// Everything except the signatures, which differ between the documents of a batch.
+- (NSString *)htmlBodyForMobile:(BOOL)mobile withTitle:(NSString *)title detail:(NSString *)detail {
     NSMutableString *body = [NSMutableString new];
     
     // header
@@ -194,13 +338,9 @@
             // page break
             [body appendFormat:@"<h4 class=\"pagebreak\">%@</h4>", _signaturePageTitle ? : @""];
             [body appendFormat:@"<p>%@</p>", _signaturePageContent ? : @""];
-            
-            for (ORKConsentSignature *signature in self.signatures) {
-                [body appendFormat:@"%@", [_signatureFormatter HTMLForSignature:signature]];
-            }
         }
     }
-    return [[self class] wrapHTMLBody:body mobile:mobile];
+    return body;
 }
 
 #pragma mark - <NSSecureCoding>
@@ -215,6 +355,7 @@
         NSArray *signatures = (NSArray *)[aDecoder decodeObjectOfClass:[NSArray class] forKey:@"signatures"];
         _signatures = [signatures mutableCopy];
         ORK_DECODE_OBJ_ARRAY(aDecoder, sections, ORKConsentSection);
+        ORK_DECODE_BOOL(aDecoder, usesNativePDFRendering);
     }
     return self;
 }
@@ -226,6 +367,7 @@
     ORK_ENCODE_OBJ(aCoder, signatures);
     ORK_ENCODE_OBJ(aCoder, htmlReviewContent);
     ORK_ENCODE_OBJ(aCoder, sections);
+    ORK_ENCODE_BOOL(aCoder, usesNativePDFRendering);
 }
 
 + (BOOL)supportsSecureCoding {
@@ -240,6 +382,7 @@
     doc.signaturePageTitle = _signaturePageTitle;
     doc.signaturePageContent = _signaturePageContent;
     doc.htmlReviewContent = _htmlReviewContent;
+    doc.usesNativePDFRendering = _usesNativePDFRendering;
     
     // Deep copy the signatures
     doc.signatures = ORKArrayCopyObjects(_signatures);
@@ -263,7 +406,8 @@
             && ORKEqualObjects(self.signaturePageContent, castObject.signaturePageContent)
             && ORKEqualObjects(self.htmlReviewContent, castObject.htmlReviewContent)
             && ORKEqualObjects(self.signatures, castObject.signatures)
-            && ORKEqualObjects(self.sections, castObject.sections));
+            && ORKEqualObjects(self.sections, castObject.sections)
+            && self.usesNativePDFRendering == castObject.usesNativePDFRendering);
 }
 
 - (NSUInteger)hash {
@@ -36,12 +36,24 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class ORKHTMLPDFWriter;
+@class ORKConsentPDFRenderer;
 @class ORKConsentSectionFormatter;
 @class ORKConsentSignatureFormatter;
 
+@interface ORKConsentPDFBatchMetrics ()
+
+- (instancetype)initWithNumberOfDocuments:(NSUInteger)numberOfDocuments
+                            numberOfBytes:(unsigned long long)numberOfBytes
+                         templateDuration:(NSTimeInterval)templateDuration
+                                 duration:(NSTimeInterval)duration NS_DESIGNATED_INITIALIZER;
+
+@end
+
+
 @interface ORKConsentDocument ()
 
 @property (nonatomic, strong, nullable) ORKHTMLPDFWriter *writer;
+@property (nonatomic, strong, nullable) ORKConsentPDFRenderer *PDFRenderer;
 @property (nonatomic, strong, nullable) ORKConsentSectionFormatter *sectionFormatter;
 @property (nonatomic, strong, nullable) ORKConsentSignatureFormatter *signatureFormatter;
 
@@ -0,0 +1,118 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <UIKit/UIKit.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ORKConsentDocument;
+@class ORKConsentSignature;
+@class ORKConsentPDFBatchMetrics;
+
+/**
+ The `ORKConsentPDFRenderer` class lays out the title, sections, and signatures of a consent
+ document directly with TextKit and draws them into a PDF, without loading any HTML into a
+ web view. The work happens on a private serial queue, so the user interface stays responsive
+ while a signed consent document is generated.
+ 
+ Documents that carry HTML (`htmlReviewContent`, or a section with `htmlContent`) cannot be
+ laid out this way and must go through `ORKHTMLPDFWriter` instead.
+ */
+@interface ORKConsentPDFRenderer : NSObject
+
+/**
+ Returns whether the document can be rendered without an HTML layout engine.
+ */
++ (BOOL)canRenderDocument:(ORKConsentDocument *)document;
+
+/**
+ The size of each page. The default is A4 or US Letter, depending on the current locale.
+ */
+@property (nonatomic) CGSize pageSize;
+
+/**
+ The margins around the printable area of each page.
+ */
+@property (nonatomic) UIEdgeInsets pageMargins;
+
+/**
+ Renders a snapshot of the document on the renderer's queue.
+ 
+ The document is copied before this method returns, so it may be modified while rendering is in
+ progress. The completion handler is called on the main queue.
+ 
+ @param document    A document for which `canRenderDocument:` returns `YES`.
+ @param completion  The block to call with the PDF data.
+ */
+- (void)renderPDFForDocument:(ORKConsentDocument *)document completion:(void (^)(NSData *data))completion;
+
+/**
+ Renders the document synchronously on the calling thread.
+ 
+ No window, web view or run loop is involved, and the layout depends only on the document,
+ `pageSize` and `pageMargins`. This makes the method suitable for headless tests and benchmarks.
+ 
+ @param document    A document for which `canRenderDocument:` returns `YES`.
+ 
+ @return The PDF data.
+ */
+- (NSData *)PDFDataForDocument:(ORKConsentDocument *)document;
+
+/**
+ The maximum number of documents rendered at the same time by
+ `renderPDFsForDocument:signatureSets:PDFHandler:completion:`. The default is the number of
+ active processors.
+ */
+@property (nonatomic) NSUInteger maximumConcurrentRenderCount;
+
+/**
+ Renders one PDF for each set of signatures, all sharing the other content of the document.
+ 
+ The pages before the signature page are laid out and drawn once into a template PDF. Each
+ document then only lays out its signature page, and copies the template pages, on a pool of at
+ most `maximumConcurrentRenderCount` workers.
+ 
+ @param document        A document for which `canRenderDocument:` returns `YES`. Its own
+                        signatures are ignored.
+ @param signatureSets   The signatures to place in each generated document.
+ @param PDFHandler      The block to call on the main queue as each document is finished.
+                        Documents may finish out of order.
+ @param completion      The block to call on the main queue after the last document.
+ */
+- (void)renderPDFsForDocument:(ORKConsentDocument *)document
+                signatureSets:(NSArray<NSArray<ORKConsentSignature *> *> *)signatureSets
+                   PDFHandler:(void (^)(NSUInteger index, NSData *data))PDFHandler
+                   completion:(void (^)(ORKConsentPDFBatchMetrics *metrics))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,490 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKConsentPDFRenderer.h"
+#import "ORKConsentDocument_Internal.h"
+#import "ORKConsentSection.h"
+#import "ORKConsentSignature.h"
+#import "ORKHTMLPDFWriter.h"
+#import "ORKHelpers.h"
+
+
+typedef void (^ORKConsentPDFDrawingBlock)(void);
+
+static const CGFloat PageEdge = 72.0 / 4;
+static const CGFloat HeaderHeight = 25.0;
+static const CGFloat FooterHeight = 25.0;
+static const CGFloat SignatureRowSpacing = 24.0;
+static const CGFloat SignatureValueHeight = 50.0;
+static const CGFloat SignatureColumnSpacing = 20.0;
+static const CGFloat SignatureCaptionSpacing = 4.0;
+static const CGFloat SingleSignatureColumnWidth = 200.0;
+
+typedef struct {
+    CGRect pageRect;
+    CGRect contentRect;
+    CGRect footerRect;
+} ORKConsentPDFPageGeometry;
+
+static ORKConsentPDFPageGeometry ORKConsentPDFPageGeometryMake(CGSize pageSize, UIEdgeInsets pageMargins) {
+    ORKConsentPDFPageGeometry geometry;
+    geometry.pageRect = CGRectMake(0, 0, pageSize.width, pageSize.height);
+    CGRect printableRect = UIEdgeInsetsInsetRect(geometry.pageRect, pageMargins);
+    geometry.contentRect = UIEdgeInsetsInsetRect(printableRect, UIEdgeInsetsMake(HeaderHeight, 0, FooterHeight, 0));
+    geometry.footerRect = CGRectMake(CGRectGetMinX(printableRect), CGRectGetMaxY(printableRect) - FooterHeight, CGRectGetWidth(printableRect), FooterHeight);
+    return geometry;
+}
+
+#pragma mark - ORKConsentPDFLayout
+
+/*
+ Flows content into fixed-size pages. Each page is recorded as a list of drawing blocks, so the
+ number of pages is known before anything is drawn.
+ */
+@interface ORKConsentPDFLayout : NSObject
+
+- (instancetype)initWithContentRect:(CGRect)contentRect;
+
+@property (nonatomic, readonly) CGRect contentRect;
+
+@property (nonatomic, readonly) NSArray<NSArray<ORKConsentPDFDrawingBlock> *> *pages;
+
+- (void)startNewPage;
+
+- (void)addSpacing:(CGFloat)spacing;
+
+- (void)layoutText:(NSAttributedString *)text;
+
+- (void)layoutBlockWithHeight:(CGFloat)height drawing:(void (^)(CGRect rect))drawing;
+
+@end
+
+
+@implementation ORKConsentPDFLayout {
+    NSMutableArray<NSMutableArray<ORKConsentPDFDrawingBlock> *> *_pages;
+    CGFloat _offset;
+}
+
+- (instancetype)initWithContentRect:(CGRect)contentRect {
+    self = [super init];
+    if (self) {
+        _contentRect = contentRect;
+        _pages = [NSMutableArray array];
+        [self startNewPage];
+    }
+    return self;
+}
+
+- (NSArray<NSArray<ORKConsentPDFDrawingBlock> *> *)pages {
+    return _pages;
+}
+
+- (void)startNewPage {
+    [_pages addObject:[NSMutableArray array]];
+    _offset = 0;
+}
+
+- (CGFloat)remainingHeight {
+    return CGRectGetHeight(_contentRect) - _offset;
+}
+
+- (void)addSpacing:(CGFloat)spacing {
+    if (_offset > 0) {
+        _offset = MIN(_offset + spacing, CGRectGetHeight(_contentRect));
+    }
+}
+
+- (void)addDrawingBlock:(ORKConsentPDFDrawingBlock)block {
+    [_pages.lastObject addObject:block];
+}
+
+- (void)layoutText:(NSAttributedString *)text {
+    if (text.length == 0) {
+        return;
+    }
+    
+    NSTextStorage *textStorage = [[NSTextStorage alloc] initWithAttributedString:text];
+    NSLayoutManager *layoutManager = [[NSLayoutManager alloc] init];
+    [textStorage addLayoutManager:layoutManager];
+    
+    NSUInteger laidOutGlyphs = 0;
+    do {
+        NSTextContainer *textContainer = [[NSTextContainer alloc] initWithSize:CGSizeMake(CGRectGetWidth(_contentRect), [self remainingHeight])];
+        textContainer.lineFragmentPadding = 0;
+        [layoutManager addTextContainer:textContainer];
+        
+        NSRange glyphRange = [layoutManager glyphRangeForTextContainer:textContainer];
+        if (glyphRange.length == 0) {
+            if (_offset == 0) {
+                // Not even a single line fits on an empty page.
+                break;
+            }
+            [self startNewPage];
+            continue;
+        }
+        
+        CGPoint origin = CGPointMake(CGRectGetMinX(_contentRect), CGRectGetMinY(_contentRect) + _offset);
+        [self addDrawingBlock:^{
+            // The layout manager only holds a weak reference to its text storage.
+            NSLayoutManager *manager = textStorage.layoutManagers.firstObject;
+            [manager drawBackgroundForGlyphRange:glyphRange atPoint:origin];
+            [manager drawGlyphsForGlyphRange:glyphRange atPoint:origin];
+        }];
+        
+        laidOutGlyphs = NSMaxRange(glyphRange);
+        if (laidOutGlyphs < layoutManager.numberOfGlyphs) {
+            [self startNewPage];
+        } else {
+            _offset += CGRectGetMaxY([layoutManager usedRectForTextContainer:textContainer]);
+        }
+    } while (laidOutGlyphs < layoutManager.numberOfGlyphs);
+}
+
+- (void)layoutBlockWithHeight:(CGFloat)height drawing:(void (^)(CGRect rect))drawing {
+    if (height > [self remainingHeight] && _offset > 0) {
+        [self startNewPage];
+    }
+    CGRect rect = CGRectMake(CGRectGetMinX(_contentRect), CGRectGetMinY(_contentRect) + _offset, CGRectGetWidth(_contentRect), height);
+    [self addDrawingBlock:^{
+        drawing(rect);
+    }];
+    _offset += height;
+}
+
+@end
+
+
+#pragma mark - ORKConsentPDFRenderer
+
+@implementation ORKConsentPDFRenderer {
+    dispatch_queue_t _queue;
+    NSDictionary<NSString *, id> *_titleAttributes;
+    NSDictionary<NSString *, id> *_headingAttributes;
+    NSDictionary<NSString *, id> *_bodyAttributes;
+    NSDictionary<NSString *, id> *_captionAttributes;
+}
+
++ (BOOL)canRenderDocument:(ORKConsentDocument *)document {
+    if (document.htmlReviewContent) {
+        return NO;
+    }
+    for (ORKConsentSection *section in document.sections) {
+        if (!section.omitFromDocument && section.htmlContent) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
++ (NSDictionary<NSString *, id> *)attributesWithFont:(UIFont *)font spacingBefore:(CGFloat)spacingBefore {
+    NSMutableParagraphStyle *paragraphStyle = [[NSMutableParagraphStyle alloc] init];
+    paragraphStyle.paragraphSpacingBefore = spacingBefore;
+    paragraphStyle.paragraphSpacing = font.pointSize / 2;
+    return @{ NSFontAttributeName: font,
+              NSForegroundColorAttributeName: [UIColor blackColor],
+              NSParagraphStyleAttributeName: paragraphStyle };
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _pageSize = [ORKHTMLPDFWriter defaultPageSize];
+        _pageMargins = UIEdgeInsetsMake(PageEdge, PageEdge, PageEdge, PageEdge);
+        _queue = dispatch_queue_create("org.researchkit.consentpdfrenderer", DISPATCH_QUEUE_SERIAL);
+        _maximumConcurrentRenderCount = MAX([NSProcessInfo processInfo].activeProcessorCount, (NSUInteger)1);
+        
+        // Match the print style sheet used for HTML consent documents.
+        _titleAttributes = [[self class] attributesWithFont:[UIFont fontWithName:@"Helvetica-Bold" size:14] spacingBefore:36];
+        _headingAttributes = [[self class] attributesWithFont:[UIFont fontWithName:@"Helvetica-Bold" size:12] spacingBefore:12];
+        _bodyAttributes = [[self class] attributesWithFont:[UIFont fontWithName:@"Helvetica" size:12] spacingBefore:0];
+        _captionAttributes = [[self class] attributesWithFont:[UIFont fontWithName:@"Helvetica" size:10] spacingBefore:0];
+    }
+    return self;
+}
+
+- (void)renderPDFForDocument:(ORKConsentDocument *)document completion:(void (^)(NSData *data))completion {
+    NSParameterAssert(completion);
+    [self validateDocument:document];
+    
+    ORKConsentDocument *snapshot = [document copy];
+    CGSize pageSize = _pageSize;
+    UIEdgeInsets pageMargins = _pageMargins;
+    dispatch_async(_queue, ^{
+        NSData *data = [self PDFDataForDocument:snapshot pageSize:pageSize pageMargins:pageMargins];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(data);
+        });
+    });
+}
+
+- (NSData *)PDFDataForDocument:(ORKConsentDocument *)document {
+    [self validateDocument:document];
+    return [self PDFDataForDocument:document pageSize:_pageSize pageMargins:_pageMargins];
+}
+
+#pragma mark - Batch rendering
+
+- (void)renderPDFsForDocument:(ORKConsentDocument *)document
+                signatureSets:(NSArray<NSArray<ORKConsentSignature *> *> *)signatureSets
+                   PDFHandler:(void (^)(NSUInteger index, NSData *data))PDFHandler
+                   completion:(void (^)(ORKConsentPDFBatchMetrics *metrics))completion {
+    NSParameterAssert(PDFHandler);
+    NSParameterAssert(completion);
+    [self validateDocument:document];
+    NSMutableArray<NSArray<ORKConsentSignature *> *> *signatureSetsSnapshot = [NSMutableArray arrayWithCapacity:signatureSets.count];
+    for (NSArray<ORKConsentSignature *> *signatures in signatureSets) {
+        [self validateSignatures:signatures];
+        [signatureSetsSnapshot addObject:ORKArrayCopyObjects(signatures)];
+    }
+    
+    ORKConsentDocument *snapshot = [document copy];
+    snapshot.signatures = nil;
+    ORKConsentPDFPageGeometry geometry = ORKConsentPDFPageGeometryMake(_pageSize, _pageMargins);
+    NSUInteger maximumConcurrentRenderCount = MAX(_maximumConcurrentRenderCount, (NSUInteger)1);
+    dispatch_async(_queue, ^{
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        
+        // Everything before the signature page is the same in every document.
+        ORKConsentPDFLayout *bodyLayout = [[ORKConsentPDFLayout alloc] initWithContentRect:geometry.contentRect];
+        [self layoutBodyOfDocument:snapshot inLayout:bodyLayout];
+        NSData *templateData = [self PDFDataWithTemplate:NULL pages:bodyLayout.pages geometry:geometry drawsFooters:NO];
+        CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)templateData);
+        CGPDFDocumentRef templateDocument = CGPDFDocumentCreateWithProvider(provider);
+        CGDataProviderRelease(provider);
+        CFAbsoluteTime templateDuration = CFAbsoluteTimeGetCurrent() - startTime;
+        
+        // Only touched on the main queue.
+        __block unsigned long long numberOfBytes = 0;
+        
+        dispatch_semaphore_t workers = dispatch_semaphore_create(maximumConcurrentRenderCount);
+        dispatch_group_t group = dispatch_group_create();
+        dispatch_queue_t workerQueue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+        [signatureSetsSnapshot enumerateObjectsUsingBlock:^(NSArray<ORKConsentSignature *> *signatures, NSUInteger index, BOOL *stop) {
+            // Wait for a free worker rather than queueing every document at once.
+            dispatch_semaphore_wait(workers, DISPATCH_TIME_FOREVER);
+            dispatch_group_async(group, workerQueue, ^{
+                NSData *data = nil;
+                @autoreleasepool {
+                    ORKConsentPDFLayout *signatureLayout = [[ORKConsentPDFLayout alloc] initWithContentRect:geometry.contentRect];
+                    [self layoutSignaturePageOfDocument:snapshot signatures:signatures inLayout:signatureLayout];
+                    data = [self PDFDataWithTemplate:templateDocument pages:signatureLayout.pages geometry:geometry drawsFooters:YES];
+                }
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    numberOfBytes += data.length;
+                    PDFHandler(index, data);
+                });
+                dispatch_semaphore_signal(workers);
+            });
+        }];
+        
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+            CGPDFDocumentRelease(templateDocument);
+            ORKConsentPDFBatchMetrics *metrics = [[ORKConsentPDFBatchMetrics alloc] initWithNumberOfDocuments:signatureSetsSnapshot.count
+                                                                                               numberOfBytes:numberOfBytes
+                                                                                            templateDuration:templateDuration
+                                                                                                    duration:CFAbsoluteTimeGetCurrent() - startTime];
+            completion(metrics);
+        });
+    });
+}
+
+#pragma mark - Layout
+
+- (void)validateDocument:(ORKConsentDocument *)document {
+    if (![[self class] canRenderDocument:document]) {
+        @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Documents with HTML content must be rendered with ORKHTMLPDFWriter" userInfo:nil];
+    }
+    [self validateSignatures:document.signatures];
+}
+
+- (void)validateSignatures:(NSArray<ORKConsentSignature *> *)signatures {
+    for (ORKConsentSignature *signature in signatures) {
+        if (signature.title == nil) {
+            @throw [NSException exceptionWithName:NSObjectNotAvailableException reason:@"Signature title is missing" userInfo:nil];
+        }
+    }
+}
+
+- (NSData *)PDFDataForDocument:(ORKConsentDocument *)document pageSize:(CGSize)pageSize pageMargins:(UIEdgeInsets)pageMargins {
+    ORKConsentPDFPageGeometry geometry = ORKConsentPDFPageGeometryMake(pageSize, pageMargins);
+    ORKConsentPDFLayout *layout = [[ORKConsentPDFLayout alloc] initWithContentRect:geometry.contentRect];
+    [self layoutBodyOfDocument:document inLayout:layout];
+    [layout startNewPage];
+    [self layoutSignaturePageOfDocument:document signatures:document.signatures inLayout:layout];
+    return [self PDFDataWithTemplate:NULL pages:layout.pages geometry:geometry drawsFooters:YES];
+}
+
+- (void)appendParagraph:(NSString *)string attributes:(NSDictionary<NSString *, id> *)attributes toText:(NSMutableAttributedString *)text {
+    NSString *paragraph = [(string ? : @"") stringByAppendingString:@"\n"];
+    [text appendAttributedString:[[NSAttributedString alloc] initWithString:paragraph attributes:attributes]];
+}
+
+- (void)layoutBodyOfDocument:(ORKConsentDocument *)document inLayout:(ORKConsentPDFLayout *)layout {
+    NSMutableAttributedString *text = [[NSMutableAttributedString alloc] init];
+    [self appendParagraph:document.title attributes:_titleAttributes toText:text];
+    for (ORKConsentSection *section in document.sections) {
+        if (!section.omitFromDocument) {
+            [self appendParagraph:(section.formalTitle ? : section.title) attributes:_headingAttributes toText:text];
+            [self appendParagraph:section.content attributes:_bodyAttributes toText:text];
+        }
+    }
+    [layout layoutText:text];
+}
+
+- (void)layoutSignaturePageOfDocument:(ORKConsentDocument *)document signatures:(NSArray<ORKConsentSignature *> *)signatures inLayout:(ORKConsentPDFLayout *)layout {
+    NSMutableAttributedString *text = [[NSMutableAttributedString alloc] init];
+    [self appendParagraph:document.signaturePageTitle attributes:_headingAttributes toText:text];
+    [self appendParagraph:document.signaturePageContent attributes:_bodyAttributes toText:text];
+    [layout layoutText:text];
+    
+    for (ORKConsentSignature *signature in signatures) {
+        [self layoutSignature:signature inLayout:layout];
+    }
+}
+
+- (void)layoutSignature:(ORKConsentSignature *)signature inLayout:(ORKConsentPDFLayout *)layout {
+    // The same elements as ORKConsentSignatureFormatter, in the same order.
+    NSMutableArray *values = [NSMutableArray array];
+    NSMutableArray<NSString *> *captions = [NSMutableArray array];
+    
+    if (signature.requiresName || signature.familyName || signature.givenName) {
+        NSMutableArray<NSString *> *names = [NSMutableArray array];
+        if (signature.givenName) {
+            [names addObject:signature.givenName];
+        }
+        if (signature.familyName) {
+            [names addObject:signature.familyName];
+        }
+        if (ORKCurrentLocalePresentsFamilyNameFirst()) {
+            names = [[[names reverseObjectEnumerator] allObjects] mutableCopy];
+        }
+        [values addObject:[names componentsJoinedByString:@" "]];
+        [captions addObject:[NSString stringWithFormat:ORKLocalizedString(@"CONSENT_DOC_LINE_PRINTED_NAME", nil), signature.title]];
+    }
+    
+    if (signature.requiresSignatureImage || signature.signatureImage) {
+        [values addObject:signature.signatureImage ? : @""];
+        [captions addObject:[NSString stringWithFormat:ORKLocalizedString(@"CONSENT_DOC_LINE_SIGNATURE", nil), signature.title]];
+    }
+    
+    if (values.count == 0) {
+        return;
+    }
+    [values addObject:signature.signatureDate ? : @""];
+    [captions addObject:ORKLocalizedString(@"CONSENT_DOC_LINE_DATE", nil)];
+    
+    CGFloat columnWidth = (values.count > 1) ? (CGRectGetWidth(layout.contentRect) - 2 * SignatureColumnSpacing) / 3 : SingleSignatureColumnWidth;
+    CGFloat captionHeight = 0;
+    for (NSString *caption in captions) {
+        CGRect captionBounds = [caption boundingRectWithSize:CGSizeMake(columnWidth, CGFLOAT_MAX)
+                                                     options:NSStringDrawingUsesLineFragmentOrigin
+                                                  attributes:_captionAttributes
+                                                     context:nil];
+        captionHeight = MAX(captionHeight, ceil(CGRectGetHeight(captionBounds)));
+    }
+    
+    NSDictionary<NSString *, id> *valueAttributes = _bodyAttributes;
+    NSDictionary<NSString *, id> *captionAttributes = _captionAttributes;
+    [layout addSpacing:SignatureRowSpacing];
+    [layout layoutBlockWithHeight:SignatureValueHeight + SignatureCaptionSpacing + captionHeight drawing:^(CGRect rect) {
+        [[UIColor blackColor] setFill];
+        for (NSUInteger index = 0; index < values.count; index++) {
+            CGFloat x = CGRectGetMinX(rect) + index * (columnWidth + SignatureColumnSpacing);
+            CGRect valueRect = CGRectMake(x, CGRectGetMinY(rect), columnWidth, SignatureValueHeight);
+            id value = values[index];
+            if ([value isKindOfClass:[UIImage class]]) {
+                UIImage *image = value;
+                CGFloat scale = MIN(1.0, MIN(CGRectGetWidth(valueRect) / image.size.width, CGRectGetHeight(valueRect) / image.size.height));
+                CGSize imageSize = CGSizeMake(image.size.width * scale, image.size.height * scale);
+                [image drawInRect:CGRectMake(x, CGRectGetMaxY(valueRect) - imageSize.height, imageSize.width, imageSize.height)];
+            } else {
+                NSString *string = value;
+                CGSize stringSize = [string sizeWithAttributes:valueAttributes];
+                [string drawAtPoint:CGPointMake(x, CGRectGetMaxY(valueRect) - ceil(stringSize.height)) withAttributes:valueAttributes];
+            }
+            UIRectFill(CGRectMake(x, CGRectGetMaxY(valueRect), columnWidth, 1));
+            
+            CGRect captionRect = CGRectMake(x, CGRectGetMaxY(valueRect) + SignatureCaptionSpacing, columnWidth, captionHeight);
+            [captions[index] drawWithRect:captionRect options:NSStringDrawingUsesLineFragmentOrigin attributes:captionAttributes context:nil];
+        }
+    }];
+}
+
+#pragma mark - Drawing
+
+/*
+ Draws the pages of `templateDocument`, if any, followed by `pages`. The template is only read, so
+ several workers can copy its pages at the same time.
+ */
+- (NSData *)PDFDataWithTemplate:(CGPDFDocumentRef)templateDocument
+                          pages:(NSArray<NSArray<ORKConsentPDFDrawingBlock> *> *)pages
+                       geometry:(ORKConsentPDFPageGeometry)geometry
+                   drawsFooters:(BOOL)drawsFooters {
+    NSMutableData *data = [NSMutableData data];
+    UIGraphicsBeginPDFContextToData(data, geometry.pageRect, @{});
+    
+    NSUInteger numberOfTemplatePages = templateDocument ? CGPDFDocumentGetNumberOfPages(templateDocument) : 0;
+    NSUInteger numberOfPages = numberOfTemplatePages + pages.count;
+    for (NSUInteger pageIndex = 0; pageIndex < numberOfPages; pageIndex++) {
+        UIGraphicsBeginPDFPage();
+        if (pageIndex < numberOfTemplatePages) {
+            // UIKit contexts are flipped relative to PDF page space.
+            CGContextRef context = UIGraphicsGetCurrentContext();
+            CGContextSaveGState(context);
+            CGContextTranslateCTM(context, 0, CGRectGetHeight(geometry.pageRect));
+            CGContextScaleCTM(context, 1, -1);
+            CGContextDrawPDFPage(context, CGPDFDocumentGetPage(templateDocument, pageIndex + 1));
+            CGContextRestoreGState(context);
+        } else {
+            for (ORKConsentPDFDrawingBlock block in pages[pageIndex - numberOfTemplatePages]) {
+                block();
+            }
+        }
+        if (drawsFooters) {
+            [self drawFooterForPageAtIndex:pageIndex numberOfPages:numberOfPages inRect:geometry.footerRect];
+        }
+    }
+    
+    UIGraphicsEndPDFContext();
+    return data;
+}
+
+- (void)drawFooterForPageAtIndex:(NSUInteger)pageIndex numberOfPages:(NSUInteger)numberOfPages inRect:(CGRect)footerRect {
+    NSString *footer = [NSString stringWithFormat:ORKLocalizedString(@"CONSENT_PAGE_NUMBER_FORMAT", nil), (long)(pageIndex + 1), (long)numberOfPages];
+    NSDictionary<NSString *, id> *attributes = @{ NSFontAttributeName: [UIFont fontWithName:@"Helvetica" size:12] };
+    CGSize size = [footer sizeWithAttributes:attributes];
+    
+    // Center Text
+    CGPoint drawPoint = CGPointMake(CGRectGetMidX(footerRect) - (size.width / 2), CGRectGetMidY(footerRect) - (size.height / 2));
+    [footer drawAtPoint:drawPoint withAttributes:attributes];
+}
+
+@end
@@ -0,0 +1,85 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <AVFoundation/AVFoundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ The decoded frames of a visual consent movie, in the bi-planar 4:2:0 format that
+ ORKEAGLMoviePlayerView consumes. The pixel buffers are IOSurface backed, as the texture
+ cache requires; the player view still creates a texture for every frame it renders.
+ */
+@interface ORKVisualConsentMovieFrames : NSObject
+
+@property (nonatomic, readonly) NSUInteger numberOfFrames;
+
+@property (nonatomic, readonly) CGSize presentationSize;
+
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+// Memory held by the pixel buffers, in bytes. The buffers may be smaller than the presentation size.
+@property (nonatomic, readonly) NSUInteger numberOfBytes;
+
+- (CVPixelBufferRef)pixelBufferAtIndex:(NSUInteger)index;
+
+- (NSTimeInterval)presentationTimeAtIndex:(NSUInteger)index;
+
+@end
+
+
+/*
+ Caches decoded visual consent movies by URL, so paging forward through scenes that have already
+ been seen does not decode the same movie again. Decoding happens on a background queue.
+ 
+ The cost of each entry is its size in bytes, and `totalCostLimit` is the memory budget, 64 MB
+ by default. A movie larger than the budget is decoded at a lower resolution, down to half of its
+ own, so that it fits. A movie that does not fit even then is not cached, and is remembered so
+ that later preloads do not decode it again.
+ */
+@interface ORKVisualConsentFrameCache : NSCache
+
++ (instancetype)sharedCache;
+
+- (nullable ORKVisualConsentMovieFrames *)framesForMovieURL:(NSURL *)movieURL;
+
+/*
+ Decodes the movie in the background unless it is already cached or being decoded.
+ The completion block is called on the main queue, with nil if the movie could not be decoded
+ or does not fit in the budget.
+ */
+- (void)preloadFramesForMovieURL:(NSURL *)movieURL
+                      completion:(nullable void (^)(ORKVisualConsentMovieFrames * _Nullable frames))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,262 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import "ORKVisualConsentFrameCache.h"
+#import "ORKHelpers.h"
+
+
+// Holds the largest bundled movie at 2x, consent_01: 138 frames of 686 x 398, about 58 MB.
+static const NSUInteger ORKVisualConsentFrameCacheDefaultBudget = 64 * 1024 * 1024;
+
+// Movies are decoded at a lower resolution to fit the budget, but not below this scale. At half
+// scale the 3x movies (1862 x 1080, about 3 MB a frame) take from 32 MB to 104 MB.
+static const CGFloat ORKVisualConsentFrameCacheMinimumScale = 0.5;
+
+// Bytes per pixel of bi-planar 4:2:0
+static const CGFloat ORKVisualConsentFrameCacheBytesPerPixel = 1.5;
+
+@interface ORKVisualConsentMovieFrames ()
+
+- (instancetype)initWithPixelBuffers:(NSArray *)pixelBuffers
+                   presentationTimes:(NSArray<NSNumber *> *)presentationTimes
+                    presentationSize:(CGSize)presentationSize
+                            duration:(NSTimeInterval)duration
+                       numberOfBytes:(NSUInteger)numberOfBytes;
+
+@end
+
+
+@implementation ORKVisualConsentMovieFrames {
+    // CVPixelBufferRefs, retained by the array.
+    NSArray *_pixelBuffers;
+    NSArray<NSNumber *> *_presentationTimes;
+}
+
+- (instancetype)initWithPixelBuffers:(NSArray *)pixelBuffers
+                   presentationTimes:(NSArray<NSNumber *> *)presentationTimes
+                    presentationSize:(CGSize)presentationSize
+                            duration:(NSTimeInterval)duration
+                       numberOfBytes:(NSUInteger)numberOfBytes {
+    self = [super init];
+    if (self) {
+        _pixelBuffers = [pixelBuffers copy];
+        _presentationTimes = [presentationTimes copy];
+        _presentationSize = presentationSize;
+        _duration = duration;
+        _numberOfBytes = numberOfBytes;
+    }
+    return self;
+}
+
+- (NSUInteger)numberOfFrames {
+    return _pixelBuffers.count;
+}
+
+- (CVPixelBufferRef)pixelBufferAtIndex:(NSUInteger)index {
+    return (__bridge CVPixelBufferRef)_pixelBuffers[index];
+}
+
+- (NSTimeInterval)presentationTimeAtIndex:(NSUInteger)index {
+    return _presentationTimes[index].doubleValue;
+}
+
+@end
+
+
+@implementation ORKVisualConsentFrameCache {
+    dispatch_queue_t _decodingQueue;
+    NSMutableDictionary<NSURL *, NSMutableArray *> *_pendingCompletions;
+    // Movies that do not fit in the budget, so they are not decoded again on every preload
+    NSMutableSet<NSURL *> *_oversizedMovieURLs;
+}
+
++ (instancetype)sharedCache {
+    static dispatch_once_t onceToken;
+    static id sharedInstance = nil;
+    dispatch_once(&onceToken, ^{
+        sharedInstance = [[[self class] alloc] init];
+    });
+    return sharedInstance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.totalCostLimit = ORKVisualConsentFrameCacheDefaultBudget;
+        _decodingQueue = dispatch_queue_create("org.researchkit.visualconsentframecache", DISPATCH_QUEUE_SERIAL);
+        _pendingCompletions = [NSMutableDictionary dictionary];
+        _oversizedMovieURLs = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (void)setTotalCostLimit:(NSUInteger)totalCostLimit {
+    [super setTotalCostLimit:totalCostLimit];
+    @synchronized (self) {
+        [_oversizedMovieURLs removeAllObjects];
+    }
+}
+
+- (BOOL)isMovieOversized:(NSURL *)movieURL {
+    @synchronized (self) {
+        return [_oversizedMovieURLs containsObject:movieURL];
+    }
+}
+
+- (ORKVisualConsentMovieFrames *)framesForMovieURL:(NSURL *)movieURL {
+    return [self objectForKey:movieURL];
+}
+
+- (void)preloadFramesForMovieURL:(NSURL *)movieURL completion:(void (^)(ORKVisualConsentMovieFrames *frames))completion {
+    NSParameterAssert(movieURL);
+    NSAssert([NSThread isMainThread], @"Preload from the main thread");
+    
+    ORKVisualConsentMovieFrames *frames = [self framesForMovieURL:movieURL];
+    if (frames || [self isMovieOversized:movieURL]) {
+        if (completion) {
+            completion(frames);
+        }
+        return;
+    }
+    
+    NSMutableArray *completions = _pendingCompletions[movieURL];
+    BOOL isDecoding = (completions != nil);
+    if (!isDecoding) {
+        completions = [NSMutableArray array];
+        _pendingCompletions[movieURL] = completions;
+    }
+    if (completion) {
+        [completions addObject:[completion copy]];
+    }
+    if (isDecoding) {
+        return;
+    }
+    
+    NSUInteger budget = self.totalCostLimit ? : NSUIntegerMax;
+    dispatch_async(_decodingQueue, ^{
+        BOOL oversized = NO;
+        ORKVisualConsentMovieFrames *decodedFrames = [[self class] decodeFramesForMovieURL:movieURL budget:budget oversized:&oversized];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (decodedFrames) {
+                [self setObject:decodedFrames forKey:movieURL cost:decodedFrames.numberOfBytes];
+            } else if (oversized && budget == (self.totalCostLimit ? : NSUIntegerMax)) {
+                @synchronized (self) {
+                    [_oversizedMovieURLs addObject:movieURL];
+                }
+            }
+            NSArray *pendingCompletions = _pendingCompletions[movieURL];
+            [_pendingCompletions removeObjectForKey:movieURL];
+            for (void (^pendingCompletion)(ORKVisualConsentMovieFrames *) in pendingCompletions) {
+                pendingCompletion(decodedFrames);
+            }
+        });
+    });
+}
+
++ (ORKVisualConsentMovieFrames *)decodeFramesForMovieURL:(NSURL *)movieURL budget:(NSUInteger)budget oversized:(BOOL *)oversized {
+    AVURLAsset *asset = [AVURLAsset URLAssetWithURL:movieURL options:nil];
+    AVAssetTrack *track = [asset tracksWithMediaType:AVMediaTypeVideo].firstObject;
+    if (!track) {
+        return nil;
+    }
+    
+    // Estimate the decoded size up front, and scale the frames down if needed to fit the budget
+    CGSize size = CGSizeApplyAffineTransform(track.naturalSize, track.preferredTransform);
+    CGSize presentationSize = CGSizeMake(fabs(size.width), fabs(size.height));
+    CGFloat scale = 1.0;
+    double estimatedNumberOfFrames = ceil(track.nominalFrameRate * CMTimeGetSeconds(track.timeRange.duration));
+    if (estimatedNumberOfFrames > 0 && presentationSize.width > 0 && presentationSize.height > 0) {
+        double estimatedNumberOfBytes = estimatedNumberOfFrames * presentationSize.width * presentationSize.height * ORKVisualConsentFrameCacheBytesPerPixel;
+        if (estimatedNumberOfBytes > budget) {
+            // Aim a little under the budget, leaving room for row padding in the buffers
+            scale = sqrt(0.9 * budget / estimatedNumberOfBytes);
+        }
+    }
+    if (scale < ORKVisualConsentFrameCacheMinimumScale) {
+        // Too large to cache; it keeps streaming through AVPlayer instead.
+        *oversized = YES;
+        return nil;
+    }
+    
+    NSError *error = nil;
+    AVAssetReader *reader = [AVAssetReader assetReaderWithAsset:asset error:&error];
+    if (!reader) {
+        ORK_Log_Warning(@"%@", error);
+        return nil;
+    }
+    NSMutableDictionary *outputSettings = [@{ (id)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange),
+                                              (id)kCVPixelBufferIOSurfacePropertiesKey: @{} } mutableCopy];
+    if (scale < 1.0) {
+        // Even dimensions, as the chroma plane is subsampled by two
+        outputSettings[(id)kCVPixelBufferWidthKey] = @(2 * floor(track.naturalSize.width * scale / 2));
+        outputSettings[(id)kCVPixelBufferHeightKey] = @(2 * floor(track.naturalSize.height * scale / 2));
+    }
+    AVAssetReaderTrackOutput *output = [AVAssetReaderTrackOutput assetReaderTrackOutputWithTrack:track outputSettings:outputSettings];
+    output.alwaysCopiesSampleData = NO;
+    [reader addOutput:output];
+    if (![reader startReading]) {
+        ORK_Log_Warning(@"%@", reader.error);
+        return nil;
+    }
+    
+    NSMutableArray *pixelBuffers = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *presentationTimes = [NSMutableArray array];
+    NSUInteger numberOfBytes = 0;
+    CMSampleBufferRef sampleBuffer = NULL;
+    while ((sampleBuffer = [output copyNextSampleBuffer])) {
+        CVPixelBufferRef pixelBuffer = CMSampleBufferGetImageBuffer(sampleBuffer);
+        if (pixelBuffer) {
+            numberOfBytes += CVPixelBufferGetDataSize(pixelBuffer);
+            [pixelBuffers addObject:(__bridge id)pixelBuffer];
+            [presentationTimes addObject:@(CMTimeGetSeconds(CMSampleBufferGetPresentationTimeStamp(sampleBuffer)))];
+        }
+        CFRelease(sampleBuffer);
+        
+        if (numberOfBytes > budget) {
+            // Larger than estimated, for example from row padding
+            [reader cancelReading];
+            *oversized = YES;
+            return nil;
+        }
+    }
+    if (reader.status != AVAssetReaderStatusCompleted || pixelBuffers.count == 0) {
+        return nil;
+    }
+    
+    // The presentation size is the movie's, which keeps its aspect ratio when the frames are scaled
+    return [[ORKVisualConsentMovieFrames alloc] initWithPixelBuffers:pixelBuffers
+                                                   presentationTimes:presentationTimes
+                                                    presentationSize:presentationSize
+                                                            duration:CMTimeGetSeconds(asset.duration)
+                                                       numberOfBytes:numberOfBytes];
+}
+
+@end
@@ -51,6 +51,7 @@
 #import "ORKAccessibility.h"
 #import "ORKTintedImageView.h"
 #import "ORKTintedImageView_Internal.h"
+#import "ORKVisualConsentFrameCache.h"
 
 
 @interface ORKVisualConsentStepViewController () <UIPageViewControllerDelegate, ORKScrollViewObserverDelegate> {
@@ -143,6 +144,7 @@
 
 - (void)dealloc {
     [[ORKTintedImageCache sharedCache] removeAllObjects];
+    [[ORKVisualConsentFrameCache sharedCache] removeAllObjects];
 }
 
 - (void)stepDidChange {
@@ -536,10 +538,48 @@
                           [[ORKTintedImageCache sharedCache] cacheImage:nextConsentSection.image
                                                               tintColor:currentSceneImageView.tintColor
                                                                   scale:currentSceneImageView.window.screen.scale];
+                          
+                          // Decode the next transition's movie while the user reads this page.
+                          NSUInteger currentIndex = [self currentIndex];
+                          NSURL *nextMovieURL = [self movieURLForTransitionFromIndex:currentIndex
+                                                                             toIndex:currentIndex + 1
+                                                             transitionBeforeAnimate:NULL];
+                          if (nextMovieURL) {
+                              [[ORKVisualConsentFrameCache sharedCache] preloadFramesForMovieURL:nextMovieURL completion:nil];
+                          }
                       }
                   }];
 }
 
+- (NSURL *)movieURLForTransitionFromIndex:(NSUInteger)currentIndex
+                                   toIndex:(NSUInteger)toIndex
+                   transitionBeforeAnimate:(BOOL *)transitionBeforeAnimate {
+    // Only use video animation when going forward
+    if (currentIndex == NSNotFound || toIndex == NSNotFound || toIndex <= currentIndex || toIndex >= _visualSections.count) {
+        return nil;
+    }
+    
+    ORKConsentSectionType currentSection = [(ORKConsentSection *)_visualSections[currentIndex] type];
+    ORKConsentSectionType destinationSection = [(ORKConsentSection *)_visualSections[toIndex] type];
+    
+    // Use the custom animation URL, if there is one for the destination index.
+    NSURL *url = [ORKDynamicCast(_visualSections[toIndex], ORKConsentSection) customAnimationURL];
+    
+    // If there's no custom URL, use an animation only if transitioning in the expected order.
+    // Exception for datagathering, which does an arrival animation AFTER.
+    if (!url) {
+        if (destinationSection == ORKConsentSectionTypeDataGathering) {
+            if (transitionBeforeAnimate) {
+                *transitionBeforeAnimate = YES;
+            }
+            url = ORKMovieURLForConsentSectionType(ORKConsentSectionTypeOverview);
+        } else if ((destinationSection - currentSection) == 1) {
+            url = ORKMovieURLForConsentSectionType(currentSection);
+        }
+    }
+    return url;
+}
+
 - (void)showViewController:(ORKConsentSceneViewController *)viewController
                    forward:(BOOL)forward
                   animated:(BOOL)animated
@@ -582,33 +622,9 @@
     } else {
         NSUInteger toIndex = [self indexOfViewController:viewController];
         
-        NSURL *url = nil;
         BOOL animateBeforeTransition = NO;
         BOOL transitionBeforeAnimate = NO;
-        
-        ORKConsentSectionType currentSection = [(ORKConsentSection *)_visualSections[currentIndex] type];
-        ORKConsentSectionType destinationSection = (toIndex != NSNotFound) ? [(ORKConsentSection *)_visualSections[toIndex] type] : ORKConsentSectionTypeCustom;
-        
-        // Only use video animation when going forward
-        if (toIndex > currentIndex) {
-            
-            // Use the custom animation URL, if there is one for the destination index.
-            if (toIndex != NSNotFound && toIndex < _visualSections.count) {
-                url = [ORKDynamicCast(_visualSections[toIndex], ORKConsentSection) customAnimationURL];
-            }
-            BOOL isCustomURL = (url != nil);
-            
-            // If there's no custom URL, use an animation only if transitioning in the expected order.
-            // Exception for datagathering, which does an arrival animation AFTER.
-            if (!isCustomURL) {
-                if (destinationSection == ORKConsentSectionTypeDataGathering) {
-                    transitionBeforeAnimate = YES;
-                    url = ORKMovieURLForConsentSectionType(ORKConsentSectionTypeOverview);
-                } else if ((destinationSection - currentSection) == 1) {
-                    url = ORKMovieURLForConsentSectionType(currentSection);
-                }
-            }
-        }
+        NSURL *url = [self movieURLForTransitionFromIndex:currentIndex toIndex:toIndex transitionBeforeAnimate:&transitionBeforeAnimate];
         
         if (!url) {
             // No video animation URL, just a regular push transition animation.
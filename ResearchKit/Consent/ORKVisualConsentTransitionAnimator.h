@@ -38,6 +38,28 @@ NS_ASSUME_NONNULL_BEGIN
 @protocol ORKVisualConsentTransitionAnimatorDelegate;
 @class ORKVisualConsentTransitionAnimator;
 
+/*
+ Frame timing for one transition, used to diagnose stutter in the visual consent animations.
+ Dropped frames are counted from display refreshes that passed without a callback.
+ */
+@interface ORKVisualConsentFrameStatistics : NSObject
+
+@property (nonatomic, readonly) NSUInteger numberOfFramesDisplayed;
+
+@property (nonatomic, readonly) NSUInteger numberOfDroppedFrames;
+
+// Longest time between two rendered frames.
+@property (nonatomic, readonly) NSTimeInterval maximumFrameInterval;
+
+// Time from the start of the transition until its first frame was rendered.
+@property (nonatomic, readonly) NSTimeInterval timeToFirstFrame;
+
+// Whether the frames came from ORKVisualConsentFrameCache rather than from AVPlayer.
+@property (nonatomic, readonly) BOOL usedCachedFrames;
+
+@end
+
+
 typedef void (^ORKVisualConsentAnimationCompletionHandler)(ORKVisualConsentTransitionAnimator *animator, UIPageViewControllerNavigationDirection direction);
 
 @interface ORKVisualConsentTransitionAnimator : NSObject
@@ -47,6 +69,8 @@ typedef void (^ORKVisualConsentAnimationCompletionHandler)(ORKVisualConsentTrans
 
 @property (nonatomic, readonly, copy) NSURL *movieURL;
 
+@property (nonatomic, readonly, strong) ORKVisualConsentFrameStatistics *frameStatistics;
+
 - (void)animateTransitionWithDirection:(UIPageViewControllerNavigationDirection)direction
                            loadHandler:(nullable ORKVisualConsentAnimationCompletionHandler)loadHandler
                      completionHandler:(nullable ORKVisualConsentAnimationCompletionHandler)handler;
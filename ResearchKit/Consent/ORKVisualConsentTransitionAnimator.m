@@ -37,6 +37,30 @@
 
 #import "ORKEAGLMoviePlayerView.h"
 #import "ORKVisualConsentStepViewController_Internal.h"
+#import "ORKVisualConsentFrameCache.h"
+
+
+@interface ORKVisualConsentFrameStatistics ()
+
+@property (nonatomic, assign) NSUInteger numberOfFramesDisplayed;
+@property (nonatomic, assign) NSUInteger numberOfDroppedFrames;
+@property (nonatomic, assign) NSTimeInterval maximumFrameInterval;
+@property (nonatomic, assign) NSTimeInterval timeToFirstFrame;
+@property (nonatomic, assign) BOOL usedCachedFrames;
+
+@end
+
+
+@implementation ORKVisualConsentFrameStatistics
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p; frames: %lu; dropped: %lu; max interval: %.1f ms; first frame: %.1f ms; cached: %d>",
+            self.class.description, self,
+            (unsigned long)_numberOfFramesDisplayed, (unsigned long)_numberOfDroppedFrames,
+            _maximumFrameInterval * 1000, _timeToFirstFrame * 1000, _usedCachedFrames];
+}
+
+@end
 
 
 // Internal object to hold the direction we're animating, the phase of the animation, and the animation completion handler.
@@ -79,6 +103,15 @@
     dispatch_queue_t _videoOutputQueue;
     NSInteger _frameCounter;
     ORKVisualConsentAnimationContext *_pendingContext;
+    
+    ORKVisualConsentMovieFrames *_cachedFrames;
+    NSUInteger _cachedFrameIndex;
+    CFTimeInterval _cachedPlaybackStartTime;
+    
+    ORKVisualConsentFrameStatistics *_frameStatistics;
+    CFTimeInterval _transitionStartTime;
+    CFTimeInterval _lastDisplayLinkTimestamp;
+    CFTimeInterval _lastRenderedFrameTimestamp;
 }
 
 - (instancetype)initWithVisualConsentStepViewController:(ORKVisualConsentStepViewController *)stepViewController
@@ -90,6 +123,7 @@
         
         _stepViewController = stepViewController;
         _movieURL = [movieURL copy];
+        _frameStatistics = [ORKVisualConsentFrameStatistics new];
         
         _moviePlayer = [[AVPlayer alloc] init];
         _moviePlayer.actionAtItemEnd = AVPlayerActionAtItemEndPause;
@@ -112,6 +146,10 @@
     return _movieURL;
 }
 
+- (ORKVisualConsentFrameStatistics *)frameStatistics {
+    return _frameStatistics;
+}
+
 - (void)animateTransitionWithDirection:(UIPageViewControllerNavigationDirection)direction
                            loadHandler:(ORKVisualConsentAnimationCompletionHandler)loadHandler
                      completionHandler:(ORKVisualConsentAnimationCompletionHandler)handler {
@@ -120,6 +158,16 @@
     context.direction = direction;
     context.loadHandler = loadHandler;
     
+    _transitionStartTime = CACurrentMediaTime();
+    
+    // Scenes that were decoded ahead of time play straight from memory, without waiting for AVPlayer to load.
+    _cachedFrames = [[ORKVisualConsentFrameCache sharedCache] framesForMovieURL:_movieURL];
+    if (_cachedFrames) {
+        _frameStatistics.usedCachedFrames = YES;
+        [self performCachedAnimationWithContext:context];
+        return;
+    }
+    
     _playerItem = [AVPlayerItem playerItemWithURL:_movieURL];
     
     [_playerItem addOutput:_videoOutput];
@@ -206,6 +254,21 @@
              }];
 }
 
+- (void)performCachedAnimationWithContext:(ORKVisualConsentAnimationContext *)context {
+    _pendingContext = context;
+    
+    ORKEAGLMoviePlayerView *playerView = [_stepViewController animationPlayerView];
+    [playerView setupGL];
+    if (!CGSizeEqualToSize(playerView.presentationSize, _cachedFrames.presentationSize)) {
+        playerView.presentationSize = _cachedFrames.presentationSize;
+    }
+    
+    _cachedFrameIndex = NSNotFound;
+    _cachedPlaybackStartTime = 0;
+    _frameCounter = 0;
+    [_displayLink setPaused:NO];
+}
+
 - (void)finishAnimationWithContext:(ORKVisualConsentAnimationContext *)context {
     if (context == _pendingContext) {
         _pendingContext = nil;
@@ -237,7 +300,78 @@
     }
 }
 
+- (void)didRenderFrameWithDisplayLink:(CADisplayLink *)sender {
+    if (_frameStatistics.numberOfFramesDisplayed == 0) {
+        _frameStatistics.timeToFirstFrame = CACurrentMediaTime() - _transitionStartTime;
+    }
+    // Measured between rendered frames, since callbacks without a new frame leave the previous one on screen.
+    if (_lastRenderedFrameTimestamp > 0) {
+        CFTimeInterval interval = sender.timestamp - _lastRenderedFrameTimestamp;
+        _frameStatistics.maximumFrameInterval = MAX(_frameStatistics.maximumFrameInterval, interval);
+    }
+    _lastRenderedFrameTimestamp = sender.timestamp;
+    _frameStatistics.numberOfFramesDisplayed++;
+}
+
+- (void)recordDisplayLinkTimestamp:(CADisplayLink *)sender {
+    // A gap of more than one and a half refresh periods means at least one refresh was missed.
+    CFTimeInterval refreshPeriod = sender.duration;
+    if (_lastDisplayLinkTimestamp > 0 && refreshPeriod > 0) {
+        CFTimeInterval interval = sender.timestamp - _lastDisplayLinkTimestamp;
+        if (interval > 1.5 * refreshPeriod) {
+            _frameStatistics.numberOfDroppedFrames += (NSUInteger)round(interval / refreshPeriod) - 1;
+        }
+    }
+}
+
+- (void)displayCachedFrameWithDisplayLink:(CADisplayLink *)sender {
+    CFTimeInterval nextVSync = ([sender timestamp] + [sender duration]);
+    if (_cachedPlaybackStartTime == 0) {
+        _cachedPlaybackStartTime = nextVSync;
+    }
+    NSTimeInterval elapsed = nextVSync - _cachedPlaybackStartTime;
+    
+    // Advance to the last frame whose presentation time has been reached.
+    NSTimeInterval firstFrameTime = [_cachedFrames presentationTimeAtIndex:0];
+    NSUInteger frameIndex = (_cachedFrameIndex == NSNotFound) ? 0 : _cachedFrameIndex;
+    while (frameIndex + 1 < _cachedFrames.numberOfFrames &&
+           [_cachedFrames presentationTimeAtIndex:frameIndex + 1] - firstFrameTime <= elapsed) {
+        frameIndex++;
+    }
+    
+    if (frameIndex != _cachedFrameIndex) {
+        _cachedFrameIndex = frameIndex;
+        ORKEAGLMoviePlayerView *playerView = [_stepViewController animationPlayerView];
+        if ([playerView consumePixelBuffer:[_cachedFrames pixelBufferAtIndex:frameIndex]]) {
+            [playerView render];
+            [self didRenderFrameWithDisplayLink:sender];
+        }
+        
+        if (_frameCounter == 1) {
+            [self initialFrameDidDisplay];
+        }
+        _frameCounter ++;
+    }
+    
+    if (elapsed >= _cachedFrames.duration) {
+        [_displayLink setPaused:YES];
+        if (_frameCounter == 1) {
+            // Single-frame movie
+            [self initialFrameDidDisplay];
+        }
+        [self finishAnimationWithContext:_pendingContext];
+    }
+}
+
 - (void)displayLinkCallback:(CADisplayLink *)sender {
+    [self recordDisplayLinkTimestamp:sender];
+    
+    if (_cachedFrames) {
+        [self displayCachedFrameWithDisplayLink:sender];
+        _lastDisplayLinkTimestamp = sender.timestamp;
+        return;
+    }
+    
     /*
      The callback gets called once every Vsync.
      Using the display link's timestamp and duration we can compute the next time the screen will be refreshed, and copy the pixel buffer for that time
@@ -266,6 +400,7 @@
         }
         if (canDisplay) {
             [playerView render];
+            [self didRenderFrameWithDisplayLink:sender];
         }
         
         if (_frameCounter == 1) {
@@ -273,6 +408,7 @@
         }
         _frameCounter ++;
     }
+    _lastDisplayLinkTimestamp = sender.timestamp;
 }
 
 #pragma mark - AVPlayerItemOutputPullDelegate
@@ -281,9 +417,15 @@
     // Restart display link.
     [_displayLink setPaused:NO];
     _frameCounter = 0;
+    _lastDisplayLinkTimestamp = 0;
+    _lastRenderedFrameTimestamp = 0;
 }
 
 - (void)finish {
+    if (_frameStatistics.numberOfFramesDisplayed > 0) {
+        ORK_Log_Debug(@"Visual consent transition %@: %@", _movieURL.lastPathComponent, _frameStatistics);
+    }
+    
     [_moviePlayer pause];
     [_displayLink invalidate]; // This makes animator single-use
     
@@ -302,6 +444,7 @@
     _pendingContext = nil;
     _videoOutput = nil;
     _videoOutputQueue = nil;
+    _cachedFrames = nil;
     [[NSNotificationCenter defaultCenter] removeObserver:self];
 }
 
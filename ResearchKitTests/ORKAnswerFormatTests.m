@@ -66,6 +66,24 @@
     XCTAssertFalse([[ORKEmailAnswerFormat emailAnswerFormat] isAnswerValidWithString:@"12345"]);
 }
 
+- (void)testImpliedAnswerFormatIsCached {
+    ORKBooleanAnswerFormat *booleanFormat = [ORKAnswerFormat booleanAnswerFormat];
+    XCTAssertEqual([booleanFormat impliedAnswerFormat], [booleanFormat impliedAnswerFormat]);
+    
+    ORKEmailAnswerFormat *emailFormat = [ORKAnswerFormat emailAnswerFormat];
+    XCTAssertEqual([emailFormat impliedAnswerFormat], [emailFormat impliedAnswerFormat]);
+}
+
+- (void)testValidationRegexChangeInvalidatesCache {
+    ORKTextAnswerFormat *answerFormat = [ORKAnswerFormat textAnswerFormatWithValidationRegex:@"^[0-9]+$" invalidMessage:@"Digits only"];
+    XCTAssertTrue([answerFormat isAnswerValidWithString:@"12345"]);
+    XCTAssertFalse([answerFormat isAnswerValidWithString:@"abc"]);
+    
+    answerFormat.validationRegex = @"^[a-z]+$";
+    XCTAssertFalse([answerFormat isAnswerValidWithString:@"12345"]);
+    XCTAssertTrue([answerFormat isAnswerValidWithString:@"abc"]);
+}
+
 - (void)testConfirmAnswerFormat {
     
     // Setup an answer format
@@ -349,4 +349,29 @@
     }
 }
 
+- (void)testSelectedIndexesForAnswerWithManyChoices {
+    NSUInteger choiceCount = 5000;
+    NSMutableArray *textChoices = [NSMutableArray arrayWithCapacity:choiceCount];
+    for (NSUInteger index = 0; index < choiceCount; index++) {
+        NSString *text = [NSString stringWithFormat:@"choice %@", @(index)];
+        [textChoices addObject:[ORKTextChoice choiceWithText:text detailText:nil value:text exclusive:(index == 0)]];
+    }
+    ORKAnswerFormat *answerFormat = [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice
+                                                                     textChoices:textChoices];
+    ORKChoiceAnswerFormatHelper *formatHelper = [[ORKChoiceAnswerFormatHelper alloc] initWithAnswerFormat:answerFormat];
+    
+    NSMutableArray *answer = [NSMutableArray new];
+    NSMutableArray *expectedIndexes = [NSMutableArray new];
+    for (NSUInteger index = 1; index < choiceCount; index += 2) {
+        [answer addObject:[textChoices[index] value]];
+        [expectedIndexes addObject:@(index)];
+    }
+    
+    [self measureBlock:^{
+        XCTAssertEqualObjects([formatHelper selectedIndexesForAnswer:answer], expectedIndexes);
+    }];
+    
+    XCTAssertEqualObjects([formatHelper exclusiveChoiceIndexes], [NSIndexSet indexSetWithIndex:0]);
+}
+
 @end
@@ -49,6 +49,22 @@
 
 @end
 
+@interface ORKCompletingMockHTMLPDFWriter : ORKHTMLPDFWriter
+@property (nonatomic, strong) NSMutableArray<NSString *> *htmls;
+@end
+
+@implementation ORKCompletingMockHTMLPDFWriter
+
+- (void)writePDFFromHTML:(NSString *)html withCompletionBlock:(void (^)(NSData *, NSError *))completionBlock {
+    if (!self.htmls) {
+        self.htmls = [NSMutableArray array];
+    }
+    [self.htmls addObject:html];
+    completionBlock([html dataUsingEncoding:NSUTF8StringEncoding], nil);
+}
+
+@end
+
 @interface ORKMockConsentSectionFormatter : ORKConsentSectionFormatter
 @end
 
@@ -163,4 +179,97 @@
     XCTAssertEqualObjects(passedError, error);
 }
 
+- (void)testMakePDFsWithSignatureSets_substitutesSignaturesIntoSharedContent {
+    ORKCompletingMockHTMLPDFWriter *writer = [[ORKCompletingMockHTMLPDFWriter alloc] init];
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] initWithHTMLPDFWriter:writer
+                                                             consentSectionFormatter:[[ORKMockConsentSectionFormatter alloc] init]
+                                                           consentSignatureFormatter:[[ORKMockConsentSignatureFormatter alloc] init]];
+    document.title = @"A Title";
+    document.sections = @[[[ORKConsentSection alloc] init]];
+    document.signatures = @[[[ORKConsentSignature alloc] init]];
+    
+    NSArray *signatureSets = @[@[[[ORKConsentSignature alloc] init]],
+                               @[],
+                               @[[[ORKConsentSignature alloc] init], [[ORKConsentSignature alloc] init]]];
+    
+    NSMutableDictionary<NSNumber *, NSData *> *PDFs = [NSMutableDictionary dictionary];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    [document makePDFsWithSignatureSets:signatureSets
+                             PDFHandler:^(NSUInteger index, NSData *PDFData) {
+                                 PDFs[@(index)] = PDFData;
+                             }
+                      completionHandler:^(ORKConsentPDFBatchMetrics *metrics, NSError *error) {
+                          XCTAssertNil(error);
+                          XCTAssertEqual(metrics.numberOfDocuments, (NSUInteger)3);
+                          [expectation fulfill];
+                      }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    
+    NSString *content = @"<h3>A Title</h3>"
+                        @"html for section"
+                        @"<h4 class=\"pagebreak\"></h4>"
+                        @"<p></p>";
+    NSArray *expectedHTMLs = @[[self htmlWithContent:[content stringByAppendingString:@"html for signature"]],
+                               [self htmlWithContent:content],
+                               [self htmlWithContent:[content stringByAppendingString:@"html for signaturehtml for signature"]]];
+    XCTAssertEqualObjects(writer.htmls, expectedHTMLs);
+    XCTAssertEqual(PDFs.count, (NSUInteger)3);
+    XCTAssertEqualObjects(PDFs[@2], [expectedHTMLs[2] dataUsingEncoding:NSUTF8StringEncoding]);
+}
+
+- (void)testMakePDFsWithSignatureSets_withHTMLReviewContent_writesOnce {
+    ORKCompletingMockHTMLPDFWriter *writer = [[ORKCompletingMockHTMLPDFWriter alloc] init];
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] initWithHTMLPDFWriter:writer
+                                                             consentSectionFormatter:[[ORKMockConsentSectionFormatter alloc] init]
+                                                           consentSignatureFormatter:[[ORKMockConsentSignatureFormatter alloc] init]];
+    document.htmlReviewContent = @"some content";
+    
+    __block NSUInteger numberOfPDFs = 0;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    [document makePDFsWithSignatureSets:@[@[], @[], @[]]
+                             PDFHandler:^(NSUInteger index, NSData *PDFData) {
+                                 numberOfPDFs++;
+                             }
+                      completionHandler:^(ORKConsentPDFBatchMetrics *metrics, NSError *error) {
+                          [expectation fulfill];
+                      }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    
+    XCTAssertEqual(writer.htmls.count, (NSUInteger)1);
+    XCTAssertEqual(numberOfPDFs, (NSUInteger)3);
+}
+
+- (void)testMakePDF_usesNativeRenderingOnlyWhenEnabled {
+    ORKCompletingMockHTMLPDFWriter *writer = [[ORKCompletingMockHTMLPDFWriter alloc] init];
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] initWithHTMLPDFWriter:writer
+                                                             consentSectionFormatter:[[ORKMockConsentSectionFormatter alloc] init]
+                                                           consentSignatureFormatter:[[ORKMockConsentSignatureFormatter alloc] init]];
+    document.title = @"A Title";
+    document.sections = @[[[ORKConsentSection alloc] init]];
+    
+    // Plain text documents are printed from HTML unless native rendering is turned on
+    XCTestExpectation *expectation = [self expectationWithDescription:@"HTML"];
+    [document makePDFWithCompletionHandler:^(NSData *PDFData, NSError *error) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(writer.htmls.count, (NSUInteger)1);
+    
+    document.usesNativePDFRendering = YES;
+    expectation = [self expectationWithDescription:@"native"];
+    [document makePDFWithCompletionHandler:^(NSData *PDFData, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertGreaterThan(PDFData.length, (NSUInteger)4);
+        XCTAssertEqual(memcmp(PDFData.bytes, "%PDF", 4), 0);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertEqual(writer.htmls.count, (NSUInteger)1);
+    
+    // The setting is kept by copies and archives
+    XCTAssertTrue([(ORKConsentDocument *)[document copy] usesNativePDFRendering]);
+    ORKConsentDocument *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:document]];
+    XCTAssertTrue(decoded.usesNativePDFRendering);
+}
+
 @end
@@ -0,0 +1,200 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKConsentPDFRenderer.h"
+
+
+@interface ORKConsentPDFRendererTests : XCTestCase
+
+@end
+
+
+@implementation ORKConsentPDFRendererTests {
+    ORKConsentPDFRenderer *_renderer;
+}
+
+- (void)setUp {
+    [super setUp];
+    _renderer = [[ORKConsentPDFRenderer alloc] init];
+    _renderer.pageSize = CGSizeMake(612, 792);
+}
+
+- (ORKConsentDocument *)documentWithNumberOfSections:(NSUInteger)numberOfSections {
+    ORKConsentDocument *document = [[ORKConsentDocument alloc] init];
+    document.title = @"Consent";
+    document.signaturePageTitle = @"Signature";
+    document.signaturePageContent = @"By signing below, I agree to take part in this study.";
+    
+    NSString *content = [@"" stringByPaddingToLength:2000 withString:@"Lorem ipsum dolor sit amet. " startingAtIndex:0];
+    NSMutableArray *sections = [NSMutableArray array];
+    for (NSUInteger index = 0; index < numberOfSections; index++) {
+        ORKConsentSection *section = [[ORKConsentSection alloc] initWithType:ORKConsentSectionTypeCustom];
+        section.title = [NSString stringWithFormat:@"Section %@", @(index)];
+        section.content = content;
+        [sections addObject:section];
+    }
+    document.sections = sections;
+    
+    ORKConsentSignature *signature = [ORKConsentSignature signatureForPersonWithTitle:@"Participant"
+                                                                     dateFormatString:nil
+                                                                           identifier:@"participant"];
+    signature.givenName = @"Jane";
+    signature.familyName = @"Appleseed";
+    signature.signatureDate = @"1/1/2016";
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(300, 100), YES, 1);
+    UIRectFill(CGRectMake(0, 0, 300, 100));
+    signature.signatureImage = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    document.signatures = @[signature];
+    
+    return document;
+}
+
+- (size_t)numberOfPagesInPDFData:(NSData *)data {
+    CGDataProviderRef provider = CGDataProviderCreateWithCFData((__bridge CFDataRef)data);
+    CGPDFDocumentRef document = CGPDFDocumentCreateWithProvider(provider);
+    size_t numberOfPages = CGPDFDocumentGetNumberOfPages(document);
+    CGPDFDocumentRelease(document);
+    CGDataProviderRelease(provider);
+    return numberOfPages;
+}
+
+- (void)testCanRenderDocument {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:2];
+    XCTAssertTrue([ORKConsentPDFRenderer canRenderDocument:document]);
+    
+    document.sections[1].htmlContent = @"<p>HTML</p>";
+    XCTAssertFalse([ORKConsentPDFRenderer canRenderDocument:document]);
+    
+    document.sections[1].omitFromDocument = YES;
+    XCTAssertTrue([ORKConsentPDFRenderer canRenderDocument:document]);
+    
+    document.htmlReviewContent = @"<p>HTML</p>";
+    XCTAssertFalse([ORKConsentPDFRenderer canRenderDocument:document]);
+    XCTAssertThrowsSpecificNamed([_renderer PDFDataForDocument:document], NSException, NSInvalidArgumentException);
+}
+
+- (void)testSignaturesStartOnANewPage {
+    NSData *shortDocument = [_renderer PDFDataForDocument:[self documentWithNumberOfSections:1]];
+    XCTAssertEqual([self numberOfPagesInPDFData:shortDocument], (size_t)2);
+    
+    NSData *longDocument = [_renderer PDFDataForDocument:[self documentWithNumberOfSections:10]];
+    XCTAssertGreaterThan([self numberOfPagesInPDFData:longDocument], (size_t)3);
+}
+
+- (void)testLayoutIsDeterministic {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:5];
+    size_t numberOfPages = [self numberOfPagesInPDFData:[_renderer PDFDataForDocument:document]];
+    XCTAssertEqual([self numberOfPagesInPDFData:[_renderer PDFDataForDocument:[document copy]]], numberOfPages);
+    
+    _renderer.pageSize = CGSizeMake(612, 396);
+    XCTAssertGreaterThan([self numberOfPagesInPDFData:[_renderer PDFDataForDocument:document]], numberOfPages);
+}
+
+- (void)testMissingSignatureTitleThrows {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:1];
+    document.signatures = @[[[ORKConsentSignature alloc] init]];
+    XCTAssertThrowsSpecificNamed([_renderer PDFDataForDocument:document], NSException, NSObjectNotAvailableException);
+}
+
+- (void)testMakePDFRendersInTheBackground {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:3];
+    document.usesNativePDFRendering = YES;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"PDF"];
+    [document makePDFWithCompletionHandler:^(NSData *data, NSError *error) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNil(error);
+        XCTAssertGreaterThan([self numberOfPagesInPDFData:data], (size_t)0);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+- (void)testBatchRenderingMatchesSingleDocuments {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:6];
+    size_t numberOfPages = [self numberOfPagesInPDFData:[_renderer PDFDataForDocument:document]];
+    
+    NSMutableArray *signatureSets = [NSMutableArray array];
+    for (NSUInteger index = 0; index < 10; index++) {
+        [signatureSets addObject:document.signatures];
+    }
+    [signatureSets addObject:@[]];
+    
+    NSMutableIndexSet *renderedIndexes = [NSMutableIndexSet indexSet];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+    _renderer.maximumConcurrentRenderCount = 3;
+    [_renderer renderPDFsForDocument:document
+                       signatureSets:signatureSets
+                          PDFHandler:^(NSUInteger index, NSData *data) {
+                              XCTAssertTrue([NSThread isMainThread]);
+                              XCTAssertEqual([self numberOfPagesInPDFData:data], numberOfPages);
+                              [renderedIndexes addIndex:index];
+                          }
+                          completion:^(ORKConsentPDFBatchMetrics *metrics) {
+                              XCTAssertEqual(metrics.numberOfDocuments, signatureSets.count);
+                              XCTAssertGreaterThan(metrics.numberOfBytes, (unsigned long long)0);
+                              XCTAssertGreaterThan(metrics.documentsPerSecond, 0.0);
+                              [expectation fulfill];
+                          }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    XCTAssertEqualObjects(renderedIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, signatureSets.count)]);
+}
+
+- (void)testBatchRenderingPerformance {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:20];
+    NSMutableArray *signatureSets = [NSMutableArray array];
+    for (NSUInteger index = 0; index < 20; index++) {
+        [signatureSets addObject:document.signatures];
+    }
+    ORKConsentPDFRenderer *renderer = _renderer;
+    [self measureBlock:^{
+        XCTestExpectation *expectation = [self expectationWithDescription:@"batch"];
+        [renderer renderPDFsForDocument:document
+                          signatureSets:signatureSets
+                             PDFHandler:^(NSUInteger index, NSData *data) {}
+                             completion:^(ORKConsentPDFBatchMetrics *metrics) {
+                                 [expectation fulfill];
+                             }];
+        [self waitForExpectationsWithTimeout:60 handler:nil];
+    }];
+}
+
+- (void)testRenderingPerformance {
+    ORKConsentDocument *document = [self documentWithNumberOfSections:20];
+    ORKConsentPDFRenderer *renderer = _renderer;
+    [self measureBlock:^{
+        [renderer PDFDataForDocument:document];
+    }];
+}
+
+@end
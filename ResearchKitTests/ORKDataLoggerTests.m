@@ -122,6 +122,28 @@
     XCTAssertEqualObjects(jsonOut[@"items"][0], jsonObject);
 }
 
+- (void)testJSONHeader {
+    NSDictionary *header = @{@"recorderType": @"test", @"offset": @(0.25) };
+    NSDictionary *jsonObject = @{@"val": @(1) };
+    
+    ORKJSONLogFormatter *formatter = [ORKJSONLogFormatter new];
+    formatter.header = header;
+    _dataLogger.delegate = nil;
+    _dataLogger = [[ORKDataLogger alloc] initWithDirectory:_directory logName:_logName formatter:formatter delegate:self];
+    
+    XCTAssertTrue([_dataLogger append:jsonObject error:nil]);
+    XCTAssertTrue([_dataLogger append:jsonObject error:nil]);
+    [_dataLogger finishCurrentLog];
+    [self wait];
+    
+    NSError *error = nil;
+    NSDictionary *jsonOut = [NSJSONSerialization JSONObjectWithData:[NSData dataWithContentsOfURL:_finishedLogFiles.lastObject] options:(NSJSONReadingOptions)0 error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(jsonOut[@"header"], header);
+    XCTAssertEqual([jsonOut[@"items"] count], 2);
+    XCTAssertEqualObjects(jsonOut[@"items"][1], jsonObject);
+}
+
 - (void)testContinuesExistingLog {
     // Test that if you create a logger, and then kill it and create a new logger, the new one
     // continues from the right place without forcing a roll-over
@@ -323,6 +345,25 @@
     XCTAssertEqual(_finishedLogFiles.count, 0);
 }
 
+- (void)testLastFinishedLogFileURL {
+    XCTAssertNil(_dataLogger.lastFinishedLogFileURL);
+    [_dataLogger finishCurrentLog];
+    XCTAssertNil(_dataLogger.lastFinishedLogFileURL);
+    
+    // Known as soon as the rollover returns, ahead of the delegate callback
+    [self logJsonObject:@{@"val": @(1)}];
+    [_dataLogger finishCurrentLog];
+    NSURL *finishedURL = _dataLogger.lastFinishedLogFileURL;
+    XCTAssertNotNil(finishedURL);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:finishedURL.path]);
+    [self wait];
+    XCTAssertEqualObjects(finishedURL, _finishedLogFiles.lastObject);
+    
+    // An empty rollover keeps the last finished file
+    [_dataLogger finishCurrentLog];
+    XCTAssertEqualObjects(_dataLogger.lastFinishedLogFileURL, finishedURL);
+}
+
 - (void)testExplicitRolloverWithZeroLengthFile {
     XCTAssertNil([_dataLogger fileHandle]);
     NSDictionary *jsonObject = @{};
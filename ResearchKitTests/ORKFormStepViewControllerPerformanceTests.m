@@ -0,0 +1,147 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import <mach/mach.h>
+#import "ORKChoiceViewCell.h"
+
+
+static const NSInteger ORKLargeFormChoiceCount = 5000;
+
+static uint64_t ORKResidentMemorySize(void) {
+    struct mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size;
+}
+
+static UITableView *ORKFirstTableViewInView(UIView *view) {
+    if ([view isKindOfClass:[UITableView class]]) {
+        return (UITableView *)view;
+    }
+    for (UIView *subview in view.subviews) {
+        UITableView *tableView = ORKFirstTableViewInView(subview);
+        if (tableView) {
+            return tableView;
+        }
+    }
+    return nil;
+}
+
+
+@interface ORKFormStepViewControllerPerformanceTests : XCTestCase
+
+@end
+
+
+@implementation ORKFormStepViewControllerPerformanceTests
+
+- (ORKFormStep *)largeChoiceFormStep {
+    NSMutableArray<ORKTextChoice *> *choices = [NSMutableArray arrayWithCapacity:ORKLargeFormChoiceCount];
+    for (NSInteger i = 0; i < ORKLargeFormChoiceCount; i++) {
+        NSString *detailText = (i % 3 == 0) ? [NSString stringWithFormat:@"Take %@ mg twice daily", @(i % 50 * 10)] : nil;
+        [choices addObject:[ORKTextChoice choiceWithText:[NSString stringWithFormat:@"Medication %04ld", (long)i]
+                                              detailText:detailText
+                                                   value:@(i)
+                                               exclusive:NO]];
+    }
+    ORKTextChoiceAnswerFormat *answerFormat = [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice textChoices:choices];
+    
+    ORKFormStep *step = [[ORKFormStep alloc] initWithIdentifier:@"medications" title:@"Medications" text:nil];
+    step.formItems = @[[[ORKFormItem alloc] initWithIdentifier:@"name" text:@"Name" answerFormat:[ORKAnswerFormat textAnswerFormat]],
+                       [[ORKFormItem alloc] initWithIdentifier:@"medication" text:@"Medication" answerFormat:answerFormat]];
+    return step;
+}
+
+/*
+ Scrolls a form with a 5,000 entry choice list from top to bottom one screen at a time, and
+ reports the layout time per frame and the peak resident memory. With cell reuse only the
+ visible rows are ever alive.
+ */
+- (void)testScrollingLargeChoiceForm {
+    ORKFormStep *step = [self largeChoiceFormStep];
+    ORKStepResult *result = [[ORKStepResult alloc] initWithStepIdentifier:step.identifier results:@[]];
+    ORKFormStepViewController *stepViewController = [[ORKFormStepViewController alloc] initWithStep:step result:result];
+    
+    UIWindow *window = [[UIWindow alloc] initWithFrame:CGRectMake(0, 0, 375, 667)];
+    window.rootViewController = stepViewController;
+    [window makeKeyAndVisible];
+    [stepViewController.view layoutIfNeeded];
+    
+    UITableView *tableView = ORKFirstTableViewInView(stepViewController.view);
+    XCTAssertNotNil(tableView);
+    XCTAssertEqual([tableView numberOfRowsInSection:1], ORKLargeFormChoiceCount);
+    
+    uint64_t baselineMemory = ORKResidentMemorySize();
+    __block uint64_t peakMemory = baselineMemory;
+    __block NSUInteger maximumChoiceCells = 0;
+    __block double maximumFrameTime = 0;
+    __block double totalFrameTime = 0;
+    __block NSUInteger frameCount = 0;
+    
+    [self measureBlock:^{
+        tableView.contentOffset = CGPointZero;
+        [tableView layoutIfNeeded];
+        CGFloat pageHeight = CGRectGetHeight(tableView.bounds) * 0.5;
+        while (tableView.contentOffset.y + CGRectGetHeight(tableView.bounds) < tableView.contentSize.height) {
+            CFTimeInterval frameStart = CACurrentMediaTime();
+            tableView.contentOffset = CGPointMake(0, tableView.contentOffset.y + pageHeight);
+            [tableView layoutIfNeeded];
+            double frameTime = CACurrentMediaTime() - frameStart;
+            
+            totalFrameTime += frameTime;
+            maximumFrameTime = MAX(maximumFrameTime, frameTime);
+            frameCount++;
+            if (frameCount % 50 == 0) {
+                peakMemory = MAX(peakMemory, ORKResidentMemorySize());
+            }
+            NSUInteger choiceCells = 0;
+            for (UITableViewCell *cell in tableView.visibleCells) {
+                choiceCells += [cell isKindOfClass:[ORKChoiceViewCell class]] ? 1 : 0;
+            }
+            maximumChoiceCells = MAX(maximumChoiceCells, choiceCells);
+        }
+    }];
+    
+    NSLog(@"Scrolled %@ frames: mean %.2f ms, max %.2f ms; peak memory %.1f MB (%.1f MB above baseline)",
+          @(frameCount), totalFrameTime * 1000 / MAX(frameCount, 1), maximumFrameTime * 1000,
+          peakMemory / 1048576.0, (peakMemory - baselineMemory) / 1048576.0);
+    
+    XCTAssertGreaterThan(frameCount, 0);
+    XCTAssertLessThan(maximumChoiceCells, 50);
+    
+    window.hidden = YES;
+}
+
+@end
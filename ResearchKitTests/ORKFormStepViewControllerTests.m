@@ -0,0 +1,119 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKChoiceViewCell.h"
+
+
+static const NSInteger ORKFormChoiceCount = 40;
+
+static UITableView *ORKFirstTableViewInView(UIView *view) {
+    if ([view isKindOfClass:[UITableView class]]) {
+        return (UITableView *)view;
+    }
+    for (UIView *subview in view.subviews) {
+        UITableView *tableView = ORKFirstTableViewInView(subview);
+        if (tableView) {
+            return tableView;
+        }
+    }
+    return nil;
+}
+
+
+@interface ORKFormStepViewControllerTests : XCTestCase
+
+@end
+
+
+@implementation ORKFormStepViewControllerTests
+
+- (ORKFormItem *)choiceFormItemWithIdentifier:(NSString *)identifier {
+    NSMutableArray<ORKTextChoice *> *choices = [NSMutableArray arrayWithCapacity:ORKFormChoiceCount];
+    for (NSInteger i = 0; i < ORKFormChoiceCount; i++) {
+        [choices addObject:[ORKTextChoice choiceWithText:[NSString stringWithFormat:@"%@ %02ld", identifier, (long)i]
+                                                   value:@(i)]];
+    }
+    ORKTextChoiceAnswerFormat *answerFormat = [ORKAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice textChoices:choices];
+    return [[ORKFormItem alloc] initWithIdentifier:identifier text:identifier answerFormat:answerFormat];
+}
+
+/*
+ Scrolls the rows of the first choice section off screen so their cells are available for reuse
+ while the second section is laid out, then selects choices in the first section. None of the
+ selections may show up on the cells of the second section.
+ */
+- (void)testChoiceCellsAreNotSharedAcrossSections {
+    ORKFormStep *step = [[ORKFormStep alloc] initWithIdentifier:@"form" title:@"Form" text:nil];
+    step.formItems = @[[self choiceFormItemWithIdentifier:@"first"], [self choiceFormItemWithIdentifier:@"second"]];
+    ORKStepResult *result = [[ORKStepResult alloc] initWithStepIdentifier:step.identifier results:@[]];
+    ORKFormStepViewController *stepViewController = [[ORKFormStepViewController alloc] initWithStep:step result:result];
+    
+    UIWindow *window = [[UIWindow alloc] initWithFrame:CGRectMake(0, 0, 375, 667)];
+    window.rootViewController = stepViewController;
+    [window makeKeyAndVisible];
+    [stepViewController.view layoutIfNeeded];
+    
+    UITableView *tableView = ORKFirstTableViewInView(stepViewController.view);
+    XCTAssertNotNil(tableView);
+    XCTAssertEqual(tableView.numberOfSections, 2L);
+    XCTAssertEqual([tableView numberOfRowsInSection:0], ORKFormChoiceCount);
+    XCTAssertEqual([tableView numberOfRowsInSection:1], ORKFormChoiceCount);
+    
+    // Bind cells to the first section, then scroll down one screen at a time until only rows of the
+    // second section are visible.
+    CGFloat pageHeight = CGRectGetHeight(tableView.bounds) * 0.5;
+    while (tableView.contentOffset.y + CGRectGetHeight(tableView.bounds) < tableView.contentSize.height) {
+        tableView.contentOffset = CGPointMake(0, tableView.contentOffset.y + pageHeight);
+        [tableView layoutIfNeeded];
+    }
+    NSArray<NSIndexPath *> *visibleIndexPaths = tableView.indexPathsForVisibleRows;
+    XCTAssertGreaterThan(visibleIndexPaths.count, 0);
+    for (NSIndexPath *indexPath in visibleIndexPaths) {
+        XCTAssertEqual(indexPath.section, 1L);
+    }
+    
+    id<UITableViewDelegate> tableViewDelegate = (id<UITableViewDelegate>)stepViewController;
+    for (NSInteger row = 0; row < ORKFormChoiceCount; row++) {
+        [tableViewDelegate tableView:tableView didSelectRowAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]];
+    }
+    
+    for (NSIndexPath *indexPath in visibleIndexPaths) {
+        ORKChoiceViewCell *cell = (ORKChoiceViewCell *)[tableView cellForRowAtIndexPath:indexPath];
+        XCTAssertTrue([cell isKindOfClass:[ORKChoiceViewCell class]]);
+        XCTAssertFalse(cell.selectedItem, @"Row %@ of the second section shows a selection made in the first", @(indexPath.row));
+    }
+    
+    window.hidden = YES;
+}
+
+@end
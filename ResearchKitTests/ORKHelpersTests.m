@@ -0,0 +1,90 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKHelpers.h"
+
+
+@interface ORKHelpersTests : XCTestCase
+
+@end
+
+
+@implementation ORKHelpersTests
+
+- (void)testUpdateActiveConstraintsReusesUnchangedConstraints {
+    UIView *superview = [UIView new];
+    UIView *view = [UIView new];
+    view.translatesAutoresizingMaskIntoConstraints = NO;
+    [superview addSubview:view];
+    
+    NSLayoutConstraint *top = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeTop relatedBy:NSLayoutRelationEqual toItem:superview attribute:NSLayoutAttributeTop multiplier:1.0 constant:10.0];
+    NSLayoutConstraint *height = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeHeight relatedBy:NSLayoutRelationEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:20.0];
+    NSArray *activeConstraints = ORKUpdateActiveConstraints(nil, @[top, height]);
+    XCTAssertEqualObjects(activeConstraints, (@[top, height]));
+    XCTAssertTrue(top.active);
+    XCTAssertTrue(height.active);
+    
+    NSLayoutConstraint *newTop = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeTop relatedBy:NSLayoutRelationEqual toItem:superview attribute:NSLayoutAttributeTop multiplier:1.0 constant:30.0];
+    NSLayoutConstraint *width = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeWidth relatedBy:NSLayoutRelationEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:40.0];
+    activeConstraints = ORKUpdateActiveConstraints(activeConstraints, @[newTop, width]);
+    
+    // The top constraint is kept with the new constant, the height is removed and the width is added.
+    XCTAssertEqualObjects(activeConstraints, (@[top, width]));
+    XCTAssertEqual(top.constant, (CGFloat)30);
+    XCTAssertTrue(top.active);
+    XCTAssertFalse(newTop.active);
+    XCTAssertFalse(height.active);
+    XCTAssertTrue(width.active);
+}
+
+- (void)testUpdateActiveConstraintsMatchesEquivalentConstraintsInOrder {
+    UIView *superview = [UIView new];
+    UIView *view = [UIView new];
+    view.translatesAutoresizingMaskIntoConstraints = NO;
+    [superview addSubview:view];
+    
+    NSLayoutConstraint *minimumHeight = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeHeight relatedBy:NSLayoutRelationGreaterThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:10.0];
+    NSLayoutConstraint *otherMinimumHeight = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeHeight relatedBy:NSLayoutRelationGreaterThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:20.0];
+    NSArray *activeConstraints = ORKUpdateActiveConstraints(nil, @[minimumHeight, otherMinimumHeight]);
+    
+    // Equivalent constraints are matched in their original order, and the extra one is removed.
+    NSLayoutConstraint *newMinimumHeight = [NSLayoutConstraint constraintWithItem:view attribute:NSLayoutAttributeHeight relatedBy:NSLayoutRelationGreaterThanOrEqual toItem:nil attribute:NSLayoutAttributeNotAnAttribute multiplier:1.0 constant:15.0];
+    activeConstraints = ORKUpdateActiveConstraints(activeConstraints, @[newMinimumHeight]);
+    XCTAssertEqualObjects(activeConstraints, (@[minimumHeight]));
+    XCTAssertEqual(minimumHeight.constant, (CGFloat)15);
+    XCTAssertTrue(minimumHeight.active);
+    XCTAssertFalse(otherMinimumHeight.active);
+    XCTAssertFalse(newMinimumHeight.active);
+}
+
+@end
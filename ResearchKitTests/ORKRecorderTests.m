@@ -33,16 +33,26 @@
 #import <ResearchKit/ResearchKit.h>
 #import <CoreLocation/CoreLocation.h>
 #import "ORKLocationRecorder.h"
+#import "ORKLocationFilter.h"
 #import "ORKAccelerometerRecorder.h"
 #import "ORKDeviceMotionRecorder.h"
 #import "ORKPedometerRecorder.h"
 #import "ORKTouchRecorder.h"
 #import "ORKAudioRecorder.h"
+#import "ORKAudioLevelAccumulator.h"
+#import "ORKVoiceFeatureExtractor.h"
 #import "ORKHealthQuantityTypeRecorder.h"
+#import "ORKHealthQuantityTypeRecorder_Internal.h"
 #import <CoreMotion/CoreMotion.h>
 #import "ORKHelpers.h"
 #import "ORKRecorder_Internal.h"
 #import "ORKRecorder_Private.h"
+#import "ORKActiveStepViewController_Internal.h"
+#import "ORKSessionClock.h"
+#import "ORKMotionHub.h"
+#import "ORKGaitAnalyzer.h"
+#import "ORKRunningStatistics.h"
+#import "ORKTappingAnalyzer.h"
 
 
 @interface ORKMockLocationManager : CLLocationManager
@@ -95,6 +105,22 @@
 @end
 
 
+@interface ORKMockPhaseTouch : ORKMockTouch
+
+@property (nonatomic) UITouchPhase mockPhase;
+
+@end
+
+
+@implementation ORKMockPhaseTouch
+
+- (UITouchPhase)phase {
+    return self.mockPhase;
+}
+
+@end
+
+
 @interface ORKMockMotionManager : CMMotionManager
 
 - (void)injectMotion:(CMDeviceMotion *)motion;
@@ -173,8 +199,8 @@
 
 @implementation ORKMockAccelerometerRecorder
 
-- (CMMotionManager *)createMotionManager {
-    return _mockManager;
+- (ORKMotionHub *)sharedMotionHub {
+    return [[ORKMotionHub alloc] initWithMotionManager:_mockManager];
 }
 
 @end
@@ -257,8 +283,8 @@
 
 @implementation ORKMockDeviceMotionRecorder
 
-- (CMMotionManager *)createMotionManager {
-    return _mockManager;
+- (ORKMotionHub *)sharedMotionHub {
+    return [[ORKMotionHub alloc] initWithMotionManager:_mockManager];
 }
 
 @end
@@ -312,6 +338,53 @@
 @end
 
 
+@interface ORKMockHealthStore : HKHealthStore
+
+@property (nonatomic, strong, readonly) NSMutableArray<HKQuery *> *executedQueries;
+
+@end
+
+
+@implementation ORKMockHealthStore
+
++ (BOOL)isHealthDataAvailable {
+    return YES;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _executedQueries = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)executeQuery:(HKQuery *)query {
+    [_executedQueries addObject:query];
+}
+
+- (void)stopQuery:(HKQuery *)query {
+}
+
+@end
+
+
+@interface ORKMockHealthQuantityTypeRecorder : ORKHealthQuantityTypeRecorder
+
+@property (nonatomic, strong) ORKMockHealthStore *mockHealthStore;
+
+@end
+
+
+@implementation ORKMockHealthQuantityTypeRecorder
+
+- (HKHealthStore *)createHealthStore {
+    return _mockHealthStore;
+}
+
+@end
+
+
 static BOOL ork_doubleEqual(double x, double y) {
     static double K = 1;
     return (fabs(x-y) < K * DBL_EPSILON * fabs(x+y) || fabs(x-y) < DBL_MIN);
@@ -320,7 +393,7 @@ static BOOL ork_doubleEqual(double x, double y) {
 #pragma mark - ORKRecorderTests
 #pragma mark -
 
-@interface ORKRecorderTests : XCTestCase <ORKRecorderDelegate>
+@interface ORKRecorderTests : XCTestCase <ORKRecorderDelegate, ORKStepViewControllerDelegate>
 
 @end
 
@@ -330,6 +403,10 @@ static BOOL ork_doubleEqual(double x, double y) {
     ORKRecorder *_recorder;
     ORKResult *_result;
     NSArray   *_items;
+    NSDictionary *_header;
+    NSError *_error;
+    XCTestExpectation *_goForwardExpectation;
+    ORKStepResult *_goForwardStepResult;
 }
 
 static const NSInteger kNumberOfSamples = 5;
@@ -352,6 +429,10 @@ static const NSInteger kNumberOfSamples = 5;
     _recorder = nil;
     _result = nil;
     _items = nil;
+    _header = nil;
+    _error = nil;
+    _goForwardExpectation = nil;
+    _goForwardStepResult = nil;
 }
 
 - (void)tearDown {
@@ -368,6 +449,23 @@ static const NSInteger kNumberOfSamples = 5;
     NSLog(@"didFailWithError: %@", error);
     _recorder = nil;
     _result = nil;
+    _error = error;
+}
+
+- (void)stepViewController:(ORKStepViewController *)stepViewController didFinishWithNavigationDirection:(ORKStepViewControllerNavigationDirection)direction {
+    _goForwardStepResult = stepViewController.result;
+    [_goForwardExpectation fulfill];
+}
+
+- (void)stepViewControllerResultDidChange:(ORKStepViewController *)stepViewController {
+}
+
+- (void)stepViewControllerDidFail:(ORKStepViewController *)stepViewController withError:(NSError *)error {
+    _error = error;
+}
+
+- (void)stepViewController:(ORKStepViewController *)stepViewController recorder:(ORKRecorder *)recorder didFailWithError:(NSError *)error {
+    _error = error;
 }
 
 - (ORKRecorder *)createRecorder:(ORKRecorderConfiguration *)recorderConfiguration {
@@ -395,6 +493,7 @@ static const NSInteger kNumberOfSamples = 5;
     XCTAssertEqual(items.count, kNumberOfSamples, @"");
     
     _items = items;
+    _header = dict[@"header"];
 }
 
 - (void)testLocationRecorder {
@@ -449,6 +548,66 @@ static const NSInteger kNumberOfSamples = 5;
     }
 }
 
+- (NSArray<CLLocation *> *)locationsWithCount:(NSInteger)count speed:(double)speed eastOffsets:(const double *)eastOffsets {
+    // Moving north, one location per second
+    const double metersPerDegree = 6371000.0 * M_PI / 180;
+    const double latitude = 37.31317;
+    const double longitude = -122.07238;
+    NSDate *startDate = [NSDate dateWithTimeIntervalSinceReferenceDate:0];
+    NSMutableArray *locations = [NSMutableArray array];
+    for (NSInteger i = 0; i < count; i++) {
+        double east = eastOffsets ? eastOffsets[i % 2] : 0;
+        CLLocationCoordinate2D coordinate = CLLocationCoordinate2DMake(latitude + speed * i / metersPerDegree,
+                                                                       longitude + east / (metersPerDegree * cos(latitude * M_PI / 180)));
+        [locations addObject:[[CLLocation alloc] initWithCoordinate:coordinate
+                                                           altitude:0
+                                                 horizontalAccuracy:10
+                                                   verticalAccuracy:10
+                                                             course:0
+                                                              speed:speed
+                                                          timestamp:[startDate dateByAddingTimeInterval:i]]];
+    }
+    return locations;
+}
+
+- (void)testLocationFilter {
+    NSArray<CLLocation *> *locations = [self locationsWithCount:100 speed:1.5 eastOffsets:NULL];
+    
+    // A straight walk simplifies to the ends of each window of 32 locations
+    ORKLocationFilter *filter = [[ORKLocationFilter alloc] initWithMinimumDistance:0 minimumTimeInterval:0 smoothsLocations:NO simplificationTolerance:1];
+    NSMutableArray<CLLocation *> *output = [NSMutableArray array];
+    for (CLLocation *location in locations) {
+        [output addObjectsFromArray:[filter filterLocations:@[location]]];
+    }
+    XCTAssertEqual(output.count, 3);
+    [output addObjectsFromArray:[filter flush]];
+    XCTAssertEqualObjects(output, (@[locations[0], locations[31], locations[62], locations[93], locations[99]]));
+    XCTAssertEqual(filter.numberOfLocations, 100);
+    XCTAssertEqualWithAccuracy(filter.totalDistance, 148.5, 0.5);
+    XCTAssertEqualWithAccuracy(filter.duration, 99, 1e-6);
+    XCTAssertEqualWithAccuracy(filter.averageSpeed, 1.5, 0.01);
+    XCTAssertEqualWithAccuracy(filter.maximumSpeed, 1.5, 0.01);
+    
+    // Locations closer than 5 m are coalesced: every fourth location is kept
+    filter = [[ORKLocationFilter alloc] initWithMinimumDistance:5 minimumTimeInterval:0 smoothsLocations:NO simplificationTolerance:0];
+    output = [[filter filterLocations:locations] mutableCopy];
+    XCTAssertEqual(output.count, 25);
+    XCTAssertEqualObjects(output[1], locations[4]);
+    XCTAssertEqual([filter flush].count, 0);
+    XCTAssertEqualWithAccuracy(filter.totalDistance, 144, 0.5);
+    
+    // Locations 10 m either side of a standing position are pulled back towards it
+    const double eastOffsets[2] = { 10, -10 };
+    NSArray<CLLocation *> *noisyLocations = [self locationsWithCount:40 speed:0 eastOffsets:eastOffsets];
+    filter = [[ORKLocationFilter alloc] initWithMinimumDistance:0 minimumTimeInterval:0 smoothsLocations:YES simplificationTolerance:0];
+    output = [[filter filterLocations:noisyLocations] mutableCopy];
+    XCTAssertEqual(output.count, 40);
+    CLLocation *position = [self locationsWithCount:1 speed:0 eastOffsets:NULL].firstObject;
+    XCTAssertLessThan([output.lastObject distanceFromLocation:position], 3);
+    XCTAssertLessThan(output.lastObject.horizontalAccuracy, 10);
+    XCTAssertLessThan(filter.totalDistance, 0.5 * 39 * 20);
+}
+
 - (void)testAccelerometerRecorder {
     
     ORKAccelerometerRecorderConfiguration *recorderConfiguration = [[ORKAccelerometerRecorderConfiguration alloc] initWithIdentifier:@"accelerometer" frequency:60.0];
@@ -462,8 +621,11 @@ static const NSInteger kNumberOfSamples = 5;
     recorder.delegate = self;
     ORKMockMotionManager *manager = [ORKMockMotionManager new];
     [(ORKMockAccelerometerRecorder*)recorder setMockManager:manager];
+    ORKSessionClock *sessionClock = [ORKSessionClock new];
+    recorder.sessionClock = sessionClock;
     
     [recorder start];
+    NSTimeInterval startUptime = recorder.startUptime;
     
     ORKMockAccelerometerData *data = [ORKMockAccelerometerData new];
     for (NSInteger i = 0; i < kNumberOfSamples; i++) {
@@ -479,6 +641,26 @@ static const NSInteger kNumberOfSamples = 5;
         XCTAssertTrue(ork_doubleEqual(data.acceleration.y, ((NSNumber *)sample[@"y"]).doubleValue), @"");
         XCTAssertTrue(ork_doubleEqual(data.acceleration.z, ((NSNumber *)sample[@"z"]).doubleValue), @"");
     }
+    
+    // The log header places the recorder on the shared session timeline
+    XCTAssertEqualObjects(_header[@"recorderType"], @"accel");
+    XCTAssertEqualObjects(_header[@"sessionReferenceDate"], ORKStringFromDateISO8601(sessionClock.referenceDate));
+    XCTAssertEqualWithAccuracy([_header[@"sessionReferenceUptime"] doubleValue], sessionClock.referenceUptime, 1e-6);
+    XCTAssertEqualWithAccuracy([_header[@"recorderStartUptime"] doubleValue], startUptime, 1e-6);
+    XCTAssertEqualWithAccuracy([_header[@"recorderStartOffset"] doubleValue], startUptime - sessionClock.referenceUptime, 1e-6);
+    XCTAssertGreaterThanOrEqual([_header[@"recorderStartOffset"] doubleValue], 0);
+}
+
+- (void)testSessionClock {
+    ORKSessionClock *clock = [ORKSessionClock new];
+    
+    // The clock shares its time base with NSProcessInfo.systemUptime
+    XCTAssertEqualWithAccuracy(clock.currentUptime, [NSProcessInfo processInfo].systemUptime, 0.001);
+    XCTAssertEqualWithAccuracy([clock.referenceDate timeIntervalSinceNow], -clock.currentTimeInterval, 0.001);
+    
+    NSTimeInterval uptime = clock.referenceUptime + 1.5;
+    XCTAssertEqualWithAccuracy([clock timeIntervalForUptime:uptime], 1.5, 1e-9);
+    XCTAssertEqualWithAccuracy([[clock dateForUptime:uptime] timeIntervalSinceDate:clock.referenceDate], 1.5, 1e-6);
 }
 
 - (void)testDeviceMotionRecorder {
@@ -531,6 +713,215 @@ static const NSInteger kNumberOfSamples = 5;
     }
 }
 
+- (void)testMotionHubFanOut {
+    ORKMockMotionManager *manager = [ORKMockMotionManager new];
+    ORKMotionHub *hub = [[ORKMotionHub alloc] initWithMotionManager:manager];
+    
+    __block NSInteger fastCount = 0;
+    __block NSInteger slowCount = 0;
+    __block NSInteger thirdCount = 0;
+    id fast = [hub addAccelerometerSubscriberWithFrequency:100 queue:nil handler:^(CMAccelerometerData *data, NSError *error) {
+        fastCount++;
+    }];
+    id slow = [hub addAccelerometerSubscriberWithFrequency:25 queue:nil handler:^(CMAccelerometerData *data, NSError *error) {
+        slowCount++;
+    }];
+    id third = [hub addAccelerometerSubscriberWithFrequency:100.0 / 3.0 queue:nil handler:^(CMAccelerometerData *data, NSError *error) {
+        thirdCount++;
+    }];
+    
+    // One stream, at the highest requested frequency
+    XCTAssertEqualWithAccuracy(hub.accelerometerFrequency, 100, 1e-9);
+    XCTAssertEqualWithAccuracy(manager.accelerometerUpdateInterval, 0.01, 1e-9);
+    
+    ORKMockAccelerometerData *data = [ORKMockAccelerometerData new];
+    for (NSInteger i = 0; i < 120; i++) {
+        [manager injectAccelerometerData:data];
+    }
+    XCTAssertEqual(fastCount, 120);
+    XCTAssertEqual(slowCount, 30);
+    XCTAssertEqual(thirdCount, 40);
+    
+    // Errors reach every subscriber, regardless of decimation
+    [hub distributeAccelerometerData:nil error:[NSError errorWithDomain:NSCocoaErrorDomain code:NSFeatureUnsupportedError userInfo:nil]];
+    XCTAssertEqual(fastCount, 121);
+    XCTAssertEqual(slowCount, 31);
+    
+    // Removing the fastest subscriber lowers the stream frequency
+    [hub removeSubscriber:fast];
+    XCTAssertEqualWithAccuracy(hub.accelerometerFrequency, 100.0 / 3.0, 1e-9);
+    [hub removeSubscriber:third];
+    XCTAssertEqualWithAccuracy(hub.accelerometerFrequency, 25, 1e-9);
+    
+    slowCount = 0;
+    for (NSInteger i = 0; i < 10; i++) {
+        [manager injectAccelerometerData:data];
+    }
+    XCTAssertEqual(slowCount, 10);
+    XCTAssertEqual(fastCount, 121);
+    
+    [hub removeSubscriber:slow];
+    XCTAssertEqual(hub.accelerometerFrequency, 0);
+    XCTAssertEqual(hub.deviceMotionFrequency, 0);
+}
+
+- (void)testMotionHubDropsQueuedDeliveriesAfterRemoval {
+    ORKMockMotionManager *manager = [ORKMockMotionManager new];
+    ORKMotionHub *hub = [[ORKMotionHub alloc] initWithMotionManager:manager];
+    
+    NSOperationQueue *queue = [NSOperationQueue new];
+    queue.maxConcurrentOperationCount = 1;
+    queue.suspended = YES;
+    
+    __block NSInteger count = 0;
+    id subscriber = [hub addAccelerometerSubscriberWithFrequency:100 queue:queue handler:^(CMAccelerometerData *data, NSError *error) {
+        count++;
+    }];
+    
+    ORKMockAccelerometerData *data = [ORKMockAccelerometerData new];
+    for (NSInteger i = 0; i < 5; i++) {
+        [manager injectAccelerometerData:data];
+    }
+    
+    // Samples queued before removal must not reach the handler once it has been removed
+    [hub removeSubscriber:subscriber];
+    queue.suspended = NO;
+    [queue waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(count, 0);
+}
+
+- (void)testGaitAnalyzer {
+    ORKGaitAnalyzer analyzer;
+    ORKGaitAnalyzerInitialize(&analyzer, 100);
+    
+    // 20 s of walking with alternating 0.5 s and 0.6 s steps, a 180 degree turn, and 10 s more walking.
+    // Each step is a short upward acceleration pulse; gravity points along -z.
+    const double stepDurations[2] = { 0.5, 0.6 };
+    const double gravity[3] = { 0, 0, -1 };
+    double phase = 0;
+    NSInteger steps = 0;
+    for (NSInteger i = 0; i < 3200; i++) {
+        double timestamp = i * 0.01;
+        phase += 0.01 / stepDurations[steps % 2];
+        if (phase >= 1) {
+            phase -= 1;
+            steps++;
+        }
+        double pulse = (phase < 0.3) ? 0.3 * sin(M_PI * phase / 0.3) : -0.1;
+        double userAcceleration[3] = { 0, 0, -pulse };
+        double rotationRate[3] = { 0, 0, (timestamp >= 20 && timestamp < 22) ? -M_PI_2 : 0 };
+        ORKGaitAnalyzerAddSample(&analyzer, timestamp, userAcceleration, gravity, rotationRate);
+    }
+    
+    ORKGaitSummary summary = ORKGaitAnalyzerSummary(&analyzer);
+    XCTAssertEqualWithAccuracy(summary.duration, 31.99, 1e-6);
+    XCTAssertEqualWithAccuracy(summary.numberOfSteps, steps, 1);
+    XCTAssertEqualWithAccuracy(summary.cadence, 60 / 0.55, 1);
+    XCTAssertEqualWithAccuracy(summary.meanStrideDuration, 1.1, 0.01);
+    XCTAssertLessThan(summary.strideDurationVariability, 0.02);
+    XCTAssertLessThan(summary.stepSymmetry, 0.95);
+    XCTAssertGreaterThan(summary.stepSymmetry, 0.8);
+    XCTAssertEqual(summary.numberOfTurns, 1);
+    XCTAssertEqualWithAccuracy(summary.meanTurnAngle, 180, 10);
+    XCTAssertEqualWithAccuracy(summary.meanTurnDuration, 2, 0.2);
+}
+
+- (void)testRunningStatistics {
+    ORKRunningStatistics statistics = ORKRunningStatisticsMake();
+    XCTAssertEqual(statistics.count, 0);
+    XCTAssertEqual(ORKRunningStatisticsVariance(&statistics), 0);
+    
+    const double values[8] = { 2, 4, 4, 4, 5, 5, 7, 9 };
+    for (NSInteger i = 0; i < 8; i++) {
+        ORKRunningStatisticsAdd(&statistics, values[i]);
+    }
+    XCTAssertEqual(statistics.count, 8);
+    XCTAssertEqualWithAccuracy(statistics.sum, 40, 1e-12);
+    XCTAssertEqualWithAccuracy(statistics.mean, 5, 1e-12);
+    XCTAssertEqual(statistics.minimum, 2);
+    XCTAssertEqual(statistics.maximum, 9);
+    XCTAssertEqualWithAccuracy(ORKRunningStatisticsVariance(&statistics), 32.0 / 7, 1e-12);
+    XCTAssertEqualWithAccuracy(ORKRunningStatisticsStandardDeviation(&statistics), sqrt(32.0 / 7), 1e-12);
+    XCTAssertEqualWithAccuracy(ORKRunningStatisticsCoefficientOfVariation(&statistics), sqrt(32.0 / 7) / 5, 1e-12);
+}
+
+- (void)testSlidingWindowSum {
+    ORKSlidingWindowSum window;
+    ORKSlidingWindowSumInitialize(&window, 60);
+    
+    // One per second for two minutes, then two per second for two minutes, growing past the initial capacity
+    for (NSInteger i = 0; i < 120; i++) {
+        ORKSlidingWindowSumAdd(&window, i, 1);
+    }
+    XCTAssertEqualWithAccuracy(window.sum, 60, 1e-12);
+    XCTAssertEqualWithAccuracy(window.maximumSum, 60, 1e-12);
+    XCTAssertEqual(window.maximumRate, 0, @"Rates are only tracked once a start time is set");
+    for (NSInteger i = 0; i < 240; i++) {
+        ORKSlidingWindowSumAdd(&window, 120 + i * 0.5, 1);
+    }
+    XCTAssertEqualWithAccuracy(window.sum, 120, 1e-12);
+    XCTAssertEqualWithAccuracy(window.maximumSum, 120, 1e-12);
+    XCTAssertEqual(window.count, 120);
+    ORKSlidingWindowSumDestroy(&window);
+    
+    // Each value accumulates over the second before it, so the first window is only partly covered
+    ORKSlidingWindowSumInitialize(&window, 60);
+    ORKSlidingWindowSumSetStartTime(&window, 0);
+    for (NSInteger i = 1; i <= 10; i++) {
+        ORKSlidingWindowSumAdd(&window, i, 3);
+    }
+    XCTAssertEqualWithAccuracy(window.maximumSum, 30, 1e-12);
+    XCTAssertEqualWithAccuracy(window.maximumRate, 3, 1e-12);
+    for (NSInteger i = 11; i <= 130; i++) {
+        ORKSlidingWindowSumAdd(&window, i, 1);
+    }
+    XCTAssertEqualWithAccuracy(window.maximumSum, 60 + 2 * 10, 1e-12);
+    XCTAssertEqualWithAccuracy(window.maximumRate, 3, 1e-12);
+    ORKSlidingWindowSumDestroy(&window);
+}
+
+- (void)testTappingAnalyzer {
+    ORKTappingAnalyzer analyzer;
+    ORKTappingAnalyzerInitialize(&analyzer);
+    
+    // Alternating taps whose interval grows by 1 ms per second, with a miss after every tenth tap
+    NSTimeInterval timestamp = 0;
+    for (NSInteger i = 0; i < 300; i++) {
+        timestamp += 0.2 + 0.001 * timestamp;
+        ORKTappingAnalyzerAddSample(&analyzer, timestamp, 10, 20, (i % 2) ? ORKTappingButtonIdentifierRight : ORKTappingButtonIdentifierLeft);
+        if (i % 10 == 0) {
+            ORKTappingAnalyzerAddSample(&analyzer, timestamp + 0.01, 0, 0, ORKTappingButtonIdentifierNone);
+        }
+    }
+    // One repeated tap on the same button
+    ORKTappingAnalyzerAddSample(&analyzer, timestamp + 0.2, 10, 20, ORKTappingButtonIdentifierRight);
+    
+    ORKTappingSummary summary = ORKTappingAnalyzerSummary(&analyzer);
+    XCTAssertEqual(summary.numberOfTaps, 331);
+    XCTAssertEqual(summary.numberOfButtonTaps, 301);
+    XCTAssertEqualWithAccuracy(summary.meanTapInterval, timestamp / 300, 0.01);
+    XCTAssertEqualWithAccuracy(summary.alternationAccuracy, 299.0 / 300, 1e-12);
+    XCTAssertEqualWithAccuracy(summary.fatigueSlope, 0.001, 0.0002);
+    XCTAssertGreaterThan(summary.tapIntervalVariability, 0);
+    
+    NSArray<ORKTappingSample *> *samples = ORKTappingAnalyzerCopySampleObjects(&analyzer);
+    XCTAssertEqual(samples.count, 331);
+    XCTAssertEqual(samples[1].buttonIdentifier, ORKTappingButtonIdentifierNone);
+    XCTAssertEqual(samples[2].location.x, 10);
+    ORKTappingAnalyzerDestroy(&analyzer);
+    
+    NSData *data = ORKTappingPackedSampleDataFromSamples(samples);
+    XCTAssertEqual(data.length, 1 + 331 * 13);
+    NSArray<ORKTappingSample *> *unpackedSamples = ORKTappingSamplesFromPackedSampleData(data);
+    XCTAssertEqual(unpackedSamples.count, samples.count);
+    for (NSUInteger i = 0; i < samples.count; i++) {
+        XCTAssertEqualWithAccuracy(unpackedSamples[i].timestamp, samples[i].timestamp, 1e-5);
+        XCTAssertEqual(unpackedSamples[i].buttonIdentifier, samples[i].buttonIdentifier);
+        XCTAssertTrue(CGPointEqualToPoint(unpackedSamples[i].location, samples[i].location));
+    }
+    XCTAssertNil(ORKTappingSamplesFromPackedSampleData([data subdataWithRange:NSMakeRange(0, 10)]));
+}
+
 - (void)testPedometerRecorder {
     
     Class recorderClass = [ORKPedometerRecorder class];
@@ -563,6 +954,15 @@ static const NSInteger kNumberOfSamples = 5;
         XCTAssertTrue(ork_doubleEqual(data.floorsAscended.doubleValue, ((NSNumber *)sample[@"floorsAscended"]).doubleValue), @"");
         XCTAssertTrue(ork_doubleEqual(data.floorsDescended.doubleValue, ((NSNumber *)sample[@"floorsDescended"]).doubleValue), @"");
     }
+    
+    // Pedometer data is cumulative, so the summary reflects the last update and all steps fall in the first minute
+    NSDictionary *summary = _result.userInfo;
+    XCTAssertEqual(((NSNumber *)summary[@"numberOfSteps"]).integerValue, data.numberOfSteps.integerValue);
+    XCTAssertTrue(ork_doubleEqual(data.distance.doubleValue, ((NSNumber *)summary[@"distance"]).doubleValue), @"");
+    XCTAssertEqualWithAccuracy(((NSNumber *)summary[@"duration"]).doubleValue, 1, 1e-9);
+    XCTAssertEqualWithAccuracy(((NSNumber *)summary[@"meanStepsPerMinute"]).doubleValue, 120, 1e-9);
+    // The recording is shorter than a minute, so the peak rate is taken over its whole duration
+    XCTAssertEqualWithAccuracy(((NSNumber *)summary[@"maximumStepsPerMinute"]).doubleValue, 120, 1e-9);
 }
 
 - (void)testTouchRecorder {
@@ -582,7 +982,7 @@ static const NSInteger kNumberOfSamples = 5;
 #pragma clang diagnostic ignored "-Wundeclared-selector"
     
     for (NSInteger i = 0; i < kNumberOfSamples; i++) {
-        [recorder performSelector:@selector(view:didDetectTouch:) withObject:view withObject:touch];
+        [recorder performSelector:@selector(view:didDetectTouches:) withObject:view withObject:[NSSet setWithObject:touch]];
     }
     
 #pragma clang diagnostic pop
@@ -602,6 +1002,130 @@ static const NSInteger kNumberOfSamples = 5;
     }
 }
 
+- (void)detectTouchesWithRecorder:(ORKTouchRecorder *)recorder view:(UIView *)view {
+    ORKMockTouch *touch = [ORKMockTouch new];
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundeclared-selector"
+    for (NSInteger i = 0; i < kNumberOfSamples; i++) {
+        [recorder performSelector:@selector(view:didDetectTouches:) withObject:view withObject:[NSSet setWithObject:touch]];
+    }
+#pragma clang diagnostic pop
+}
+
+- (void)testPrepareToStopInGroup {
+    ORKTouchRecorder *recorder = (ORKTouchRecorder *)[self createRecorder:[[ORKTouchRecorderConfiguration alloc] initWithIdentifier:@"touch"]];
+    UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0, 0, 300, 400)];
+    [recorder viewController:[UIViewController new] willStartStepWithView:view];
+    [recorder start];
+    [self detectTouchesWithRecorder:recorder view:view];
+    
+    dispatch_group_t group = dispatch_group_create();
+    [recorder prepareToStopInGroup:group];
+    XCTAssertNil(recorder.touchView, @"Capture stops before the log is closed");
+    XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5 * NSEC_PER_SEC))), 0L);
+    // Preparing closes the log but leaves reporting to -stop
+    XCTAssertNil(_result);
+    
+    [recorder stop];
+    [self checkResult];
+    XCTAssertNil(_error);
+}
+
+- (void)testPrepareToStopInGroupReportsLogFailure {
+    ORKTouchRecorder *recorder = (ORKTouchRecorder *)[self createRecorder:[[ORKTouchRecorderConfiguration alloc] initWithIdentifier:@"touch"]];
+    UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0, 0, 300, 400)];
+    [recorder viewController:[UIViewController new] willStartStepWithView:view];
+    [recorder start];
+    [self detectTouchesWithRecorder:recorder view:view];
+    
+    // A read-only recording directory keeps the finished log from being moved into place
+    NSString *directoryPath = recorder.recordingDirectoryURL.path;
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    XCTAssertTrue([fileManager setAttributes:@{NSFilePosixPermissions: @(0555)} ofItemAtPath:directoryPath error:NULL]);
+    dispatch_group_t group = dispatch_group_create();
+    [recorder prepareToStopInGroup:group];
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    [fileManager setAttributes:@{NSFilePosixPermissions: @(0755)} ofItemAtPath:directoryPath error:NULL];
+    
+    [recorder stop];
+    XCTAssertNil(_result);
+    XCTAssertEqualObjects(_error.domain, NSCocoaErrorDomain);
+    XCTAssertNotEqual(_error.code, NSFileReadNoSuchFileError, @"The logger's own error should be reported");
+}
+
+- (void)testStopRecordersDefersGoForward {
+    ORKActiveStep *step = [[ORKActiveStep alloc] initWithIdentifier:@"step"];
+    step.recorderConfigurations = @[[[ORKTouchRecorderConfiguration alloc] initWithIdentifier:@"touch"]];
+    ORKActiveStepViewController *stepViewController = [[ORKActiveStepViewController alloc] initWithStep:step];
+    stepViewController.outputDirectory = [NSURL fileURLWithPath:_outputPath];
+    stepViewController.delegate = self;
+    // Load the view, which provides the container the touch recorder captures from
+    XCTAssertNotNil(stepViewController.view);
+    [stepViewController start];
+    
+    ORKTouchRecorder *recorder = stepViewController.recorders.firstObject;
+    XCTAssertTrue([recorder isKindOfClass:[ORKTouchRecorder class]]);
+    [self detectTouchesWithRecorder:recorder view:stepViewController.customViewContainer];
+    
+    // Logs are closed off the main queue, so the recorder has not reported when stopRecorders returns
+    [stepViewController stopRecorders];
+    XCTAssertTrue(stepViewController.isStoppingRecorders);
+    XCTAssertNil(recorder.touchView);
+    XCTAssertEqual(stepViewController.result.results.count, 0);
+    
+    // Stopping again while the first stop is pending does nothing
+    [stepViewController stopRecorders];
+    
+    _goForwardExpectation = [self expectationWithDescription:@"goForward"];
+    [stepViewController goForward];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    
+    XCTAssertFalse(stepViewController.isStoppingRecorders);
+    XCTAssertNil(_error);
+    XCTAssertEqual(_goForwardStepResult.results.count, 1);
+    ORKFileResult *fileResult = (ORKFileResult *)_goForwardStepResult.results.firstObject;
+    XCTAssertTrue([fileResult isKindOfClass:[ORKFileResult class]]);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:fileResult.fileURL.path]);
+}
+
+- (void)testTouchRecorderIndexes {
+    ORKTouchRecorder *recorder = (ORKTouchRecorder *)[self createRecorder:[[ORKTouchRecorderConfiguration alloc] initWithIdentifier:@"touch"]];
+    UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0, 0, 300, 400)];
+    [recorder viewController:[UIViewController new] willStartStepWithView:view];
+    [recorder start];
+    
+    ORKMockPhaseTouch *firstTouch = [ORKMockPhaseTouch new];
+    firstTouch.mockPhase = UITouchPhaseBegan;
+    ORKMockPhaseTouch *secondTouch = [ORKMockPhaseTouch new];
+    secondTouch.mockPhase = UITouchPhaseBegan;
+    
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wundeclared-selector"
+    
+    // Two touches in one event, then the first one moves and ends
+    [recorder performSelector:@selector(view:didDetectTouches:) withObject:view withObject:[NSSet setWithObjects:firstTouch, secondTouch, nil]];
+    firstTouch.mockPhase = UITouchPhaseMoved;
+    [recorder performSelector:@selector(view:didDetectTouches:) withObject:view withObject:[NSSet setWithObject:firstTouch]];
+    firstTouch.mockPhase = UITouchPhaseEnded;
+    [recorder performSelector:@selector(view:didDetectTouches:) withObject:view withObject:[NSSet setWithObject:firstTouch]];
+    
+    // A touch object reused by UIKit after it ended is a new touch
+    firstTouch.mockPhase = UITouchPhaseBegan;
+    [recorder performSelector:@selector(view:didDetectTouches:) withObject:view withObject:[NSSet setWithObject:firstTouch]];
+    
+#pragma clang diagnostic pop
+    
+    [recorder stop];
+    [self checkResult];
+    
+    NSArray<NSNumber *> *indexes = [_items valueForKey:@"index"];
+    NSSet *firstIndexes = [NSSet setWithArray:[indexes subarrayWithRange:NSMakeRange(0, 2)]];
+    XCTAssertEqualObjects(firstIndexes, ([NSSet setWithObjects:@0, @1, nil]));
+    XCTAssertEqualObjects(indexes[2], indexes[3]);
+    XCTAssertEqualObjects(indexes[4], @2);
+    XCTAssertEqualObjects([_items[3] objectForKey:@"phase"], @(UITouchPhaseEnded));
+}
+
 - (void)testAudioRecorder {
     
     ORKAudioRecorderConfiguration *recorderConfiguration = [[ORKAudioRecorderConfiguration alloc] initWithIdentifier:@"audio" recorderSettings:@{}];
@@ -611,6 +1135,97 @@ static const NSInteger kNumberOfSamples = 5;
     XCTAssertTrue([recorder isKindOfClass:recorderClass], @"");
 }
 
+- (void)testAudioLevelAccumulator {
+    const double sampleRate = 1000;
+    ORKAudioLevelAccumulator accumulator;
+    ORKAudioLevelAccumulatorInitialize(&accumulator, sampleRate, 2);
+    
+    // One second of full-scale square wave, then one second at -60 dBFS, stereo interleaved.
+    SInt16 samples[4000];
+    for (int i = 0; i < 4000; i++) {
+        SInt16 magnitude = (i < 2000) ? 32767 : 33;
+        samples[i] = (i % 4 < 2) ? magnitude : -magnitude;
+    }
+    // Feed in uneven chunks to exercise the window bookkeeping.
+    ORKAudioLevelAccumulatorAddSamples(&accumulator, samples, 1234);
+    ORKAudioLevelAccumulatorAddSamples(&accumulator, samples + 1234, 4000 - 1234);
+    
+    NSDictionary *statistics = ORKAudioLevelAccumulatorStatistics(&accumulator);
+    XCTAssertEqual([statistics[ORKAudioRecorderLevelSampleCountKey] integerValue], 4000);
+    XCTAssertEqualWithAccuracy([statistics[ORKAudioRecorderLevelPeakKey] doubleValue], 0, 0.01);
+    XCTAssertEqualWithAccuracy([statistics[ORKAudioRecorderLevelNoiseFloorKey] doubleValue], 20 * log10(33.0 / 32767), 0.01);
+    XCTAssertEqualWithAccuracy([statistics[ORKAudioRecorderLevelRMSKey] doubleValue], 20 * log10(sqrt((32767.0 * 32767 + 33 * 33) / 2) / 32767), 0.01);
+    // Half the samples are at full scale (level 1) and half are just above -60 dBFS (level ~0).
+    XCTAssertEqualWithAccuracy([statistics[ORKAudioRecorderLevelMeanKey] doubleValue], 0.5, 0.01);
+}
+
+- (void)testAudioLevelAccumulatorFloatSamples {
+    const double sampleRate = 1000;
+    ORKAudioLevelAccumulator floatAccumulator;
+    ORKAudioLevelAccumulatorInitialize(&floatAccumulator, sampleRate, 2);
+    ORKAudioLevelAccumulator integerAccumulator;
+    ORKAudioLevelAccumulatorInitialize(&integerAccumulator, sampleRate, 2);
+    
+    // Two seconds of non-interleaved stereo, longer than one conversion chunk.
+    float left[2000];
+    float right[2000];
+    SInt16 interleaved[4000];
+    for (int i = 0; i < 2000; i++) {
+        left[i] = 0.5f * sinf(i * 0.1f);
+        right[i] = (i < 1000) ? 1.5f : -0.001f; // Out of range samples are clipped
+        interleaved[2 * i] = (SInt16)lrintf(left[i] * 32767);
+        interleaved[2 * i + 1] = (SInt16)lrintf(MIN(MAX(right[i], -1), 1) * 32767);
+    }
+    const float *channels[2] = { left, right };
+    ORKAudioLevelAccumulatorAddFloatSamples(&floatAccumulator, channels, 2, 2000);
+    ORKAudioLevelAccumulatorAddSamples(&integerAccumulator, interleaved, 4000);
+    
+    NSDictionary *floatStatistics = ORKAudioLevelAccumulatorStatistics(&floatAccumulator);
+    NSDictionary *integerStatistics = ORKAudioLevelAccumulatorStatistics(&integerAccumulator);
+    XCTAssertEqualObjects([NSSet setWithArray:floatStatistics.allKeys], [NSSet setWithArray:integerStatistics.allKeys]);
+    for (NSString *key in integerStatistics) {
+        // Samples are summed in differently sized chunks, so allow for rounding.
+        XCTAssertEqualWithAccuracy([floatStatistics[key] doubleValue], [integerStatistics[key] doubleValue], 1e-4, @"%@", key);
+    }
+}
+
+- (void)testVoiceFeatureExtractor {
+    const double sampleRate = 44100;
+    ORKVoiceFeatureExtractor *extractor = [[ORKVoiceFeatureExtractor alloc] initWithSampleRate:sampleRate];
+    XCTAssertEqual(extractor.frameLength, 2048);
+    XCTAssertEqual(extractor.hopLength, 1024);
+    
+    // One second of a 200 Hz tone at half scale, appended in uneven chunks.
+    NSUInteger count = (NSUInteger)sampleRate;
+    float *samples = calloc(count, sizeof(float));
+    for (NSUInteger i = 0; i < count; i++) {
+        samples[i] = (float)(0.5 * sin(2 * M_PI * 200 * i / sampleRate));
+    }
+    [extractor appendSamples:samples count:1000];
+    [extractor appendSamples:samples + 1000 count:count - 1000];
+    free(samples);
+    
+    XCTAssertEqual(extractor.frameCount, (count - extractor.frameLength) / extractor.hopLength + 1);
+    NSDictionary *summary = [extractor summary];
+    XCTAssertEqualWithAccuracy([summary[@"voicedFrameFraction"] doubleValue], 1, 0.001);
+    XCTAssertEqualWithAccuracy([summary[@"meanPitch"] doubleValue], 200, 1);
+    XCTAssertEqualWithAccuracy([summary[@"meanLevel"] doubleValue], 20 * log10(0.5 * M_SQRT1_2), 0.1);
+    XCTAssertEqualWithAccuracy([summary[@"meanZeroCrossingRate"] doubleValue], 400, 10);
+    XCTAssertEqualWithAccuracy([summary[@"meanSpectralCentroid"] doubleValue], 200, 50);
+    XCTAssertLessThan([summary[@"jitter"] doubleValue], 0.01);
+    XCTAssertLessThan([summary[@"shimmer"] doubleValue], 0.01);
+    
+    NSDictionary *JSONObject = [extractor JSONObject];
+    XCTAssertTrue([NSJSONSerialization isValidJSONObject:JSONObject]);
+    XCTAssertEqual([JSONObject[@"frames"][@"pitch"] count], extractor.frameCount);
+    
+    // Silence is not voiced.
+    ORKVoiceFeatureExtractor *silenceExtractor = [[ORKVoiceFeatureExtractor alloc] initWithSampleRate:sampleRate];
+    float silence[4096] = {0};
+    [silenceExtractor appendSamples:silence count:4096];
+    XCTAssertEqual([[silenceExtractor summary][@"voicedFrameFraction"] doubleValue], 0);
+}
+
 - (void)testHealthQuantityTypeRecorder {
     
     HKUnit *bpmUnit = [[HKUnit countUnit] unitDividedByUnit:[HKUnit minuteUnit]];
@@ -620,6 +1235,149 @@ static const NSInteger kNumberOfSamples = 5;
     ORKHealthQuantityTypeRecorder *recorder = (ORKHealthQuantityTypeRecorder *)[self createRecorder:recorderConfiguration];
     
     XCTAssertTrue([recorder isKindOfClass:recorderClass], @"");
+    XCTAssertEqual(recorder.queryLimit, 100);
+    XCTAssertEqual(recorder.numberOfQueries, 0);
+    XCTAssertEqual(recorder.averageQueryLatency, 0);
+}
+
+- (ORKMockHealthQuantityTypeRecorder *)createMockHealthQuantityTypeRecorder {
+    HKUnit *bpmUnit = [[HKUnit countUnit] unitDividedByUnit:[HKUnit minuteUnit]];
+    HKQuantityType *hbQuantityType = [HKQuantityType quantityTypeForIdentifier:HKQuantityTypeIdentifierHeartRate];
+    ORKMockHealthQuantityTypeRecorder *recorder = [[ORKMockHealthQuantityTypeRecorder alloc] initWithIdentifier:@"healthQuantityTypeRecorder"
+                                                                                               healthQuantityType:hbQuantityType
+                                                                                                             unit:bpmUnit
+                                                                                                             step:[[ORKStep alloc] initWithIdentifier:@"step"]
+                                                                                                  outputDirectory:[NSURL fileURLWithPath:_outputPath]];
+    recorder.mockHealthStore = [ORKMockHealthStore new];
+    recorder.delegate = self;
+    return recorder;
+}
+
+- (NSArray<HKQuantitySample *> *)heartRateSamplesWithValues:(NSArray<NSNumber *> *)values interval:(NSTimeInterval)interval {
+    HKUnit *bpmUnit = [[HKUnit countUnit] unitDividedByUnit:[HKUnit minuteUnit]];
+    HKQuantityType *hbQuantityType = [HKQuantityType quantityTypeForIdentifier:HKQuantityTypeIdentifierHeartRate];
+    NSMutableArray *samples = [NSMutableArray array];
+    [values enumerateObjectsUsingBlock:^(NSNumber *value, NSUInteger idx, BOOL *stop) {
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:1000 + idx * interval];
+        [samples addObject:[HKQuantitySample quantitySampleWithType:hbQuantityType
+                                                           quantity:[HKQuantity quantityWithUnit:bpmUnit doubleValue:value.doubleValue]
+                                                          startDate:date
+                                                            endDate:date]];
+    }];
+    return samples;
+}
+
+- (void)testHealthQuantityTypeRecorderSummary {
+    ORKMockHealthQuantityTypeRecorder *recorder = [self createMockHealthQuantityTypeRecorder];
+    [recorder start];
+    XCTAssertTrue(recorder.isRecording);
+    
+    NSArray *samples = [self heartRateSamplesWithValues:@[@60, @70, @80, @90, @100] interval:15];
+    [recorder query_handleResults:samples anchor:nil anchorValue:0 issueTime:[NSDate timeIntervalSinceReferenceDate] error:nil];
+    XCTAssertEqual(recorder.numberOfQueries, 1);
+    XCTAssertEqual(recorder.numberOfFetchedSamples, samples.count);
+    
+    [recorder stop];
+    [self checkResult];
+    
+    NSDictionary *summary = _result.userInfo;
+    XCTAssertEqualObjects(summary[ORKHealthQuantityTypeRecorderSummaryUnitKey], @"count/min");
+    XCTAssertEqual([summary[ORKHealthQuantityTypeRecorderSummaryCountKey] integerValue], 5);
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummarySumKey] doubleValue], 400, 1e-9);
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummaryMinimumKey] doubleValue], 60, 1e-9);
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummaryMaximumKey] doubleValue], 100, 1e-9);
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummaryMeanKey] doubleValue], 80, 1e-9);
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummaryStandardDeviationKey] doubleValue], sqrt(250), 1e-9);
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummaryWindowDurationKey] doubleValue], 60, 1e-9);
+    // The first sample leaves the window when the last one arrives a minute later
+    XCTAssertEqualWithAccuracy([summary[ORKHealthQuantityTypeRecorderSummaryMaximumWindowSumKey] doubleValue], 340, 1e-9);
+}
+
+- (void)testHealthAnchoredQueryLimit {
+    // Too few samples to estimate a rate
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(100, 0, 0), 100);
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(400, 1, 10), 100);
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(100, 2, 0), 100);
+    
+    // About 30 s of samples at the observed rate: 10 Hz, then 20 Hz
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(1000, 150, 15), 300);
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(1000, 400, 20), 600);
+    
+    // Clamped to 100-2000
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(100, 10, 300), 100);
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(2000, 1000, 1), 2000);
+    
+    // A full batch at least doubles the limit, up to the maximum
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(100, 100, 100), 200);
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(400, 400, 4), 2000);
+    XCTAssertEqual(ORKHealthAnchoredQueryLimit(1600, 1600, 1600), 2000);
+}
+
+- (NSUInteger)numberOfAnchoredQueriesInStore:(ORKMockHealthStore *)healthStore {
+    NSUInteger count = 0;
+    for (HKQuery *query in healthStore.executedQueries) {
+        if ([query isKindOfClass:[HKAnchoredObjectQuery class]]) {
+            count++;
+        }
+    }
+    return count;
+}
+
+- (void)testHealthQuantityTypeRecorderSerializesQueries {
+    ORKMockHealthQuantityTypeRecorder *recorder = [self createMockHealthQuantityTypeRecorder];
+    ORKMockHealthStore *healthStore = recorder.mockHealthStore;
+    [recorder start];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 0);
+    
+    [recorder doFetchNewData];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 1);
+    
+    // An observer wake-up while a query is in flight is deferred, not issued
+    [recorder doFetchNewData];
+    [recorder doFetchNewData];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 1);
+    
+    // The deferred fetch runs once the query in flight returns, even though its batch was not full
+    NSTimeInterval issueTime = [NSDate timeIntervalSinceReferenceDate];
+    [recorder query_handleResults:[self heartRateSamplesWithValues:@[@60, @61, @62] interval:10] anchor:nil anchorValue:0 issueTime:issueTime error:nil];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 2);
+    XCTAssertEqual(recorder.queryLimit, 100);
+    
+    // A full batch fetches again immediately and doubles the limit
+    NSMutableArray *values = [NSMutableArray array];
+    for (NSInteger i = 0; i < 100; i++) {
+        [values addObject:@(60 + i % 10)];
+    }
+    [recorder query_handleResults:[self heartRateSamplesWithValues:values interval:1] anchor:nil anchorValue:0 issueTime:issueTime error:nil];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 3);
+    XCTAssertEqual(recorder.queryLimit, 200);
+    
+    // A partial batch with nothing pending waits for the next observer update
+    [recorder query_handleResults:[self heartRateSamplesWithValues:@[@70] interval:1] anchor:nil anchorValue:0 issueTime:issueTime error:nil];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 3);
+    XCTAssertEqual(recorder.queryLimit, 100);
+    
+    XCTAssertEqual(recorder.numberOfQueries, 3);
+    XCTAssertEqual(recorder.numberOfFetchedSamples, 104);
+    
+    [recorder stop];
+    
+    // Nothing is queried once the recorder has stopped
+    [recorder doFetchNewData];
+    XCTAssertEqual([self numberOfAnchoredQueriesInStore:healthStore], 3);
+}
+
+- (void)testHealthQuantityTypeRecorderIgnoresResultsAfterStop {
+    ORKMockHealthQuantityTypeRecorder *recorder = [self createMockHealthQuantityTypeRecorder];
+    [recorder start];
+    [recorder query_handleResults:[self heartRateSamplesWithValues:@[@60, @70, @80, @90, @100] interval:15] anchor:nil anchorValue:0 issueTime:[NSDate timeIntervalSinceReferenceDate] error:nil];
+    [recorder stop];
+    [self checkResult];
+    
+    // A results handler that saw the recorder running can still queue a write after stop closed the log
+    [recorder query_logResults:[self heartRateSamplesWithValues:@[@120, @130] interval:1]];
+    XCTAssertEqual([recorder.userInfo[ORKHealthQuantityTypeRecorderSummaryCountKey] integerValue], 5);
+    XCTAssertEqualWithAccuracy([recorder.userInfo[ORKHealthQuantityTypeRecorderSummaryMaximumKey] doubleValue], 100, 1e-9);
 }
 
 @end
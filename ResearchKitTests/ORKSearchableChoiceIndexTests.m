@@ -0,0 +1,182 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKAnswerFormat_Internal.h"
+#import "ORKSearchableChoiceIndex.h"
+
+
+@interface ORKSearchableChoiceIndexTests : XCTestCase {
+    NSURL *_fileURL;
+}
+
+@end
+
+
+@implementation ORKSearchableChoiceIndexTests
+
+- (void)setUp {
+    [super setUp];
+    
+    _fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString]];
+    [self writeChoicesFile];
+}
+
+- (void)writeChoicesFile {
+    NSString *contents = @"Paracetamol\tN02BE01\tAnalgesic\n"
+                         @"Ibuprofen\tM01AE01\n"
+                         @"Aspirin\n"
+                         @"\n"
+                         @"Acetylsalicylic acid\tB01AC06\n"
+                         @"Codéine\tR05DA04\n"
+                         @"Paroxetine\tN06AB05\r\n";
+    BOOL success = [contents writeToURL:_fileURL atomically:YES encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertTrue(success, @"Write choices file");
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:nil];
+    [super tearDown];
+}
+
+- (NSArray<NSString *> *)textsForQuery:(NSString *)query index:(ORKSearchableChoiceIndex *)index {
+    NSMutableArray<NSString *> *texts = [NSMutableArray new];
+    for (NSNumber *choiceIndex in [index choiceIndexesMatchingQuery:query maximumNumberOfResults:10]) {
+        [texts addObject:[index textChoiceAtIndex:choiceIndex.unsignedIntegerValue].text];
+    }
+    return texts;
+}
+
+- (void)testChoices {
+    ORKSearchableChoiceIndex *index = [[ORKSearchableChoiceIndex alloc] initWithFileURL:_fileURL];
+    XCTAssertEqual(index.count, (NSUInteger)0);
+    
+    // Empty lines are skipped, and an empty query lists every choice in sorted order
+    XCTAssertEqualObjects([self textsForQuery:@"" index:index], (@[@"Acetylsalicylic acid", @"Aspirin", @"Codéine", @"Ibuprofen", @"Paracetamol", @"Paroxetine"]));
+    XCTAssertEqual(index.count, (NSUInteger)6);
+    
+    ORKTextChoice *choice = [index textChoiceAtIndex:0];
+    XCTAssertEqualObjects(choice.text, @"Paracetamol");
+    XCTAssertEqualObjects(choice.value, @"N02BE01");
+    XCTAssertEqualObjects(choice.detailText, @"Analgesic");
+    
+    // A line without a value uses its text
+    XCTAssertEqualObjects([index textChoiceAtIndex:2].value, @"Aspirin");
+    XCTAssertEqualObjects([index textChoiceAtIndex:5].value, @"N06AB05");
+    XCTAssertNil([index textChoiceAtIndex:6]);
+    
+    XCTAssertEqualObjects([index textChoiceForValue:@"R05DA04"].text, @"Codéine");
+    XCTAssertNil([index textChoiceForValue:@"X"]);
+}
+
+- (void)testTextChoiceForValue {
+    ORKSearchableChoiceIndex *index = [[ORKSearchableChoiceIndex alloc] initWithFileURL:_fileURL];
+    
+    // Before the index is built the file is scanned, and the last resolved choice is kept
+    XCTAssertEqualObjects([index textChoiceForValue:@"M01AE01"].text, @"Ibuprofen");
+    [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:nil];
+    XCTAssertEqualObjects([index textChoiceForValue:@"M01AE01"].text, @"Ibuprofen");
+    XCTAssertNil([index textChoiceForValue:@"N02BE01"]);
+    
+    // Once the index is built, values are found without reading the file again
+    [self writeChoicesFile];
+    index = [[ORKSearchableChoiceIndex alloc] initWithFileURL:_fileURL];
+    XCTAssertEqual([index choiceIndexesMatchingQuery:@"" maximumNumberOfResults:10].count, (NSUInteger)6);
+    [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:nil];
+    XCTAssertEqualObjects([index textChoiceForValue:@"N02BE01"].detailText, @"Analgesic");
+    XCTAssertEqualObjects([index textChoiceForValue:@"Aspirin"].text, @"Aspirin");
+    XCTAssertEqualObjects([index textChoiceForValue:@"N06AB05"].text, @"Paroxetine");
+    XCTAssertEqualObjects([index textChoiceForValue:@"B01AC06"].text, @"Acetylsalicylic acid");
+    XCTAssertNil([index textChoiceForValue:@"Ibuprofen"]);
+    XCTAssertNil([index textChoiceForValue:@"N02BE0"]);
+    XCTAssertNil([index textChoiceForValue:@"ZZZ"]);
+    XCTAssertNil([index textChoiceForValue:@1]);
+}
+
+- (void)testSearch {
+    ORKSearchableChoiceIndex *index = [[ORKSearchableChoiceIndex alloc] initWithFileURL:_fileURL];
+    
+    // Prefix matches come before choices containing the query, ignoring case and diacritics
+    XCTAssertEqualObjects([self textsForQuery:@"pa" index:index], (@[@"Paracetamol", @"Paroxetine"]));
+    XCTAssertEqualObjects([self textsForQuery:@"a" index:index], (@[@"Acetylsalicylic acid", @"Aspirin", @"Paracetamol", @"Paroxetine"]));
+    XCTAssertEqualObjects([self textsForQuery:@"CODEI" index:index], (@[@"Codéine"]));
+    XCTAssertEqualObjects([self textsForQuery:@"  ine " index:index], (@[@"Codéine", @"Paroxetine"]));
+    
+    // Type-ahead narrows the previous matches
+    XCTAssertEqualObjects([self textsForQuery:@"cet" index:index], (@[@"Acetylsalicylic acid", @"Paracetamol"]));
+    XCTAssertEqualObjects([self textsForQuery:@"ceta" index:index], (@[@"Paracetamol"]));
+    XCTAssertEqualObjects([self textsForQuery:@"acid" index:index], (@[@"Acetylsalicylic acid"]));
+    XCTAssertEqualObjects([self textsForQuery:@"xyz" index:index], (@[]));
+    
+    XCTAssertEqual([index choiceIndexesMatchingQuery:@"" maximumNumberOfResults:2].count, (NSUInteger)2);
+}
+
+- (void)testAsynchronousSearch {
+    ORKSearchableChoiceIndex *index = [[ORKSearchableChoiceIndex alloc] initWithFileURL:_fileURL];
+    
+    [index searchWithQuery:@"pa" maximumNumberOfResults:10 completion:^(NSArray<NSNumber *> *choiceIndexes) {
+        XCTFail(@"Superseded search should not complete");
+    }];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Search"];
+    [index searchWithQuery:@"ibu" maximumNumberOfResults:10 completion:^(NSArray<NSNumber *> *choiceIndexes) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertEqualObjects(choiceIndexes, @[@1]);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+- (void)testAnswerFormat {
+    ORKSearchableChoiceAnswerFormat *answerFormat = [ORKAnswerFormat searchableChoiceAnswerFormatWithChoicesFileURL:_fileURL];
+    XCTAssertEqual(answerFormat.questionType, ORKQuestionTypeSingleChoice);
+    XCTAssertEqual(answerFormat.maximumNumberOfResults, (NSUInteger)50);
+    XCTAssertNoThrow([answerFormat validateParameters]);
+    XCTAssertEqualObjects([answerFormat stringForAnswer:@[@"M01AE01"]], @"Ibuprofen");
+    
+    ORKSearchableChoiceAnswerFormat *copy = [answerFormat copy];
+    XCTAssertEqualObjects(copy, answerFormat);
+    XCTAssertEqual([copy choiceIndex], [answerFormat choiceIndex]);
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:answerFormat];
+    ORKSearchableChoiceAnswerFormat *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+    XCTAssertEqualObjects(decoded.choicesFileURL.path.stringByResolvingSymlinksInPath, _fileURL.path.stringByResolvingSymlinksInPath);
+    XCTAssertEqual(decoded.maximumNumberOfResults, (NSUInteger)50);
+    
+    ORKQuestionStep *questionStep = [ORKQuestionStep questionStepWithIdentifier:@"q" title:@"Medication" answer:answerFormat];
+    XCTAssertNoThrow([questionStep validateParameters]);
+    
+    ORKFormStep *formStep = [[ORKFormStep alloc] initWithIdentifier:@"f"];
+    formStep.formItems = @[[[ORKFormItem alloc] initWithIdentifier:@"i" text:@"Medication" answerFormat:answerFormat]];
+    XCTAssertThrows([formStep validateParameters]);
+}
+
+@end
@@ -0,0 +1,214 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKSignatureStrokes.h"
+#import "ORKSignatureView.h"
+
+
+@interface ORKSignatureView (ORKSignatureStrokesTests)
+
+- (void)gestureTouchesBegan:(NSSet *)touches withEvent:(UIEvent *)event;
+- (void)gestureTouchesMoved:(NSSet *)touches withEvent:(UIEvent *)event;
+- (void)gestureTouchesEnded:(NSSet *)touches withEvent:(UIEvent *)event;
+
+@end
+
+
+@interface ORKMockSignatureTouch : UITouch
+
+@property (nonatomic) CGPoint mockLocation;
+@property (nonatomic) CGPoint mockPreviousLocation;
+@property (nonatomic) NSTimeInterval mockTimestamp;
+
+@end
+
+
+@implementation ORKMockSignatureTouch
+
+- (CGPoint)locationInView:(UIView *)view {
+    return self.mockLocation;
+}
+
+- (CGPoint)previousLocationInView:(UIView *)view {
+    return self.mockPreviousLocation;
+}
+
+- (NSTimeInterval)timestamp {
+    return self.mockTimestamp;
+}
+
+@end
+
+
+@interface ORKSignatureStrokesTests : XCTestCase
+
+@end
+
+
+@implementation ORKSignatureStrokesTests
+
+- (ORKSignatureStrokes *)strokesWithNumberOfStrokes:(NSUInteger)numberOfStrokes samplesPerStroke:(NSUInteger)samplesPerStroke {
+    ORKSignatureStrokes *strokes = [[ORKSignatureStrokes alloc] initWithCanvasSize:CGSizeMake(320, 140) lineWidth:1 lineWidthVariation:3];
+    NSTimeInterval timestamp = 0;
+    for (NSUInteger strokeIndex = 0; strokeIndex < numberOfStrokes; strokeIndex++) {
+        [strokes beginStroke];
+        for (NSUInteger sampleIndex = 0; sampleIndex < samplesPerStroke; sampleIndex++) {
+            ORKSignatureSample sample;
+            sample.location = CGPointMake(10 + sampleIndex * 3.3 + strokeIndex * 40, 70 + 30 * sin(sampleIndex / 4.0));
+            sample.timestamp = timestamp;
+            sample.pressure = (sampleIndex % 10) / 10.0;
+            [strokes addSample:sample];
+            timestamp += 0.016;
+        }
+        timestamp += 0.2;
+    }
+    return strokes;
+}
+
+- (void)testEncodingRoundTrip {
+    ORKSignatureStrokes *strokes = [self strokesWithNumberOfStrokes:3 samplesPerStroke:25];
+    ORKSignatureStrokes *decoded = [[ORKSignatureStrokes alloc] initWithData:[strokes data]];
+    XCTAssertNotNil(decoded);
+    
+    XCTAssertEqual(decoded.numberOfStrokes, (NSUInteger)3);
+    XCTAssertEqual(decoded.numberOfSamples, strokes.numberOfSamples);
+    XCTAssertEqualWithAccuracy(decoded.canvasSize.width, 320, 0.01);
+    XCTAssertEqualWithAccuracy(decoded.lineWidthVariation, 3, 0.01);
+    XCTAssertTrue(NSEqualRanges([decoded sampleRangeOfStrokeAtIndex:1], NSMakeRange(25, 25)));
+    
+    for (NSUInteger index = 0; index < strokes.numberOfSamples; index++) {
+        ORKSignatureSample original = [strokes sampleAtIndex:index];
+        ORKSignatureSample sample = [decoded sampleAtIndex:index];
+        XCTAssertEqualWithAccuracy(sample.location.x, original.location.x, 0.05);
+        XCTAssertEqualWithAccuracy(sample.location.y, original.location.y, 0.05);
+        XCTAssertEqualWithAccuracy(sample.timestamp, original.timestamp, 0.0005);
+        XCTAssertEqualWithAccuracy(sample.pressure, original.pressure, 0.5 / 255);
+    }
+    
+    // Re-encoding the decoded strokes is lossless.
+    XCTAssertEqualObjects([decoded data], [strokes data]);
+}
+
+- (void)testMalformedDataIsRejected {
+    NSData *data = [[self strokesWithNumberOfStrokes:2 samplesPerStroke:10] data];
+    XCTAssertNil([[ORKSignatureStrokes alloc] initWithData:[NSData data]]);
+    XCTAssertNil([[ORKSignatureStrokes alloc] initWithData:[data subdataWithRange:NSMakeRange(0, data.length - 1)]]);
+    
+    NSMutableData *trailingData = [data mutableCopy];
+    [trailingData appendBytes:"x" length:1];
+    XCTAssertNil([[ORKSignatureStrokes alloc] initWithData:trailingData]);
+    
+    NSMutableData *wrongVersion = [data mutableCopy];
+    ((uint8_t *)wrongVersion.mutableBytes)[4] = 99;
+    XCTAssertNil([[ORKSignatureStrokes alloc] initWithData:wrongVersion]);
+}
+
+- (void)testEncodingIsCompact {
+    ORKSignatureStrokes *strokes = [self strokesWithNumberOfStrokes:6 samplesPerStroke:60];
+    NSData *data = [strokes data];
+    // Small deltas take one byte per component.
+    XCTAssertLessThan(data.length, strokes.numberOfSamples * 8);
+    
+    UIImage *image = [strokes imageWithScale:2 lineColor:[UIColor blackColor]];
+    XCTAssertLessThan(data.length, UIImagePNGRepresentation(image).length);
+}
+
+- (void)testRasterization {
+    ORKSignatureStrokes *strokes = [self strokesWithNumberOfStrokes:2 samplesPerStroke:20];
+    UIImage *image = [strokes imageWithScale:2 lineColor:[UIColor blackColor]];
+    XCTAssertTrue(CGSizeEqualToSize(image.size, CGSizeMake(320, 140)));
+    XCTAssertEqual(image.scale, (CGFloat)2);
+    
+    strokes.canvasSize = CGSizeZero;
+    XCTAssertNil([strokes imageWithScale:2 lineColor:[UIColor blackColor]]);
+}
+
+- (void)testSignatureResultCodingAndRasterization {
+    ORKSignatureResult *result = [[ORKSignatureResult alloc] initWithIdentifier:@"signature"];
+    result.signatureStrokeData = [[self strokesWithNumberOfStrokes:2 samplesPerStroke:20] data];
+    
+    ORKSignatureResult *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:result]];
+    XCTAssertEqualObjects(decoded.signatureStrokeData, result.signatureStrokeData);
+    XCTAssertEqualObjects([result copy], result);
+    
+    UIImage *image = [decoded rasterizedSignatureImageWithScale:1 lineColor:[UIColor blackColor]];
+    XCTAssertTrue(CGSizeEqualToSize(image.size, CGSizeMake(320, 140)));
+    
+    result.signatureStrokeData = [NSData dataWithBytes:"ORKS" length:4];
+    XCTAssertNil([result rasterizedSignatureImageWithScale:1 lineColor:[UIColor blackColor]]);
+}
+
+- (void)testDrawingAfterRestoringStrokes {
+    ORKSignatureStrokes *restoredStrokes = [self strokesWithNumberOfStrokes:2 samplesPerStroke:20];
+    NSTimeInterval lastRestoredTimestamp = [restoredStrokes sampleAtIndex:restoredStrokes.numberOfSamples - 1].timestamp;
+    
+    ORKSignatureView *signatureView = [ORKSignatureView new];
+    signatureView.frame = CGRectMake(0, 0, 320, 140);
+    signatureView.signatureStrokeData = [restoredStrokes data];
+    
+    // Touch timestamps are system uptime, far from the restored ones
+    ORKMockSignatureTouch *touch = [ORKMockSignatureTouch new];
+    touch.mockLocation = CGPointMake(20, 20);
+    touch.mockPreviousLocation = touch.mockLocation;
+    touch.mockTimestamp = 5000;
+    NSSet *touches = [NSSet setWithObject:touch];
+    [signatureView gestureTouchesBegan:touches withEvent:nil];
+    touch.mockPreviousLocation = touch.mockLocation;
+    touch.mockLocation = CGPointMake(40, 40);
+    touch.mockTimestamp = 5000.1;
+    [signatureView gestureTouchesMoved:touches withEvent:nil];
+    [signatureView gestureTouchesEnded:touches withEvent:nil];
+    
+    ORKSignatureStrokes *strokes = [[ORKSignatureStrokes alloc] initWithData:signatureView.signatureStrokeData];
+    XCTAssertEqual(strokes.numberOfStrokes, (NSUInteger)3);
+    XCTAssertEqual(strokes.numberOfSamples, restoredStrokes.numberOfSamples + 2);
+    
+    // The new stroke continues the restored timeline
+    NSUInteger firstNewSampleIndex = [strokes sampleRangeOfStrokeAtIndex:2].location;
+    NSTimeInterval firstNewTimestamp = [strokes sampleAtIndex:firstNewSampleIndex].timestamp;
+    XCTAssertGreaterThan(firstNewTimestamp, lastRestoredTimestamp);
+    XCTAssertLessThan(firstNewTimestamp, lastRestoredTimestamp + 1);
+    XCTAssertEqualWithAccuracy([strokes sampleAtIndex:firstNewSampleIndex + 1].timestamp - firstNewTimestamp, 0.1, 0.002);
+}
+
+- (void)testEncodingPerformance {
+    ORKSignatureStrokes *strokes = [self strokesWithNumberOfStrokes:20 samplesPerStroke:200];
+    [self measureBlock:^{
+        for (NSUInteger iteration = 0; iteration < 20; iteration++) {
+            ORKSignatureStrokes *decoded = [[ORKSignatureStrokes alloc] initWithData:[strokes data]];
+            XCTAssertNotNil(decoded);
+        }
+    }];
+}
+
+@end
@@ -1472,6 +1472,48 @@ static ORKStepResult *(^getStepResult)(NSString *, Class, ORKQuestionType, id) =
     
 }
 
+- (NSArray<ORKDeviceMotionRecorderConfiguration *> *)deviceMotionConfigurationsInTask:(ORKOrderedTask *)task {
+    NSMutableArray *configurations = [NSMutableArray array];
+    for (ORKStep *step in task.steps) {
+        if (![step isKindOfClass:[ORKActiveStep class]]) {
+            continue;
+        }
+        for (ORKRecorderConfiguration *configuration in ((ORKActiveStep *)step).recorderConfigurations) {
+            if ([configuration isKindOfClass:[ORKDeviceMotionRecorderConfiguration class]]) {
+                [configurations addObject:configuration];
+            }
+        }
+    }
+    return configurations;
+}
+
+- (void)testWalkingTasksExtractGaitFeaturesOnlyWhenRequested {
+    NSArray<ORKOrderedTask *> *defaultTasks = @[[ORKOrderedTask shortWalkTaskWithIdentifier:@"walking" intendedUseDescription:nil numberOfStepsPerLeg:20 restDuration:30 options:0],
+                                                [ORKOrderedTask walkBackAndForthTaskWithIdentifier:@"walking" intendedUseDescription:nil walkDuration:30 restDuration:30 options:0]];
+    for (ORKOrderedTask *task in defaultTasks) {
+        NSArray<ORKDeviceMotionRecorderConfiguration *> *configurations = [self deviceMotionConfigurationsInTask:task];
+        XCTAssertGreaterThan(configurations.count, 0);
+        for (ORKDeviceMotionRecorderConfiguration *configuration in configurations) {
+            XCTAssertFalse(configuration.extractsGaitFeatures);
+        }
+    }
+    
+    NSArray<ORKOrderedTask *> *gaitTasks = @[[ORKOrderedTask shortWalkTaskWithIdentifier:@"walking" intendedUseDescription:nil numberOfStepsPerLeg:20 restDuration:30 options:ORKPredefinedTaskOptionIncludeGaitFeatures],
+                                             [ORKOrderedTask walkBackAndForthTaskWithIdentifier:@"walking" intendedUseDescription:nil walkDuration:30 restDuration:30 options:ORKPredefinedTaskOptionIncludeGaitFeatures]];
+    for (ORKOrderedTask *task in gaitTasks) {
+        // Only the walking steps extract gait features; the rest steps keep recording raw motion.
+        for (NSString *identifier in @[ORKShortWalkOutboundStepIdentifier, ORKShortWalkRestStepIdentifier]) {
+            ORKActiveStep *step = (ORKActiveStep *)[task stepWithIdentifier:identifier];
+            for (ORKRecorderConfiguration *configuration in step.recorderConfigurations) {
+                if ([configuration isKindOfClass:[ORKDeviceMotionRecorderConfiguration class]]) {
+                    XCTAssertEqual(((ORKDeviceMotionRecorderConfiguration *)configuration).extractsGaitFeatures,
+                                   [identifier isEqualToString:ORKShortWalkOutboundStepIdentifier]);
+                }
+            }
+        }
+    }
+}
+
 #pragma mark - two-finger tapping with both hands
 
 - (void)testTwoFingerTappingIntervalTaskWithIdentifier_TapHandOptionUndefined {
@@ -0,0 +1,251 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKStepViewController_Internal.h"
+#import "ORKTaskViewController_Internal.h"
+
+
+@interface ORKTaskViewController (ORKPrefetchTesting)
+
+- (ORKStepViewController *)viewControllerForStep:(ORKStep *)step;
+- (void)showViewController:(ORKStepViewController *)viewController goForward:(BOOL)goForward animated:(BOOL)animated;
+- (void)prefetchNextStepViewController;
+- (ORKStepViewController *)dequeuePrefetchedViewControllerForStep:(ORKStep *)step;
+
+@end
+
+
+// An ordered task whose next step can be changed, as an answer would change it in a navigable task.
+@interface ORKPrefetchTestTask : ORKOrderedTask
+
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *nextStepIdentifiers;
+
+@end
+
+
+@implementation ORKPrefetchTestTask
+
+- (ORKStep *)stepAfterStep:(ORKStep *)step withResult:(ORKTaskResult *)result {
+    NSString *identifier = self.nextStepIdentifiers[step.identifier];
+    return identifier ? [self stepWithIdentifier:identifier] : [super stepAfterStep:step withResult:result];
+}
+
+@end
+
+
+@interface ORKPrefetchTestDelegate : NSObject <ORKTaskViewControllerDelegate>
+
+@end
+
+
+@implementation ORKPrefetchTestDelegate
+
+- (void)taskViewController:(ORKTaskViewController *)taskViewController didFinishWithReason:(ORKTaskViewControllerFinishReason)reason error:(NSError *)error {
+}
+
+- (ORKStepViewController *)taskViewController:(ORKTaskViewController *)taskViewController viewControllerForStep:(ORKStep *)step {
+    return nil;
+}
+
+@end
+
+
+@interface ORKTaskViewControllerTests : XCTestCase {
+    ORKPrefetchTestTask *_task;
+    ORKTaskViewController *_taskViewController;
+}
+
+@end
+
+
+@implementation ORKTaskViewControllerTests
+
+- (void)setUp {
+    [super setUp];
+    
+    NSMutableArray<ORKStep *> *steps = [NSMutableArray new];
+    for (NSString *identifier in @[@"intro", @"a", @"b", @"c", @"d"]) {
+        ORKInstructionStep *step = [[ORKInstructionStep alloc] initWithIdentifier:identifier];
+        step.title = identifier;
+        [steps addObject:step];
+    }
+    [steps addObject:[[ORKActiveStep alloc] initWithIdentifier:@"active"]];
+    [steps addObject:[ORKReviewStep embeddedReviewStepWithIdentifier:@"review"]];
+    _task = [[ORKPrefetchTestTask alloc] initWithIdentifier:@"prefetch" steps:steps];
+    
+    _taskViewController = [[ORKTaskViewController alloc] initWithTask:_task taskRunUUID:nil];
+    _taskViewController.prefetchesStepViewControllers = YES;
+    [self showStepWithIdentifier:@"intro"];
+}
+
+- (void)tearDown {
+    _taskViewController = nil;
+    _task = nil;
+    [super tearDown];
+}
+
+// Shows a step directly, without presenting the task view controller.
+- (ORKStepViewController *)showStepWithIdentifier:(NSString *)identifier {
+    ORKStepViewController *stepViewController = [_taskViewController viewControllerForStep:[_task stepWithIdentifier:identifier]];
+    [_taskViewController showViewController:stepViewController goForward:YES animated:NO];
+    return stepViewController;
+}
+
+- (BOOL)hasPrefetchedStepWithIdentifier:(NSString *)identifier {
+    return [_taskViewController dequeuePrefetchedViewControllerForStep:[_task stepWithIdentifier:identifier]] != nil;
+}
+
+- (void)testPrefetchedViewControllerIsReused {
+    _task.nextStepIdentifiers = @{ @"intro": @"a" };
+    [_taskViewController prefetchNextStepViewController];
+    
+    ORKStep *step = [_task stepWithIdentifier:@"a"];
+    ORKStepViewController *prefetched = [_taskViewController dequeuePrefetchedViewControllerForStep:step];
+    XCTAssertNotNil(prefetched);
+    XCTAssertEqual(prefetched.step, step);
+    XCTAssertTrue(prefetched.isViewLoaded);
+    // Dequeuing removes it
+    XCTAssertNil([_taskViewController dequeuePrefetchedViewControllerForStep:step]);
+    
+    // Prefetching a step that is already prefetched is a no-op, and moving to the step uses the
+    // prefetched view controller, whose view is already loaded
+    [_taskViewController prefetchNextStepViewController];
+    [_taskViewController prefetchNextStepViewController];
+    ORKStepViewController *stepViewController = [_taskViewController viewControllerForStep:step];
+    XCTAssertEqual(stepViewController.step, step);
+    XCTAssertTrue(stepViewController.isViewLoaded);
+    XCTAssertNil([_taskViewController dequeuePrefetchedViewControllerForStep:step]);
+}
+
+- (void)testPrefetchingIsOptIn {
+    _taskViewController.prefetchesStepViewControllers = NO;
+    _task.nextStepIdentifiers = @{ @"intro": @"a" };
+    [_taskViewController prefetchNextStepViewController];
+    _taskViewController.prefetchesStepViewControllers = YES;
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"a"]);
+    
+    // Turning prefetching off drops what was prefetched
+    [_taskViewController prefetchNextStepViewController];
+    _taskViewController.prefetchesStepViewControllers = NO;
+    _taskViewController.prefetchesStepViewControllers = YES;
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"a"]);
+}
+
+- (void)testChangedNextStepIsPrefetched {
+    _task.nextStepIdentifiers = @{ @"intro": @"a" };
+    [_taskViewController prefetchNextStepViewController];
+    
+    // An answer that changes the next step makes the next prefetch build that step instead
+    _task.nextStepIdentifiers = @{ @"intro": @"b" };
+    [_taskViewController stepViewControllerResultDidChange:_taskViewController.currentStepViewController];
+    [_taskViewController prefetchNextStepViewController];
+    
+    ORKStep *step = [_task stepWithIdentifier:@"b"];
+    ORKStepViewController *prefetched = [_taskViewController dequeuePrefetchedViewControllerForStep:step];
+    XCTAssertNotNil(prefetched);
+    XCTAssertEqual(prefetched.step, step);
+}
+
+- (void)testPrefetchedViewControllerIsDiscardedWhenSavedResultChanges {
+    _task.nextStepIdentifiers = @{ @"intro": @"a" };
+    [_taskViewController prefetchNextStepViewController];
+    
+    ORKStepResult *stepResult = [[ORKStepResult alloc] initWithStepIdentifier:@"a" results:@[]];
+    ORKTaskResult *taskResult = [[ORKTaskResult alloc] initWithTaskIdentifier:_task.identifier taskRunUUID:[NSUUID UUID] outputDirectory:nil];
+    taskResult.results = @[stepResult];
+    _taskViewController.defaultResultSource = taskResult;
+    
+    ORKStep *step = [_task stepWithIdentifier:@"a"];
+    XCTAssertNil([_taskViewController dequeuePrefetchedViewControllerForStep:step]);
+    
+    // The stale view controller was dropped, so the step is built again from the new result
+    [_taskViewController prefetchNextStepViewController];
+    ORKStepViewController *prefetched = [_taskViewController dequeuePrefetchedViewControllerForStep:step];
+    XCTAssertNotNil(prefetched);
+    XCTAssertEqualObjects(prefetched.result.identifier, @"a");
+}
+
+- (void)testPrefetchedViewControllersAreBounded {
+    for (NSString *identifier in @[@"a", @"b", @"c", @"d"]) {
+        _task.nextStepIdentifiers = @{ @"intro": identifier };
+        [_taskViewController prefetchNextStepViewController];
+    }
+    
+    // The oldest is dropped first
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"a"]);
+    XCTAssertTrue([self hasPrefetchedStepWithIdentifier:@"b"]);
+    XCTAssertTrue([self hasPrefetchedStepWithIdentifier:@"c"]);
+    XCTAssertTrue([self hasPrefetchedStepWithIdentifier:@"d"]);
+}
+
+- (void)testPrefetchedViewControllersAreCleared {
+    _task.nextStepIdentifiers = @{ @"intro": @"a" };
+    
+    [_taskViewController prefetchNextStepViewController];
+    [_taskViewController didReceiveMemoryWarning];
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"a"]);
+    
+    // The task view controller has not been presented, so its task can still be set
+    [_taskViewController prefetchNextStepViewController];
+    _taskViewController.task = _task;
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"a"]);
+    
+    [_taskViewController prefetchNextStepViewController];
+    [_taskViewController stepViewControllerDidFail:_taskViewController.currentStepViewController withError:[NSError errorWithDomain:NSCocoaErrorDomain code:0 userInfo:nil]];
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"a"]);
+}
+
+- (void)testStepsThatAreNeverPrefetched {
+    // Active and review steps are built when shown
+    for (NSString *identifier in @[@"active", @"review"]) {
+        _task.nextStepIdentifiers = @{ @"intro": identifier };
+        [_taskViewController prefetchNextStepViewController];
+        XCTAssertFalse([self hasPrefetchedStepWithIdentifier:identifier], @"%@", identifier);
+    }
+    
+    // Nothing is prefetched while a step is being reviewed
+    ORKStepViewController *stepViewController = [self showStepWithIdentifier:@"a"];
+    stepViewController.parentReviewStep = (ORKReviewStep *)[_task stepWithIdentifier:@"review"];
+    _task.nextStepIdentifiers = @{ @"a": @"b" };
+    [_taskViewController prefetchNextStepViewController];
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"b"]);
+    stepViewController.parentReviewStep = nil;
+    
+    // Nor are any steps when the delegate can supply view controllers
+    ORKPrefetchTestDelegate *delegate = [ORKPrefetchTestDelegate new];
+    _taskViewController.delegate = delegate;
+    [_taskViewController prefetchNextStepViewController];
+    XCTAssertFalse([self hasPrefetchedStepWithIdentifier:@"b"]);
+}
+
+@end
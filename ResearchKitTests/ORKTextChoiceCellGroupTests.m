@@ -580,4 +580,31 @@
     [self testSingleChoice:answerFormat choices:choices];
 }
 
+- (void)testCellReuse {
+    NSArray *choices = [self textChoices];
+    ORKTextChoiceAnswerFormat *answerFormat = [ORKTextChoiceAnswerFormat choiceAnswerFormatWithStyle:ORKChoiceAnswerStyleMultipleChoice textChoices:choices];
+    ORKTextChoiceCellGroup *group = [[ORKTextChoiceCellGroup alloc] initWithTextChoiceAnswerFormat:answerFormat
+                                                                                            answer:@[@"c2"]
+                                                                                beginningIndexPath:[NSIndexPath indexPathForRow:0 inSection:0]
+                                                                               immediateNavigation:NO];
+    
+    ORKChoiceViewCell *cell = [group cellAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] withReuseIdentifier:@"abc"];
+    XCTAssertEqualObjects(cell.shortLabel.text, @"choice 01");
+    XCTAssertFalse(cell.selectedItem);
+    
+    // A dequeued cell takes the text and selection of the row it is bound to
+    [group configureCell:cell atIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]];
+    XCTAssertEqualObjects(cell.shortLabel.text, @"choice 02");
+    XCTAssertTrue(cell.selectedItem);
+    XCTAssertEqual([group cellAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0] withReuseIdentifier:@"abc"], cell);
+    XCTAssertNotEqual([group cellAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] withReuseIdentifier:@"abc"], cell);
+    
+    // Selection is tracked without a cell for every row
+    [group didSelectCellAtIndexPath:[NSIndexPath indexPathForRow:3 inSection:0]];
+    XCTAssertEqualObjects(group.answer, (@[@"c2", @"c4"]));
+    [group didSelectCellAtIndexPath:[NSIndexPath indexPathForRow:1 inSection:0]];
+    XCTAssertFalse(cell.selectedItem);
+    XCTAssertEqualObjects(group.answer, (@[@"c4"]));
+}
+
 @end
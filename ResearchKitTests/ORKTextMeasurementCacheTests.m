@@ -0,0 +1,68 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKTextMeasurementCache.h"
+
+
+@interface ORKTextMeasurementCacheTests : XCTestCase
+
+@end
+
+
+@implementation ORKTextMeasurementCacheTests
+
+- (void)testSizeMatchesBoundingRect {
+    ORKTextMeasurementCache *cache = [ORKTextMeasurementCache new];
+    NSString *string = @"Rate how often you experienced each of the following symptoms over the past week.";
+    UIFont *font = [UIFont systemFontOfSize:17];
+    
+    CGSize expectedSize = [string boundingRectWithSize:CGSizeMake(200, CGFLOAT_MAX)
+                                               options:NSStringDrawingUsesLineFragmentOrigin
+                                            attributes:@{ NSFontAttributeName : font }
+                                               context:nil].size;
+    XCTAssertTrue(CGSizeEqualToSize([cache sizeOfString:string font:font width:200], expectedSize));
+    // Second lookup comes from the cache
+    XCTAssertTrue(CGSizeEqualToSize([cache sizeOfString:string font:font width:200], expectedSize));
+    
+    CGSize singleLineSize = [cache sizeOfString:string font:font width:CGFLOAT_MAX];
+    XCTAssertGreaterThan(singleLineSize.width, expectedSize.width);
+    XCTAssertLessThan(singleLineSize.height, expectedSize.height);
+    
+    CGSize largerFontSize = [cache sizeOfString:string font:[UIFont systemFontOfSize:24] width:200];
+    XCTAssertGreaterThan(largerFontSize.height, expectedSize.height);
+    
+    XCTAssertTrue(CGSizeEqualToSize([cache sizeOfString:nil font:font width:200], CGSizeZero));
+    XCTAssertTrue(CGSizeEqualToSize([cache sizeOfString:@"" font:font width:200], CGSizeZero));
+}
+
+@end
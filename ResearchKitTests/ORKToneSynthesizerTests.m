@@ -0,0 +1,218 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "ORKToneSynthesizer.h"
+
+
+static const double ORKTestSampleRate = 44100.0;
+static const double ORKTestAmplitude = 0.03;
+
+// Magnitude of a single DFT bin, using the Goertzel recurrence.
+static double ORKTestGoertzelMagnitude(const float *samples, uint32_t count, double frequency, double sampleRate) {
+    double coefficient = 2 * cos(2 * M_PI * frequency / sampleRate);
+    double previous = 0;
+    double previous2 = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        double value = samples[i] + coefficient * previous - previous2;
+        previous2 = previous;
+        previous = value;
+    }
+    double power = previous2 * previous2 + previous * previous - coefficient * previous * previous2;
+    return sqrt(MAX(power, 0)) * 2 / count;
+}
+
+
+@interface ORKToneSynthesizerTests : XCTestCase
+
+@end
+
+
+@implementation ORKToneSynthesizerTests {
+    ORKToneSynthesizer _synthesizer;
+    float *_buffer;
+    uint32_t _bufferLength;
+}
+
+- (void)setUp {
+    [super setUp];
+    _bufferLength = (uint32_t)ORKTestSampleRate;
+    _buffer = calloc(_bufferLength, sizeof(float));
+    ORKToneSynthesizerInitialize(&_synthesizer, ORKTestSampleRate, ORKTestAmplitude);
+}
+
+- (void)tearDown {
+    free(_buffer);
+    [super tearDown];
+}
+
+- (void)renderInBlocksOfSize:(uint32_t)blockSize {
+    for (uint32_t frame = 0; frame < _bufferLength; frame += blockSize) {
+        ORKToneSynthesizerRender(&_synthesizer, _buffer + frame, MIN(blockSize, _bufferLength - frame));
+    }
+}
+
+- (void)testMatchesReferenceSine {
+    ORKToneSynthesizerSetFrequency(&_synthesizer, 1000);
+    ORKToneSynthesizerStartFadeIn(&_synthesizer, 0);
+    // An odd block size exercises the scalar tail and the phase hand-off between blocks.
+    [self renderInBlocksOfSize:511];
+    
+    for (uint32_t frame = 0; frame < _bufferLength; frame++) {
+        double expected = ORKTestAmplitude * sin(2 * M_PI * 1000 * frame / ORKTestSampleRate);
+        XCTAssertEqualWithAccuracy(_buffer[frame], expected, 1e-6);
+    }
+}
+
+- (void)testFrequencyAccuracyAndDistortion {
+    for (NSNumber *frequency in @[@250, @1000, @4000, @8000]) {
+        ORKToneSynthesizerSetFrequency(&_synthesizer, frequency.doubleValue);
+        ORKToneSynthesizerStartFadeIn(&_synthesizer, 0);
+        [self renderInBlocksOfSize:512];
+        
+        double fundamental = ORKTestGoertzelMagnitude(_buffer, _bufferLength, frequency.doubleValue, ORKTestSampleRate);
+        XCTAssertEqualWithAccuracy(fundamental, ORKTestAmplitude, ORKTestAmplitude * 1e-3);
+        
+        // One second of signal gives 1 Hz bins; energy must not leak into the neighbours.
+        double below = ORKTestGoertzelMagnitude(_buffer, _bufferLength, frequency.doubleValue - 1, ORKTestSampleRate);
+        double above = ORKTestGoertzelMagnitude(_buffer, _bufferLength, frequency.doubleValue + 1, ORKTestSampleRate);
+        XCTAssertLessThan(MAX(below, above), fundamental * 1e-4);
+        
+        double harmonicPower = 0;
+        for (int harmonic = 2; harmonic * frequency.doubleValue < ORKTestSampleRate / 2; harmonic++) {
+            double magnitude = ORKTestGoertzelMagnitude(_buffer, _bufferLength, harmonic * frequency.doubleValue, ORKTestSampleRate);
+            harmonicPower += magnitude * magnitude;
+        }
+        double totalHarmonicDistortion = sqrt(harmonicPower) / fundamental;
+        XCTAssertLessThan(totalHarmonicDistortion, 1e-4);
+    }
+}
+
+- (void)testFadeIn {
+    ORKToneSynthesizerSetFrequency(&_synthesizer, 1000);
+    ORKToneSynthesizerStartFadeIn(&_synthesizer, 0.5);
+    XCTAssertEqualWithAccuracy(ORKToneSynthesizerCurrentAmplitude(&_synthesizer), ORKTestAmplitude * 0.01, 1e-12);
+    
+    ORKToneSynthesizerRender(&_synthesizer, _buffer, (uint32_t)(ORKTestSampleRate * 0.25));
+    XCTAssertEqualWithAccuracy(ORKToneSynthesizerCurrentAmplitude(&_synthesizer), ORKTestAmplitude * 0.1, 1e-9);
+    
+    ORKToneSynthesizerRender(&_synthesizer, _buffer, (uint32_t)(ORKTestSampleRate * 0.25));
+    XCTAssertEqualWithAccuracy(ORKToneSynthesizerCurrentAmplitude(&_synthesizer), ORKTestAmplitude, 1e-9);
+    
+    ORKToneSynthesizerRender(&_synthesizer, _buffer, _bufferLength);
+    float peak = 0;
+    for (uint32_t frame = 0; frame < _bufferLength; frame++) {
+        peak = MAX(peak, fabsf(_buffer[frame]));
+    }
+    XCTAssertLessThanOrEqual(peak, ORKTestAmplitude);
+    XCTAssertEqualWithAccuracy(peak, ORKTestAmplitude, ORKTestAmplitude * 1e-3);
+}
+
+- (void)testPulsedTone {
+    uint32_t length = ORKToneSynthesizerPulsedToneLength(ORKTestSampleRate);
+    XCTAssertEqual(length, (uint32_t)(0.4 * ORKTestSampleRate));
+    
+    float *waveform = calloc(length, sizeof(float));
+    ORKToneSynthesizerFillPulsedTone(waveform, length, ORKTestSampleRate, 1000);
+    ORKToneSynthesizerSetWaveform(&_synthesizer, waveform, length);
+    ORKToneSynthesizerStartFadeIn(&_synthesizer, 0);
+    [self renderInBlocksOfSize:512];
+    
+    for (uint32_t frame = 0; frame < _bufferLength; frame++) {
+        double time = fmod(frame / ORKTestSampleRate, 0.4);
+        if (time > 0.2) {
+            XCTAssertEqual(_buffer[frame], 0);
+        } else if (time > 0.02 && time < 0.18) {
+            double expected = ORKTestAmplitude * sin(2 * M_PI * 1000 * (frame % length) / ORKTestSampleRate);
+            XCTAssertEqualWithAccuracy(_buffer[frame], expected, 1e-6);
+        }
+    }
+    free(waveform);
+}
+
+- (void)testWarbleToneLoopsSeamlessly {
+    uint32_t length = ORKToneSynthesizerWarbleToneLength(ORKTestSampleRate);
+    float *waveform = calloc(length, sizeof(float));
+    ORKToneSynthesizerFillWarbleTone(waveform, length, ORKTestSampleRate, 1003.3);
+    
+    // The step across the loop point must look like any other step of the waveform.
+    double maximumStep = 0;
+    for (uint32_t frame = 1; frame < length; frame++) {
+        maximumStep = MAX(maximumStep, fabs(waveform[frame] - waveform[frame - 1]));
+    }
+    XCTAssertLessThanOrEqual(fabs(waveform[0] - waveform[length - 1]), maximumStep);
+    
+    // Energy stays within the ±5% modulation band.
+    ORKToneSynthesizerSetWaveform(&_synthesizer, waveform, length);
+    ORKToneSynthesizerStartFadeIn(&_synthesizer, 0);
+    [self renderInBlocksOfSize:512];
+    double inBand = ORKTestGoertzelMagnitude(_buffer, _bufferLength, 1003, ORKTestSampleRate);
+    double outOfBand = ORKTestGoertzelMagnitude(_buffer, _bufferLength, 1200, ORKTestSampleRate);
+    XCTAssertGreaterThan(inBand, outOfBand * 100);
+    free(waveform);
+}
+
+- (void)testNarrowBandNoise {
+    double gain = ORKToneSynthesizerNarrowBandNoiseGain(ORKTestSampleRate, 2000, 42);
+    XCTAssertGreaterThan(gain, 0);
+    ORKToneSynthesizerSetNarrowBandNoise(&_synthesizer, 2000, 42, gain);
+    ORKToneSynthesizerStartFadeIn(&_synthesizer, 0);
+    [self renderInBlocksOfSize:512];
+    
+    double sumOfSquares = 0;
+    for (uint32_t frame = 0; frame < _bufferLength; frame++) {
+        sumOfSquares += _buffer[frame] * _buffer[frame];
+    }
+    double rms = sqrt(sumOfSquares / _bufferLength);
+    XCTAssertEqualWithAccuracy(rms, ORKTestAmplitude * M_SQRT1_2, ORKTestAmplitude * 0.05);
+    
+    double inBand = 0;
+    double outOfBand = 0;
+    for (double frequency = 1900; frequency <= 2100; frequency += 10) {
+        inBand += ORKTestGoertzelMagnitude(_buffer, _bufferLength, frequency, ORKTestSampleRate);
+    }
+    for (double frequency = 7900; frequency <= 8100; frequency += 10) {
+        outOfBand += ORKTestGoertzelMagnitude(_buffer, _bufferLength, frequency, ORKTestSampleRate);
+    }
+    XCTAssertGreaterThan(inBand, outOfBand * 30);
+}
+
+- (void)testRenderPerformance {
+    ORKToneSynthesizerSetFrequency(&_synthesizer, 1000);
+    ORKToneSynthesizerStartFadeIn(&_synthesizer, 0.5);
+    [self measureBlock:^{
+        for (int i = 0; i < 20; i++) {
+            [self renderInBlocksOfSize:512];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,138 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import "ORKTremorSpectrum.h"
+
+
+static const double ORKTestSampleRate = 100.0;
+static const double ORKTestLowerBandFrequency = 3.0;
+static const double ORKTestUpperBandFrequency = 12.0;
+
+typedef void (^ORKTestMotionGenerator)(double time, double userAcceleration[3], double rotationRate[3]);
+
+
+@interface ORKTremorSpectrumTests : XCTestCase
+
+@end
+
+
+@implementation ORKTremorSpectrumTests {
+    ORKTremorSpectrum _spectrum;
+}
+
+- (void)setUp {
+    [super setUp];
+    ORKTremorSpectrumInitialize(&_spectrum, ORKTestSampleRate);
+}
+
+- (void)tearDown {
+    ORKTremorSpectrumDestroy(&_spectrum);
+    [super tearDown];
+}
+
+- (void)addSamples:(NSInteger)count generator:(ORKTestMotionGenerator)generator {
+    for (NSInteger i = 0; i < count; i++) {
+        double userAcceleration[3] = { 0, 0, 0 };
+        double rotationRate[3] = { 0, 0, 0 };
+        generator(i / ORKTestSampleRate, userAcceleration, rotationRate);
+        ORKTremorSpectrumAddSample(&_spectrum, userAcceleration, rotationRate);
+    }
+}
+
+- (void)testSegmentation {
+    // About 2.5 s segments, rounded up to a power of two, with 50% overlap
+    XCTAssertEqual(_spectrum.segmentLength, 256);
+    XCTAssertEqual(_spectrum.hopLength, 128);
+    
+    [self addSamples:255 generator:^(double time, double userAcceleration[3], double rotationRate[3]) {
+        userAcceleration[0] = sin(2 * M_PI * 5 * time);
+    }];
+    XCTAssertEqual(_spectrum.segmentCount, 0);
+    XCTAssertEqual(ORKTremorSpectrumBandPower(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 0);
+    XCTAssertEqual(ORKTremorSpectrumDominantFrequency(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 0);
+    
+    [self addSamples:1 + 128 * 3 generator:^(double time, double userAcceleration[3], double rotationRate[3]) {
+    }];
+    XCTAssertEqual(_spectrum.segmentCount, 4);
+}
+
+- (void)testSinePowerAndFrequency {
+    // A sine of amplitude A has power A^2 / 2
+    [self addSamples:3000 generator:^(double time, double userAcceleration[3], double rotationRate[3]) {
+        userAcceleration[0] = 0.1 * sin(2 * M_PI * 5.3 * time);
+        rotationRate[1] = 0.5 * sin(2 * M_PI * 8.7 * time);
+    }];
+    
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumBandPower(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 0.005, 0.0001);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumTotalPower(&_spectrum, ORKTremorSpectrumSignalUserAcceleration), 0.005, 0.0001);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumDominantFrequency(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 5.3, 0.1);
+    
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumBandPower(&_spectrum, ORKTremorSpectrumSignalRotationRate, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 0.125, 0.0025);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumDominantFrequency(&_spectrum, ORKTremorSpectrumSignalRotationRate, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 8.7, 0.1);
+}
+
+- (void)testAxesAreCombined {
+    // The same motion split across axes has the same power as on a single axis
+    [self addSamples:2000 generator:^(double time, double userAcceleration[3], double rotationRate[3]) {
+        double value = 0.2 * sin(2 * M_PI * 6 * time);
+        userAcceleration[0] = value * 0.6;
+        userAcceleration[1] = value * 0.8;
+    }];
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumBandPower(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 0.02, 0.0005);
+    XCTAssertEqual(ORKTremorSpectrumTotalPower(&_spectrum, ORKTremorSpectrumSignalRotationRate), 0);
+}
+
+- (void)testOutOfBandMotionIsExcluded {
+    // Walking-like motion at 1 Hz and an offset do not count as tremor
+    [self addSamples:3000 generator:^(double time, double userAcceleration[3], double rotationRate[3]) {
+        userAcceleration[2] = 0.3 * sin(2 * M_PI * 1.0 * time) + 0.05;
+        userAcceleration[0] = 0.01 * sin(2 * M_PI * 4.0 * time);
+    }];
+    double bandPower = ORKTremorSpectrumBandPower(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency);
+    XCTAssertEqualWithAccuracy(bandPower, 0.00005, 0.00001);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumTotalPower(&_spectrum, ORKTremorSpectrumSignalUserAcceleration), 0.045 + 0.00005, 0.001);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumDominantFrequency(&_spectrum, ORKTremorSpectrumSignalUserAcceleration, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), 4.0, 0.1);
+}
+
+- (void)testWhiteNoisePower {
+    // Uniform noise in [-a, a] has variance a^2 / 3, spread evenly up to the Nyquist frequency
+    srand48(7);
+    [self addSamples:20000 generator:^(double time, double userAcceleration[3], double rotationRate[3]) {
+        rotationRate[2] = 0.3 * (2 * drand48() - 1);
+    }];
+    double variance = 0.09 / 3;
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumTotalPower(&_spectrum, ORKTremorSpectrumSignalRotationRate), variance, variance * 0.05);
+    double bandFraction = (ORKTestUpperBandFrequency - ORKTestLowerBandFrequency) / (ORKTestSampleRate / 2);
+    XCTAssertEqualWithAccuracy(ORKTremorSpectrumBandPower(&_spectrum, ORKTremorSpectrumSignalRotationRate, ORKTestLowerBandFrequency, ORKTestUpperBandFrequency), variance * bandFraction, variance * bandFraction * 0.1);
+}
+
+@end
@@ -0,0 +1,114 @@
+/*
+ Copyright (c) 2016, Apple Inc. All rights reserved.
+
+ Redistribution and use in source and binary forms, with or without modification,
+ are permitted provided that the following conditions are met:
+ 
+ 1.  Redistributions of source code must retain the above copyright notice, this
+ list of conditions and the following disclaimer.
+ 
+ 2.  Redistributions in binary form must reproduce the above copyright notice,
+ this list of conditions and the following disclaimer in the documentation and/or
+ other materials provided with the distribution.
+ 
+ 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+ may be used to endorse or promote products derived from this software without
+ specific prior written permission. No license is granted to the trademarks of
+ the copyright holders even if such marks are included in this software.
+ 
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#import <XCTest/XCTest.h>
+#import <ResearchKit/ResearchKit.h>
+#import "ORKVisualConsentFrameCache.h"
+#import "ORKConsentSection_Internal.h"
+
+
+@interface ORKVisualConsentFrameCacheTests : XCTestCase
+
+@end
+
+
+@implementation ORKVisualConsentFrameCacheTests
+
+- (void)testPreloadDecodesMovieFrames {
+    // The shortest movie, which fits the default budget at 2x and, at half resolution, at 3x
+    ORKVisualConsentFrameCache *cache = [ORKVisualConsentFrameCache new];
+    NSURL *movieURL = ORKMovieURLForConsentSectionType(ORKConsentSectionTypeStudyTasks);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"preload"];
+    [cache preloadFramesForMovieURL:movieURL completion:^(ORKVisualConsentMovieFrames *frames) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertNotNil(frames);
+        XCTAssertGreaterThan(frames.numberOfFrames, (NSUInteger)0);
+        XCTAssertGreaterThan(frames.numberOfBytes, (NSUInteger)0);
+        XCTAssertLessThanOrEqual(frames.numberOfBytes, cache.totalCostLimit);
+        XCTAssertGreaterThan(frames.presentationSize.width, 0);
+        XCTAssertTrue([frames presentationTimeAtIndex:frames.numberOfFrames - 1] >= [frames presentationTimeAtIndex:0]);
+        XCTAssertEqual([cache framesForMovieURL:movieURL], frames);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+- (void)testMovieLargerThanBudgetIsNotCached {
+    ORKVisualConsentFrameCache *cache = [ORKVisualConsentFrameCache new];
+    cache.totalCostLimit = 1024;
+    NSURL *movieURL = ORKMovieURLForConsentSectionType(ORKConsentSectionTypeOverview);
+    
+    XCTestExpectation *expectation = [self expectationWithDescription:@"preload"];
+    [cache preloadFramesForMovieURL:movieURL completion:^(ORKVisualConsentMovieFrames *frames) {
+        XCTAssertNil(frames);
+        XCTAssertNil([cache framesForMovieURL:movieURL]);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    
+    // The movie is remembered as too large, so the next preload completes without decoding
+    __block BOOL completed = NO;
+    [cache preloadFramesForMovieURL:movieURL completion:^(ORKVisualConsentMovieFrames *frames) {
+        XCTAssertNil(frames);
+        completed = YES;
+    }];
+    XCTAssertTrue(completed);
+}
+
+- (void)testMovieIsScaledDownToFitBudget {
+    ORKVisualConsentFrameCache *cache = [ORKVisualConsentFrameCache new];
+    NSURL *movieURL = ORKMovieURLForConsentSectionType(ORKConsentSectionTypeStudyTasks);
+    
+    __block ORKVisualConsentMovieFrames *fullFrames = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"preload"];
+    [cache preloadFramesForMovieURL:movieURL completion:^(ORKVisualConsentMovieFrames *frames) {
+        fullFrames = frames;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertNotNil(fullFrames);
+    
+    // A budget of about half the size needs frames at about 70% of the resolution
+    ORKVisualConsentFrameCache *smallCache = [ORKVisualConsentFrameCache new];
+    smallCache.totalCostLimit = fullFrames.numberOfBytes / 2;
+    expectation = [self expectationWithDescription:@"preload scaled"];
+    [smallCache preloadFramesForMovieURL:movieURL completion:^(ORKVisualConsentMovieFrames *frames) {
+        XCTAssertNotNil(frames);
+        XCTAssertLessThanOrEqual(frames.numberOfBytes, smallCache.totalCostLimit);
+        XCTAssertLessThan(CVPixelBufferGetWidth([frames pixelBufferAtIndex:0]), CVPixelBufferGetWidth([fullFrames pixelBufferAtIndex:0]));
+        XCTAssertTrue(CGSizeEqualToSize(frames.presentationSize, fullFrames.presentationSize));
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+@end
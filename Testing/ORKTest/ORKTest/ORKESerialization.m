@@ -119,6 +119,23 @@ static CLLocationCoordinate2D coordinateFromDictionary(NSDictionary *dict) {
     return (CLLocationCoordinate2D){.latitude = ((NSNumber *)dict[@"latitude"]).doubleValue, .longitude = ((NSNumber *)dict[@"longitude"]).doubleValue };
 }
 
+// JSON object keys must be strings, so the frequency keyed calibration table is written as an array of pairs.
+static NSArray *arrayFromCalibrationTable(NSDictionary<NSNumber *, NSNumber *> *table) {
+    NSMutableArray *pairs = [NSMutableArray array];
+    for (NSNumber *frequency in [table.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        [pairs addObject:@{ @"frequency": frequency, @"amplitude": table[frequency] }];
+    }
+    return pairs;
+}
+
+static NSDictionary<NSNumber *, NSNumber *> *calibrationTableFromArray(NSArray *pairs) {
+    NSMutableDictionary *table = [NSMutableDictionary dictionary];
+    for (NSDictionary *pair in pairs) {
+        table[pair[@"frequency"]] = pair[@"amplitude"];
+    }
+    return table;
+}
+
 static ORKNumericAnswerStyle ORKNumericAnswerStyleFromString(NSString *s) {
     return tableMapReverse(s, ORKNumericAnswerStyleTable());
 }
@@ -510,6 +527,10 @@ encondingTable =
         },
         (@{
            PROPERTY(toneDuration, NSNumber, NSObject, YES, nil, nil),
+           PROPERTY(stimulusType, NSNumber, NSObject, YES, nil, nil),
+           PROPERTY(calibrationTable, NSDictionary, NSObject, YES,
+                    ^id(id table) { return arrayFromCalibrationTable(table); },
+                    ^id(id pairs) { return calibrationTableFromArray(pairs); }),
            })),
    ENTRY(ORKToneAudiometryPracticeStep,
          ^id(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
@@ -639,6 +660,7 @@ encondingTable =
         },
         (@{
           PROPERTY(recorderSettings, NSDictionary, NSObject, NO, nil, nil),
+          PROPERTY(extractsVoiceFeatures, NSNumber, NSObject, YES, nil, nil),
           })),
   ENTRY(ORKConsentDocument,
         nil,
@@ -649,6 +671,7 @@ encondingTable =
           PROPERTY(signaturePageContent, NSString, NSObject, NO, nil, nil),
           PROPERTY(signatures, ORKConsentSignature, NSArray, NO, nil, nil),
           PROPERTY(htmlReviewContent, NSString, NSObject, NO, nil, nil),
+          PROPERTY(usesNativePDFRendering, NSNumber, NSObject, NO, nil, nil),
           })),
   ENTRY(ORKConsentSharingStep,
         ^(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
@@ -731,6 +754,8 @@ encondingTable =
         },
         (@{
           PROPERTY(frequency, NSNumber, NSObject, NO, nil, nil),
+          PROPERTY(extractsGaitFeatures, NSNumber, NSObject, YES, nil, nil),
+          PROPERTY(extractsTremorSpectrum, NSNumber, NSObject, YES, nil, nil),
           })),
   ENTRY(ORKFormStep,
         ^id(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
@@ -813,6 +838,16 @@ encondingTable =
           PROPERTY(style, NSNumber, NSObject, NO, NUMTOSTRINGBLOCK(ORKChoiceAnswerStyleTable()), STRINGTONUMBLOCK(ORKChoiceAnswerStyleTable())),
           PROPERTY(textChoices, ORKTextChoice, NSArray, NO, nil, nil),
           })),
+  ENTRY(ORKSearchableChoiceAnswerFormat,
+        ^id(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
+            return [[ORKSearchableChoiceAnswerFormat alloc] initWithChoicesFileURL:GETPROP(dict, choicesFileURL)];
+        },
+        (@{
+          PROPERTY(choicesFileURL, NSURL, NSObject, NO,
+                   ^id(id url) { return [(NSURL *)url absoluteString]; },
+                   ^id(id string) { return [NSURL URLWithString:string]; }),
+          PROPERTY(maximumNumberOfResults, NSNumber, NSObject, YES, nil, nil),
+          })),
   ENTRY(ORKTextChoice,
         ^id(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
             return [[ORKTextChoice alloc] initWithText:GETPROP(dict, text) detailText:GETPROP(dict, detailText) value:GETPROP(dict, value) exclusive:((NSNumber *)GETPROP(dict, exclusive)).boolValue];
@@ -972,6 +1007,12 @@ encondingTable =
             return [[ORKLocationRecorderConfiguration alloc] initWithIdentifier:GETPROP(dict,identifier)];
         },
         (@{
+          PROPERTY(minimumDistance, NSNumber, NSObject, YES, nil, nil),
+          PROPERTY(minimumTimeInterval, NSNumber, NSObject, YES, nil, nil),
+          PROPERTY(smoothsLocations, NSNumber, NSObject, YES, nil, nil),
+          PROPERTY(simplificationTolerance, NSNumber, NSObject, YES, nil, nil),
+          PROPERTY(outputMode, NSNumber, NSObject, YES, nil, nil),
+          PROPERTY(summarizesMovement, NSNumber, NSObject, YES, nil, nil),
           })),
    ENTRY(ORKPedometerRecorderConfiguration,
          ^id(NSDictionary *dict, ORKESerializationPropertyGetter getter) {
@@ -1020,7 +1061,11 @@ encondingTable =
                     ^id(id dict) { return [NSValue valueWithCGRect:rectFromDictionary(dict)]; }),
            PROPERTY(buttonRect2, NSValue, NSObject, NO,
                     ^id(id value) { return value?dictionaryFromCGRect(((NSValue *)value).CGRectValue):nil; },
-                    ^id(id dict) { return [NSValue valueWithCGRect:rectFromDictionary(dict)]; })
+                    ^id(id dict) { return [NSValue valueWithCGRect:rectFromDictionary(dict)]; }),
+           PROPERTY(meanTapInterval, NSNumber, NSObject, NO, nil, nil),
+           PROPERTY(tapIntervalVariability, NSNumber, NSObject, NO, nil, nil),
+           PROPERTY(alternationAccuracy, NSNumber, NSObject, NO, nil, nil),
+           PROPERTY(fatigueSlope, NSNumber, NSObject, NO, nil, nil)
            })),
   ENTRY(ORKSpatialSpanMemoryGameTouchSample,
         nil,
@@ -1089,6 +1134,44 @@ encondingTable =
             PROPERTY(timeLimit, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
            })),
+   ENTRY(ORKGaitResult,
+         nil,
+         (@{
+            PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(numberOfSteps, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(cadence, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(meanStepDuration, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(stepDurationVariability, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(meanStrideDuration, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(strideDurationVariability, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(stepSymmetry, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(numberOfTurns, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(meanTurnDuration, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(meanTurnAngle, NSNumber, NSObject, NO, nil, nil),
+           })),
+   ENTRY(ORKTremorSpectrumResult,
+         nil,
+         (@{
+            PROPERTY(lowerBandFrequency, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(upperBandFrequency, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(numberOfSegments, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(userAccelerationBandPower, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(userAccelerationTotalPower, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(userAccelerationDominantFrequency, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(rotationRateBandPower, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(rotationRateTotalPower, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(rotationRateDominantFrequency, NSNumber, NSObject, NO, nil, nil),
+           })),
+   ENTRY(ORKLocationSummaryResult,
+         nil,
+         (@{
+            PROPERTY(numberOfLocations, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(numberOfRecordedLocations, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(totalDistance, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(duration, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(averageSpeed, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(maximumSpeed, NSNumber, NSObject, NO, nil, nil),
+           })),
    ENTRY(ORKPSATSample,
          nil,
          (@{
@@ -1107,6 +1190,8 @@ encondingTable =
             PROPERTY(totalCorrect, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(totalDyad, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(totalTime, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(meanTime, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(timeStandardDeviation, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(initialDigit, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(samples, ORKPSATSample, NSArray, NO, nil, nil),
             })),
@@ -1140,6 +1225,8 @@ encondingTable =
             PROPERTY(totalSuccesses, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(totalFailures, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(totalTime, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(meanTime, NSNumber, NSObject, NO, nil, nil),
+            PROPERTY(timeStandardDeviation, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(totalDistance, NSNumber, NSObject, NO, nil, nil),
             PROPERTY(samples, ORKHolePegTestSample, NSArray, NO, nil, nil),
             })),
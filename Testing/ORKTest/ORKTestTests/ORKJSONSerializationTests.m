@@ -353,6 +353,7 @@ ORK_MAKE_TEST_INIT(ORKLocation, (^{
                                               @"ORKConsentSection.escapedContent",
                                               @"ORKConsentSignature.signatureImage",
                                               @"ORKConsentDocument.writer",
+                                              @"ORKConsentDocument.PDFRenderer",
                                               @"ORKConsentDocument.signatureFormatter",
                                               @"ORKConsentDocument.sectionFormatter",
                                               @"ORKConsentDocument.sections",
@@ -392,6 +393,7 @@ ORK_MAKE_TEST_INIT(ORKLocation, (^{
                                               @"ORKRegistrationStep.passcodeInvalidMessage",
                                               @"ORKSignatureResult.signatureImage",
                                               @"ORKSignatureResult.signaturePath",
+                                              @"ORKSignatureResult.signatureStrokeData",
                                               ];
     NSArray *allowedUnTouchedKeys = @[@"_class"];
     
@@ -475,6 +477,8 @@ ORK_MAKE_TEST_INIT(ORKLocation, (^{
             [instance setValue:NSStringFromClass([ORKVerificationStepViewController class]) forKey:@"verificationViewControllerString"];
         } else if ([aClass isSubclassOfClass:[ORKReviewStep class]]) {
             [instance setValue:[ORKTaskResult new] forKey:@"resultSource"]; // Manually add here because it's a protocol and hence property doesn't have a class
+        } else if ([aClass isSubclassOfClass:[ORKToneAudiometryStep class]]) {
+            [instance setValue:@{ @250: @0.2, @1000: @0.5, @8000: @0.8 } forKey:@"calibrationTable"];
         }
         
         // Serialization
@@ -578,6 +582,7 @@ ORK_MAKE_TEST_INIT(ORKLocation, (^{
                                        @"firstResult",
                                        ];
     NSArray *knownNotSerializedProperties = @[@"ORKConsentDocument.writer", // created on demand
+                                              @"ORKConsentDocument.PDFRenderer", // created on demand
                                               @"ORKConsentDocument.signatureFormatter", // created on demand
                                               @"ORKConsentDocument.sectionFormatter", // created on demand
                                               @"ORKStep.task", // weak ref - object will be nil